@@ -946,13 +946,34 @@ macro(CheckPTHREAD)
       check_function_exists(pthread_setname_np HAVE_PTHREAD_SETNAME_NP)
       check_function_exists(pthread_set_name_np HAVE_PTHREAD_SET_NAME_NP)
 
+      if(FUTEX AND LINUX)
+        check_c_source_compiles("
+            #include <linux/futex.h>
+            #include <sys/syscall.h>
+            #include <unistd.h>
+            int main(int argc, char **argv) {
+                return (int) syscall(SYS_futex, 0, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG, 0, 0, 0, FUTEX_BITSET_MATCH_ANY);
+            }" HAVE_FUTEX)
+      endif()
+
       set(SOURCE_FILES ${SOURCE_FILES}
           ${SDL2_SOURCE_DIR}/src/thread/pthread/SDL_systhread.c
-          ${SDL2_SOURCE_DIR}/src/thread/pthread/SDL_sysmutex.c   # Can be faked, if necessary
-          ${SDL2_SOURCE_DIR}/src/thread/pthread/SDL_syscond.c    # Can be faked, if necessary
           ${SDL2_SOURCE_DIR}/src/thread/pthread/SDL_systls.c
           )
-      if(HAVE_PTHREADS_SEM)
+      if(HAVE_FUTEX)
+        set(SOURCE_FILES ${SOURCE_FILES}
+            ${SDL2_SOURCE_DIR}/src/thread/linux/SDL_sysmutex.c
+            ${SDL2_SOURCE_DIR}/src/thread/linux/SDL_syscond.c
+            ${SDL2_SOURCE_DIR}/src/thread/linux/SDL_syssem.c)
+      else()
+        set(SOURCE_FILES ${SOURCE_FILES}
+            ${SDL2_SOURCE_DIR}/src/thread/pthread/SDL_sysmutex.c   # Can be faked, if necessary
+            ${SDL2_SOURCE_DIR}/src/thread/pthread/SDL_syscond.c    # Can be faked, if necessary
+            )
+      endif()
+      if(HAVE_FUTEX)
+        # Semaphores come from the futex implementation above
+      elseif(HAVE_PTHREADS_SEM)
         set(SOURCE_FILES ${SOURCE_FILES}
             ${SDL2_SOURCE_DIR}/src/thread/pthread/SDL_syssem.c)
       else()
@@ -1105,6 +1126,29 @@ macro(CheckUSBHID)
   endif()
 endmacro()
 
+# Requires:
+# - PkgCheckModules
+macro(CheckHIDAPI)
+  # The hidraw support doesn't catch Xbox, PS4 and Nintendo controllers,
+  # so this uses libusb, like configure does.
+  if(HIDAPI)
+    pkg_check_modules(PKG_LIBUSB libusb-1.0)
+    if(PKG_LIBUSB_FOUND)
+      set(CMAKE_REQUIRED_FLAGS "${PKG_LIBUSB_CFLAGS}")
+      check_include_file(libusb.h HAVE_LIBUSB_1_0_LIBUSB_H)
+      set(CMAKE_REQUIRED_FLAGS "${ORIG_CMAKE_REQUIRED_FLAGS}")
+      if(HAVE_LIBUSB_1_0_LIBUSB_H)
+        set(HAVE_HIDAPI TRUE)
+        set(SDL_JOYSTICK_HIDAPI 1)
+        file(GLOB HIDAPI_JOYSTICK_SOURCES ${SDL2_SOURCE_DIR}/src/joystick/hidapi/*.c)
+        set(SOURCE_FILES ${SOURCE_FILES} ${HIDAPI_JOYSTICK_SOURCES} ${SDL2_SOURCE_DIR}/src/hidapi/libusb/hid.c)
+        list(APPEND EXTRA_CFLAGS "-I${SDL2_SOURCE_DIR}/src/hidapi/hidapi" ${PKG_LIBUSB_CFLAGS})
+        list(APPEND EXTRA_LDFLAGS ${PKG_LIBUSB_LDFLAGS})
+      endif()
+    endif()
+  endif()
+endmacro()
+
 # Requires:
 # - n/a
 macro(CheckRPI)
@@ -43,12 +43,14 @@
 #include "SDL_gamecontroller.h"
 #include "SDL_haptic.h"
 #include "SDL_hints.h"
+#include "SDL_jobs.h"
 #include "SDL_joystick.h"
 #include "SDL_loadso.h"
 #include "SDL_log.h"
 #include "SDL_messagebox.h"
 #include "SDL_mutex.h"
 #include "SDL_power.h"
+#include "SDL_profile.h"
 #include "SDL_render.h"
 #include "SDL_rwops.h"
 #include "SDL_sensor.h"
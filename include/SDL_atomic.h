@@ -265,6 +265,51 @@ extern DECLSPEC void* SDLCALL SDL_AtomicSetPtr(void **a, void* v);
  */
 extern DECLSPEC void* SDLCALL SDL_AtomicGetPtr(void **a);
 
+/**
+ *  \name Lock-free queue
+ *
+ *  A bounded queue of pointers that any number of threads can push to and
+ *  pop from at once without taking a lock. Pushing to a full queue and
+ *  popping from an empty one fail rather than wait.
+ */
+/* @{ */
+
+/* The SDL lock-free queue structure, defined in SDL_atomicqueue.c */
+struct SDL_AtomicQueue;
+typedef struct SDL_AtomicQueue SDL_AtomicQueue;
+
+/**
+ * \brief Create a lock-free queue.
+ *
+ * \param capacity The number of items the queue can hold, rounded up to a power of two.
+ *
+ * \return A new queue, or NULL if there was an error.
+ */
+extern DECLSPEC SDL_AtomicQueue * SDLCALL SDL_CreateAtomicQueue(int capacity);
+
+/**
+ * \brief Add an item to the back of a lock-free queue.
+ *
+ * \return SDL_TRUE if the item was added, SDL_FALSE if the queue was full.
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_AtomicQueuePush(SDL_AtomicQueue *queue, void *item);
+
+/**
+ * \brief Remove the item at the front of a lock-free queue.
+ *
+ * \return SDL_TRUE if an item was removed into \c item, SDL_FALSE if the queue was empty.
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_AtomicQueuePop(SDL_AtomicQueue *queue, void **item);
+
+/**
+ * \brief Destroy a lock-free queue.
+ *
+ * \note No other threads may be using the queue, and items left in it are not freed.
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyAtomicQueue(SDL_AtomicQueue *queue);
+
+/* @} *//* Lock-free queue */
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
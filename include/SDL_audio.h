@@ -523,6 +523,24 @@ extern DECLSPEC SDL_AudioStream * SDLCALL SDL_NewAudioStream(const SDL_AudioForm
                                            const Uint8 dst_channels,
                                            const int dst_rate);
 
+/**
+ *  Set aside all the memory a stream needs for puts of up to \c max_put_len
+ *  bytes, so it doesn't allocate while running.
+ *
+ *  Call this right after SDL_NewAudioStream(). Afterwards, SDL_AudioStreamPut()
+ *  with no more than \c max_put_len bytes won't allocate, as long as the
+ *  caller gets the converted data out before more than two puts' worth has
+ *  built up. This makes a stream safe to use from a real-time audio thread.
+ *
+ *  \param stream The stream to preallocate for
+ *  \param max_put_len The largest number of bytes a single put will add
+ *  \return 0 on success, or -1 on error.
+ *
+ *  \sa SDL_NewAudioStream
+ *  \sa SDL_AudioStreamPut
+ */
+extern DECLSPEC int SDLCALL SDL_AudioStreamPreallocate(SDL_AudioStream *stream, int max_put_len);
+
 /**
  *  Add data to be converted/resampled to the stream
  *
@@ -793,6 +811,46 @@ extern DECLSPEC Uint32 SDLCALL SDL_GetQueuedAudioSize(SDL_AudioDeviceID dev);
  */
 extern DECLSPEC void SDLCALL SDL_ClearQueuedAudio(SDL_AudioDeviceID dev);
 
+/**
+ *  Get how far an open audio device is behind the application, in sample
+ *  frames at the rate you opened the device with.
+ *
+ *  For playback devices, this is everything that has been generated but
+ *  not played yet: audio queued with SDL_QueueAudio(), audio SDL is holding
+ *  while converting it, and audio the device has buffered. For capture
+ *  devices, it is everything recorded that the application hasn't seen yet.
+ *
+ *  Drivers that can't report their own buffering are assumed to be playing
+ *  one buffer of spec.samples frames at a time.
+ *
+ *  \param dev The device ID to query.
+ *  \return The latency in sample frames, or -1 on error.
+ *
+ *  \sa SDL_GetAudioDeviceTimestamp
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioDeviceLatency(SDL_AudioDeviceID dev);
+
+/**
+ *  Get the timing of the most recent audio callback on a device, for
+ *  synchronizing audio with video.
+ *
+ *  Both times are SDL_GetPerformanceCounter() values. \c callback_time is
+ *  when SDL started the callback. For playback devices, \c sample_time is
+ *  when the first sample the callback writes is expected to be heard. For
+ *  capture devices, it is when the first sample it gets was recorded.
+ *
+ *  Call this from your audio callback to time the buffer you're given, or
+ *  from elsewhere to time the last one. Both are 0 before the first callback.
+ *
+ *  \param dev The device ID to query.
+ *  \param callback_time Filled in with when the last callback started, may be NULL.
+ *  \param sample_time Filled in with when its first sample plays or was recorded, may be NULL.
+ *  \return 0 on success, or -1 on error.
+ *
+ *  \sa SDL_GetAudioDeviceLatency
+ */
+extern DECLSPEC int SDLCALL SDL_GetAudioDeviceTimestamp(SDL_AudioDeviceID dev, Uint64 *callback_time, Uint64 *sample_time);
+
 
 /**
  *  \name Audio lock functions
@@ -652,6 +652,25 @@ extern DECLSPEC SDL_bool SDLCALL SDL_HasEvents(Uint32 minType, Uint32 maxType);
 extern DECLSPEC void SDLCALL SDL_FlushEvent(Uint32 type);
 extern DECLSPEC void SDLCALL SDL_FlushEvents(Uint32 minType, Uint32 maxType);
 
+/**
+ *  Gets raw motion events recorded while event coalescing is enabled.
+ *
+ *  With ::SDL_HINT_EVENT_COALESCING enabled, motion events for the same
+ *  device and axis are merged in the event queue, and every one of them is
+ *  also recorded here before it is merged, oldest first. Applications that
+ *  need every sample, like drawing programs, can read them from here.
+ *
+ *  Up to \c numevents events within the specified minimum and maximum type
+ *  are returned and removed from the history. Only the most recent 4096
+ *  events are kept.
+ *
+ *  \return The number of events actually stored, or -1 if there was an error.
+ *
+ *  This function is thread-safe.
+ */
+extern DECLSPEC int SDLCALL SDL_GetEventHistory(SDL_Event * events, int numevents,
+                                                Uint32 minType, Uint32 maxType);
+
 /**
  *  \brief Polls for currently pending events.
  *
@@ -153,6 +153,25 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_VSYNC               "SDL_RENDER_VSYNC"
 
+/**
+ *  \brief  A variable controlling how many threads the software renderer draws with.
+ *
+ *  This variable can be set to the following values:
+ *    "0" or "1" - Draw each call immediately on the calling thread
+ *    "N"        - Record fills, clears and unscaled copies, sort them into
+ *                 64x64 pixel tiles and draw the tiles on up to N threads
+ *                 of the job system, see SDL_HINT_JOB_THREADS
+ *
+ *  Recorded drawing is finished by SDL_RenderPresent(), SDL_RenderReadPixels(),
+ *  changing the render target, updating or locking a texture, and by any
+ *  other drawing, which is still done on the calling thread. The result is
+ *  the same as drawing on one thread.
+ *
+ *  By default the software renderer draws on the calling thread. This hint
+ *  is read when the renderer is created.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_THREADS    "SDL_RENDER_SOFTWARE_THREADS"
+
 /**
  *  \brief  A variable controlling whether the screensaver is enabled. 
  *
@@ -1043,6 +1062,190 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_CATEGORY   "SDL_AUDIO_CATEGORY"
 
+/**
+ *  \brief  A variable controlling the number of worker threads in the job system
+ *
+ *  The workers are started by the first use of the job system, so this
+ *  must be set before then.
+ *
+ *  This variable can be set to a positive number of threads. By default
+ *  there is one fewer than the number of CPUs, since threads waiting for
+ *  jobs help run them, but always at least one.
+ */
+#define SDL_HINT_JOB_THREADS   "SDL_JOB_THREADS"
+
+/**
+ *  \brief  A variable controlling whether SDL splits large operations across the job system
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Large operations run on the calling thread (default)
+ *    "1"       - Large blits and pixel format conversions are split into
+ *                bands of rows, which are done in parallel
+ *
+ *  This applies to SDL_BlitSurface(), SDL_ConvertSurface() and
+ *  SDL_ConvertPixels(), except for scaled blits, RLE encoded sources,
+ *  blits within one surface and conversions to or from YUV formats.
+ */
+#define SDL_HINT_JOB_BULK_OPERATIONS   "SDL_JOB_BULK_OPERATIONS"
+
+/**
+ *  \brief  A variable controlling whether the disk audio driver runs in real time
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Write audio as fast as it can be generated and written out,
+ *                e.g. for offline rendering or capturing output in tests
+ *    "1"       - Wait for as long as each buffer would take to play (default)
+ *
+ *  In real time mode the wait can be overridden with the SDL_DISKAUDIODELAY
+ *  environment variable, in milliseconds.
+ */
+#define SDL_HINT_AUDIO_DISK_REALTIME   "SDL_AUDIO_DISK_REALTIME"
+
+/**
+ *  \brief  A variable controlling whether the disk audio driver writes a WAV header
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Write raw sample data (default)
+ *    "1"       - Write a WAV file, converting to a format WAV supports if necessary
+ */
+#define SDL_HINT_AUDIO_DISK_WAV_HEADER   "SDL_AUDIO_DISK_WAV_HEADER"
+
+/**
+ *  \brief  A variable controlling whether audio devices convert in place
+ *
+ *  When a device only needs a format or channel conversion, and the callback
+ *  and device use the same number of samples per buffer, the audio thread
+ *  can convert each buffer in place, straight into the device's buffer,
+ *  instead of passing it through an SDL_AudioStream.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Always pass converted audio through an SDL_AudioStream
+ *    "1"       - Convert in place when possible (default)
+ *
+ *  This is checked when the device is opened.
+ */
+#define SDL_HINT_AUDIO_DIRECT_CONVERSION   "SDL_AUDIO_DIRECT_CONVERSION"
+
+/**
+ *  \brief  A variable controlling whether audio devices are opened for low latency
+ *
+ *  In low latency mode, SDL asks the audio driver for the shortest buffer it
+ *  can play safely if the requested spec has more samples than that. The
+ *  driver may still round this up. The callback only gets the device's
+ *  buffer size if SDL_AUDIO_ALLOW_SAMPLES_CHANGE is allowed; otherwise SDL
+ *  converts between the two sizes as usual.
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Use the requested number of samples (default)
+ *    "1"       - Use at most the shortest buffer the driver supports
+ *
+ *  This is checked when the device is opened.
+ *
+ *  \sa SDL_GetAudioDeviceLatency
+ */
+#define SDL_HINT_AUDIO_LOW_LATENCY   "SDL_AUDIO_LOW_LATENCY"
+
+/**
+ *  \brief  A variable controlling the number of threads used for asynchronous file I/O
+ *
+ *  The I/O threads are started by the first call to SDL_LoadFileAsync() or
+ *  SDL_RWReadAsync(), so this must be set before then.
+ *
+ *  This variable can be set to a positive number of threads (default: 4).
+ */
+#define SDL_HINT_ASYNCIO_THREADS   "SDL_ASYNCIO_THREADS"
+
+/**
+ *  \brief  A variable naming a file that the dummy video driver writes presented frames to
+ *
+ *  The frames are written on a background thread, so the presenting thread
+ *  only waits if the writer falls more than a few frames behind. Set this
+ *  to "-" to write to standard output, e.g. to pipe frames into an encoder.
+ *
+ *  This is read when the first window framebuffer is created.
+ */
+#define SDL_HINT_VIDEO_DUMMY_FRAME_OUTPUT   "SDL_VIDEO_DUMMY_FRAME_OUTPUT"
+
+/**
+ *  \brief  A variable controlling the format of frames written by the dummy video driver
+ *
+ *  This variable can be set to the following values:
+ *    "ppm"    - Each frame is a binary (P6) PPM image (default)
+ *    "raw"    - Each frame is the packed framebuffer rows, in SDL_PIXELFORMAT_RGB888
+ */
+#define SDL_HINT_VIDEO_DUMMY_FRAME_FORMAT   "SDL_VIDEO_DUMMY_FRAME_FORMAT"
+
+/**
+ *  \brief  A variable controlling whether Linux input devices are read on a dedicated thread
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Devices are read when events are pumped (default)
+ *    "1"       - A high priority thread reads joystick and evdev devices as
+ *                soon as they have input, so joystick events are queued and
+ *                joystick state is updated between frames. Keyboard, mouse
+ *                and touch input from evdev is buffered, and sent when
+ *                events are pumped, since that state isn't thread safe.
+ *
+ *  Either way, events from these devices are timestamped with the time the
+ *  kernel received them, rather than the time they were read.
+ *
+ *  This is read when the first joystick or evdev input backend starts.
+ */
+#define SDL_HINT_INPUT_THREAD   "SDL_INPUT_THREAD"
+
+/**
+ *  \brief  A variable listing extra evdev devices to read keyboard and mouse input from
+ *
+ *  This is a colon separated list of device paths, e.g. "/dev/input/event3",
+ *  which are opened in addition to any devices found by udev. It is useful
+ *  when SDL is built without udev support.
+ *
+ *  This is read when the evdev input backend starts.
+ */
+#define SDL_HINT_EVDEV_DEVICES   "SDL_EVDEV_DEVICES"
+
+/**
+ *  \brief  A variable controlling whether motion events are merged in the event queue
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Every motion event is queued separately (default)
+ *    "1"       - A mouse motion, touch motion, joystick axis or ball, game
+ *                controller axis or sensor event replaces a queued event for
+ *                the same device and axis, so a frame gets one event for each
+ *
+ *  Relative motion is added up when events are merged, and events are never
+ *  merged across other events like button presses. Event watchers still see
+ *  every event, and the raw events can be read with SDL_GetEventHistory().
+ */
+#define SDL_HINT_EVENT_COALESCING   "SDL_EVENT_COALESCING"
+
+/**
+ *  \brief  A variable naming a file to write a profile trace to
+ *
+ *  When SDL is built with the profiler, this starts recording at SDL_Init()
+ *  and writes the zones, counters and frame markers to this file in the
+ *  Chrome trace event format, which chrome://tracing and Perfetto can open.
+ *  The file is complete after SDL_Quit().
+ *
+ *  By default no trace is written.
+ */
+#define SDL_HINT_PROFILE_TRACE   "SDL_PROFILE_TRACE"
+
+/**
+ *  \brief  A variable controlling whether converting RGB surfaces to 8 bits per pixel is dithered
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Each pixel becomes the nearest palette color (default)
+ *    "1"       - A 4x4 ordered dither pattern, scaled to the spacing of the
+ *                palette colors, is added first, so gradients come out as
+ *                a mix of colors rather than bands
+ *
+ *  This applies to SDL_ConvertSurface() and to blits without blending or a
+ *  colorkey, and is read when a surface is mapped for blitting to an 8-bit
+ *  surface, e.g. after the destination palette changes.
+ */
+#define SDL_HINT_PALETTE_DITHER   "SDL_PALETTE_DITHER"
+
 /**
  *  \brief  An enumeration of hint priorities
  */
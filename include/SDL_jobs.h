@@ -0,0 +1,153 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_jobs_h_
+#define SDL_jobs_h_
+
+/**
+ *  \file SDL_jobs.h
+ *
+ *  Header for the SDL job system.
+ *
+ *  The job system runs small units of work on a fixed pool of worker
+ *  threads, sized from SDL_GetCPUCount() unless SDL_HINT_JOB_THREADS is
+ *  set. Each worker has its own queue, and idle workers steal work from
+ *  busy ones. The pool is started by the first job and stopped by
+ *  SDL_Quit().
+ *
+ *  Jobs are tracked with counters: a counter is incremented when a job
+ *  is submitted against it and decremented when that job finishes, so
+ *  waiting for a counter to reach zero waits for a whole batch of jobs.
+ *  Threads waiting on a counter run queued jobs until it does, so it is
+ *  safe to wait from inside a job.
+ */
+
+#include "SDL_stdinc.h"
+#include "SDL_error.h"
+
+#include "begin_code.h"
+/* Set up for C function definitions, even when using C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The SDL job counter structure, defined in SDL_jobs.c */
+struct SDL_JobCounter;
+typedef struct SDL_JobCounter SDL_JobCounter;
+
+/**
+ *  The function run by a job.
+ */
+typedef void (SDLCALL * SDL_JobFunction) (void *data);
+
+/**
+ *  The function run by SDL_ParallelFor() for each range of indices,
+ *  from \c start up to but not including \c end.
+ */
+typedef void (SDLCALL * SDL_ParallelForFunction) (void *data, int start, int end);
+
+/**
+ *  \brief Get the number of worker threads in the job system, starting it if necessary.
+ *
+ *  \return The number of worker threads, or -1 if the job system couldn't be started.
+ */
+extern DECLSPEC int SDLCALL SDL_GetJobWorkerCount(void);
+
+/**
+ *  \brief Create a counter to track a group of jobs.
+ *
+ *  \return A new counter with a value of zero, or NULL if there was an error.
+ */
+extern DECLSPEC SDL_JobCounter * SDLCALL SDL_CreateJobCounter(void);
+
+/**
+ *  \brief Get the number of unfinished jobs submitted against a counter.
+ */
+extern DECLSPEC int SDLCALL SDL_GetJobCounterValue(SDL_JobCounter * counter);
+
+/**
+ *  \brief Destroy a counter.
+ *
+ *  \note No jobs may be pending on or waiting for the counter.
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyJobCounter(SDL_JobCounter * counter);
+
+/**
+ *  \brief Run a function on the job system.
+ *
+ *  \param fn      The function to run.
+ *  \param data    A pointer that is passed to \c fn.
+ *  \param counter A counter to track the job with, or NULL.
+ *
+ *  \return 0 on success, or -1 if the job couldn't be queued.
+ *
+ *  \sa SDL_WaitJobCounter()
+ */
+extern DECLSPEC int SDLCALL SDL_RunJob(SDL_JobFunction fn, void *data, SDL_JobCounter * counter);
+
+/**
+ *  \brief Run a function on the job system once other jobs have finished.
+ *
+ *  The job is queued when \c dependency next reaches zero, or right away
+ *  if it is already zero. \c counter is incremented immediately, so
+ *  waiting on it also waits for the dependency.
+ *
+ *  \param fn         The function to run.
+ *  \param data       A pointer that is passed to \c fn.
+ *  \param counter    A counter to track the job with, or NULL.
+ *  \param dependency The counter to wait for.
+ *
+ *  \return 0 on success, or -1 if the job couldn't be queued.
+ */
+extern DECLSPEC int SDLCALL SDL_RunJobAfter(SDL_JobFunction fn, void *data, SDL_JobCounter * counter, SDL_JobCounter * dependency);
+
+/**
+ *  \brief Wait for all the jobs submitted against a counter to finish.
+ *
+ *  The calling thread runs queued jobs while it waits.
+ */
+extern DECLSPEC void SDLCALL SDL_WaitJobCounter(SDL_JobCounter * counter);
+
+/**
+ *  \brief Call a function for a range of indices on the job system, and wait for it to finish.
+ *
+ *  \param start The first index.
+ *  \param end   One past the last index.
+ *  \param grain The number of indices to pass to each call, or 0 to pick
+ *               one based on the number of worker threads.
+ *  \param fn    The function to call for each range.
+ *  \param data  A pointer that is passed to \c fn.
+ *
+ *  \return 0 on success, or -1 if there was an error. If the job system
+ *          can't be used, \c fn is called for the whole range on the
+ *          calling thread instead.
+ */
+extern DECLSPEC int SDLCALL SDL_ParallelFor(int start, int end, int grain, SDL_ParallelForFunction fn, void *data);
+
+/* Ends C function definitions when using C++ */
+#ifdef __cplusplus
+}
+#endif
+#include "close_code.h"
+
+#endif /* SDL_jobs_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -240,6 +240,72 @@ extern DECLSPEC int SDLCALL SDL_CondWaitTimeout(SDL_cond * cond,
 /* @} *//* Condition variable functions */
 
 
+/**
+ *  \name Reader-writer lock functions
+ */
+/* @{ */
+
+/* The SDL reader-writer lock structure, defined in SDL_rwlock.c */
+struct SDL_rwlock;
+typedef struct SDL_rwlock SDL_rwlock;
+
+/**
+ *  Create a reader-writer lock.
+ *
+ *  Any number of threads may hold the lock for reading at once, but a
+ *  thread holding it for writing excludes everyone else. Use it to protect
+ *  data that is read often and changed rarely.
+ *
+ *  A thread that holds the lock for reading may lock it for reading again,
+ *  but must not try to lock it for writing, and a thread holding it for
+ *  writing must not lock it again at all.
+ */
+extern DECLSPEC SDL_rwlock *SDLCALL SDL_CreateRWLock(void);
+
+/**
+ *  Lock the reader-writer lock for reading, waiting while a writer holds it.
+ *
+ *  \return 0, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_LockRWLockForReading(SDL_rwlock * rwlock);
+
+/**
+ *  Lock the reader-writer lock for writing, waiting until no other thread
+ *  holds it.
+ *
+ *  \return 0, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_LockRWLockForWriting(SDL_rwlock * rwlock);
+
+/**
+ *  Try to lock the reader-writer lock for reading without waiting.
+ *
+ *  \return 0, ::SDL_MUTEX_TIMEDOUT, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_TryLockRWLockForReading(SDL_rwlock * rwlock);
+
+/**
+ *  Try to lock the reader-writer lock for writing without waiting.
+ *
+ *  \return 0, ::SDL_MUTEX_TIMEDOUT, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_TryLockRWLockForWriting(SDL_rwlock * rwlock);
+
+/**
+ *  Unlock the reader-writer lock, whichever way it was locked.
+ *
+ *  \return 0, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_UnlockRWLock(SDL_rwlock * rwlock);
+
+/**
+ *  Destroy a reader-writer lock.
+ */
+extern DECLSPEC void SDLCALL SDL_DestroyRWLock(SDL_rwlock * rwlock);
+
+/* @} *//* Reader-writer lock functions */
+
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
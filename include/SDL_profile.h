@@ -0,0 +1,141 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_profile_h_
+#define SDL_profile_h_
+
+/**
+ *  \file SDL_profile.h
+ *
+ *  Header for the built-in profiler.
+ *
+ *  SDL can record zones (timed spans of code), counters and frame markers
+ *  from its own hot paths, like SDL_PumpEvents(), SDL_RenderPresent(), the
+ *  audio callback and surface blits, and applications can add their own.
+ *  Each thread records into its own ring buffer without taking locks. The
+ *  buffers are drained by SDL_FlushProfile(), which SDL_ProfileFrame() and
+ *  SDL_PumpEvents() call, and the events are passed to the callback set
+ *  with SDL_SetProfileCallback() and written to the Chrome trace event
+ *  file named by SDL_HINT_PROFILE_TRACE.
+ *
+ *  The profiler is only built in when SDL is configured with
+ *  --enable-profiler (or -DPROFILER=ON with CMake). Otherwise SDL's own
+ *  zones compile to nothing and these functions do nothing.
+ */
+
+#include "SDL_stdinc.h"
+#include "SDL_error.h"
+#include "SDL_thread.h"
+
+#include "begin_code.h"
+/* Set up for C function definitions, even when using C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  The kinds of profile events.
+ */
+typedef enum
+{
+    SDL_PROFILE_ZONE_BEGIN,     /**< A zone was entered */
+    SDL_PROFILE_ZONE_END,       /**< The innermost zone was left */
+    SDL_PROFILE_COUNTER,        /**< A counter was set */
+    SDL_PROFILE_FRAME           /**< A frame ended */
+} SDL_ProfileEventType;
+
+/**
+ *  A recorded profile event.
+ */
+typedef struct SDL_ProfileEvent
+{
+    SDL_ProfileEventType type;
+    const char *name;       /**< The zone or counter name, NULL for frame markers */
+    SDL_threadID thread;    /**< The thread that recorded the event */
+    Uint64 timestamp;       /**< When it was recorded, in SDL_GetPerformanceCounter() units */
+    Sint64 value;           /**< The counter value, 0 for other events */
+} SDL_ProfileEvent;
+
+/**
+ *  The function called by SDL_FlushProfile() with the events recorded
+ *  since the last flush. Events from one thread are in order, but events
+ *  from different threads are not merged.
+ */
+typedef void (SDLCALL * SDL_ProfileCallback) (void *userdata, const SDL_ProfileEvent *events, int numevents);
+
+/**
+ *  \brief Enter a zone on the calling thread.
+ *
+ *  \param name The name of the zone. Only the pointer is recorded, so it
+ *              must stay valid until the events are flushed; a string
+ *              literal is best.
+ */
+extern DECLSPEC void SDLCALL SDL_ProfileBeginZone(const char *name);
+
+/**
+ *  \brief Leave the innermost zone on the calling thread.
+ *
+ *  \param name The name of the zone, the same as passed to SDL_ProfileBeginZone()
+ */
+extern DECLSPEC void SDLCALL SDL_ProfileEndZone(const char *name);
+
+/**
+ *  \brief Record the value of a named counter.
+ *
+ *  \param name The name of the counter, which must stay valid like zone names
+ *  \param value The current value of the counter
+ */
+extern DECLSPEC void SDLCALL SDL_ProfileCounter(const char *name, Sint64 value);
+
+/**
+ *  \brief Mark the end of a frame and flush the recorded events.
+ */
+extern DECLSPEC void SDLCALL SDL_ProfileFrame(void);
+
+/**
+ *  \brief Set a function to receive the recorded events.
+ *
+ *  Recording starts when a callback is set, or at SDL_Init() when
+ *  SDL_HINT_PROFILE_TRACE is set, and stops at SDL_Quit().
+ *
+ *  \param callback The function to call, or NULL to remove the callback
+ *  \param userdata A pointer passed to the callback
+ *
+ *  \return 0 on success, or -1 if SDL was built without the profiler.
+ */
+extern DECLSPEC int SDLCALL SDL_SetProfileCallback(SDL_ProfileCallback callback, void *userdata);
+
+/**
+ *  \brief Pass the events recorded by all threads to the callback and the trace file.
+ *
+ *  \return The number of events flushed, or -1 if SDL was built without the profiler.
+ */
+extern DECLSPEC int SDLCALL SDL_FlushProfile(void);
+
+/* Ends C function definitions when using C++ */
+#ifdef __cplusplus
+}
+#endif
+#include "close_code.h"
+
+#endif /* SDL_profile_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
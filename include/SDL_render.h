@@ -127,6 +127,27 @@ typedef struct SDL_Renderer SDL_Renderer;
 struct SDL_Texture;
 typedef struct SDL_Texture SDL_Texture;
 
+/**
+ *  \brief The number of presented frames SDL_GetRenderStatsHistory() remembers.
+ */
+#define SDL_RENDER_STATS_HISTORY    60
+
+/**
+ *  \brief The work a renderer did for one frame.
+ *
+ *  \sa SDL_GetRenderStats()
+ */
+typedef struct SDL_RenderStats
+{
+    Uint32 frame;               /**< The frame number, counting presents from 1 */
+    Uint32 draw_calls;          /**< Clears, points, lines, rects and copies handed to the backend */
+    Uint32 texture_binds;       /**< Copies from a different texture than the copy before */
+    Uint32 blend_changes;       /**< Draws with a different blend mode than the draw before */
+    Uint32 state_changes;       /**< Render target, viewport and clip rectangle changes */
+    Uint32 texture_uploads;     /**< Texture updates and unlocks the backend carried out */
+    Uint64 bytes_uploaded;      /**< Pixel data the backend uploaded to textures, in bytes */
+} SDL_RenderStats;
+
 
 /* Function prototypes */
 
@@ -860,6 +881,39 @@ extern DECLSPEC int SDLCALL SDL_RenderReadPixels(SDL_Renderer * renderer,
  */
 extern DECLSPEC void SDLCALL SDL_RenderPresent(SDL_Renderer * renderer);
 
+/**
+ *  \brief Get the statistics of the last frame a renderer presented.
+ *
+ *  The counters are collected from one SDL_RenderPresent() to the next, so
+ *  they cover everything drawn and uploaded for that frame. Before the first
+ *  present, all of them are 0.
+ *
+ *  \param renderer The renderer to query.
+ *  \param stats    A pointer filled in with the statistics.
+ *
+ *  \return 0 on success, or -1 on error.
+ *
+ *  \sa SDL_GetRenderStatsHistory()
+ */
+extern DECLSPEC int SDLCALL SDL_GetRenderStats(SDL_Renderer * renderer,
+                                               SDL_RenderStats * stats);
+
+/**
+ *  \brief Get the statistics of the last frames a renderer presented.
+ *
+ *  \param renderer The renderer to query.
+ *  \param stats    An array filled in with the statistics, newest frame first.
+ *  \param count    The number of elements in the array. At most
+ *                  ::SDL_RENDER_STATS_HISTORY frames are remembered.
+ *
+ *  \return The number of frames filled in, or -1 on error.
+ *
+ *  \sa SDL_GetRenderStats()
+ */
+extern DECLSPEC int SDLCALL SDL_GetRenderStatsHistory(SDL_Renderer * renderer,
+                                                      SDL_RenderStats * stats,
+                                                      int count);
+
 /**
  *  \brief Destroy the specified texture.
  *
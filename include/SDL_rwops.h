@@ -45,6 +45,8 @@ extern "C" {
 #define SDL_RWOPS_JNIFILE   3U  /**< Android asset */
 #define SDL_RWOPS_MEMORY    4U  /**< Memory stream */
 #define SDL_RWOPS_MEMORY_RO 5U  /**< Read-Only memory stream */
+#define SDL_RWOPS_MAPPED    6U  /**< Read-Only memory mapped file */
+#define SDL_RWOPS_BUFFERED  7U  /**< Buffered stream on top of another SDL_RWops */
 
 /**
  * This is the read/write operation structure -- very basic.
@@ -165,6 +167,34 @@ extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromMem(void *mem, int size);
 extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromConstMem(const void *mem,
                                                       int size);
 
+/**
+ *  Open a file for reading by mapping it into memory.
+ *
+ *  Reads from the returned stream are plain memory copies, and
+ *  SDL_RWGetMemory() gives direct access to the file contents. If the file
+ *  can't be mapped (or the platform lacks mmap()), it is loaded into memory
+ *  instead and the stream type is SDL_RWOPS_MEMORY_RO.
+ *
+ *  \return a read-only stream, or NULL on error.
+ */
+extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromFileMapped(const char *file);
+
+/**
+ *  Create a stream that buffers reads and writes of another stream.
+ *
+ *  This turns many small reads, like the ones done by SDL_ReadLE32() and
+ *  friends, into a few large reads of the underlying stream.
+ *
+ *  \param src The stream to buffer
+ *  \param buffer_size The size of the buffer in bytes, or 0 for a default size
+ *  \param autoclose If SDL_TRUE, src is closed when the new stream is closed
+ *
+ *  \return the buffered stream, or NULL on error.
+ */
+extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromBuffered(SDL_RWops * src,
+                                                      size_t buffer_size,
+                                                      SDL_bool autoclose);
+
 /* @} *//* RWFrom functions */
 
 
@@ -189,6 +219,23 @@ extern DECLSPEC void SDLCALL SDL_FreeRW(SDL_RWops * area);
 #define SDL_RWclose(ctx)        (ctx)->close(ctx)
 /* @} *//* Read/write macros */
 
+/**
+ *  Get direct access to the unread data of a memory backed stream.
+ *
+ *  This works for streams created by SDL_RWFromMem(), SDL_RWFromConstMem()
+ *  and SDL_RWFromFileMapped(). The returned pointer is valid until the
+ *  stream is closed and must not be written to. The stream position is not
+ *  changed.
+ *
+ *  \param context The stream to query
+ *  \param available Filled with the number of bytes left in the stream, may be NULL
+ *
+ *  \return a pointer to the data at the current position, or NULL if the
+ *          stream isn't memory backed.
+ */
+extern DECLSPEC const void *SDLCALL SDL_RWGetMemory(SDL_RWops * context,
+                                                    size_t *available);
+
 
 /**
  *  Load all the data from an SDL data stream.
@@ -243,6 +290,99 @@ extern DECLSPEC size_t SDLCALL SDL_WriteLE64(SDL_RWops * dst, Uint64 value);
 extern DECLSPEC size_t SDLCALL SDL_WriteBE64(SDL_RWops * dst, Uint64 value);
 /* @} *//* Write endian functions */
 
+/**
+ *  \name Asynchronous I/O
+ *
+ *  Requests are serviced in priority order by a pool of I/O threads, see
+ *  SDL_HINT_ASYNCIO_THREADS. Requests on different files run in parallel,
+ *  reads of the same SDL_RWops run one after the other in priority order.
+ */
+/* @{ */
+
+typedef struct SDL_AsyncIO SDL_AsyncIO;
+
+typedef enum
+{
+    SDL_ASYNCIO_PENDING,    /**< The request is queued or in progress */
+    SDL_ASYNCIO_COMPLETE,   /**< The request finished successfully */
+    SDL_ASYNCIO_FAILED,     /**< The request failed, see SDL_WaitAsyncIO() */
+    SDL_ASYNCIO_CANCELED    /**< The request was canceled before it ran */
+} SDL_AsyncIOStatus;
+
+/**
+ *  The function called on an I/O thread when a request finishes.
+ *
+ *  SDL_GetAsyncIOStatus() and SDL_GetAsyncIOData() can be used on the request
+ *  from the callback, but it must not be freed there.
+ */
+typedef void (SDLCALL *SDL_AsyncIOCallback)(void *userdata, SDL_AsyncIO *request);
+
+/**
+ *  Load an entire file in the background.
+ *
+ *  \param file The file to load
+ *  \param priority Requests with higher priority are serviced first
+ *  \param callback A function called when the request finishes, may be NULL
+ *  \param userdata A pointer passed to the callback
+ *
+ *  \return a request handle that must be freed with SDL_FreeAsyncIO(), or
+ *          NULL on error.
+ */
+extern DECLSPEC SDL_AsyncIO *SDLCALL SDL_LoadFileAsync(const char *file,
+                                                       int priority,
+                                                       SDL_AsyncIOCallback callback,
+                                                       void *userdata);
+
+/**
+ *  Read from a stream in the background.
+ *
+ *  Reads up to \c maxnum objects each of size \c size into \c ptr, like
+ *  SDL_RWread(). The stream and the buffer must not be used until the
+ *  request has finished.
+ *
+ *  \return a request handle that must be freed with SDL_FreeAsyncIO(), or
+ *          NULL on error.
+ */
+extern DECLSPEC SDL_AsyncIO *SDLCALL SDL_RWReadAsync(SDL_RWops * src,
+                                                     void *ptr, size_t size,
+                                                     size_t maxnum,
+                                                     int priority,
+                                                     SDL_AsyncIOCallback callback,
+                                                     void *userdata);
+
+/**
+ *  Poll the status of an asynchronous request without blocking.
+ */
+extern DECLSPEC SDL_AsyncIOStatus SDLCALL SDL_GetAsyncIOStatus(SDL_AsyncIO *request);
+
+/**
+ *  Wait for an asynchronous request to finish.
+ *
+ *  If the request failed or was canceled, SDL_GetError() describes why.
+ */
+extern DECLSPEC SDL_AsyncIOStatus SDLCALL SDL_WaitAsyncIO(SDL_AsyncIO *request);
+
+/**
+ *  Get the result of a completed request.
+ *
+ *  For SDL_LoadFileAsync() this returns the file contents, null terminated
+ *  like SDL_LoadFile(), and ownership passes to the caller who must free it
+ *  with SDL_free(). For SDL_RWReadAsync() this returns the destination
+ *  buffer and \c size is set to the number of objects read.
+ *
+ *  \return the data, or NULL if the request hasn't completed successfully.
+ */
+extern DECLSPEC void *SDLCALL SDL_GetAsyncIOData(SDL_AsyncIO *request,
+                                                 size_t *size);
+
+/**
+ *  Free a request, canceling it if it hasn't started yet or waiting for it
+ *  to finish otherwise.
+ */
+extern DECLSPEC void SDLCALL SDL_FreeAsyncIO(SDL_AsyncIO *request);
+
+/* @} *//* Asynchronous I/O */
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
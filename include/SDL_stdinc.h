@@ -394,6 +394,83 @@ extern DECLSPEC int SDLCALL SDL_SetMemoryFunctions(SDL_malloc_func malloc_func,
  */
 extern DECLSPEC int SDLCALL SDL_GetNumAllocations(void);
 
+/**
+ *  \brief Allocation statistics gathered while allocation tracking is enabled
+ *
+ *  \sa SDL_SetAllocationTracking()
+ *  \sa SDL_GetAllocationStats()
+ */
+typedef struct SDL_AllocationStats
+{
+    Uint64 num_allocations;         /**< Allocations (including reallocations) made */
+    Uint64 num_frees;               /**< Tracked allocations that have been freed */
+    Uint64 bytes_allocated;         /**< Total number of bytes requested */
+    Uint64 bytes_in_use;            /**< Bytes held by outstanding tracked allocations */
+    Uint64 peak_bytes_in_use;       /**< High water mark of bytes_in_use */
+    Uint32 frame_allocations;       /**< Allocations made since the last frame marker */
+    Uint32 last_frame_allocations;  /**< Allocations made during the previous frame */
+    Uint32 peak_frame_allocations;  /**< Largest number of allocations in a single frame */
+    Uint32 num_frames;              /**< Number of frame markers seen */
+} SDL_AllocationStats;
+
+/**
+ *  \brief Allocation statistics for a single call site of SDL_malloc(),
+ *         SDL_calloc() or SDL_realloc()
+ */
+typedef struct SDL_AllocationSite
+{
+    const void *caller;             /**< Return address of the allocating code, or NULL if unknown */
+    Uint64 num_allocations;         /**< Allocations made from this call site */
+    Uint64 bytes_allocated;         /**< Bytes requested from this call site */
+    Uint32 frame_allocations;       /**< Allocations made since the last frame marker */
+    Uint32 peak_frame_allocations;  /**< Largest number of allocations in a single frame */
+} SDL_AllocationSite;
+
+/**
+ *  \brief Enable or disable allocation statistics
+ *
+ *  When enabled, every allocation made through SDL_malloc(), SDL_calloc()
+ *  and SDL_realloc() is recorded along with its call site. This is meant
+ *  for debugging and profiling and adds a lock to every allocation.
+ *
+ *  Enabling tracking clears any previously gathered statistics. Memory
+ *  allocated before tracking was enabled is not accounted for.
+ *
+ *  \return 0 on success, or -1 on error.
+ */
+extern DECLSPEC int SDLCALL SDL_SetAllocationTracking(SDL_bool enabled);
+
+/**
+ *  \brief Get whether allocation statistics are being gathered
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_GetAllocationTracking(void);
+
+/**
+ *  \brief Clear the allocation counters, keeping track of outstanding memory
+ */
+extern DECLSPEC void SDLCALL SDL_ResetAllocationStats(void);
+
+/**
+ *  \brief Get the current allocation statistics
+ */
+extern DECLSPEC void SDLCALL SDL_GetAllocationStats(SDL_AllocationStats *stats);
+
+/**
+ *  \brief Get per call site allocation statistics
+ *
+ *  \param sites An array to be filled with the busiest call sites, sorted by
+ *               number of allocations, or NULL
+ *  \param maxsites The number of elements in the sites array
+ *
+ *  \return The total number of call sites that have allocated memory.
+ */
+extern DECLSPEC int SDLCALL SDL_GetAllocationSites(SDL_AllocationSite *sites, int maxsites);
+
+/**
+ *  \brief Mark the end of a frame for the per-frame allocation counters
+ */
+extern DECLSPEC void SDLCALL SDL_MarkAllocationFrame(void);
+
 extern DECLSPEC char *SDLCALL SDL_getenv(const char *name);
 extern DECLSPEC int SDLCALL SDL_setenv(const char *name, const char *value, int overwrite);
 
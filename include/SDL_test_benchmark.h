@@ -0,0 +1,118 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/**
+ *  \file SDL_test_benchmark.h
+ *
+ *  Include file for SDL test framework.
+ *
+ *  This code is a part of the SDL2_test library, not the main SDL library.
+ */
+
+/*
+
+ Benchmark mode for the test harness.
+
+ Benchmarks are ordinary test cases in ordinary suites, which call
+ SDLTest_Benchmark() for each piece of code they measure. Run the suites
+ through SDLTest_RunBenchmarks() to control the iterations, write the
+ results as JSON and compare them against the results of an earlier run.
+
+*/
+
+#ifndef SDL_test_benchmark_h_
+#define SDL_test_benchmark_h_
+
+#include "SDL_test_harness.h"
+
+#include "begin_code.h"
+/* Set up for C function definitions, even when using C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ! Defaults used for options that are out of range */
+#define SDLTEST_BENCHMARK_WARMUP_ITERATIONS  10
+#define SDLTEST_BENCHMARK_ITERATIONS         100
+#define SDLTEST_BENCHMARK_TOLERANCE          10.0f
+
+/* !< Function pointer to the code measured by a benchmark, called once per iteration */
+typedef void (*SDLTest_BenchmarkFp)(void *arg);
+
+/**
+ * Holds the settings of a benchmark run.
+ */
+typedef struct SDLTest_BenchmarkOptions {
+    /* !< Untimed iterations run first, to warm up caches and lazy initialization. <0 uses the default. */
+    int warmupIterations;
+    /* !< Timed iterations the statistics are taken over. <1 uses the default. */
+    int iterations;
+    /* !< File the results are written to as JSON. NULL disables. */
+    const char *outputFile;
+    /* !< JSON results of an earlier run to compare against. NULL disables. */
+    const char *baselineFile;
+    /* !< How much slower than the baseline median, in percent, fails a benchmark. <=0 uses the default. */
+    float tolerance;
+} SDLTest_BenchmarkOptions;
+
+/**
+ * \brief Measure a piece of code.
+ *
+ * Calls the function for the warm-up iterations, then times each of the
+ * timed iterations with SDL_GetPerformanceCounter() and logs the minimum,
+ * median, 95th percentile, mean and maximum time per iteration. When a
+ * baseline was given, the median is compared with the baseline median of
+ * the same name and an assert fails if it is slower than the tolerance.
+ *
+ * Outside of SDLTest_RunBenchmarks() the default options are used and
+ * nothing is recorded.
+ *
+ * \param name Name of the benchmark, unique within the run, e.g. "blit_copy_xrgb8888".
+ * \param benchmark Function to measure.
+ * \param arg Argument passed to the function.
+ *
+ * \returns 0 if the benchmark ran, 1 if it was slower than the baseline, -1 on error.
+ */
+int SDLTest_Benchmark(const char *name, SDLTest_BenchmarkFp benchmark, void *arg);
+
+/**
+ * \brief Run benchmark suites.
+ *
+ * Runs the suites through SDLTest_RunSuites(), then logs a summary of all
+ * benchmarks and writes the results to the output file.
+ *
+ * \param testSuites Suites containing the benchmarks.
+ * \param filter Filter specification, as for SDLTest_RunSuites(). NULL disables.
+ * \param options Settings of the run, or NULL for the defaults.
+ *
+ * \returns 0 when all benchmarks ran and none regressed, 1 otherwise, 2 on setup errors.
+ */
+int SDLTest_RunBenchmarks(SDLTest_TestSuiteReference *testSuites[], const char *filter, const SDLTest_BenchmarkOptions *options);
+
+/* Ends C function definitions when using C++ */
+#ifdef __cplusplus
+}
+#endif
+#include "close_code.h"
+
+#endif /* SDL_test_benchmark_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -51,6 +51,21 @@ int SDLTest_TrackAllocations();
  */
 void SDLTest_LogAllocations();
 
+/**
+ * \brief Start a region of code that is expected not to allocate memory
+ *
+ * \note This enables SDL allocation tracking if it isn't already enabled,
+ *       and SDLTest_EndSteadyState() disables it again
+ */
+void SDLTest_BeginSteadyState(void);
+
+/**
+ * \brief End a steady state region, failing the current test if it allocated memory
+ *
+ * \returns the number of allocations made in the region
+ */
+int SDLTest_EndSteadyState(void);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
@@ -868,6 +868,40 @@ extern DECLSPEC int SDLCALL SDL_UpdateWindowSurfaceRects(SDL_Window * window,
                                                          const SDL_Rect * rects,
                                                          int numrects);
 
+/**
+ *  \brief The function type for receiving presented window framebuffers.
+ *
+ *  \param userdata The pointer passed to SDL_SetFrameSinkCallback().
+ *  \param window   The window being updated.
+ *  \param format   The pixel format of the framebuffer (an SDL_PixelFormatEnum).
+ *  \param pixels   The framebuffer itself, not a copy.
+ *  \param pitch    The length of a framebuffer row, in bytes.
+ *  \param w        The width of the framebuffer, in pixels.
+ *  \param h        The height of the framebuffer, in pixels.
+ *  \param rects    The areas of the framebuffer that were updated.
+ *  \param numrects The number of rectangles in \c rects.
+ *
+ *  The framebuffer is only valid until the callback returns.
+ */
+typedef void (SDLCALL *SDL_FrameSinkCallback)(void *userdata, SDL_Window *window, Uint32 format, const void *pixels, int pitch, int w, int h, const SDL_Rect *rects, int numrects);
+
+/**
+ *  \brief Receive each window surface update directly from the video driver.
+ *
+ *  \param callback The function to call from SDL_UpdateWindowSurface() and
+ *                  SDL_UpdateWindowSurfaceRects(), or NULL to remove it.
+ *  \param userdata A pointer that is passed to \c callback.
+ *
+ *  \return 0 on success, or -1 if the current video driver doesn't support
+ *          frame sinks.
+ *
+ *  This is intended for headless capture, and is currently only supported
+ *  by the dummy video driver.
+ *
+ *  \sa SDL_UpdateWindowSurfaceRects()
+ */
+extern DECLSPEC int SDLCALL SDL_SetFrameSinkCallback(SDL_FrameSinkCallback callback, void *userdata);
+
 /**
  *  \brief Set a window's input grab mode.
  *
@@ -30,10 +30,13 @@
 #include "SDL_bits.h"
 #include "SDL_revision.h"
 #include "SDL_assert_c.h"
+#include "SDL_profile_c.h"
 #include "events/SDL_events_c.h"
+#include "file/SDL_asyncio_c.h"
 #include "haptic/SDL_haptic_c.h"
 #include "joystick/SDL_joystick_c.h"
 #include "sensor/SDL_sensor_c.h"
+#include "thread/SDL_jobs_c.h"
 
 /* Initialization/Cleanup routines */
 #if !SDL_TIMERS_DISABLED
@@ -135,6 +138,9 @@ SDL_InitSubSystem(Uint32 flags)
     SDL_TicksInit();
 #endif
 
+    /* Start recording if a profile trace was asked for */
+    SDL_ProfileInit();
+
     /* Initialize the event subsystem */
     if ((flags & SDL_INIT_EVENTS)) {
 #if !SDL_EVENTS_DISABLED
@@ -377,6 +383,10 @@ SDL_Quit(void)
 #endif
     SDL_QuitSubSystem(SDL_INIT_EVERYTHING);
 
+    SDL_QuitAsyncIO();
+    SDL_QuitJobs();
+    SDL_ProfileQuit();
+
 #if !SDL_TIMERS_DISABLED
     SDL_TicksQuit();
 #endif
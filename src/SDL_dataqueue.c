@@ -39,6 +39,7 @@ struct SDL_DataQueue
     SDL_DataQueuePacket *pool; /* these are unused packets. */
     size_t packet_size;   /* size of new packets */
     size_t queued_bytes;  /* number of bytes of data in the queue. */
+    SDL_bool allocations_forbidden;  /* assert if we have to malloc a packet. */
 };
 
 static void
@@ -150,6 +151,7 @@ AllocateDataQueuePacket(SDL_DataQueue *queue)
         queue->pool = packet->next;
     } else {
         /* Have to allocate a new one! */
+        SDL_assert(!queue->allocations_forbidden);  /* not enough was preallocated. */
         packet = (SDL_DataQueuePacket *) SDL_malloc(sizeof (SDL_DataQueuePacket) + queue->packet_size);
         if (packet == NULL) {
             return NULL;
@@ -296,6 +298,50 @@ SDL_CountDataQueue(SDL_DataQueue *queue)
     return queue ? queue->queued_bytes : 0;
 }
 
+int
+SDL_PreallocateDataQueue(SDL_DataQueue *queue, const size_t len)
+{
+    SDL_DataQueuePacket *packet;
+    size_t wantpackets;
+    size_t havepackets = 0;
+
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    /* (len) bytes can straddle one more packet than they fill. */
+    wantpackets = ((len + (queue->packet_size - 1)) / queue->packet_size) + 1;
+
+    for (packet = queue->head; packet; packet = packet->next) {
+        havepackets++;
+    }
+    for (packet = queue->pool; packet; packet = packet->next) {
+        havepackets++;
+    }
+
+    while (havepackets < wantpackets) {
+        packet = (SDL_DataQueuePacket *) SDL_malloc(sizeof (SDL_DataQueuePacket) + queue->packet_size);
+        if (!packet) {
+            return SDL_OutOfMemory();
+        }
+        packet->datalen = 0;
+        packet->startpos = 0;
+        packet->next = queue->pool;
+        queue->pool = packet;
+        havepackets++;
+    }
+
+    return 0;
+}
+
+void
+SDL_SetDataQueueAllocationsForbidden(SDL_DataQueue *queue, const SDL_bool forbidden)
+{
+    if (queue) {
+        queue->allocations_forbidden = forbidden;
+    }
+}
+
 void *
 SDL_ReserveSpaceInDataQueue(SDL_DataQueue *queue, const size_t len)
 {
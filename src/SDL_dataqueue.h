@@ -34,6 +34,16 @@ size_t SDL_ReadFromDataQueue(SDL_DataQueue *queue, void *buf, const size_t len);
 size_t SDL_PeekIntoDataQueue(SDL_DataQueue *queue, void *buf, const size_t len);
 size_t SDL_CountDataQueue(SDL_DataQueue *queue);
 
+/* this makes sure there are enough packets, queued or pooled, to hold (len)
+   bytes, so writes that keep the queue at or below that never allocate.
+   Returns 0 on success, -1 on error. */
+int SDL_PreallocateDataQueue(SDL_DataQueue *queue, const size_t len);
+
+/* when this is set, a write that needs a new packet trips an SDL_assert()
+   before allocating it. Use it to check that a real-time thread stays
+   within what SDL_PreallocateDataQueue() set aside. */
+void SDL_SetDataQueueAllocationsForbidden(SDL_DataQueue *queue, const SDL_bool forbidden);
+
 /* this sets a section of the data queue aside (possibly allocating memory for it)
    as if it's been written to, but returns a pointer to that space. You may write
    to this space until a read would consume it. Writes (and other calls to this
@@ -22,11 +22,28 @@
 
 #include "SDL_hints.h"
 #include "SDL_error.h"
+#include "SDL_atomic.h"
+#include "SDL_mutex.h"
 
 
 /* Assuming there aren't many hints set and they aren't being queried in
    critical performance paths, we'll just use linked lists here.
+
+   Hints are read far more often than they are set, and from any thread,
+   so the list is protected by a reader-writer lock. Callbacks are called
+   with the lock released, so they can get and set hints themselves.
+
+   SDL_GetHint() returns a pointer that another thread may replace at any
+   time, so every value a hint has held is kept until SDL_ClearHints().
+   Hints usually flip between a handful of values, so setting one of them
+   again reuses its copy rather than making a new one.
  */
+
+typedef struct SDL_HintValue {
+    char *value;
+    struct SDL_HintValue *next;
+} SDL_HintValue;
+
 typedef struct SDL_HintWatch {
     SDL_HintCallback callback;
     void *userdata;
@@ -36,12 +53,116 @@ typedef struct SDL_HintWatch {
 typedef struct SDL_Hint {
     char *name;
     char *value;
+    SDL_HintValue *values;
     SDL_HintPriority priority;
     SDL_HintWatch *callbacks;
     struct SDL_Hint *next;
 } SDL_Hint;
 
 static SDL_Hint *SDL_hints;
+static SDL_rwlock *SDL_hints_lock;
+static SDL_SpinLock SDL_hints_lock_init;
+
+/* Hints can be used before SDL_Init(), so the lock is created on first use */
+static SDL_rwlock *
+SDL_GetHintsLock(void)
+{
+    if (!SDL_AtomicGetPtr((void **)&SDL_hints_lock)) {
+        SDL_AtomicLock(&SDL_hints_lock_init);
+        if (!SDL_hints_lock) {
+            SDL_AtomicSetPtr((void **)&SDL_hints_lock, SDL_CreateRWLock());
+        }
+        SDL_AtomicUnlock(&SDL_hints_lock_init);
+    }
+    return (SDL_rwlock *)SDL_AtomicGetPtr((void **)&SDL_hints_lock);
+}
+
+static void
+SDL_LockHints(SDL_bool write)
+{
+    SDL_rwlock *lock = SDL_GetHintsLock();
+    if (lock) {
+        if (write) {
+            SDL_LockRWLockForWriting(lock);
+        } else {
+            SDL_LockRWLockForReading(lock);
+        }
+    }
+}
+
+static void
+SDL_UnlockHints(void)
+{
+    SDL_rwlock *lock = (SDL_rwlock *)SDL_AtomicGetPtr((void **)&SDL_hints_lock);
+    if (lock) {
+        SDL_UnlockRWLock(lock);
+    }
+}
+
+static SDL_Hint *
+SDL_FindHint(const char *name)
+{
+    SDL_Hint *hint;
+
+    for (hint = SDL_hints; hint; hint = hint->next) {
+        if (SDL_strcmp(name, hint->name) == 0) {
+            return hint;
+        }
+    }
+    return NULL;
+}
+
+/* Returns the kept copy of value, or NULL if out of memory */
+static char *
+SDL_InternHintValue(SDL_Hint *hint, const char *value)
+{
+    SDL_HintValue *entry, **prev;
+
+    /* The values are kept most recently used first */
+    for (prev = &hint->values; (entry = *prev) != NULL; prev = &entry->next) {
+        if (SDL_strcmp(entry->value, value) == 0) {
+            *prev = entry->next;
+            entry->next = hint->values;
+            hint->values = entry;
+            return entry->value;
+        }
+    }
+
+    entry = (SDL_HintValue *)SDL_malloc(sizeof(*entry));
+    if (!entry) {
+        return NULL;
+    }
+    entry->value = SDL_strdup(value);
+    if (!entry->value) {
+        SDL_free(entry);
+        return NULL;
+    }
+    entry->next = hint->values;
+    hint->values = entry;
+    return entry->value;
+}
+
+/* Whether a callback is still registered, in case an earlier callback removed it */
+static SDL_bool
+SDL_HasHintCallback(const char *name, SDL_HintCallback callback, void *userdata)
+{
+    SDL_Hint *hint;
+    SDL_HintWatch *entry;
+    SDL_bool found = SDL_FALSE;
+
+    SDL_LockHints(SDL_FALSE);
+    hint = SDL_FindHint(name);
+    if (hint) {
+        for (entry = hint->callbacks; entry; entry = entry->next) {
+            if (callback == entry->callback && userdata == entry->userdata) {
+                found = SDL_TRUE;
+                break;
+            }
+        }
+    }
+    SDL_UnlockHints();
+    return found;
+}
 
 SDL_bool
 SDL_SetHintWithPriority(const char *name, const char *value,
@@ -49,7 +170,9 @@ SDL_SetHintWithPriority(const char *name, const char *value,
 {
     const char *env;
     SDL_Hint *hint;
-    SDL_HintWatch *entry;
+    SDL_HintWatch *entry, *watches = NULL;
+    const char *old_value = NULL;
+    int i, num_watches = 0;
 
     if (!name || !value) {
         return SDL_FALSE;
@@ -60,37 +183,72 @@ SDL_SetHintWithPriority(const char *name, const char *value,
         return SDL_FALSE;
     }
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            if (priority < hint->priority) {
-                return SDL_FALSE;
+    SDL_LockHints(SDL_TRUE);
+    hint = SDL_FindHint(name);
+    if (hint) {
+        if (priority < hint->priority) {
+            SDL_UnlockHints();
+            return SDL_FALSE;
+        }
+        if (!hint->value || !value || SDL_strcmp(hint->value, value) != 0) {
+            /* Copy the callbacks, so they can be called without the lock */
+            for (entry = hint->callbacks; entry; entry = entry->next) {
+                ++num_watches;
             }
-            if (!hint->value || !value || SDL_strcmp(hint->value, value) != 0) {
-                for (entry = hint->callbacks; entry; ) {
-                    /* Save the next entry in case this one is deleted */
-                    SDL_HintWatch *next = entry->next;
-                    entry->callback(entry->userdata, name, hint->value, value);
-                    entry = next;
+            if (num_watches > 0) {
+                watches = (SDL_HintWatch *)SDL_malloc(num_watches * sizeof(*watches));
+                if (!watches) {
+                    num_watches = 0;
                 }
-                SDL_free(hint->value);
-                hint->value = value ? SDL_strdup(value) : NULL;
             }
-            hint->priority = priority;
-            return SDL_TRUE;
+            for (entry = hint->callbacks, i = 0; i < num_watches; entry = entry->next, ++i) {
+                watches[i] = *entry;
+            }
+            old_value = hint->value;
+            hint->value = SDL_InternHintValue(hint, value);
+            if (!hint->value) {
+                /* The hint keeps its old value */
+                hint->value = (char *)old_value;
+                SDL_UnlockHints();
+                SDL_free(watches);
+                SDL_OutOfMemory();
+                return SDL_FALSE;
+            }
         }
+        hint->priority = priority;
+        SDL_UnlockHints();
+
+        for (i = 0; i < num_watches; ++i) {
+            if (SDL_HasHintCallback(name, watches[i].callback, watches[i].userdata)) {
+                watches[i].callback(watches[i].userdata, name, old_value, value);
+            }
+        }
+        SDL_free(watches);
+        return SDL_TRUE;
     }
 
     /* Couldn't find the hint, add a new one */
     hint = (SDL_Hint *)SDL_malloc(sizeof(*hint));
     if (!hint) {
+        SDL_UnlockHints();
+        SDL_OutOfMemory();
         return SDL_FALSE;
     }
     hint->name = SDL_strdup(name);
-    hint->value = value ? SDL_strdup(value) : NULL;
+    hint->values = NULL;
+    hint->value = hint->name ? SDL_InternHintValue(hint, value) : NULL;
+    if (!hint->value) {
+        SDL_UnlockHints();
+        SDL_free(hint->name);
+        SDL_free(hint);
+        SDL_OutOfMemory();
+        return SDL_FALSE;
+    }
     hint->priority = priority;
     hint->callbacks = NULL;
     hint->next = SDL_hints;
     SDL_hints = hint;
+    SDL_UnlockHints();
     return SDL_TRUE;
 }
 
@@ -107,14 +265,13 @@ SDL_GetHint(const char *name)
     SDL_Hint *hint;
 
     env = SDL_getenv(name);
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            if (!env || hint->priority == SDL_HINT_OVERRIDE) {
-                return hint->value;
-            }
-            break;
-        }
+
+    SDL_LockHints(SDL_FALSE);
+    hint = SDL_FindHint(name);
+    if (hint && (!env || hint->priority == SDL_HINT_OVERRIDE)) {
+        env = hint->value;
     }
+    SDL_UnlockHints();
     return env;
 }
 
@@ -131,6 +288,29 @@ SDL_GetHintBoolean(const char *name, SDL_bool default_value)
     return SDL_TRUE;
 }
 
+static void
+SDL_DelHintCallbackLocked(const char *name, SDL_HintCallback callback, void *userdata)
+{
+    SDL_Hint *hint = SDL_FindHint(name);
+    SDL_HintWatch *entry, *prev = NULL;
+
+    if (!hint) {
+        return;
+    }
+    for (entry = hint->callbacks; entry; entry = entry->next) {
+        if (callback == entry->callback && userdata == entry->userdata) {
+            if (prev) {
+                prev->next = entry->next;
+            } else {
+                hint->callbacks = entry->next;
+            }
+            SDL_free(entry);
+            break;
+        }
+        prev = entry;
+    }
+}
+
 void
 SDL_AddHintCallback(const char *name, SDL_HintCallback callback, void *userdata)
 {
@@ -147,8 +327,6 @@ SDL_AddHintCallback(const char *name, SDL_HintCallback callback, void *userdata)
         return;
     }
 
-    SDL_DelHintCallback(name, callback, userdata);
-
     entry = (SDL_HintWatch *)SDL_malloc(sizeof(*entry));
     if (!entry) {
         SDL_OutOfMemory();
@@ -157,21 +335,22 @@ SDL_AddHintCallback(const char *name, SDL_HintCallback callback, void *userdata)
     entry->callback = callback;
     entry->userdata = userdata;
 
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            break;
-        }
-    }
+    SDL_LockHints(SDL_TRUE);
+    SDL_DelHintCallbackLocked(name, callback, userdata);
+
+    hint = SDL_FindHint(name);
     if (!hint) {
         /* Need to add a hint entry for this watcher */
         hint = (SDL_Hint *)SDL_malloc(sizeof(*hint));
         if (!hint) {
+            SDL_UnlockHints();
             SDL_OutOfMemory();
             SDL_free(entry);
             return;
         }
         hint->name = SDL_strdup(name);
         hint->value = NULL;
+        hint->values = NULL;
         hint->priority = SDL_HINT_DEFAULT;
         hint->callbacks = NULL;
         hint->next = SDL_hints;
@@ -181,6 +360,7 @@ SDL_AddHintCallback(const char *name, SDL_HintCallback callback, void *userdata)
     /* Add it to the callbacks for this hint */
     entry->next = hint->callbacks;
     hint->callbacks = entry;
+    SDL_UnlockHints();
 
     /* Now call it with the current value */
     value = SDL_GetHint(name);
@@ -190,27 +370,9 @@ SDL_AddHintCallback(const char *name, SDL_HintCallback callback, void *userdata)
 void
 SDL_DelHintCallback(const char *name, SDL_HintCallback callback, void *userdata)
 {
-    SDL_Hint *hint;
-    SDL_HintWatch *entry, *prev;
-
-    for (hint = SDL_hints; hint; hint = hint->next) {
-        if (SDL_strcmp(name, hint->name) == 0) {
-            prev = NULL;
-            for (entry = hint->callbacks; entry; entry = entry->next) {
-                if (callback == entry->callback && userdata == entry->userdata) {
-                    if (prev) {
-                        prev->next = entry->next;
-                    } else {
-                        hint->callbacks = entry->next;
-                    }
-                    SDL_free(entry);
-                    break;
-                }
-                prev = entry;
-            }
-            return;
-        }
-    }
+    SDL_LockHints(SDL_TRUE);
+    SDL_DelHintCallbackLocked(name, callback, userdata);
+    SDL_UnlockHints();
 }
 
 void SDL_ClearHints(void)
@@ -218,12 +380,18 @@ void SDL_ClearHints(void)
     SDL_Hint *hint;
     SDL_HintWatch *entry;
 
+    SDL_LockHints(SDL_TRUE);
     while (SDL_hints) {
         hint = SDL_hints;
         SDL_hints = hint->next;
 
         SDL_free(hint->name);
-        SDL_free(hint->value);
+        while (hint->values) {
+            SDL_HintValue *freeable = hint->values;
+            hint->values = freeable->next;
+            SDL_free(freeable->value);
+            SDL_free(freeable);
+        }
         for (entry = hint->callbacks; entry; ) {
             SDL_HintWatch *freeable = entry;
             entry = entry->next;
@@ -231,6 +399,7 @@ void SDL_ClearHints(void)
         }
         SDL_free(hint);
     }
+    SDL_UnlockHints();
 }
 
 /* vi: set ts=4 sw=4 expandtab: */
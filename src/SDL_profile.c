@@ -0,0 +1,517 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "./SDL_internal.h"
+
+/* Lightweight profiling zones, counters and frame markers */
+
+#include "SDL_atomic.h"
+#include "SDL_hints.h"
+#include "SDL_log.h"
+#include "SDL_mutex.h"
+#include "SDL_rwops.h"
+#include "SDL_thread.h"
+#include "SDL_timer.h"
+#include "SDL_profile_c.h"
+
+#if SDL_PROFILER
+
+/* Events each thread can record between flushes, a power of two */
+#define SDL_PROFILE_BUFFER_EVENTS   8192
+
+/* Size of the text buffered before it's written to the trace file */
+#define SDL_PROFILE_TRACE_BUFFER    (64 * 1024)
+
+/* Each thread records into its own ring buffer. Only the thread moves
+   head and only SDL_FlushProfile() moves tail, so neither side locks.
+   Each side fences before publishing its index and after reading the
+   other side's, so the events themselves are seen in order. */
+typedef struct SDL_ProfileBuffer
+{
+    SDL_ProfileEvent events[SDL_PROFILE_BUFFER_EVENTS];
+    SDL_threadID thread;
+    SDL_atomic_t head;
+    SDL_atomic_t tail;
+    SDL_atomic_t dropped;
+    SDL_atomic_t finished;
+    struct SDL_ProfileBuffer *next;
+} SDL_ProfileBuffer;
+
+SDL_atomic_t SDL_profile_recording;
+
+/* Threads inside SDL_ProfileRecord(), which SDL_ProfileQuit() waits out
+   before it frees their buffers */
+static SDL_atomic_t SDL_profile_writers;
+
+/* Protects the setup and the list of buffers */
+static SDL_SpinLock SDL_profile_lock;
+static SDL_TLSID SDL_profile_tls;
+static SDL_ProfileBuffer *SDL_profile_buffers;
+
+/* Everything below is protected by the flush lock */
+static SDL_mutex *SDL_profile_flush_lock;
+static SDL_ProfileCallback SDL_profile_callback;
+static void *SDL_profile_userdata;
+static int SDL_profile_dropped;
+
+static SDL_RWops *SDL_profile_trace;
+static Uint64 SDL_profile_trace_start;
+static double SDL_profile_trace_scale;
+static SDL_bool SDL_profile_trace_first;
+static char *SDL_profile_trace_text;
+static size_t SDL_profile_trace_length;
+
+static int
+SDL_ProfileStart(void)
+{
+    int retval = 0;
+
+    SDL_AtomicLock(&SDL_profile_lock);
+    if (!SDL_profile_tls) {
+        SDL_profile_tls = SDL_TLSCreate();
+        if (!SDL_profile_tls) {
+            retval = -1;
+        }
+    }
+    if (retval == 0 && !SDL_profile_flush_lock) {
+        SDL_profile_flush_lock = SDL_CreateMutex();
+        if (!SDL_profile_flush_lock) {
+            retval = -1;
+        }
+    }
+    SDL_AtomicUnlock(&SDL_profile_lock);
+    return retval;
+}
+
+static void SDLCALL
+SDL_FinishProfileBuffer(void *data)
+{
+    SDL_ProfileBuffer *buffer;
+
+    /* SDL_ProfileQuit() may have freed it already, so only mark it if it's
+       still listed. Another buffer at the same address for this thread is
+       finished too, since the thread is exiting. */
+    SDL_AtomicLock(&SDL_profile_lock);
+    for (buffer = SDL_profile_buffers; buffer; buffer = buffer->next) {
+        if (buffer == data && buffer->thread == SDL_ThreadID()) {
+            /* The next flush drains and frees it */
+            SDL_AtomicSet(&buffer->finished, 1);
+        }
+    }
+    SDL_AtomicUnlock(&SDL_profile_lock);
+}
+
+static SDL_ProfileBuffer *
+SDL_GetProfileBuffer(void)
+{
+    SDL_ProfileBuffer *buffer = (SDL_ProfileBuffer *) SDL_TLSGet(SDL_profile_tls);
+
+    if (!buffer) {
+        buffer = (SDL_ProfileBuffer *) SDL_calloc(1, sizeof(*buffer));
+        if (!buffer) {
+            return NULL;
+        }
+        buffer->thread = SDL_ThreadID();
+        if (SDL_TLSSet(SDL_profile_tls, buffer, SDL_FinishProfileBuffer) < 0) {
+            SDL_free(buffer);
+            return NULL;
+        }
+
+        SDL_AtomicLock(&SDL_profile_lock);
+        buffer->next = SDL_profile_buffers;
+        SDL_profile_buffers = buffer;
+        SDL_AtomicUnlock(&SDL_profile_lock);
+    }
+    return buffer;
+}
+
+static void
+SDL_ProfileRecord(SDL_ProfileEventType type, const char *name, Sint64 value)
+{
+    SDL_ProfileBuffer *buffer;
+    SDL_ProfileEvent *event;
+    Uint32 head, tail;
+
+    if (!SDL_AtomicGet(&SDL_profile_recording)) {
+        return;
+    }
+
+    /* Check again once SDL_ProfileQuit() can see this thread, so either it
+       waits for this event or this thread sees that recording stopped */
+    SDL_AtomicIncRef(&SDL_profile_writers);
+    if (!SDL_AtomicGet(&SDL_profile_recording)) {
+        (void)SDL_AtomicDecRef(&SDL_profile_writers);
+        return;
+    }
+    buffer = SDL_GetProfileBuffer();
+    if (!buffer) {
+        (void)SDL_AtomicDecRef(&SDL_profile_writers);
+        return;
+    }
+
+    head = (Uint32) SDL_AtomicGet(&buffer->head);
+    tail = (Uint32) SDL_AtomicGet(&buffer->tail);
+    SDL_MemoryBarrierAcquire();
+    if ((head - tail) >= SDL_PROFILE_BUFFER_EVENTS) {
+        /* Full until the next flush */
+        SDL_AtomicIncRef(&buffer->dropped);
+        (void)SDL_AtomicDecRef(&SDL_profile_writers);
+        return;
+    }
+
+    event = &buffer->events[head & (SDL_PROFILE_BUFFER_EVENTS - 1)];
+    event->type = type;
+    event->name = name;
+    event->thread = buffer->thread;
+    event->timestamp = SDL_GetPerformanceCounter();
+    event->value = value;
+
+    /* Publish the event to the flush */
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&buffer->head, (int) (head + 1));
+    (void)SDL_AtomicDecRef(&SDL_profile_writers);
+}
+
+static void
+SDL_WriteTraceText(void)
+{
+    if (SDL_profile_trace_length > 0) {
+        SDL_RWwrite(SDL_profile_trace, SDL_profile_trace_text, SDL_profile_trace_length, 1);
+        SDL_profile_trace_length = 0;
+    }
+}
+
+static void
+SDL_WriteTraceEvents(const SDL_ProfileEvent *events, int numevents)
+{
+    char name[128];
+    int i;
+
+    for (i = 0; i < numevents; ++i) {
+        const SDL_ProfileEvent *event = &events[i];
+        const double ts = (double) (Sint64) (event->timestamp - SDL_profile_trace_start) * SDL_profile_trace_scale;
+        char *text;
+        size_t room;
+        int length;
+
+        /* Leave room for the longest event */
+        if (SDL_profile_trace_length + 512 > SDL_PROFILE_TRACE_BUFFER) {
+            SDL_WriteTraceText();
+        }
+        text = SDL_profile_trace_text + SDL_profile_trace_length;
+        room = SDL_PROFILE_TRACE_BUFFER - SDL_profile_trace_length;
+
+        if (event->name) {
+            size_t j;
+            SDL_strlcpy(name, event->name, sizeof(name));
+            for (j = 0; name[j]; ++j) {
+                if (name[j] == '"' || name[j] == '\\' || (unsigned char) name[j] < ' ') {
+                    name[j] = '_';
+                }
+            }
+        } else {
+            SDL_strlcpy(name, "Frame", sizeof(name));
+        }
+
+        switch (event->type) {
+        case SDL_PROFILE_ZONE_BEGIN:
+        case SDL_PROFILE_ZONE_END:
+            length = SDL_snprintf(text, room, "%s\n{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":1,\"tid\":%lu}",
+                                  SDL_profile_trace_first ? "" : ",", name,
+                                  (event->type == SDL_PROFILE_ZONE_BEGIN) ? "B" : "E",
+                                  ts, (unsigned long) event->thread);
+            break;
+        case SDL_PROFILE_COUNTER:
+            length = SDL_snprintf(text, room, "%s\n{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%lu,\"args\":{\"value\":%" SDL_PRIs64 "}}",
+                                  SDL_profile_trace_first ? "" : ",", name,
+                                  ts, (unsigned long) event->thread, event->value);
+            break;
+        case SDL_PROFILE_FRAME:
+            length = SDL_snprintf(text, room, "%s\n{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":%lu}",
+                                  SDL_profile_trace_first ? "" : ",", name,
+                                  ts, (unsigned long) event->thread);
+            break;
+        default:
+            length = 0;
+            break;
+        }
+
+        if (length > 0) {
+            SDL_profile_trace_length += SDL_min((size_t) length, room - 1);
+            SDL_profile_trace_first = SDL_FALSE;
+        }
+    }
+}
+
+static void
+SDL_DeliverProfileEvents(const SDL_ProfileEvent *events, int numevents)
+{
+    if (SDL_profile_callback) {
+        SDL_profile_callback(SDL_profile_userdata, events, numevents);
+    }
+    if (SDL_profile_trace) {
+        SDL_WriteTraceEvents(events, numevents);
+    }
+}
+
+static int
+SDL_DrainProfileBuffer(SDL_ProfileBuffer *buffer)
+{
+    const Uint32 tail = (Uint32) SDL_AtomicGet(&buffer->tail);
+    const Uint32 head = (Uint32) SDL_AtomicGet(&buffer->head);
+    const Uint32 count = head - tail;
+    const Uint32 start = tail & (SDL_PROFILE_BUFFER_EVENTS - 1);
+    const Uint32 first = SDL_min(count, SDL_PROFILE_BUFFER_EVENTS - start);
+
+    if (count == 0) {
+        return 0;
+    }
+    SDL_MemoryBarrierAcquire();
+
+    /* The ring may wrap, in which case it's delivered in two pieces */
+    SDL_DeliverProfileEvents(&buffer->events[start], (int) first);
+    if (count > first) {
+        SDL_DeliverProfileEvents(buffer->events, (int) (count - first));
+    }
+
+    /* Hand the space back to the thread */
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&buffer->tail, (int) head);
+    return (int) count;
+}
+
+void
+SDL_ProfileBeginZone(const char *name)
+{
+    SDL_ProfileRecord(SDL_PROFILE_ZONE_BEGIN, name, 0);
+}
+
+void
+SDL_ProfileEndZone(const char *name)
+{
+    SDL_ProfileRecord(SDL_PROFILE_ZONE_END, name, 0);
+}
+
+void
+SDL_ProfileCounter(const char *name, Sint64 value)
+{
+    SDL_ProfileRecord(SDL_PROFILE_COUNTER, name, value);
+}
+
+void
+SDL_ProfileFrame(void)
+{
+    if (SDL_AtomicGet(&SDL_profile_recording)) {
+        SDL_ProfileRecord(SDL_PROFILE_FRAME, NULL, 0);
+        SDL_FlushProfile();
+    }
+}
+
+int
+SDL_SetProfileCallback(SDL_ProfileCallback callback, void *userdata)
+{
+    if (SDL_ProfileStart() < 0) {
+        return -1;
+    }
+
+    SDL_LockMutex(SDL_profile_flush_lock);
+    SDL_profile_callback = callback;
+    SDL_profile_userdata = userdata;
+    SDL_AtomicSet(&SDL_profile_recording, (SDL_profile_callback || SDL_profile_trace) ? 1 : 0);
+    SDL_UnlockMutex(SDL_profile_flush_lock);
+    return 0;
+}
+
+int
+SDL_FlushProfile(void)
+{
+    SDL_ProfileBuffer *buffer, *next, **prev;
+    int count = 0;
+
+    if (!SDL_profile_flush_lock) {
+        return 0;
+    }
+
+    SDL_LockMutex(SDL_profile_flush_lock);
+
+    /* New buffers are only added at the front, so the rest of the list
+       can be walked without the lock */
+    SDL_AtomicLock(&SDL_profile_lock);
+    buffer = SDL_profile_buffers;
+    SDL_AtomicUnlock(&SDL_profile_lock);
+
+    while (buffer) {
+        /* Check this first, so no events are missed if it finishes now */
+        const SDL_bool finished = SDL_AtomicGet(&buffer->finished) ? SDL_TRUE : SDL_FALSE;
+
+        next = buffer->next;
+        count += SDL_DrainProfileBuffer(buffer);
+        SDL_profile_dropped += SDL_AtomicSet(&buffer->dropped, 0);
+
+        if (finished) {
+            SDL_AtomicLock(&SDL_profile_lock);
+            for (prev = &SDL_profile_buffers; *prev != buffer; prev = &(*prev)->next) {
+                continue;
+            }
+            *prev = next;
+            SDL_AtomicUnlock(&SDL_profile_lock);
+            SDL_free(buffer);
+        }
+        buffer = next;
+    }
+
+    if (SDL_profile_trace) {
+        SDL_WriteTraceText();
+    }
+
+    SDL_UnlockMutex(SDL_profile_flush_lock);
+
+    return count;
+}
+
+void
+SDL_ProfileInit(void)
+{
+    const char *file = SDL_GetHint(SDL_HINT_PROFILE_TRACE);
+    SDL_RWops *trace;
+
+    if (!file || !*file || SDL_profile_trace || SDL_ProfileStart() < 0) {
+        return;
+    }
+
+    trace = SDL_RWFromFile(file, "wb");
+    if (!trace) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_SYSTEM, "Couldn't open profile trace %s: %s", file, SDL_GetError());
+        return;
+    }
+
+    SDL_LockMutex(SDL_profile_flush_lock);
+    SDL_profile_trace_text = (char *) SDL_malloc(SDL_PROFILE_TRACE_BUFFER);
+    if (!SDL_profile_trace_text) {
+        SDL_UnlockMutex(SDL_profile_flush_lock);
+        SDL_RWclose(trace);
+        return;
+    }
+    SDL_profile_trace = trace;
+    SDL_profile_trace_start = SDL_GetPerformanceCounter();
+    SDL_profile_trace_scale = 1000000.0 / (double) SDL_GetPerformanceFrequency();
+    SDL_profile_trace_first = SDL_TRUE;
+    SDL_profile_trace_length = 0;
+    SDL_RWwrite(SDL_profile_trace, "{\"traceEvents\":[", 16, 1);
+    SDL_AtomicSet(&SDL_profile_recording, 1);
+    SDL_UnlockMutex(SDL_profile_flush_lock);
+}
+
+void
+SDL_ProfileQuit(void)
+{
+    SDL_ProfileBuffer *buffer, *next;
+
+    if (!SDL_profile_flush_lock) {
+        return;
+    }
+
+    /* Nothing records once the threads already recording are done */
+    SDL_AtomicSet(&SDL_profile_recording, 0);
+    while (SDL_AtomicGet(&SDL_profile_writers) > 0) {
+        SDL_Delay(0);
+    }
+    SDL_FlushProfile();
+
+    SDL_LockMutex(SDL_profile_flush_lock);
+
+    /* Free the buffers of threads that are still running too, including
+       this one. Their TLS still points at them, so the next start uses a
+       new TLS slot, and they never record into these again. */
+    SDL_AtomicLock(&SDL_profile_lock);
+    buffer = SDL_profile_buffers;
+    SDL_profile_buffers = NULL;
+    SDL_profile_tls = 0;
+    SDL_AtomicUnlock(&SDL_profile_lock);
+    while (buffer) {
+        next = buffer->next;
+        SDL_free(buffer);
+        buffer = next;
+    }
+
+    if (SDL_profile_trace) {
+        SDL_RWwrite(SDL_profile_trace, "\n],\"displayTimeUnit\":\"ms\"}\n", 27, 1);
+        SDL_RWclose(SDL_profile_trace);
+        SDL_profile_trace = NULL;
+        SDL_free(SDL_profile_trace_text);
+        SDL_profile_trace_text = NULL;
+    }
+    SDL_profile_callback = NULL;
+    SDL_profile_userdata = NULL;
+    if (SDL_profile_dropped > 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_SYSTEM, "The profiler dropped %d events, call SDL_ProfileFrame() or SDL_FlushProfile() more often", SDL_profile_dropped);
+        SDL_profile_dropped = 0;
+    }
+    SDL_UnlockMutex(SDL_profile_flush_lock);
+}
+
+#else /* !SDL_PROFILER */
+
+void
+SDL_ProfileBeginZone(const char *name)
+{
+}
+
+void
+SDL_ProfileEndZone(const char *name)
+{
+}
+
+void
+SDL_ProfileCounter(const char *name, Sint64 value)
+{
+}
+
+void
+SDL_ProfileFrame(void)
+{
+}
+
+int
+SDL_SetProfileCallback(SDL_ProfileCallback callback, void *userdata)
+{
+    return SDL_Unsupported();
+}
+
+int
+SDL_FlushProfile(void)
+{
+    return SDL_Unsupported();
+}
+
+void
+SDL_ProfileInit(void)
+{
+}
+
+void
+SDL_ProfileQuit(void)
+{
+}
+
+#endif /* SDL_PROFILER */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,57 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_profile_c_h_
+#define SDL_profile_c_h_
+
+#include "./SDL_internal.h"
+
+#include "SDL_atomic.h"
+#include "SDL_profile.h"
+
+extern void SDL_ProfileInit(void);
+extern void SDL_ProfileQuit(void);
+
+/* SDL's own zones and counters. These test a flag before calling out, so
+   they cost an atomic read and a branch when nothing is recording, and
+   nothing at all when SDL is built without the profiler. Names must be
+   literals. */
+#if SDL_PROFILER
+extern SDL_atomic_t SDL_profile_recording;
+
+#define SDL_PROFILE_ZONE_BEGIN(name) \
+    do { if (SDL_AtomicGet(&SDL_profile_recording)) { SDL_ProfileBeginZone(name); } } while (0)
+#define SDL_PROFILE_ZONE_END(name) \
+    do { if (SDL_AtomicGet(&SDL_profile_recording)) { SDL_ProfileEndZone(name); } } while (0)
+#define SDL_PROFILE_COUNTER(name, value) \
+    do { if (SDL_AtomicGet(&SDL_profile_recording)) { SDL_ProfileCounter(name, value); } } while (0)
+#define SDL_PROFILE_FLUSH() \
+    do { if (SDL_AtomicGet(&SDL_profile_recording)) { SDL_FlushProfile(); } } while (0)
+#else
+#define SDL_PROFILE_ZONE_BEGIN(name)
+#define SDL_PROFILE_ZONE_END(name)
+#define SDL_PROFILE_COUNTER(name, value)
+#define SDL_PROFILE_FLUSH()
+#endif
+
+#endif /* SDL_profile_c_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,171 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* Bounded multi-producer multi-consumer queue, after Dmitry Vyukov's design.
+
+   Each cell has a sequence number that says whose turn it is: when it
+   equals a producer's position the cell is free for that producer, and
+   when it is one past a consumer's position it holds that consumer's item.
+   Threads claim a position with a single CAS and then only touch their own
+   cell, so producers and consumers don't contend with each other.
+
+   Positions are kept as unsigned and wrap around; the capacity is a power
+   of two, so the cell index stays correct across the wrap.
+ */
+
+#include "SDL_atomic.h"
+#include "SDL_error.h"
+
+/* Keep the positions on their own cache lines */
+#define SDL_QUEUE_CACHELINE 64
+
+typedef struct
+{
+    SDL_atomic_t sequence;
+    void *data;
+} SDL_AtomicQueueCell;
+
+struct SDL_AtomicQueue
+{
+    SDL_AtomicQueueCell *cells;
+    unsigned int mask;
+    char pad0[SDL_QUEUE_CACHELINE];
+    SDL_atomic_t enqueue_pos;
+    char pad1[SDL_QUEUE_CACHELINE - sizeof(SDL_atomic_t)];
+    SDL_atomic_t dequeue_pos;
+    char pad2[SDL_QUEUE_CACHELINE - sizeof(SDL_atomic_t)];
+};
+
+SDL_AtomicQueue *
+SDL_CreateAtomicQueue(int capacity)
+{
+    SDL_AtomicQueue *queue;
+    unsigned int size = 2;
+    unsigned int i;
+
+    if (capacity <= 0 || capacity > (1 << 30)) {
+        SDL_InvalidParamError("capacity");
+        return NULL;
+    }
+    while (size < (unsigned int) capacity) {
+        size *= 2;
+    }
+
+    queue = (SDL_AtomicQueue *) SDL_calloc(1, sizeof(*queue));
+    if (!queue) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    queue->cells = (SDL_AtomicQueueCell *) SDL_calloc(size, sizeof(*queue->cells));
+    if (!queue->cells) {
+        SDL_free(queue);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    queue->mask = size - 1;
+    for (i = 0; i < size; ++i) {
+        SDL_AtomicSet(&queue->cells[i].sequence, (int) i);
+    }
+    return queue;
+}
+
+/* The sequence updates use SDL_AtomicAdd() because it is a full barrier:
+   the item is written before the cell is handed to a consumer, and read
+   before the cell is handed back to a producer.
+ */
+SDL_bool
+SDL_AtomicQueuePush(SDL_AtomicQueue *queue, void *item)
+{
+    SDL_AtomicQueueCell *cell;
+    unsigned int pos;
+
+    if (!queue) {
+        SDL_InvalidParamError("queue");
+        return SDL_FALSE;
+    }
+
+    pos = (unsigned int) SDL_AtomicGet(&queue->enqueue_pos);
+    for ( ; ; ) {
+        int diff;
+
+        cell = &queue->cells[pos & queue->mask];
+        diff = (int) ((unsigned int) SDL_AtomicGet(&cell->sequence) - pos);
+        if (diff == 0) {
+            if (SDL_AtomicCAS(&queue->enqueue_pos, (int) pos, (int) (pos + 1))) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* The consumer for this cell hasn't been by yet, so it's full */
+            return SDL_FALSE;
+        }
+        pos = (unsigned int) SDL_AtomicGet(&queue->enqueue_pos);
+    }
+
+    cell->data = item;
+    SDL_AtomicAdd(&cell->sequence, 1);
+    return SDL_TRUE;
+}
+
+SDL_bool
+SDL_AtomicQueuePop(SDL_AtomicQueue *queue, void **item)
+{
+    SDL_AtomicQueueCell *cell;
+    unsigned int pos;
+
+    if (!queue || !item) {
+        SDL_InvalidParamError(queue ? "item" : "queue");
+        return SDL_FALSE;
+    }
+
+    pos = (unsigned int) SDL_AtomicGet(&queue->dequeue_pos);
+    for ( ; ; ) {
+        int diff;
+
+        cell = &queue->cells[pos & queue->mask];
+        diff = (int) ((unsigned int) SDL_AtomicGet(&cell->sequence) - (pos + 1));
+        if (diff == 0) {
+            if (SDL_AtomicCAS(&queue->dequeue_pos, (int) pos, (int) (pos + 1))) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* The producer for this cell hasn't been by yet, so it's empty */
+            return SDL_FALSE;
+        }
+        pos = (unsigned int) SDL_AtomicGet(&queue->dequeue_pos);
+    }
+
+    *item = cell->data;
+    /* Hand the cell to the producer one lap ahead: pos + capacity */
+    SDL_AtomicAdd(&cell->sequence, (int) queue->mask);
+    return SDL_TRUE;
+}
+
+void
+SDL_DestroyAtomicQueue(SDL_AtomicQueue *queue)
+{
+    if (queue) {
+        SDL_free(queue->cells);
+        SDL_free(queue);
+    }
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
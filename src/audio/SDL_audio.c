@@ -27,6 +27,8 @@
 #include "SDL_audio_c.h"
 #include "SDL_sysaudio.h"
 #include "../thread/SDL_systhread.h"
+#include "../cpuinfo/SDL_simd.h"
+#include "../SDL_profile_c.h"
 
 #define _THIS SDL_AudioDevice *_this
 
@@ -254,6 +256,23 @@ SDL_AudioGetPendingBytes_Default(_THIS)
     return 0;
 }
 
+static int
+SDL_AudioGetLatencyBytes_Default(_THIS)
+{
+    return 0;
+}
+
+static int
+SDL_AudioGetMinimumSamples_Default(int freq)
+{
+    /* Without anything better to go on, about 10 milliseconds. */
+    int samples = 1;
+    while (samples < (freq / 100)) {
+        samples *= 2;
+    }
+    return samples;
+}
+
 static Uint8 *
 SDL_AudioGetDeviceBuf_Default(_THIS)
 {
@@ -362,6 +381,8 @@ finish_audio_entry_points_init(void)
     FILL_STUB(WaitDevice);
     FILL_STUB(PlayDevice);
     FILL_STUB(GetPendingBytes);
+    FILL_STUB(GetLatencyBytes);
+    FILL_STUB(GetMinimumSamples);
     FILL_STUB(GetDeviceBuf);
     FILL_STUB(CaptureFromDevice);
     FILL_STUB(FlushCapture);
@@ -667,6 +688,104 @@ SDL_GetQueuedAudioSize(SDL_AudioDeviceID devid)
     return retval;
 }
 
+/* Sample frames the device itself has buffered. This is kept apart from
+   GetPendingBytes, which SDL_GetQueuedAudioSize() reports to the app.
+   Drivers that can't tell us are assumed to be playing the last buffer
+   they were given. */
+static int
+GetDeviceBufferedFrames(SDL_AudioDevice *device)
+{
+    const int framesize = (SDL_AUDIO_BITSIZE(device->spec.format) / 8) * device->spec.channels;
+
+    if (current_audio.impl.GetLatencyBytes != SDL_AudioGetLatencyBytes_Default) {
+        return current_audio.impl.GetLatencyBytes(device) / framesize;
+    }
+    if (current_audio.impl.GetPendingBytes != SDL_AudioGetPendingBytes_Default) {
+        return current_audio.impl.GetPendingBytes(device) / framesize;
+    }
+    return device->iscapture ? 0 : device->spec.samples;
+}
+
+/* Sample frames between the callback and the device, at the callback's rate. */
+static int
+GetDeviceLatencyFrames(SDL_AudioDevice *device)
+{
+    int devframes = GetDeviceBufferedFrames(device);
+    int frames = 0;
+
+    if (device->stream) {
+        /* the stream holds data in the format it converts to. */
+        const int queued = SDL_AtomicGet(&device->stream_queued);
+        if (device->iscapture) {
+            frames += queued / ((SDL_AUDIO_BITSIZE(device->callbackspec.format) / 8) * device->callbackspec.channels);
+        } else {
+            devframes += queued / ((SDL_AUDIO_BITSIZE(device->spec.format) / 8) * device->spec.channels);
+        }
+    }
+
+    return frames + (int) ((((Sint64) devframes) * device->callbackspec.freq) / device->spec.freq);
+}
+
+/* Call with the mixer lock held, right before the app's callback. */
+static void
+UpdateCallbackTimestamp(SDL_AudioDevice *device)
+{
+    const Uint64 now = SDL_GetPerformanceCounter();
+    Uint64 frames = (Uint64) GetDeviceLatencyFrames(device);
+    Uint64 offset;
+
+    /* a capture buffer's first sample is a whole buffer older than its last. */
+    if (device->iscapture) {
+        frames += device->callbackspec.samples;
+    }
+    offset = (frames * SDL_GetPerformanceFrequency()) / device->callbackspec.freq;
+
+    device->callback_time = now;
+    device->sample_time = device->iscapture ? (now - offset) : (now + offset);
+}
+
+int
+SDL_GetAudioDeviceLatency(SDL_AudioDeviceID devid)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+    int retval;
+
+    if (!device) {
+        return -1;
+    }
+
+    current_audio.impl.LockDevice(device);
+    retval = GetDeviceLatencyFrames(device);
+    if (device->buffer_queue) {
+        const int framesize = (SDL_AUDIO_BITSIZE(device->callbackspec.format) / 8) * device->callbackspec.channels;
+        retval += (int) (SDL_CountDataQueue(device->buffer_queue) / framesize);
+    }
+    current_audio.impl.UnlockDevice(device);
+
+    return retval;
+}
+
+int
+SDL_GetAudioDeviceTimestamp(SDL_AudioDeviceID devid, Uint64 *callback_time, Uint64 *sample_time)
+{
+    SDL_AudioDevice *device = get_audio_device(devid);
+
+    if (!device) {
+        return -1;
+    }
+
+    current_audio.impl.LockDevice(device);
+    if (callback_time) {
+        *callback_time = device->callback_time;
+    }
+    if (sample_time) {
+        *sample_time = device->sample_time;
+    }
+    current_audio.impl.UnlockDevice(device);
+
+    return 0;
+}
+
 void
 SDL_ClearQueuedAudio(SDL_AudioDeviceID devid)
 {
@@ -686,6 +805,10 @@ SDL_ClearQueuedAudio(SDL_AudioDeviceID devid)
 }
 
 
+/* The device streams are preallocated when they're opened, so after this
+   many buffers the audio thread should never allocate again. */
+#define SDL_AUDIO_WARMUP_BUFFERS 4
+
 /* The general mixing thread function */
 static int SDLCALL
 SDL_RunAudio(void *devicep)
@@ -693,6 +816,8 @@ SDL_RunAudio(void *devicep)
     SDL_AudioDevice *device = (SDL_AudioDevice *) devicep;
     void *udata = device->callbackspec.userdata;
     SDL_AudioCallback callback = device->callbackspec.callback;
+    int warmup = SDL_AUDIO_WARMUP_BUFFERS;
+    const int direct_len = SDL_AudioStreamDirectBufferSize(device->stream, device->callbackspec.size);
     int data_len = 0;
     Uint8 *data;
 
@@ -710,6 +835,56 @@ SDL_RunAudio(void *devicep)
         current_audio.impl.BeginLoopIteration(device);
         data_len = device->callbackspec.size;
 
+        if (device->stream_direct) {
+            /* The callback writes into the device buffer if the converted
+               data fits there, and we convert it in place. Otherwise convert
+               in the work_buffer and make one copy to the device. */
+            Uint8 *devbuf = SDL_AtomicGet(&device->enabled) ? current_audio.impl.GetDeviceBuf(device) : NULL;
+            int got;
+
+            if (!device->stream_direct) {
+                /* the device changed format (WASAPI can do this); play
+                   silence this time and use the stream from now on. */
+                if (devbuf) {
+                    SDL_memset(devbuf, device->spec.silence, device->spec.size);
+                    current_audio.impl.PlayDevice(device);
+                    current_audio.impl.WaitDevice(device);
+                }
+                continue;
+            }
+
+            data = (devbuf && (direct_len <= (int) device->spec.size)) ? devbuf : device->work_buffer;
+
+            /* !!! FIXME: this should be LockDevice. */
+            SDL_LockMutex(device->mixer_lock);
+            if (SDL_AtomicGet(&device->paused)) {
+                SDL_memset(data, device->callbackspec.silence, data_len);
+            } else {
+                UpdateCallbackTimestamp(device);
+                SDL_PROFILE_ZONE_BEGIN("SDL_AudioCallback");
+                callback(udata, data, data_len);
+                SDL_PROFILE_ZONE_END("SDL_AudioCallback");
+            }
+            SDL_UnlockMutex(device->mixer_lock);
+
+            got = SDL_AudioStreamConvertDirect(device->stream, data, data_len);
+            SDL_assert((got < 0) || (got == device->spec.size));
+
+            if (devbuf == NULL) {
+                const Uint32 delay = ((device->spec.samples * 1000) / device->spec.freq);
+                SDL_Delay(delay);
+            } else {
+                if (got != device->spec.size) {
+                    SDL_memset(devbuf, device->spec.silence, device->spec.size);
+                } else if (data != devbuf) {
+                    SDL_memcpy(devbuf, data, device->spec.size);
+                }
+                current_audio.impl.PlayDevice(device);
+                current_audio.impl.WaitDevice(device);
+            }
+            continue;
+        }
+
         /* Fill the current buffer with sound */
         if (!device->stream && SDL_AtomicGet(&device->enabled)) {
             SDL_assert(data_len == device->spec.size);
@@ -733,7 +908,10 @@ SDL_RunAudio(void *devicep)
         if (SDL_AtomicGet(&device->paused)) {
             SDL_memset(data, device->spec.silence, data_len);
         } else {
+            UpdateCallbackTimestamp(device);
+            SDL_PROFILE_ZONE_BEGIN("SDL_AudioCallback");
             callback(udata, data, data_len);
+            SDL_PROFILE_ZONE_END("SDL_AudioCallback");
         }
         SDL_UnlockMutex(device->mixer_lock);
 
@@ -742,6 +920,10 @@ SDL_RunAudio(void *devicep)
             /* if this fails...oh well. We'll play silence here. */
             SDL_AudioStreamPut(device->stream, data, data_len);
 
+            if (warmup && (--warmup == 0)) {
+                SDL_AudioStreamForbidAllocations(device->stream, SDL_TRUE);
+            }
+
             while (SDL_AudioStreamAvailable(device->stream) >= ((int) device->spec.size)) {
                 int got;
                 data = SDL_AtomicGet(&device->enabled) ? current_audio.impl.GetDeviceBuf(device) : NULL;
@@ -759,6 +941,7 @@ SDL_RunAudio(void *devicep)
                     current_audio.impl.WaitDevice(device);
                 }
             }
+            SDL_AtomicSet(&device->stream_queued, SDL_AudioStreamAvailable(device->stream));
         } else if (data == device->work_buffer) {
             /* nothing to do; pause like we queued a buffer to play. */
             const Uint32 delay = ((device->spec.samples * 1000) / device->spec.freq);
@@ -792,6 +975,7 @@ SDL_CaptureAudio(void *devicep)
     Uint8 *data;
     void *udata = device->callbackspec.userdata;
     SDL_AudioCallback callback = device->callbackspec.callback;
+    int warmup = SDL_AUDIO_WARMUP_BUFFERS;
 
     SDL_assert(device->iscapture);
 
@@ -852,13 +1036,33 @@ SDL_CaptureAudio(void *devicep)
             SDL_memset(ptr, silence, still_need);
         }
 
-        if (device->stream) {
+        if (device->stream_direct) {
+            /* work_buffer has room to convert in place. */
+            const int got = SDL_AudioStreamConvertDirect(device->stream, data, data_len);
+            SDL_assert((got < 0) || (got == device->callbackspec.size));
+            if (got != device->callbackspec.size) {
+                SDL_memset(data, device->callbackspec.silence, device->callbackspec.size);
+            }
+
+            /* !!! FIXME: this should be LockDevice. */
+            SDL_LockMutex(device->mixer_lock);
+            if (!SDL_AtomicGet(&device->paused)) {
+                UpdateCallbackTimestamp(device);
+                callback(udata, data, device->callbackspec.size);
+            }
+            SDL_UnlockMutex(device->mixer_lock);
+        } else if (device->stream) {
             /* if this fails...oh well. */
             SDL_AudioStreamPut(device->stream, data, data_len);
 
+            if (warmup && (--warmup == 0)) {
+                SDL_AudioStreamForbidAllocations(device->stream, SDL_TRUE);
+            }
+
             while (SDL_AudioStreamAvailable(device->stream) >= ((int) device->callbackspec.size)) {
                 const int got = SDL_AudioStreamGet(device->stream, device->work_buffer, device->callbackspec.size);
                 SDL_assert((got < 0) || (got == device->callbackspec.size));
+                SDL_AtomicSet(&device->stream_queued, SDL_AudioStreamAvailable(device->stream));
                 if (got != device->callbackspec.size) {
                     SDL_memset(device->work_buffer, device->spec.silence, device->callbackspec.size);
                 }
@@ -866,6 +1070,7 @@ SDL_CaptureAudio(void *devicep)
                 /* !!! FIXME: this should be LockDevice. */
                 SDL_LockMutex(device->mixer_lock);
                 if (!SDL_AtomicGet(&device->paused)) {
+                    UpdateCallbackTimestamp(device);
                     callback(udata, device->work_buffer, device->callbackspec.size);
                 }
                 SDL_UnlockMutex(device->mixer_lock);
@@ -874,6 +1079,7 @@ SDL_CaptureAudio(void *devicep)
             /* !!! FIXME: this should be LockDevice. */
             SDL_LockMutex(device->mixer_lock);
             if (!SDL_AtomicGet(&device->paused)) {
+                UpdateCallbackTimestamp(device);
                 callback(udata, data, device->callbackspec.size);
             }
             SDL_UnlockMutex(device->mixer_lock);
@@ -1123,7 +1329,7 @@ close_audio_device(SDL_AudioDevice * device)
         SDL_DestroyMutex(device->mixer_lock);
     }
 
-    SDL_free(device->work_buffer);
+    SDL_SIMDFree(device->work_buffer);
     SDL_FreeAudioStream(device->stream);
 
     if (device->id > 0) {
@@ -1217,6 +1423,7 @@ open_audio_device(const char *devname, int iscapture,
     SDL_AudioSpec _obtained;
     SDL_AudioDevice *device;
     SDL_bool build_stream;
+    const SDL_bool low_latency = SDL_GetHintBoolean(SDL_HINT_AUDIO_LOW_LATENCY, SDL_FALSE);
     void *handle = NULL;
     int i = 0;
 
@@ -1250,6 +1457,17 @@ open_audio_device(const char *devname, int iscapture,
         return 0;
     }
 
+    /* In low latency mode, ask for no more than the shortest buffer the
+       driver can play safely. The driver may round it up when it opens the
+       device. A smaller request from the app is left alone. */
+    if (low_latency) {
+        const int samples = current_audio.impl.GetMinimumSamples(obtained->freq);
+        if ((samples > 0) && (samples < obtained->samples)) {
+            obtained->samples = (Uint16) samples;
+            SDL_CalculateAudioSpec(obtained);
+        }
+    }
+
     /* If app doesn't care about a specific device, let the user override. */
     if (devname == NULL) {
         devname = SDL_getenv("SDL_AUDIO_DEVICE_NAME");
@@ -1400,6 +1618,26 @@ open_audio_device(const char *devname, int iscapture,
             close_audio_device(device);
             return 0;
         }
+
+        /* Same rate and buffer size? Then our audio thread can convert each
+           buffer in place, and the stream's queue is never used. */
+        if (!current_audio.impl.ProvidesOwnCallbackThread &&
+            (obtained->samples == device->spec.samples) &&
+            (SDL_AudioStreamDirectBufferSize(device->stream, 1) > 0) &&
+            SDL_GetHintBoolean(SDL_HINT_AUDIO_DIRECT_CONVERSION, SDL_TRUE)) {
+            device->stream_direct = SDL_TRUE;
+        } else {
+            /* The device thread puts one buffer at a time and takes out whole
+               device buffers, so make sure a put can cover one of those. */
+            const SDL_AudioSpec *src = iscapture ? &device->spec : obtained;
+            const SDL_AudioSpec *dst = iscapture ? obtained : &device->spec;
+            const int srcframesize = (SDL_AUDIO_BITSIZE(src->format) / 8) * src->channels;
+            const int getframes = (int) ((((Sint64) dst->samples) * src->freq + (dst->freq - 1)) / dst->freq);
+            if (SDL_AudioStreamPreallocate(device->stream, SDL_max((int) src->size, getframes * srcframesize)) < 0) {
+                close_audio_device(device);
+                return 0;
+            }
+        }
     }
 
     if (device->spec.callback == NULL) {  /* use buffer queueing? */
@@ -1419,9 +1657,16 @@ open_audio_device(const char *devname, int iscapture,
     if (device->spec.size > device->work_buffer_len) {
         device->work_buffer_len = device->spec.size;
     }
+    if (device->stream_direct) {
+        const int direct_len = SDL_AudioStreamDirectBufferSize(device->stream,
+                                    iscapture ? device->spec.size : device->callbackspec.size);
+        if (direct_len > (int) device->work_buffer_len) {
+            device->work_buffer_len = direct_len;
+        }
+    }
     SDL_assert(device->work_buffer_len > 0);
 
-    device->work_buffer = (Uint8 *) SDL_malloc(device->work_buffer_len);
+    device->work_buffer = (Uint8 *) SDL_SIMDAlloc(device->work_buffer_len);
     if (device->work_buffer == NULL) {
         close_audio_device(device);
         SDL_OutOfMemory();
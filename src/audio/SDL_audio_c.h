@@ -74,6 +74,18 @@ extern SDL_AudioFilter SDL_Convert_F32_to_S32;
 extern int SDL_PrepareResampleFilter(void);
 extern void SDL_FreeResampleFilter(void);
 
+/* After warm-up, the audio thread calls this so debug builds assert if its
+   stream ever needs more memory than SDL_AudioStreamPreallocate() set aside. */
+extern void SDL_AudioStreamForbidAllocations(SDL_AudioStream *stream, SDL_bool forbidden);
+
+/* If the stream only changes format and channels, this returns how big a
+   buffer has to be to convert (len) bytes in place, otherwise 0. */
+extern int SDL_AudioStreamDirectBufferSize(SDL_AudioStream *stream, const int len);
+
+/* Converts (len) bytes in place, bypassing the stream's queue. The buffer
+   must be SDL_AudioStreamDirectBufferSize() bytes. Returns converted bytes. */
+extern int SDL_AudioStreamConvertDirect(SDL_AudioStream *stream, void *buf, const int len);
+
 #endif /* SDL_audio_c_h_ */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -33,6 +33,7 @@
 #include "SDL_assert.h"
 #include "../SDL_dataqueue.h"
 #include "SDL_cpuinfo.h"
+#include "../cpuinfo/SDL_simd.h"
 
 #define DEBUG_AUDIOSTREAM 0
 
@@ -460,6 +461,50 @@ SDL_PrepareResampleFilter(void)
     return 0;
 }
 
+/* SDL_ResampleCVT() keeps no state between calls, so it pads both ends
+   with silence. Rather than allocating that on every call, share one
+   buffer of zeros, sized when the SDL_AudioCVT is built. It only grows,
+   and a CVT running on another thread may still be reading the old one,
+   so replaced buffers are kept until SDL_FreeResampleFilter(). */
+typedef struct ResamplerSilence
+{
+    struct ResamplerSilence *next;
+    int samples;
+    float data[SDL_VARIABLE_LENGTH_ARRAY];
+} ResamplerSilence;
+
+static ResamplerSilence *ResamplerZeroPadding = NULL;
+
+static int
+SDL_PrepareResamplePadding(const int samples)
+{
+    SDL_AtomicLock(&ResampleFilterSpinlock);
+    if (!ResamplerZeroPadding || (ResamplerZeroPadding->samples < samples)) {
+        ResamplerSilence *silence = (ResamplerSilence *) SDL_calloc(1, sizeof (ResamplerSilence) + (samples * sizeof (float)));
+        if (!silence) {
+            SDL_AtomicUnlock(&ResampleFilterSpinlock);
+            return SDL_OutOfMemory();
+        }
+        silence->samples = samples;
+        silence->next = ResamplerZeroPadding;
+        ResamplerZeroPadding = silence;
+    }
+    SDL_AtomicUnlock(&ResampleFilterSpinlock);
+    return 0;
+}
+
+static const float *
+SDL_GetResamplePadding(const int samples)
+{
+    const float *retval = NULL;
+    SDL_AtomicLock(&ResampleFilterSpinlock);
+    if (ResamplerZeroPadding && (ResamplerZeroPadding->samples >= samples)) {
+        retval = ResamplerZeroPadding->data;
+    }
+    SDL_AtomicUnlock(&ResampleFilterSpinlock);
+    return retval;
+}
+
 void
 SDL_FreeResampleFilter(void)
 {
@@ -467,6 +512,12 @@ SDL_FreeResampleFilter(void)
     SDL_free(ResamplerFilterDifference);
     ResamplerFilter = NULL;
     ResamplerFilterDifference = NULL;
+
+    while (ResamplerZeroPadding) {
+        ResamplerSilence *next = ResamplerZeroPadding->next;
+        SDL_free(ResamplerZeroPadding);
+        ResamplerZeroPadding = next;
+    }
 }
 
 static int
@@ -719,21 +770,19 @@ SDL_ResampleCVT(SDL_AudioCVT *cvt, const int chans, const SDL_AudioFormat format
     float *dst = (float *) (cvt->buf + srclen);
     const int dstlen = (cvt->len * cvt->len_mult) - srclen;
     const int paddingsamples = (ResamplerPadding(inrate, outrate) * chans);
-    float *padding;
+    const float *padding;
 
     SDL_assert(format == AUDIO_F32SYS);
 
     /* we keep no streaming state here, so pad with silence on both ends. */
-    padding = (float *) SDL_calloc(paddingsamples ? paddingsamples : 1, sizeof (float));
+    padding = SDL_GetResamplePadding(paddingsamples);
     if (!padding) {
-        SDL_OutOfMemory();
+        SDL_SetError("Audio resampler wasn't prepared for this conversion");
         return;
     }
 
     cvt->len_cvt = SDL_ResampleAudio(chans, inrate, outrate, padding, padding, src, srclen, dst, dstlen);
 
-    SDL_free(padding);
-
     SDL_memmove(cvt->buf, dst, cvt->len_cvt);  /* !!! FIXME: remove this if we can get the resampler to work in-place again. */
 
     if (cvt->filters[++cvt->filter_index]) {
@@ -791,6 +840,10 @@ SDL_BuildAudioResampleCVT(SDL_AudioCVT * cvt, const int dst_channels,
         return -1;
     }
 
+    if (SDL_PrepareResamplePadding(ResamplerPadding(src_rate, dst_rate) * dst_channels) < 0) {
+        return -1;
+    }
+
     /* Update (cvt) with filter details... */
     if (SDL_AddAudioCVTFilter(cvt, filter) < 0) {
         return -1;
@@ -1089,7 +1142,7 @@ struct _SDL_AudioStream
     Uint8 *staging_buffer;
     int staging_buffer_size;
     int staging_buffer_filled;
-    Uint8 *work_buffer_base;  /* maybe unaligned pointer from SDL_realloc(). */
+    Uint8 *work_buffer;  /* from SDL_SIMDAlloc(), so it's aligned and padded. */
     int work_buffer_len;
     int src_sample_frame_size;
     SDL_AudioFormat src_format;
@@ -1102,6 +1155,8 @@ struct _SDL_AudioStream
     double rate_incr;
     Uint8 pre_resample_channels;
     int packetlen;
+    int preallocated_len;  /* queue bytes set aside by SDL_AudioStreamPreallocate(). */
+    SDL_bool allocations_forbidden;
     int resampler_padding_samples;
     float *resampler_padding;
     void *resampler_state;
@@ -1113,24 +1168,21 @@ struct _SDL_AudioStream
 static Uint8 *
 EnsureStreamBufferSize(SDL_AudioStream *stream, const int newlen)
 {
-    Uint8 *ptr;
-    size_t offset;
+    if (stream->work_buffer_len < newlen) {
+        /* The contents don't need to survive, so don't realloc and copy them */
+        Uint8 *ptr;
 
-    if (stream->work_buffer_len >= newlen) {
-        ptr = stream->work_buffer_base;
-    } else {
-        ptr = (Uint8 *) SDL_realloc(stream->work_buffer_base, newlen + 32);
+        SDL_assert(!stream->allocations_forbidden);  /* put is bigger than what was preallocated. */
+        ptr = (Uint8 *) SDL_SIMDAlloc(newlen);
         if (!ptr) {
             SDL_OutOfMemory();
             return NULL;
         }
-        /* Make sure we're aligned to 16 bytes for SIMD code. */
-        stream->work_buffer_base = ptr;
+        SDL_SIMDFree(stream->work_buffer);
+        stream->work_buffer = ptr;
         stream->work_buffer_len = newlen;
     }
-
-    offset = ((size_t) ptr) & 15;
-    return offset ? ptr + (16 - offset) : ptr;
+    return stream->work_buffer;
 }
 
 #ifdef HAVE_LIBSAMPLERATE_H
@@ -1301,7 +1353,7 @@ SDL_NewAudioStream(const SDL_AudioFormat src_format,
 
     retval->staging_buffer_size = ((retval->resampler_padding_samples / retval->pre_resample_channels) * retval->src_sample_frame_size);
     if (retval->staging_buffer_size > 0) {
-        retval->staging_buffer = (Uint8 *) SDL_malloc(retval->staging_buffer_size);
+        retval->staging_buffer = (Uint8 *) SDL_SIMDAlloc(retval->staging_buffer_size);
         if (retval->staging_buffer == NULL) {
             SDL_FreeAudioStream(retval);
             SDL_OutOfMemory();
@@ -1364,6 +1416,38 @@ SDL_NewAudioStream(const SDL_AudioFormat src_format,
     return retval;
 }
 
+/* How much work buffer a put of (len) bytes needs, and how much of that
+   is the second half the resampler writes into. */
+static int
+GetStreamWorkBufferSize(SDL_AudioStream *stream, const int len, int *resamplebuflen)
+{
+    int workbuflen = len;
+
+    *resamplebuflen = 0;
+
+    if (stream->cvt_before_resampling.needed) {
+        workbuflen *= stream->cvt_before_resampling.len_mult;
+    }
+
+    if (stream->dst_rate != stream->src_rate) {
+        /* resamples can't happen in place, so make space for second buf. */
+        const int framesize = stream->pre_resample_channels * sizeof (float);
+        const int frames = workbuflen / framesize;
+        *resamplebuflen = ((int) SDL_ceil(frames * stream->rate_incr)) * framesize;
+        #if DEBUG_AUDIOSTREAM
+        printf("AUDIOSTREAM: will resample %d bytes to %d (ratio=%.6f)\n", workbuflen, *resamplebuflen, stream->rate_incr);
+        #endif
+        workbuflen += *resamplebuflen;
+    }
+
+    if (stream->cvt_after_resampling.needed) {
+        /* !!! FIXME: buffer might be big enough already? */
+        workbuflen *= stream->cvt_after_resampling.len_mult;
+    }
+
+    return workbuflen + (stream->resampler_padding_samples * sizeof (float));
+}
+
 static int
 SDL_AudioStreamPutInternal(SDL_AudioStream *stream, const void *buf, int len, int *maxputbytes)
 {
@@ -1389,28 +1473,7 @@ SDL_AudioStreamPutInternal(SDL_AudioStream *stream, const void *buf, int len, in
     stream->first_run = SDL_FALSE;
 
     /* Make sure the work buffer can hold all the data we need at once... */
-    workbuflen = buflen;
-    if (stream->cvt_before_resampling.needed) {
-        workbuflen *= stream->cvt_before_resampling.len_mult;
-    }
-
-    if (stream->dst_rate != stream->src_rate) {
-        /* resamples can't happen in place, so make space for second buf. */
-        const int framesize = stream->pre_resample_channels * sizeof (float);
-        const int frames = workbuflen / framesize;
-        resamplebuflen = ((int) SDL_ceil(frames * stream->rate_incr)) * framesize;
-        #if DEBUG_AUDIOSTREAM
-        printf("AUDIOSTREAM: will resample %d bytes to %d (ratio=%.6f)\n", workbuflen, resamplebuflen, stream->rate_incr);
-        #endif
-        workbuflen += resamplebuflen;
-    }
-
-    if (stream->cvt_after_resampling.needed) {
-        /* !!! FIXME: buffer might be big enough already? */
-        workbuflen *= stream->cvt_after_resampling.len_mult;
-    }
-
-    workbuflen += neededpaddingbytes;
+    workbuflen = GetStreamWorkBufferSize(stream, buflen, &resamplebuflen);
 
     #if DEBUG_AUDIOSTREAM
     printf("AUDIOSTREAM: Putting %d bytes of preconverted audio, need %d byte work buffer\n", buflen, workbuflen);
@@ -1558,6 +1621,84 @@ SDL_AudioStreamPut(SDL_AudioStream *stream, const void *buf, int len)
     return 0;
 }
 
+int
+SDL_AudioStreamPreallocate(SDL_AudioStream *stream, int max_put_len)
+{
+    int resamplebuflen;
+    int inframes;
+    int outlen;
+
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (max_put_len <= 0) {
+        return SDL_InvalidParamError("max_put_len");
+    }
+
+    /* Puts go through the staging buffer in pieces of its size, too. */
+    if (max_put_len < stream->staging_buffer_size) {
+        max_put_len = stream->staging_buffer_size;
+    }
+
+    if (!EnsureStreamBufferSize(stream, GetStreamWorkBufferSize(stream, max_put_len, &resamplebuflen))) {
+        return -1;
+    }
+
+    /* Leave room for the output of two puts, so a caller that takes out
+       what each put made never needs another packet. The extra frame
+       covers the resampler rounding up. */
+    inframes = (max_put_len + (stream->src_sample_frame_size - 1)) / stream->src_sample_frame_size;
+    outlen = (((int) SDL_ceil(inframes * stream->rate_incr)) + 1) * stream->dst_sample_frame_size;
+    if (SDL_PreallocateDataQueue(stream->queue, outlen * 2) < 0) {
+        return -1;
+    }
+
+    if (stream->preallocated_len < outlen * 2) {
+        stream->preallocated_len = outlen * 2;
+    }
+    return 0;
+}
+
+void
+SDL_AudioStreamForbidAllocations(SDL_AudioStream *stream, SDL_bool forbidden)
+{
+    if (stream) {
+        stream->allocations_forbidden = forbidden;
+        SDL_SetDataQueueAllocationsForbidden(stream->queue, forbidden);
+    }
+}
+
+int
+SDL_AudioStreamDirectBufferSize(SDL_AudioStream *stream, const int len)
+{
+    /* Without resampling, each put converts whole frames and keeps nothing
+       back, so there's no reason the data has to go through the queue. */
+    if (!stream || (stream->src_rate != stream->dst_rate)) {
+        return 0;
+    }
+    SDL_assert(!stream->cvt_before_resampling.needed);
+    return stream->cvt_after_resampling.needed ? (len * stream->cvt_after_resampling.len_mult) : len;
+}
+
+int
+SDL_AudioStreamConvertDirect(SDL_AudioStream *stream, void *buf, const int len)
+{
+    SDL_AudioCVT *cvt = &stream->cvt_after_resampling;
+
+    SDL_assert(stream->src_rate == stream->dst_rate);
+    SDL_assert((len % stream->src_sample_frame_size) == 0);
+
+    if (!cvt->needed) {
+        return len;
+    }
+
+    cvt->buf = (Uint8 *) buf;
+    cvt->len = len;
+    if (SDL_ConvertAudio(cvt) == -1) {
+        return -1;
+    }
+    return cvt->len_cvt;
+}
+
 int SDL_AudioStreamFlush(SDL_AudioStream *stream)
 {
     if (!stream) {
@@ -1644,7 +1785,8 @@ SDL_AudioStreamClear(SDL_AudioStream *stream)
     if (!stream) {
         SDL_InvalidParamError("stream");
     } else {
-        SDL_ClearDataQueue(stream->queue, stream->packetlen * 2);
+        /* keep what was preallocated, so clearing never undoes it. */
+        SDL_ClearDataQueue(stream->queue, SDL_max(stream->packetlen * 2, stream->preallocated_len + stream->packetlen));
         if (stream->reset_resampler_func) {
             stream->reset_resampler_func(stream);
         }
@@ -1662,8 +1804,8 @@ SDL_FreeAudioStream(SDL_AudioStream *stream)
             stream->cleanup_resampler_func(stream);
         }
         SDL_FreeDataQueue(stream->queue);
-        SDL_free(stream->staging_buffer);
-        SDL_free(stream->work_buffer_base);
+        SDL_SIMDFree(stream->staging_buffer);
+        SDL_SIMDFree(stream->work_buffer);
         SDL_free(stream->resampler_padding);
         SDL_free(stream);
     }
@@ -72,6 +72,8 @@ typedef struct SDL_AudioDriverImpl
     void (*WaitDevice) (_THIS);
     void (*PlayDevice) (_THIS);
     int (*GetPendingBytes) (_THIS);
+    int (*GetLatencyBytes) (_THIS);  /**< Bytes the device still has to play, for SDL_GetAudioDeviceLatency() only */
+    int (*GetMinimumSamples) (int freq);  /**< Shortest buffer that plays safely, for SDL_HINT_AUDIO_LOW_LATENCY */
     Uint8 *(*GetDeviceBuf) (_THIS);
     int (*CaptureFromDevice) (_THIS, void *buffer, int buflen);
     void (*FlushCapture) (_THIS);
@@ -144,6 +146,17 @@ struct SDL_AudioDevice
     /* Stream that converts and resamples. NULL if not needed. */
     SDL_AudioStream *stream;
 
+    /* True if the stream converts each buffer in place instead of queueing. */
+    SDL_bool stream_direct;
+
+    /* Bytes left in the stream after the audio thread's last get. */
+    SDL_atomic_t stream_queued;
+
+    /* Performance counter at the last callback, and when its first sample
+       plays (or was recorded). Protected by mixer_lock. */
+    Uint64 callback_time;
+    Uint64 sample_time;
+
     /* Current state flags */
     SDL_atomic_t shutdown; /* true if we are signaling the play thread to end. */
     SDL_atomic_t enabled;  /* true if device is functioning and connected. */
@@ -31,7 +31,9 @@
 #include "SDL_rwops.h"
 #include "SDL_timer.h"
 #include "SDL_audio.h"
+#include "SDL_hints.h"
 #include "../SDL_audio_c.h"
+#include "../../thread/SDL_systhread.h"
 #include "SDL_diskaudio.h"
 #include "SDL_log.h"
 
@@ -43,27 +45,106 @@
 #define DISKDEFAULT_INFILE      "sdlaudio-in.raw"
 #define DISKENVR_IODELAY      "SDL_DISKAUDIODELAY"
 
+#define WAV_HEADER_SIZE     44
+
 /* This function waits until it is possible to write a full sound buffer */
 static void
 DISKAUDIO_WaitDevice(_THIS)
 {
-    SDL_Delay(this->hidden->io_delay);
+    /* With no delay we run as fast as the writer thread can keep up */
+    if (this->hidden->io_delay) {
+        SDL_Delay(this->hidden->io_delay);
+    }
+}
+
+static int SDLCALL
+DISKAUDIO_WriterThread(void *data)
+{
+    SDL_AudioDevice *this = (SDL_AudioDevice *) data;
+    struct SDL_PrivateAudioData *h = this->hidden;
+
+    SDL_LockMutex(h->lock);
+    for ( ; ; ) {
+        size_t written;
+
+        while (!h->pending && !h->shutdown) {
+            SDL_CondWait(h->cond, h->lock);
+        }
+        if (!h->pending) {
+            break;  /* shut down with nothing left to write. */
+        }
+
+        /* writebuf is ours until pending is cleared */
+        SDL_UnlockMutex(h->lock);
+        written = SDL_RWwrite(h->io, h->writebuf, 1, this->spec.size);
+#ifdef DEBUG_AUDIO
+        fprintf(stderr, "Wrote %d bytes of audio data\n", (int) written);
+#endif
+        SDL_LockMutex(h->lock);
+
+        h->bytes_written += (Uint32) written;
+        if (written != this->spec.size) {
+            h->failed = SDL_TRUE;
+        }
+        h->pending = SDL_FALSE;
+        SDL_CondSignal(h->cond);
+    }
+    SDL_UnlockMutex(h->lock);
+
+    return 0;
 }
 
 static void
 DISKAUDIO_PlayDevice(_THIS)
 {
-    const size_t written = SDL_RWwrite(this->hidden->io,
-                                       this->hidden->mixbuf,
-                                       1, this->spec.size);
+    struct SDL_PrivateAudioData *h = this->hidden;
+    SDL_bool failed;
+    Uint8 *buf;
+
+    /* Wait for the previous buffer to be written, then hand this one over */
+    SDL_LockMutex(h->lock);
+    while (h->pending) {
+        SDL_CondWait(h->cond, h->lock);
+    }
+    failed = h->failed;
+    if (!failed) {
+        buf = h->writebuf;
+        h->writebuf = h->mixbuf;
+        h->mixbuf = buf;
+        h->pending = SDL_TRUE;
+        SDL_CondSignal(h->cond);
+    }
+    SDL_UnlockMutex(h->lock);
 
     /* If we couldn't write, assume fatal error for now */
-    if (written != this->spec.size) {
+    if (failed) {
         SDL_OpenedAudioDeviceDisconnected(this);
     }
-#ifdef DEBUG_AUDIO
-    fprintf(stderr, "Wrote %d bytes of audio data\n", written);
-#endif
+}
+
+static int
+DISKAUDIO_GetLatencyBytes(_THIS)
+{
+    struct SDL_PrivateAudioData *h = this->hidden;
+    int retval = 0;
+
+    /* In real time, the last buffer plays while we wait; otherwise the
+       writer thread might not have written it out yet. */
+    if (h->lock) {
+        SDL_LockMutex(h->lock);
+        if (h->pending || h->io_delay) {
+            retval = this->spec.size;
+        }
+        SDL_UnlockMutex(h->lock);
+    }
+    return retval;
+}
+
+static int
+DISKAUDIO_GetMinimumSamples(int freq)
+{
+    /* We time buffers with SDL_Delay(), so don't go below a couple of ms. */
+    return (freq + 499) / 500;
 }
 
 static Uint8 *
@@ -103,14 +184,71 @@ DISKAUDIO_FlushCapture(_THIS)
 }
 
 
+static void
+DISKAUDIO_WriteWAVSizes(SDL_RWops *io, Uint32 data_size)
+{
+    /* If the output isn't seekable (a pipe, say) the sizes stay at the
+       maximum, which most readers take to mean "until end of file". */
+    if (SDL_RWseek(io, 4, RW_SEEK_SET) == 4) {
+        SDL_WriteLE32(io, (data_size + WAV_HEADER_SIZE - 8));
+        SDL_RWseek(io, WAV_HEADER_SIZE - 4, RW_SEEK_SET);
+        SDL_WriteLE32(io, data_size);
+    }
+}
+
+static int
+DISKAUDIO_WriteWAVHeader(_THIS)
+{
+    SDL_RWops *io = this->hidden->io;
+    const Uint16 bits = (Uint16) SDL_AUDIO_BITSIZE(this->spec.format);
+    const Uint16 block_align = (Uint16) ((bits / 8) * this->spec.channels);
+
+    SDL_RWwrite(io, "RIFF", 4, 1);
+    SDL_WriteLE32(io, 0xFFFFFFFF);
+    SDL_RWwrite(io, "WAVE", 4, 1);
+    SDL_RWwrite(io, "fmt ", 4, 1);
+    SDL_WriteLE32(io, 16);
+    SDL_WriteLE16(io, SDL_AUDIO_ISFLOAT(this->spec.format) ? 0x0003 : 0x0001);
+    SDL_WriteLE16(io, this->spec.channels);
+    SDL_WriteLE32(io, (Uint32) this->spec.freq);
+    SDL_WriteLE32(io, (Uint32) this->spec.freq * block_align);
+    SDL_WriteLE16(io, block_align);
+    SDL_WriteLE16(io, bits);
+    SDL_RWwrite(io, "data", 4, 1);
+    if (SDL_WriteLE32(io, 0xFFFFFFFF) != 1) {
+        return SDL_SetError("Couldn't write WAV header");
+    }
+    return 0;
+}
+
 static void
 DISKAUDIO_CloseDevice(_THIS)
 {
-    if (this->hidden->io != NULL) {
-        SDL_RWclose(this->hidden->io);
+    struct SDL_PrivateAudioData *h = this->hidden;
+
+    if (h->writer != NULL) {
+        /* The writer finishes any buffer it was handed before exiting */
+        SDL_LockMutex(h->lock);
+        h->shutdown = SDL_TRUE;
+        SDL_CondSignal(h->cond);
+        SDL_UnlockMutex(h->lock);
+        SDL_WaitThread(h->writer, NULL);
+    }
+    if (h->io != NULL) {
+        if (h->wav_header) {
+            DISKAUDIO_WriteWAVSizes(h->io, h->bytes_written);
+        }
+        SDL_RWclose(h->io);
+    }
+    if (h->cond != NULL) {
+        SDL_DestroyCond(h->cond);
     }
-    SDL_free(this->hidden->mixbuf);
-    SDL_free(this->hidden);
+    if (h->lock != NULL) {
+        SDL_DestroyMutex(h->lock);
+    }
+    SDL_free(h->mixbuf);
+    SDL_free(h->writebuf);
+    SDL_free(h);
 }
 
 
@@ -140,7 +278,9 @@ DISKAUDIO_OpenDevice(_THIS, void *handle, const char *devname, int iscapture)
     }
     SDL_zerop(this->hidden);
 
-    if (envr != NULL) {
+    if (!SDL_GetHintBoolean(SDL_HINT_AUDIO_DISK_REALTIME, SDL_TRUE)) {
+        this->hidden->io_delay = 0;
+    } else if (envr != NULL) {
         this->hidden->io_delay = SDL_atoi(envr);
     } else {
         this->hidden->io_delay = ((this->spec.samples * 1000) / this->spec.freq);
@@ -152,13 +292,44 @@ DISKAUDIO_OpenDevice(_THIS, void *handle, const char *devname, int iscapture)
         return -1;
     }
 
-    /* Allocate mixing buffer */
+    /* Allocate mixing buffers and start the writer */
     if (!iscapture) {
+        if (SDL_GetHintBoolean(SDL_HINT_AUDIO_DISK_WAV_HEADER, SDL_FALSE)) {
+            /* WAV data is little endian, and only 8-bit data is unsigned */
+            switch (SDL_AUDIO_BITSIZE(this->spec.format)) {
+            case 8: this->spec.format = AUDIO_U8; break;
+            case 16: this->spec.format = AUDIO_S16LSB; break;
+            default:
+                this->spec.format = SDL_AUDIO_ISFLOAT(this->spec.format) ? AUDIO_F32LSB : AUDIO_S32LSB;
+                break;
+            }
+            SDL_CalculateAudioSpec(&this->spec);
+
+            if (DISKAUDIO_WriteWAVHeader(this) < 0) {
+                return -1;
+            }
+            this->hidden->wav_header = SDL_TRUE;
+        }
+
         this->hidden->mixbuf = (Uint8 *) SDL_malloc(this->spec.size);
-        if (this->hidden->mixbuf == NULL) {
+        this->hidden->writebuf = (Uint8 *) SDL_malloc(this->spec.size);
+        if (this->hidden->mixbuf == NULL || this->hidden->writebuf == NULL) {
             return SDL_OutOfMemory();
         }
         SDL_memset(this->hidden->mixbuf, this->spec.silence, this->spec.size);
+
+        this->hidden->lock = SDL_CreateMutex();
+        if (this->hidden->lock == NULL) {
+            return -1;
+        }
+        this->hidden->cond = SDL_CreateCond();
+        if (this->hidden->cond == NULL) {
+            return -1;
+        }
+        this->hidden->writer = SDL_CreateThreadInternal(DISKAUDIO_WriterThread, "SDLDiskAudioWriter", 0, this);
+        if (this->hidden->writer == NULL) {
+            return -1;
+        }
     }
 
     SDL_LogCritical(SDL_LOG_CATEGORY_AUDIO,
@@ -186,6 +357,8 @@ DISKAUDIO_Init(SDL_AudioDriverImpl * impl)
     impl->WaitDevice = DISKAUDIO_WaitDevice;
     impl->PlayDevice = DISKAUDIO_PlayDevice;
     impl->GetDeviceBuf = DISKAUDIO_GetDeviceBuf;
+    impl->GetLatencyBytes = DISKAUDIO_GetLatencyBytes;
+    impl->GetMinimumSamples = DISKAUDIO_GetMinimumSamples;
     impl->CaptureFromDevice = DISKAUDIO_CaptureFromDevice;
     impl->FlushCapture = DISKAUDIO_FlushCapture;
 
@@ -24,6 +24,8 @@
 #define SDL_diskaudio_h_
 
 #include "SDL_rwops.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
 #include "../SDL_sysaudio.h"
 
 /* Hidden "this" pointer for the audio functions */
@@ -35,6 +37,20 @@ struct SDL_PrivateAudioData
     SDL_RWops *io;
     Uint32 io_delay;
     Uint8 *mixbuf;
+
+    /* Playback is written out by a separate thread, while the audio
+       thread mixes the next buffer. */
+    Uint8 *writebuf;
+    SDL_Thread *writer;
+    SDL_mutex *lock;
+    SDL_cond *cond;
+    SDL_bool pending;
+    SDL_bool shutdown;
+    SDL_bool failed;
+
+    /* Set if a WAV header was written, so its sizes are patched on close */
+    SDL_bool wav_header;
+    Uint32 bytes_written;
 };
 
 #endif /* SDL_diskaudio_h_ */
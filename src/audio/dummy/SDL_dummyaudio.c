@@ -44,12 +44,20 @@ DUMMYAUDIO_CaptureFromDevice(_THIS, void *buffer, int buflen)
     return buflen;
 }
 
+static int
+DUMMYAUDIO_GetMinimumSamples(int freq)
+{
+    /* We time buffers with SDL_Delay(), so don't go below a couple of ms. */
+    return (freq + 499) / 500;
+}
+
 static int
 DUMMYAUDIO_Init(SDL_AudioDriverImpl * impl)
 {
     /* Set the function pointers */
     impl->OpenDevice = DUMMYAUDIO_OpenDevice;
     impl->CaptureFromDevice = DUMMYAUDIO_CaptureFromDevice;
+    impl->GetMinimumSamples = DUMMYAUDIO_GetMinimumSamples;
 
     impl->OnlyHasDefaultOutputDevice = 1;
     impl->OnlyHasDefaultCaptureDevice = 1;
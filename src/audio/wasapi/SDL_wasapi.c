@@ -202,6 +202,9 @@ UpdateAudioStream(_THIS, const SDL_AudioSpec *oldspec)
        the audio stream that the higher level uses to convert data, so
        SDL keeps firing the callback as if nothing happened here. */
 
+    /* the new spec might need resampling, so go through the stream's queue. */
+    this->stream_direct = SDL_FALSE;
+
     if ( (this->callbackspec.channels == this->spec.channels) &&
          (this->callbackspec.format == this->spec.format) &&
          (this->callbackspec.freq == this->spec.freq) &&
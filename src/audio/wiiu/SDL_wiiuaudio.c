@@ -200,6 +200,7 @@ static int WIIUAUDIO_OpenDevice(_THIS, void* handle, const char* devname, int is
     /*  Offsets are set for playing the first mixbuf, so we should render the second */
         this->hidden->playingid = 0;
         this->hidden->renderingid = 1;
+        SDL_AtomicSet(&this->hidden->queued, 1);
 
     /*  Start playing. */
         AXSetVoiceState(this->hidden->voice[i], AX_VOICE_STATE_PLAYING);
@@ -256,6 +257,13 @@ static void _WIIUAUDIO_framecallback() {
                 cb_this->spec.size, (void*)cb_hidden->mixbufs[1]);*/
         printf("DEBUG: Playing an invalid buffer? This is not a good sign.\n");
         playing_buffer = 0;
+    } else if (playing_buffer != cb_hidden->playingid) {
+    /*  Moving on to another buffer means the last one finished playing.
+        Don't go below zero if we lost track of the hardware earlier. */
+        int queued;
+        do {
+            queued = SDL_AtomicGet(&cb_hidden->queued);
+        } while (queued > 0 && !SDL_AtomicCAS(&cb_hidden->queued, queued, queued - 1));
     }
 
 /*  Make sure playingid is in sync with the hardware */
@@ -330,6 +338,7 @@ static void WIIUAUDIO_PlayDevice(_THIS) {
     DCStoreRange(this->hidden->mixbufs[this->hidden->renderingid], this->spec.size);
 /*  Signal we're no longer rendering this buffer, AX callback will notice later */
     this->hidden->renderingid = next_id(this->hidden->renderingid);
+    SDL_AtomicIncRef(&this->hidden->queued);
 }
 
 static void WIIUAUDIO_WaitDevice(_THIS) {
@@ -339,6 +348,18 @@ static void WIIUAUDIO_WaitDevice(_THIS) {
     }
 }
 
+static int WIIUAUDIO_GetLatencyBytes(_THIS) {
+/*  renderingid == playingid can mean a full or an empty ring, so count the
+    buffers instead */
+    return SDL_AtomicGet(&this->hidden->queued) * this->spec.size;
+}
+
+static int WIIUAUDIO_GetMinimumSamples(int freq) {
+/*  AX mixes in 3ms frames, and OpenDevice rounds up to
+    AXGetInputSamplesPerFrame() anyway */
+    return (freq * 3 + 999) / 1000;
+}
+
 static Uint8* WIIUAUDIO_GetDeviceBuf(_THIS) {
 /*  SDL will write audio samples into this buffer */
     return this->hidden->mixbufs[this->hidden->renderingid];
@@ -374,6 +395,8 @@ static int WIIUAUDIO_Init(SDL_AudioDriverImpl* impl) {
     impl->PlayDevice = WIIUAUDIO_PlayDevice;
     impl->WaitDevice = WIIUAUDIO_WaitDevice;
     impl->GetDeviceBuf = WIIUAUDIO_GetDeviceBuf;
+    impl->GetLatencyBytes = WIIUAUDIO_GetLatencyBytes;
+    impl->GetMinimumSamples = WIIUAUDIO_GetMinimumSamples;
     impl->CloseDevice = WIIUAUDIO_CloseDevice;
     impl->ThreadInit = WIIUAUDIO_ThreadInit;
 
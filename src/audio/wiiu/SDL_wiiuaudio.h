@@ -45,6 +45,9 @@ struct SDL_PrivateAudioData {
 
     int renderingid;
     int playingid;
+    /* Buffers handed to AX that haven't finished playing, including the
+       playing one. Updated by the AX frame callback. */
+    SDL_atomic_t queued;
     uint32_t last_loopcount;
 };
 
@@ -0,0 +1,420 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#include "SDL_epoll.h"
+#include "SDL_hints.h"
+#include "SDL_mutex.h"
+#include "SDL_thread.h"
+#include "SDL_timer.h"
+#include "../../thread/SDL_systhread.h"
+
+#ifdef __LINUX__
+
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <linux/input.h>
+
+/* Sources are level triggered, so a backend that stops reading before a
+   device is drained will see it again on the next poll. */
+
+#define MAX_EVENTS_PER_WAIT 64
+
+static int epoll_refcount = 0;
+static int epoll_fd = -1;
+/* Held across epoll_wait() and source removal, so a wait never hands out
+   a source that is being freed */
+static SDL_mutex *epoll_lock = NULL;
+
+/* The input thread holds epoll_lock while it waits, and is woken through
+   epoll_wake_fd when another thread needs the lock */
+static SDL_Thread *epoll_thread = NULL;
+static int epoll_wake_fd = -1;
+static SDL_atomic_t epoll_lock_waiters;
+static SDL_atomic_t epoll_thread_quit;
+/* The number of SDL_EPOLL_RemoveSource() calls in progress */
+static SDL_atomic_t epoll_removing;
+
+static void
+SDL_EPOLL_Wake(void)
+{
+    const Uint64 value = 1;
+
+    if (write(epoll_wake_fd, &value, sizeof(value)) < 0) {
+        /* The counter is full, so the thread is being woken anyway */
+    }
+}
+
+static void
+SDL_EPOLL_Lock(void)
+{
+    if (epoll_thread) {
+        SDL_AtomicIncRef(&epoll_lock_waiters);
+        SDL_EPOLL_Wake();
+        SDL_LockMutex(epoll_lock);
+        (void)SDL_AtomicDecRef(&epoll_lock_waiters);
+    } else {
+        SDL_LockMutex(epoll_lock);
+    }
+}
+
+static int SDLCALL
+SDL_EPOLL_InputThread(void *data)
+{
+    struct epoll_event events[MAX_EVENTS_PER_WAIT];
+    SDL_EPOLL_Source *dispatch[MAX_EVENTS_PER_WAIT];
+    int count, num_dispatch, i;
+
+    SDL_SetThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+
+    SDL_LockMutex(epoll_lock);
+    while (!SDL_AtomicGet(&epoll_thread_quit)) {
+        count = epoll_wait(epoll_fd, events, SDL_arraysize(events), -1);
+
+        num_dispatch = 0;
+        for (i = 0; i < count; ++i) {
+            SDL_EPOLL_Source *source = (SDL_EPOLL_Source *) events[i].data.ptr;
+
+            if (!source) {
+                Uint64 value;
+                if (read(epoll_wake_fd, &value, sizeof(value)) < 0) {
+                    /* Already drained */
+                }
+            } else if (source->dispatch) {
+                if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                    /* Let the read find out, but don't spin on the device
+                       until the backend gets around to removing it */
+                    struct epoll_event event;
+                    SDL_zero(event);
+                    event.data.ptr = source;
+                    epoll_ctl(epoll_fd, EPOLL_CTL_MOD, source->fd, &event);
+                }
+                SDL_AtomicIncRef(&source->busy);
+                dispatch[num_dispatch++] = source;
+            } else {
+                SDL_AtomicSet(&source->ready, 1);
+            }
+        }
+        SDL_UnlockMutex(epoll_lock);
+
+        /* Sources can't be removed while they're busy */
+        for (i = 0; i < num_dispatch; ++i) {
+            if (!SDL_AtomicGet(&dispatch[i]->removed)) {
+                dispatch[i]->dispatch(dispatch[i]);
+            }
+            (void)SDL_AtomicDecRef(&dispatch[i]->busy);
+        }
+
+        while (SDL_AtomicGet(&epoll_lock_waiters) > 0) {
+            SDL_Delay(0);
+        }
+        SDL_LockMutex(epoll_lock);
+    }
+    SDL_UnlockMutex(epoll_lock);
+
+    return 0;
+}
+
+static void
+SDL_EPOLL_StartThread(void)
+{
+    struct epoll_event event;
+
+    epoll_wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (epoll_wake_fd < 0) {
+        return;
+    }
+    SDL_zero(event);
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, epoll_wake_fd, &event) < 0) {
+        close(epoll_wake_fd);
+        epoll_wake_fd = -1;
+        return;
+    }
+
+    SDL_AtomicSet(&epoll_thread_quit, 0);
+    epoll_thread = SDL_CreateThreadInternal(SDL_EPOLL_InputThread, "SDLInput", 0, NULL);
+    if (!epoll_thread) {
+        close(epoll_wake_fd);
+        epoll_wake_fd = -1;
+    }
+}
+
+static void
+SDL_EPOLL_StopThread(void)
+{
+    if (epoll_thread) {
+        SDL_AtomicSet(&epoll_thread_quit, 1);
+        SDL_EPOLL_Wake();
+        SDL_WaitThread(epoll_thread, NULL);
+        epoll_thread = NULL;
+    }
+    if (epoll_wake_fd >= 0) {
+        close(epoll_wake_fd);
+        epoll_wake_fd = -1;
+    }
+}
+
+/* If epoll can't be set up, every source is reported ready and backends
+   go back to reading each device, so callers always pair this with
+   SDL_EPOLL_Quit() and can ignore a failure. */
+int
+SDL_EPOLL_Init(void)
+{
+    if (epoll_refcount++ > 0) {
+        return (epoll_fd >= 0) ? 0 : -1;
+    }
+
+    epoll_lock = SDL_CreateMutex();
+    if (!epoll_lock) {
+        return -1;
+    }
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0) {
+        return SDL_SetError("epoll_create1() failed: %s", strerror(errno));
+    }
+
+    if (SDL_GetHintBoolean(SDL_HINT_INPUT_THREAD, SDL_FALSE)) {
+        SDL_EPOLL_StartThread();
+    }
+    return 0;
+}
+
+void
+SDL_EPOLL_Quit(void)
+{
+    if (epoll_refcount > 0 && --epoll_refcount == 0) {
+        SDL_EPOLL_StopThread();
+        if (epoll_fd >= 0) {
+            close(epoll_fd);
+            epoll_fd = -1;
+        }
+        if (epoll_lock) {
+            SDL_DestroyMutex(epoll_lock);
+            epoll_lock = NULL;
+        }
+    }
+}
+
+int
+SDL_EPOLL_AddSource(SDL_EPOLL_Source *source, int fd, SDL_EPOLL_DispatchFunc dispatch, void *data)
+{
+    struct epoll_event event;
+
+    source->fd = fd;
+    source->dispatch = dispatch;
+    source->data = data;
+    SDL_AtomicSet(&source->ready, 1);
+    SDL_AtomicSet(&source->busy, 0);
+    SDL_AtomicSet(&source->removed, 0);
+
+    if (epoll_fd < 0) {
+        /* Not initialized, the source is polled by reading it every time */
+        return 0;
+    }
+
+    SDL_zero(event);
+    event.events = EPOLLIN;
+    if (epoll_thread && !dispatch) {
+        /* The backend clears these when it gets around to it, until then
+           the thread shouldn't keep waking up for them */
+        event.events |= EPOLLET;
+    }
+    event.data.ptr = source;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        source->fd = -1;
+        return SDL_SetError("epoll_ctl() failed: %s", strerror(errno));
+    }
+    return 0;
+}
+
+void
+SDL_EPOLL_RemoveSource(SDL_EPOLL_Source *source)
+{
+    if (epoll_fd >= 0 && source->fd >= 0) {
+        SDL_AtomicIncRef(&epoll_removing);
+        SDL_EPOLL_Lock();
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, source->fd, NULL);
+        SDL_AtomicSet(&source->removed, 1);
+        SDL_UnlockMutex(epoll_lock);
+
+        while (SDL_AtomicGet(&source->busy) > 0) {
+            SDL_Delay(0);
+        }
+        (void)SDL_AtomicDecRef(&epoll_removing);
+    }
+    source->fd = -1;
+}
+
+int
+SDL_EPOLL_Poll(void)
+{
+    struct epoll_event events[MAX_EVENTS_PER_WAIT];
+    int count, i;
+
+    if (epoll_fd < 0 || epoll_thread) {
+        return 0;
+    }
+
+    SDL_LockMutex(epoll_lock);
+    count = epoll_wait(epoll_fd, events, SDL_arraysize(events), 0);
+    for (i = 0; i < count; ++i) {
+        SDL_EPOLL_Source *source = (SDL_EPOLL_Source *) events[i].data.ptr;
+        /* Hangups and errors are reported too, so reads find out about them */
+        SDL_AtomicSet(&source->ready, 1);
+    }
+    SDL_UnlockMutex(epoll_lock);
+
+    return (count > 0) ? count : 0;
+}
+
+SDL_bool
+SDL_EPOLL_TakeReady(SDL_EPOLL_Source *source)
+{
+    if (epoll_fd < 0 || source->fd < 0) {
+        return SDL_TRUE;
+    }
+    if (epoll_thread && source->dispatch) {
+        /* The input thread reads this one */
+        return SDL_FALSE;
+    }
+    return SDL_AtomicCAS(&source->ready, 1, 0);
+}
+
+SDL_bool
+SDL_EPOLL_IsThreaded(void)
+{
+    return epoll_thread ? SDL_TRUE : SDL_FALSE;
+}
+
+SDL_bool
+SDL_EPOLL_CanDispatch(SDL_EPOLL_Source *source)
+{
+    /* Any source being removed may be waiting on one dispatched before it */
+    return (!SDL_AtomicGet(&source->removed) && SDL_AtomicGet(&epoll_removing) == 0);
+}
+
+SDL_bool
+SDL_EPOLL_SetMonotonicEventTime(int fd)
+{
+#ifdef EVIOCSCLOCKID
+    int clock = CLOCK_MONOTONIC;
+    if (ioctl(fd, EVIOCSCLOCKID, &clock) == 0) {
+        return SDL_TRUE;
+    }
+#endif
+    return SDL_FALSE;
+}
+
+Uint32
+SDL_EPOLL_GetEventTicks(long sec, long usec, SDL_bool monotonic)
+{
+    const Uint32 ticks = SDL_GetTicks();
+    struct timespec now;
+    Sint64 age;
+
+    if (clock_gettime(monotonic ? CLOCK_MONOTONIC : CLOCK_REALTIME, &now) < 0) {
+        return ticks;
+    }
+
+    /* How long ago the event happened, in microseconds */
+    age = ((Sint64) now.tv_sec - sec) * 1000000 + (now.tv_nsec / 1000 - usec);
+    if (age <= 0) {
+        return ticks;
+    }
+    return ticks - (Uint32) ((age + 500) / 1000);
+}
+
+#else
+
+int
+SDL_EPOLL_Init(void)
+{
+    return 0;
+}
+
+void
+SDL_EPOLL_Quit(void)
+{
+}
+
+int
+SDL_EPOLL_AddSource(SDL_EPOLL_Source *source, int fd, SDL_EPOLL_DispatchFunc dispatch, void *data)
+{
+    source->fd = fd;
+    source->dispatch = dispatch;
+    source->data = data;
+    SDL_AtomicSet(&source->ready, 1);
+    SDL_AtomicSet(&source->busy, 0);
+    SDL_AtomicSet(&source->removed, 0);
+    return 0;
+}
+
+void
+SDL_EPOLL_RemoveSource(SDL_EPOLL_Source *source)
+{
+    source->fd = -1;
+}
+
+int
+SDL_EPOLL_Poll(void)
+{
+    return 0;
+}
+
+SDL_bool
+SDL_EPOLL_TakeReady(SDL_EPOLL_Source *source)
+{
+    return SDL_TRUE;
+}
+
+SDL_bool
+SDL_EPOLL_IsThreaded(void)
+{
+    return SDL_FALSE;
+}
+
+SDL_bool
+SDL_EPOLL_CanDispatch(SDL_EPOLL_Source *source)
+{
+    return SDL_FALSE;
+}
+
+SDL_bool
+SDL_EPOLL_SetMonotonicEventTime(int fd)
+{
+    return SDL_FALSE;
+}
+
+Uint32
+SDL_EPOLL_GetEventTicks(long sec, long usec, SDL_bool monotonic)
+{
+    return SDL_GetTicks();
+}
+
+#endif /* __LINUX__ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,93 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "../../SDL_internal.h"
+
+#ifndef SDL_epoll_h_
+#define SDL_epoll_h_
+
+#include "SDL_atomic.h"
+
+/* A single epoll set shared by the Linux input backends (joystick, evdev
+   and the udev monitor), so a frame costs one epoll_wait() instead of one
+   read() per open device.
+
+   Each backend embeds an SDL_EPOLL_Source per file descriptor. SDL_EPOLL_Poll()
+   asks the kernel which descriptors are readable and marks their sources,
+   and the backend only reads the sources that SDL_EPOLL_TakeReady() says
+   have data. Without epoll, every source is always reported ready, which
+   is the old behaviour of reading every device.
+
+   With SDL_HINT_INPUT_THREAD set, a thread waits on the set instead and
+   calls the dispatch function of each source as soon as it has data, so
+   input doesn't wait for the application to pump events. Those sources are
+   then never reported ready to the backend. Sources without a dispatch
+   function are still marked ready for the backend to handle.
+ */
+
+typedef struct SDL_EPOLL_Source SDL_EPOLL_Source;
+
+/* Called on the input thread when the source is readable. Removing a
+   source waits for dispatches to finish, and the thread removing it may
+   hold the backend's lock, so dispatch functions must take that lock with
+   a try-lock loop that gives up when SDL_EPOLL_CanDispatch() fails. The
+   source will be reported again if it still has data. */
+typedef void (*SDL_EPOLL_DispatchFunc)(SDL_EPOLL_Source *source);
+
+struct SDL_EPOLL_Source
+{
+    int fd;
+    SDL_atomic_t ready;
+    SDL_EPOLL_DispatchFunc dispatch;
+    void *data;
+    SDL_atomic_t busy;
+    SDL_atomic_t removed;
+};
+
+extern int SDL_EPOLL_Init(void);
+extern void SDL_EPOLL_Quit(void);
+
+/* Watch fd for input; the source starts out ready so pending data is read.
+   dispatch may be NULL if the source is only ever read by the backend. */
+extern int SDL_EPOLL_AddSource(SDL_EPOLL_Source *source, int fd, SDL_EPOLL_DispatchFunc dispatch, void *data);
+/* Stop watching the source, call this before closing its file descriptor.
+   It waits for the input thread to finish with the source. */
+extern void SDL_EPOLL_RemoveSource(SDL_EPOLL_Source *source);
+
+/* Check every source without blocking, returns the number that became ready */
+extern int SDL_EPOLL_Poll(void);
+/* Returns whether the source had data at the last poll, and clears it */
+extern SDL_bool SDL_EPOLL_TakeReady(SDL_EPOLL_Source *source);
+
+/* Returns whether the input thread is dispatching sources */
+extern SDL_bool SDL_EPOLL_IsThreaded(void);
+/* Returns whether a dispatch function waiting for a lock should keep trying */
+extern SDL_bool SDL_EPOLL_CanDispatch(SDL_EPOLL_Source *source);
+
+/* Ask an evdev device for CLOCK_MONOTONIC event times, returns SDL_FALSE if
+   its events keep CLOCK_REALTIME times */
+extern SDL_bool SDL_EPOLL_SetMonotonicEventTime(int fd);
+/* Convert the time of an input_event to the SDL_GetTicks() timebase */
+extern Uint32 SDL_EPOLL_GetEventTicks(long sec, long usec, SDL_bool monotonic);
+
+#endif /* SDL_epoll_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -45,6 +45,7 @@
 #include "../../events/SDL_events_c.h"
 #include "../../events/scancodes_linux.h" /* adds linux_scancode_table */
 #include "../../core/linux/SDL_udev.h"
+#include "../../core/linux/SDL_epoll.h"
 
 /* These are not defined in older Linux kernel headers */
 #ifndef SYN_DROPPED
@@ -57,10 +58,23 @@
 #define ABS_MT_TRACKING_ID  0x39
 #endif
 
+/* The most events a device buffers on the input thread between pumps */
+#define EVDEV_MAX_QUEUED_EVENTS 1024
+
 typedef struct SDL_evdevlist_item
 {
     char *path;
     int fd;
+    SDL_EPOLL_Source source;
+
+    /* Whether the kernel stamps events with CLOCK_MONOTONIC */
+    SDL_bool monotonic_time;
+
+    /* Events read on the input thread, waiting for SDL_EVDEV_Poll() to
+       handle them on the thread that pumps events */
+    struct input_event *queued;
+    int num_queued;
+    int max_queued;
 
     /* TODO: use this for every device, not just touchscreen */
     int out_of_sync;
@@ -99,6 +113,10 @@ typedef struct SDL_EVDEV_PrivateData
     SDL_evdevlist_item *first;
     SDL_evdevlist_item *last;
     SDL_EVDEV_keyboard_state *kbd;
+
+    /* Held while reading devices or changing the list, since devices can
+       also be read on the input thread */
+    SDL_mutex *lock;
 } SDL_EVDEV_PrivateData;
 
 #undef _THIS
@@ -107,10 +125,12 @@ static _THIS = NULL;
 
 static SDL_Scancode SDL_EVDEV_translate_keycode(int keycode);
 static void SDL_EVDEV_sync_device(SDL_evdevlist_item *item);
+static int SDL_EVDEV_device_added(const char *dev_path, SDL_bool is_touchscreen);
 static int SDL_EVDEV_device_removed(const char *dev_path);
+static void SDL_EVDEV_add_hint_devices(void);
+static void SDL_EVDEV_dispatch(SDL_EPOLL_Source *source);
 
 #if SDL_USE_LIBUDEV
-static int SDL_EVDEV_device_added(const char *dev_path, int udev_class);
 static void SDL_EVDEV_udev_callback(SDL_UDEV_deviceevent udev_type, int udev_class,
     const char *dev_path);
 #endif /* SDL_USE_LIBUDEV */
@@ -135,8 +155,20 @@ SDL_EVDEV_Init(void)
             return SDL_OutOfMemory();
         }
 
+        _this->lock = SDL_CreateMutex();
+        if (_this->lock == NULL) {
+            SDL_free(_this);
+            _this = NULL;
+            return -1;
+        }
+
+        /* Devices are only read when the shared epoll set says they have data */
+        SDL_EPOLL_Init();
+
 #if SDL_USE_LIBUDEV
         if (SDL_UDEV_Init() < 0) {
+            SDL_EPOLL_Quit();
+            SDL_DestroyMutex(_this->lock);
             SDL_free(_this);
             _this = NULL;
             return -1;
@@ -145,6 +177,8 @@ SDL_EVDEV_Init(void)
         /* Set up the udev callback */
         if (SDL_UDEV_AddCallback(SDL_EVDEV_udev_callback) < 0) {
             SDL_UDEV_Quit();
+            SDL_EPOLL_Quit();
+            SDL_DestroyMutex(_this->lock);
             SDL_free(_this);
             _this = NULL;
             return -1;
@@ -156,6 +190,9 @@ SDL_EVDEV_Init(void)
         /* TODO: Scan the devices manually, like a caveman */
 #endif /* SDL_USE_LIBUDEV */
 
+        /* Devices the application asked for by path */
+        SDL_EVDEV_add_hint_devices();
+
         _this->kbd = SDL_EVDEV_kbd_init();
     }
 
@@ -182,14 +219,19 @@ SDL_EVDEV_Quit(void)
         SDL_EVDEV_kbd_quit(_this->kbd);
 
         /* Remove existing devices */
+        SDL_LockMutex(_this->lock);
         while(_this->first != NULL) {
             SDL_EVDEV_device_removed(_this->first->path);
         }
+        SDL_UnlockMutex(_this->lock);
 
         SDL_assert(_this->first == NULL);
         SDL_assert(_this->last == NULL);
         SDL_assert(_this->num_devices == 0);
 
+        SDL_EPOLL_Quit();
+
+        SDL_DestroyMutex(_this->lock);
         SDL_free(_this);
         _this = NULL;
     }
@@ -203,13 +245,15 @@ static void SDL_EVDEV_udev_callback(SDL_UDEV_deviceevent udev_event, int udev_cl
         return;
     }
 
+    /* This can be called from the joystick driver's udev poll too */
+    SDL_LockMutex(_this->lock);
     switch(udev_event) {
     case SDL_UDEV_DEVICEADDED:
         if (!(udev_class & (SDL_UDEV_DEVICE_MOUSE | SDL_UDEV_DEVICE_KEYBOARD |
             SDL_UDEV_DEVICE_TOUCHSCREEN)))
-            return;
+            break;
 
-        SDL_EVDEV_device_added(dev_path, udev_class);
+        SDL_EVDEV_device_added(dev_path, (udev_class & SDL_UDEV_DEVICE_TOUCHSCREEN) ? SDL_TRUE : SDL_FALSE);
         break;  
     case SDL_UDEV_DEVICEREMOVED:
         SDL_EVDEV_device_removed(dev_path);
@@ -217,176 +261,263 @@ static void SDL_EVDEV_udev_callback(SDL_UDEV_deviceevent udev_event, int udev_cl
     default:
         break;
     }
+    SDL_UnlockMutex(_this->lock);
 }
 #endif /* SDL_USE_LIBUDEV */
 
-void 
-SDL_EVDEV_Poll(void)
+/* Turn device events into SDL events, called with the lock held */
+static void
+SDL_EVDEV_handle_events(SDL_evdevlist_item *item, const struct input_event *events, int len)
 {
-    struct input_event events[32];
-    int i, j, len;
-    SDL_evdevlist_item *item;
+    int i, j;
     SDL_Scancode scan_code;
     int mouse_button;
-    SDL_Mouse *mouse;
+    SDL_Mouse *mouse = SDL_GetMouse();
     float norm_x, norm_y;
 
-    if (!_this) {
-        return;
-    }
+    for (i = 0; i < len; ++i) {
+        /* Events are stamped with the time the kernel saw them */
+        SDL_SetEventTimestamp(SDL_EPOLL_GetEventTicks(events[i].time.tv_sec, events[i].time.tv_usec, item->monotonic_time));
 
-#if SDL_USE_LIBUDEV
-    SDL_UDEV_Poll();
-#endif
+        /* special handling for touchscreen, that should eventually be
+           used for all devices */
+        if (item->out_of_sync && item->is_touchscreen &&
+            events[i].type == EV_SYN && events[i].code != SYN_REPORT) {
+            break;
+        }
 
-    mouse = SDL_GetMouse();
+        switch (events[i].type) {
+        case EV_KEY:
+            if (events[i].code >= BTN_MOUSE && events[i].code < BTN_MOUSE + SDL_arraysize(EVDEV_MouseButtons)) {
+                mouse_button = events[i].code - BTN_MOUSE;
+                if (events[i].value == 0) {
+                    SDL_SendMouseButton(mouse->focus, mouse->mouseID, SDL_RELEASED, EVDEV_MouseButtons[mouse_button]);
+                } else if (events[i].value == 1) {
+                    SDL_SendMouseButton(mouse->focus, mouse->mouseID, SDL_PRESSED, EVDEV_MouseButtons[mouse_button]);
+                }
+                break;
+            }
 
-    for (item = _this->first; item != NULL; item = item->next) {
-        while ((len = read(item->fd, events, (sizeof events))) > 0) {
-            len /= sizeof(events[0]);
-            for (i = 0; i < len; ++i) {
-                /* special handling for touchscreen, that should eventually be
-                   used for all devices */
-                if (item->out_of_sync && item->is_touchscreen &&
-                    events[i].type == EV_SYN && events[i].code != SYN_REPORT) {
+            /* Probably keyboard */
+            scan_code = SDL_EVDEV_translate_keycode(events[i].code);
+            if (scan_code != SDL_SCANCODE_UNKNOWN) {
+                if (events[i].value == 0) {
+                    SDL_SendKeyboardKey(SDL_RELEASED, scan_code);
+                } else if (events[i].value == 1 || events[i].value == 2 /* key repeated */) {
+                    SDL_SendKeyboardKey(SDL_PRESSED, scan_code);
+                }
+            }
+            SDL_EVDEV_kbd_keycode(_this->kbd, events[i].code, events[i].value);
+            break;
+        case EV_ABS:
+            switch(events[i].code) {
+            case ABS_MT_SLOT:
+                if (!item->is_touchscreen) /* FIXME: temp hack */
                     break;
+                item->touchscreen_data->current_slot = events[i].value;
+                break;
+            case ABS_MT_TRACKING_ID:
+                if (!item->is_touchscreen) /* FIXME: temp hack */
+                    break;
+                if (events[i].value >= 0) {
+                    item->touchscreen_data->slots[item->touchscreen_data->current_slot].tracking_id = events[i].value;
+                    item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_DOWN;
+                } else {
+                    item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_UP;
                 }
-
-                switch (events[i].type) {
-                case EV_KEY:
-                    if (events[i].code >= BTN_MOUSE && events[i].code < BTN_MOUSE + SDL_arraysize(EVDEV_MouseButtons)) {
-                        mouse_button = events[i].code - BTN_MOUSE;
-                        if (events[i].value == 0) {
-                            SDL_SendMouseButton(mouse->focus, mouse->mouseID, SDL_RELEASED, EVDEV_MouseButtons[mouse_button]);
-                        } else if (events[i].value == 1) {
-                            SDL_SendMouseButton(mouse->focus, mouse->mouseID, SDL_PRESSED, EVDEV_MouseButtons[mouse_button]);
-                        }
-                        break;
-                    }
-
-                    /* Probably keyboard */
-                    scan_code = SDL_EVDEV_translate_keycode(events[i].code);
-                    if (scan_code != SDL_SCANCODE_UNKNOWN) {
-                        if (events[i].value == 0) {
-                            SDL_SendKeyboardKey(SDL_RELEASED, scan_code);
-                        } else if (events[i].value == 1 || events[i].value == 2 /* key repeated */) {
-                            SDL_SendKeyboardKey(SDL_PRESSED, scan_code);
-                        }
-                    }
-                    SDL_EVDEV_kbd_keycode(_this->kbd, events[i].code, events[i].value);
+                break;
+            case ABS_MT_POSITION_X:
+                if (!item->is_touchscreen) /* FIXME: temp hack */
                     break;
-                case EV_ABS:
-                    switch(events[i].code) {
-                    case ABS_MT_SLOT:
-                        if (!item->is_touchscreen) /* FIXME: temp hack */
-                            break;
-                        item->touchscreen_data->current_slot = events[i].value;
-                        break;
-                    case ABS_MT_TRACKING_ID:
-                        if (!item->is_touchscreen) /* FIXME: temp hack */
-                            break;
-                        if (events[i].value >= 0) {
-                            item->touchscreen_data->slots[item->touchscreen_data->current_slot].tracking_id = events[i].value;
-                            item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_DOWN;
-                        } else {
-                            item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_UP;
-                        }
-                        break;
-                    case ABS_MT_POSITION_X:
-                        if (!item->is_touchscreen) /* FIXME: temp hack */
-                            break;
-                        item->touchscreen_data->slots[item->touchscreen_data->current_slot].x = events[i].value;
-                        if (item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta == EVDEV_TOUCH_SLOTDELTA_NONE) {
-                            item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_MOVE;
-                        }
-                        break;
-                    case ABS_MT_POSITION_Y:
-                        if (!item->is_touchscreen) /* FIXME: temp hack */
-                            break;
-                        item->touchscreen_data->slots[item->touchscreen_data->current_slot].y = events[i].value;
-                        if (item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta == EVDEV_TOUCH_SLOTDELTA_NONE) {
-                            item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_MOVE;
-                        }
-                        break;
-                    case ABS_X:
-                        if (item->is_touchscreen) /* FIXME: temp hack */
-                            break;
-                        SDL_SendMouseMotion(mouse->focus, mouse->mouseID, SDL_FALSE, events[i].value, mouse->y);
-                        break;
-                    case ABS_Y:
-                        if (item->is_touchscreen) /* FIXME: temp hack */
-                            break;
-                        SDL_SendMouseMotion(mouse->focus, mouse->mouseID, SDL_FALSE, mouse->x, events[i].value);
-                        break;
-                    default:
-                        break;
-                    }
+                item->touchscreen_data->slots[item->touchscreen_data->current_slot].x = events[i].value;
+                if (item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta == EVDEV_TOUCH_SLOTDELTA_NONE) {
+                    item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_MOVE;
+                }
+                break;
+            case ABS_MT_POSITION_Y:
+                if (!item->is_touchscreen) /* FIXME: temp hack */
                     break;
-                case EV_REL:
-                    switch(events[i].code) {
-                    case REL_X:
-                        SDL_SendMouseMotion(mouse->focus, mouse->mouseID, SDL_TRUE, events[i].value, 0);
-                        break;
-                    case REL_Y:
-                        SDL_SendMouseMotion(mouse->focus, mouse->mouseID, SDL_TRUE, 0, events[i].value);
-                        break;
-                    case REL_WHEEL:
-                        SDL_SendMouseWheel(mouse->focus, mouse->mouseID, 0, events[i].value, SDL_MOUSEWHEEL_NORMAL);
-                        break;
-                    case REL_HWHEEL:
-                        SDL_SendMouseWheel(mouse->focus, mouse->mouseID, events[i].value, 0, SDL_MOUSEWHEEL_NORMAL);
-                        break;
-                    default:
-                        break;
-                    }
+                item->touchscreen_data->slots[item->touchscreen_data->current_slot].y = events[i].value;
+                if (item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta == EVDEV_TOUCH_SLOTDELTA_NONE) {
+                    item->touchscreen_data->slots[item->touchscreen_data->current_slot].delta = EVDEV_TOUCH_SLOTDELTA_MOVE;
+                }
+                break;
+            case ABS_X:
+                if (item->is_touchscreen) /* FIXME: temp hack */
+                    break;
+                SDL_SendMouseMotion(mouse->focus, mouse->mouseID, SDL_FALSE, events[i].value, mouse->y);
+                break;
+            case ABS_Y:
+                if (item->is_touchscreen) /* FIXME: temp hack */
+                    break;
+                SDL_SendMouseMotion(mouse->focus, mouse->mouseID, SDL_FALSE, mouse->x, events[i].value);
+                break;
+            default:
+                break;
+            }
+            break;
+        case EV_REL:
+            switch(events[i].code) {
+            case REL_X:
+                SDL_SendMouseMotion(mouse->focus, mouse->mouseID, SDL_TRUE, events[i].value, 0);
+                break;
+            case REL_Y:
+                SDL_SendMouseMotion(mouse->focus, mouse->mouseID, SDL_TRUE, 0, events[i].value);
+                break;
+            case REL_WHEEL:
+                SDL_SendMouseWheel(mouse->focus, mouse->mouseID, 0, events[i].value, SDL_MOUSEWHEEL_NORMAL);
+                break;
+            case REL_HWHEEL:
+                SDL_SendMouseWheel(mouse->focus, mouse->mouseID, events[i].value, 0, SDL_MOUSEWHEEL_NORMAL);
+                break;
+            default:
+                break;
+            }
+            break;
+        case EV_SYN:
+            switch (events[i].code) {
+            case SYN_REPORT:
+                if (!item->is_touchscreen) /* FIXME: temp hack */
                     break;
-                case EV_SYN:
-                    switch (events[i].code) {
-                    case SYN_REPORT:
-                        if (!item->is_touchscreen) /* FIXME: temp hack */
-                            break;
-
-                        for(j = 0; j < item->touchscreen_data->max_slots; j++) {
-                            norm_x = (float)(item->touchscreen_data->slots[j].x - item->touchscreen_data->min_x) /
-                                (float)item->touchscreen_data->range_x;
-                            norm_y = (float)(item->touchscreen_data->slots[j].y - item->touchscreen_data->min_y) /
-                                (float)item->touchscreen_data->range_y;
-
-                            switch(item->touchscreen_data->slots[j].delta) {
-                            case EVDEV_TOUCH_SLOTDELTA_DOWN:
-                                SDL_SendTouch(item->fd, item->touchscreen_data->slots[j].tracking_id, SDL_TRUE, norm_x, norm_y, 1.0f);
-                                item->touchscreen_data->slots[j].delta = EVDEV_TOUCH_SLOTDELTA_NONE;
-                                break;
-                            case EVDEV_TOUCH_SLOTDELTA_UP:
-                                SDL_SendTouch(item->fd, item->touchscreen_data->slots[j].tracking_id, SDL_FALSE, norm_x, norm_y, 1.0f);
-                                item->touchscreen_data->slots[j].tracking_id = -1;
-                                item->touchscreen_data->slots[j].delta = EVDEV_TOUCH_SLOTDELTA_NONE;
-                                break;
-                            case EVDEV_TOUCH_SLOTDELTA_MOVE:
-                                SDL_SendTouchMotion(item->fd, item->touchscreen_data->slots[j].tracking_id, norm_x, norm_y, 1.0f);
-                                item->touchscreen_data->slots[j].delta = EVDEV_TOUCH_SLOTDELTA_NONE;
-                                break;
-                            default:
-                                break;
-                            }
-                        }
-
-                        if (item->out_of_sync)
-                            item->out_of_sync = 0;
+
+                for(j = 0; j < item->touchscreen_data->max_slots; j++) {
+                    norm_x = (float)(item->touchscreen_data->slots[j].x - item->touchscreen_data->min_x) /
+                        (float)item->touchscreen_data->range_x;
+                    norm_y = (float)(item->touchscreen_data->slots[j].y - item->touchscreen_data->min_y) /
+                        (float)item->touchscreen_data->range_y;
+
+                    switch(item->touchscreen_data->slots[j].delta) {
+                    case EVDEV_TOUCH_SLOTDELTA_DOWN:
+                        SDL_SendTouch(item->fd, item->touchscreen_data->slots[j].tracking_id, SDL_TRUE, norm_x, norm_y, 1.0f);
+                        item->touchscreen_data->slots[j].delta = EVDEV_TOUCH_SLOTDELTA_NONE;
                         break;
-                    case SYN_DROPPED:
-                        if (item->is_touchscreen)
-                            item->out_of_sync = 1;
-                        SDL_EVDEV_sync_device(item);
+                    case EVDEV_TOUCH_SLOTDELTA_UP:
+                        SDL_SendTouch(item->fd, item->touchscreen_data->slots[j].tracking_id, SDL_FALSE, norm_x, norm_y, 1.0f);
+                        item->touchscreen_data->slots[j].tracking_id = -1;
+                        item->touchscreen_data->slots[j].delta = EVDEV_TOUCH_SLOTDELTA_NONE;
+                        break;
+                    case EVDEV_TOUCH_SLOTDELTA_MOVE:
+                        SDL_SendTouchMotion(item->fd, item->touchscreen_data->slots[j].tracking_id, norm_x, norm_y, 1.0f);
+                        item->touchscreen_data->slots[j].delta = EVDEV_TOUCH_SLOTDELTA_NONE;
                         break;
                     default:
                         break;
                     }
-                    break;
                 }
+
+                if (item->out_of_sync)
+                    item->out_of_sync = 0;
+                break;
+            case SYN_DROPPED:
+                if (item->is_touchscreen)
+                    item->out_of_sync = 1;
+                SDL_EVDEV_sync_device(item);
+                break;
+            default:
+                break;
+            }
+            break;
+        }
+    }
+    SDL_SetEventTimestamp(0);
+}
+
+/* Read everything a device has queued, called with the lock held */
+static void
+SDL_EVDEV_read_device(SDL_evdevlist_item *item)
+{
+    struct input_event events[32];
+    int len;
+
+    while ((len = read(item->fd, events, (sizeof events))) > 0) {
+        SDL_EVDEV_handle_events(item, events, len / sizeof(events[0]));
+    }
+}
+
+/* Read everything a device has queued into its buffer, called with the
+   lock held. Mouse, keyboard and touch state belong to the thread pumping
+   events, so the events are handled there by SDL_EVDEV_Poll(). */
+static void
+SDL_EVDEV_queue_device(SDL_evdevlist_item *item)
+{
+    struct input_event *queued;
+    int max_queued;
+    int len;
+
+    for ( ; ; ) {
+        if (item->num_queued == item->max_queued) {
+            max_queued = item->max_queued ? item->max_queued * 2 : 64;
+            queued = NULL;
+            if (max_queued <= EVDEV_MAX_QUEUED_EVENTS) {
+                queued = (struct input_event *) SDL_realloc(item->queued, max_queued * sizeof(*queued));
+            }
+            if (queued) {
+                item->queued = queued;
+                item->max_queued = max_queued;
+            } else if (item->num_queued > 0) {
+                /* The application isn't pumping events, so drop what's
+                   buffered and resync, as the kernel does when its own
+                   buffer fills up */
+                item->queued[0].time = item->queued[item->num_queued - 1].time;
+                item->queued[0].type = EV_SYN;
+                item->queued[0].code = SYN_DROPPED;
+                item->queued[0].value = 0;
+                item->num_queued = 1;
+            } else {
+                return;
             }
-        }    
+        }
+
+        len = read(item->fd, &item->queued[item->num_queued],
+                   (item->max_queued - item->num_queued) * sizeof(*item->queued));
+        if (len <= 0) {
+            return;
+        }
+        item->num_queued += len / sizeof(*item->queued);
+    }
+}
+
+/* Called on the input thread when a device has input */
+static void
+SDL_EVDEV_dispatch(SDL_EPOLL_Source *source)
+{
+    while (SDL_TryLockMutex(_this->lock) != 0) {
+        if (!SDL_EPOLL_CanDispatch(source)) {
+            return;
+        }
+        SDL_Delay(0);
+    }
+    SDL_EVDEV_queue_device((SDL_evdevlist_item *) source->data);
+    SDL_UnlockMutex(_this->lock);
+}
+
+void 
+SDL_EVDEV_Poll(void)
+{
+    SDL_evdevlist_item *item;
+
+    if (!_this) {
+        return;
+    }
+
+    /* One system call to find the devices with input, instead of a read of each one */
+    SDL_EPOLL_Poll();
+
+#if SDL_USE_LIBUDEV
+    SDL_UDEV_Poll();
+#endif
+
+    SDL_LockMutex(_this->lock);
+    for (item = _this->first; item != NULL; item = item->next) {
+        if (item->num_queued > 0) {
+            SDL_EVDEV_handle_events(item, item->queued, item->num_queued);
+            item->num_queued = 0;
+        }
+        if (SDL_EPOLL_TakeReady(&item->source)) {
+            SDL_EVDEV_read_device(item);
+        }
     }
+    SDL_UnlockMutex(_this->lock);
 }
 
 static SDL_Scancode
@@ -406,7 +537,6 @@ SDL_EVDEV_translate_keycode(int keycode)
     return scancode;
 }
 
-#ifdef SDL_USE_LIBUDEV
 static int
 SDL_EVDEV_init_touchscreen(SDL_evdevlist_item* item)
 {
@@ -485,7 +615,6 @@ SDL_EVDEV_init_touchscreen(SDL_evdevlist_item* item)
 
     return 0;
 }
-#endif /* SDL_USE_LIBUDEV */
 
 static void
 SDL_EVDEV_destroy_touchscreen(SDL_evdevlist_item* item) {
@@ -605,9 +734,8 @@ SDL_EVDEV_sync_device(SDL_evdevlist_item *item)
 #endif /* EVIOCGMTSLOTS */
 }
 
-#if SDL_USE_LIBUDEV
 static int
-SDL_EVDEV_device_added(const char *dev_path, int udev_class)
+SDL_EVDEV_device_added(const char *dev_path, SDL_bool is_touchscreen)
 {
     int ret;
     SDL_evdevlist_item *item;
@@ -637,7 +765,7 @@ SDL_EVDEV_device_added(const char *dev_path, int udev_class)
         return SDL_OutOfMemory();
     }
 
-    if (udev_class & SDL_UDEV_DEVICE_TOUCHSCREEN) {
+    if (is_touchscreen) {
         item->is_touchscreen = 1;
 
         if ((ret = SDL_EVDEV_init_touchscreen(item)) < 0) {
@@ -655,10 +783,41 @@ SDL_EVDEV_device_added(const char *dev_path, int udev_class)
     }
 
     SDL_EVDEV_sync_device(item);
+    item->monotonic_time = SDL_EPOLL_SetMonotonicEventTime(item->fd);
+    SDL_EPOLL_AddSource(&item->source, item->fd, SDL_EVDEV_dispatch, item);
 
     return _this->num_devices++;
 }
-#endif /* SDL_USE_LIBUDEV */
+
+static void
+SDL_EVDEV_add_hint_devices(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_EVDEV_DEVICES);
+    char *paths, *path, *next;
+
+    if (!hint || !*hint) {
+        return;
+    }
+
+    paths = SDL_strdup(hint);
+    if (!paths) {
+        return;
+    }
+
+    SDL_LockMutex(_this->lock);
+    for (path = paths; path; path = next) {
+        next = SDL_strchr(path, ':');
+        if (next) {
+            *next++ = '\0';
+        }
+        if (*path) {
+            SDL_EVDEV_device_added(path, SDL_FALSE);
+        }
+    }
+    SDL_UnlockMutex(_this->lock);
+
+    SDL_free(paths);
+}
 
 static int
 SDL_EVDEV_device_removed(const char *dev_path)
@@ -678,10 +837,12 @@ SDL_EVDEV_device_removed(const char *dev_path)
             if (item == _this->last) {
                 _this->last = prev;
             }
+            SDL_EPOLL_RemoveSource(&item->source);
             if (item->is_touchscreen) {
                 SDL_EVDEV_destroy_touchscreen(item);
             }
             close(item->fd);
+            SDL_free(item->queued);
             SDL_free(item->path);
             SDL_free(item);
             _this->num_devices--;
@@ -30,6 +30,7 @@
 #ifdef SDL_USE_LIBUDEV
 
 #include <linux/input.h>
+#include <sys/stat.h>
 
 #include "SDL_assert.h"
 #include "SDL_loadso.h"
@@ -119,6 +120,8 @@ SDL_UDEV_Init(void)
         if(_this == NULL) {
             return SDL_OutOfMemory();
         }
+        _this->udev_mon_source.fd = -1;
+        SDL_EPOLL_Init();
         
         retval = SDL_UDEV_LoadLibrary();
         if (retval < 0) {
@@ -127,7 +130,8 @@ SDL_UDEV_Init(void)
         }
         
         /* Set up udev monitoring 
-         * Listen for input devices (mouse, keyboard, joystick, etc) and sound devices
+         * Listen for input devices (mouse, keyboard, joystick, etc) and sound devices,
+         * and for raw HID and USB devices so HIDAPI can follow hotplug without rescanning
          */
         
         _this->udev = _this->syms.udev_new();
@@ -144,7 +148,10 @@ SDL_UDEV_Init(void)
         
         _this->syms.udev_monitor_filter_add_match_subsystem_devtype(_this->udev_mon, "input", NULL);
         _this->syms.udev_monitor_filter_add_match_subsystem_devtype(_this->udev_mon, "sound", NULL);
+        _this->syms.udev_monitor_filter_add_match_subsystem_devtype(_this->udev_mon, "hidraw", NULL);
+        _this->syms.udev_monitor_filter_add_match_subsystem_devtype(_this->udev_mon, "usb", "usb_device");
         _this->syms.udev_monitor_enable_receiving(_this->udev_mon);
+        SDL_EPOLL_AddSource(&_this->udev_mon_source, _this->syms.udev_monitor_get_fd(_this->udev_mon), NULL, NULL);
         
         /* Do an initial scan of existing devices */
         SDL_UDEV_Scan();
@@ -170,6 +177,7 @@ SDL_UDEV_Quit(void)
     if (_this->ref_count < 1) {
         
         if (_this->udev_mon != NULL) {
+            SDL_EPOLL_RemoveSource(&_this->udev_mon_source);
             _this->syms.udev_monitor_unref(_this->udev_mon);
             _this->udev_mon = NULL;
         }
@@ -186,6 +194,7 @@ SDL_UDEV_Quit(void)
         }
         
         SDL_UDEV_UnloadLibrary();
+        SDL_EPOLL_Quit();
         SDL_free(_this);
         _this = NULL;
     }
@@ -460,6 +469,10 @@ device_event(SDL_UDEV_deviceevent type, struct udev_device *dev)
                 devclass = guess_device_class(dev);
             }
         }
+    } else if (SDL_strcmp(subsystem, "hidraw") == 0) {
+        devclass = SDL_UDEV_DEVICE_HIDRAW;
+    } else if (SDL_strcmp(subsystem, "usb") == 0) {
+        devclass = SDL_UDEV_DEVICE_USB;
     } else {
         return;
     }
@@ -480,6 +493,12 @@ SDL_UDEV_Poll(void)
         return;
     }
 
+    /* The monitor is in the shared epoll set, so there's nothing to check
+       unless the last SDL_EPOLL_Poll() saw it become readable */
+    if (!SDL_EPOLL_TakeReady(&_this->udev_mon_source)) {
+        return;
+    }
+
     while (SDL_UDEV_hotplug_update_available()) {
         dev = _this->syms.udev_monitor_receive_device(_this->udev_mon);
         if (dev == NULL) {
@@ -488,8 +507,13 @@ SDL_UDEV_Poll(void)
         action = _this->syms.udev_device_get_action(dev);
 
         if (SDL_strcmp(action, "add") == 0) {
-            /* Wait for the device to finish initialization */
-            SDL_Delay(100);
+            const char *subsystem = _this->syms.udev_device_get_subsystem(dev);
+
+            /* Wait for the device to finish initialization. Raw HID and USB
+               devices are only enumerated by HIDAPI afterwards, so they don't need to. */
+            if (SDL_strcmp(subsystem, "hidraw") != 0 && SDL_strcmp(subsystem, "usb") != 0) {
+                SDL_Delay(100);
+            }
 
             device_event(SDL_UDEV_DEVICEADDED, dev);
         } else if (SDL_strcmp(action, "remove") == 0) {
@@ -547,6 +571,50 @@ SDL_UDEV_DelCallback(SDL_UDEV_Callback cb)
     
 }
 
+int
+SDL_UDEV_GetProductInfo(const char *devpath, Uint16 *vendor, Uint16 *product)
+{
+    struct stat statbuf;
+    struct udev_device *dev;
+    struct udev_device *parent;
+    const char *val;
+    unsigned int bus, vendor_id, product_id;
+    int retval = -1;
+
+    if (_this == NULL) {
+        return SDL_SetError("udev isn't initialized");
+    }
+    if (stat(devpath, &statbuf) < 0 || !S_ISCHR(statbuf.st_mode)) {
+        return SDL_SetError("Couldn't find device node %s", devpath);
+    }
+
+    dev = _this->syms.udev_device_new_from_devnum(_this->udev, 'c', statbuf.st_rdev);
+    if (dev == NULL) {
+        return SDL_SetError("Couldn't find udev device for %s", devpath);
+    }
+
+    /* Raw HID nodes hang off a hid device with HID_ID=bus:vendor:product,
+       USB device nodes carry PRODUCT=vendor/product/version themselves */
+    parent = _this->syms.udev_device_get_parent_with_subsystem_devtype(dev, "hid", NULL);
+    val = parent ? _this->syms.udev_device_get_property_value(parent, "HID_ID") : NULL;
+    if (val != NULL && SDL_sscanf(val, "%x:%x:%x", &bus, &vendor_id, &product_id) == 3) {
+        retval = 0;
+    } else {
+        val = _this->syms.udev_device_get_property_value(dev, "PRODUCT");
+        if (val != NULL && SDL_sscanf(val, "%x/%x", &vendor_id, &product_id) == 2) {
+            retval = 0;
+        }
+    }
+    _this->syms.udev_device_unref(dev);
+
+    if (retval < 0) {
+        return SDL_SetError("Couldn't get the product of %s", devpath);
+    }
+    *vendor = (Uint16)vendor_id;
+    *product = (Uint16)product_id;
+    return 0;
+}
+
 const SDL_UDEV_Symbols *
 SDL_UDEV_GetUdevSyms(void)
 {
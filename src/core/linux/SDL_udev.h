@@ -32,6 +32,7 @@
 
 #include "SDL_loadso.h"
 #include "SDL_events.h"
+#include "SDL_epoll.h"
 #include <libudev.h>
 #include <sys/time.h>
 #include <sys/types.h>
@@ -54,7 +55,9 @@ typedef enum
     SDL_UDEV_DEVICE_KEYBOARD    = 0x0002,
     SDL_UDEV_DEVICE_JOYSTICK    = 0x0004,
     SDL_UDEV_DEVICE_SOUND       = 0x0008,
-    SDL_UDEV_DEVICE_TOUCHSCREEN = 0x0010
+    SDL_UDEV_DEVICE_TOUCHSCREEN = 0x0010,
+    SDL_UDEV_DEVICE_HIDRAW      = 0x0020,
+    SDL_UDEV_DEVICE_USB         = 0x0040
 } SDL_UDEV_deviceclass;
 
 typedef void (*SDL_UDEV_Callback)(SDL_UDEV_deviceevent udev_type, int udev_class, const char *devpath);
@@ -99,6 +102,7 @@ typedef struct SDL_UDEV_PrivateData
     void *udev_handle;
     struct udev *udev;
     struct udev_monitor *udev_mon;
+    SDL_EPOLL_Source udev_mon_source;
     int ref_count;
     SDL_UDEV_CallbackList *first, *last;
     
@@ -114,6 +118,7 @@ extern void SDL_UDEV_Poll(void);
 extern void SDL_UDEV_Scan(void);
 extern int SDL_UDEV_AddCallback(SDL_UDEV_Callback cb);
 extern void SDL_UDEV_DelCallback(SDL_UDEV_Callback cb);
+extern int SDL_UDEV_GetProductInfo(const char *devpath, Uint16 *vendor, Uint16 *product);
 extern const SDL_UDEV_Symbols *SDL_UDEV_GetUdevSyms(void);
 extern void SDL_UDEV_ReleaseUdevSyms(void);
 
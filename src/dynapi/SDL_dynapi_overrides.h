@@ -701,3 +701,50 @@
 #define SDL_JoystickGetDevicePlayerIndex SDL_JoystickGetDevicePlayerIndex_REAL
 #define SDL_JoystickGetPlayerIndex SDL_JoystickGetPlayerIndex_REAL
 #define SDL_GameControllerGetPlayerIndex SDL_GameControllerGetPlayerIndex_REAL
+#define SDL_SetAllocationTracking SDL_SetAllocationTracking_REAL
+#define SDL_ResetAllocationStats SDL_ResetAllocationStats_REAL
+#define SDL_GetAllocationStats SDL_GetAllocationStats_REAL
+#define SDL_GetAllocationSites SDL_GetAllocationSites_REAL
+#define SDL_MarkAllocationFrame SDL_MarkAllocationFrame_REAL
+#define SDL_RWFromFileMapped SDL_RWFromFileMapped_REAL
+#define SDL_RWFromBuffered SDL_RWFromBuffered_REAL
+#define SDL_RWGetMemory SDL_RWGetMemory_REAL
+#define SDL_LoadFileAsync SDL_LoadFileAsync_REAL
+#define SDL_RWReadAsync SDL_RWReadAsync_REAL
+#define SDL_GetAsyncIOStatus SDL_GetAsyncIOStatus_REAL
+#define SDL_WaitAsyncIO SDL_WaitAsyncIO_REAL
+#define SDL_GetAsyncIOData SDL_GetAsyncIOData_REAL
+#define SDL_FreeAsyncIO SDL_FreeAsyncIO_REAL
+#define SDL_SetFrameSinkCallback SDL_SetFrameSinkCallback_REAL
+#define SDL_GetJobWorkerCount SDL_GetJobWorkerCount_REAL
+#define SDL_CreateJobCounter SDL_CreateJobCounter_REAL
+#define SDL_GetJobCounterValue SDL_GetJobCounterValue_REAL
+#define SDL_DestroyJobCounter SDL_DestroyJobCounter_REAL
+#define SDL_RunJob SDL_RunJob_REAL
+#define SDL_RunJobAfter SDL_RunJobAfter_REAL
+#define SDL_WaitJobCounter SDL_WaitJobCounter_REAL
+#define SDL_ParallelFor SDL_ParallelFor_REAL
+#define SDL_CreateRWLock SDL_CreateRWLock_REAL
+#define SDL_LockRWLockForReading SDL_LockRWLockForReading_REAL
+#define SDL_LockRWLockForWriting SDL_LockRWLockForWriting_REAL
+#define SDL_TryLockRWLockForReading SDL_TryLockRWLockForReading_REAL
+#define SDL_TryLockRWLockForWriting SDL_TryLockRWLockForWriting_REAL
+#define SDL_UnlockRWLock SDL_UnlockRWLock_REAL
+#define SDL_DestroyRWLock SDL_DestroyRWLock_REAL
+#define SDL_CreateAtomicQueue SDL_CreateAtomicQueue_REAL
+#define SDL_AtomicQueuePush SDL_AtomicQueuePush_REAL
+#define SDL_AtomicQueuePop SDL_AtomicQueuePop_REAL
+#define SDL_DestroyAtomicQueue SDL_DestroyAtomicQueue_REAL
+#define SDL_AudioStreamPreallocate SDL_AudioStreamPreallocate_REAL
+#define SDL_GetAudioDeviceLatency SDL_GetAudioDeviceLatency_REAL
+#define SDL_GetAudioDeviceTimestamp SDL_GetAudioDeviceTimestamp_REAL
+#define SDL_GetEventHistory SDL_GetEventHistory_REAL
+#define SDL_ProfileBeginZone SDL_ProfileBeginZone_REAL
+#define SDL_ProfileEndZone SDL_ProfileEndZone_REAL
+#define SDL_ProfileCounter SDL_ProfileCounter_REAL
+#define SDL_ProfileFrame SDL_ProfileFrame_REAL
+#define SDL_SetProfileCallback SDL_SetProfileCallback_REAL
+#define SDL_FlushProfile SDL_FlushProfile_REAL
+#define SDL_GetRenderStats SDL_GetRenderStats_REAL
+#define SDL_GetRenderStatsHistory SDL_GetRenderStatsHistory_REAL
+#define SDL_GetAllocationTracking SDL_GetAllocationTracking_REAL
@@ -755,3 +755,50 @@ SDL_DYNAPI_PROC(SDL_Thread*,SDL_CreateThreadWithStackSize,(SDL_ThreadFunction a,
 SDL_DYNAPI_PROC(int,SDL_JoystickGetDevicePlayerIndex,(int a),(a),return)
 SDL_DYNAPI_PROC(int,SDL_JoystickGetPlayerIndex,(SDL_Joystick *a),(a),return)
 SDL_DYNAPI_PROC(int,SDL_GameControllerGetPlayerIndex,(SDL_GameController *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_SetAllocationTracking,(SDL_bool a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_ResetAllocationStats,(void),(),)
+SDL_DYNAPI_PROC(void,SDL_GetAllocationStats,(SDL_AllocationStats *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_GetAllocationSites,(SDL_AllocationSite *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_MarkAllocationFrame,(void),(),)
+SDL_DYNAPI_PROC(SDL_RWops*,SDL_RWFromFileMapped,(const char *a),(a),return)
+SDL_DYNAPI_PROC(SDL_RWops*,SDL_RWFromBuffered,(SDL_RWops *a, size_t b, SDL_bool c),(a,b,c),return)
+SDL_DYNAPI_PROC(const void*,SDL_RWGetMemory,(SDL_RWops *a, size_t *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_AsyncIO*,SDL_LoadFileAsync,(const char *a, int b, SDL_AsyncIOCallback c, void *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_AsyncIO*,SDL_RWReadAsync,(SDL_RWops *a, void *b, size_t c, size_t d, int e, SDL_AsyncIOCallback f, void *g),(a,b,c,d,e,f,g),return)
+SDL_DYNAPI_PROC(SDL_AsyncIOStatus,SDL_GetAsyncIOStatus,(SDL_AsyncIO *a),(a),return)
+SDL_DYNAPI_PROC(SDL_AsyncIOStatus,SDL_WaitAsyncIO,(SDL_AsyncIO *a),(a),return)
+SDL_DYNAPI_PROC(void*,SDL_GetAsyncIOData,(SDL_AsyncIO *a, size_t *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_FreeAsyncIO,(SDL_AsyncIO *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_SetFrameSinkCallback,(SDL_FrameSinkCallback a, void *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetJobWorkerCount,(void),(),return)
+SDL_DYNAPI_PROC(SDL_JobCounter*,SDL_CreateJobCounter,(void),(),return)
+SDL_DYNAPI_PROC(int,SDL_GetJobCounterValue,(SDL_JobCounter *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyJobCounter,(SDL_JobCounter *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_RunJob,(SDL_JobFunction a, void *b, SDL_JobCounter *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_RunJobAfter,(SDL_JobFunction a, void *b, SDL_JobCounter *c, SDL_JobCounter *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(void,SDL_WaitJobCounter,(SDL_JobCounter *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_ParallelFor,(int a, int b, int c, SDL_ParallelForFunction d, void *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(SDL_rwlock*,SDL_CreateRWLock,(void),(),return)
+SDL_DYNAPI_PROC(int,SDL_LockRWLockForReading,(SDL_rwlock *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_LockRWLockForWriting,(SDL_rwlock *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_TryLockRWLockForReading,(SDL_rwlock *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_TryLockRWLockForWriting,(SDL_rwlock *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_UnlockRWLock,(SDL_rwlock *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyRWLock,(SDL_rwlock *a),(a),)
+SDL_DYNAPI_PROC(SDL_AtomicQueue*,SDL_CreateAtomicQueue,(int a),(a),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_AtomicQueuePush,(SDL_AtomicQueue *a, void *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_AtomicQueuePop,(SDL_AtomicQueue *a, void **b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyAtomicQueue,(SDL_AtomicQueue *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_AudioStreamPreallocate,(SDL_AudioStream *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetAudioDeviceLatency,(SDL_AudioDeviceID a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetAudioDeviceTimestamp,(SDL_AudioDeviceID a, Uint64 *b, Uint64 *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_GetEventHistory,(SDL_Event *a, int b, Uint32 c, Uint32 d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(void,SDL_ProfileBeginZone,(const char *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_ProfileEndZone,(const char *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_ProfileCounter,(const char *a, Sint64 b),(a,b),)
+SDL_DYNAPI_PROC(void,SDL_ProfileFrame,(void),(),)
+SDL_DYNAPI_PROC(int,SDL_SetProfileCallback,(SDL_ProfileCallback a, void *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_FlushProfile,(void),(),return)
+SDL_DYNAPI_PROC(int,SDL_GetRenderStats,(SDL_Renderer *a, SDL_RenderStats *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_GetRenderStatsHistory,(SDL_Renderer *a, SDL_RenderStats *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_GetAllocationTracking,(void),(),return)
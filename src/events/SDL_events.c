@@ -27,6 +27,7 @@
 #include "SDL_thread.h"
 #include "SDL_events_c.h"
 #include "../timer/SDL_timer_c.h"
+#include "../SDL_profile_c.h"
 #if !SDL_JOYSTICK_DISABLED
 #include "../joystick/SDL_joystick_c.h"
 #endif
@@ -38,6 +39,9 @@
 /* An arbitrary limit so we don't have unbounded growth */
 #define SDL_MAX_QUEUED_EVENTS   65535
 
+/* The number of raw motion events kept for SDL_GetEventHistory() */
+#define SDL_MAX_EVENT_HISTORY   4096
+
 typedef struct SDL_EventWatcher {
     SDL_EventFilter callback;
     void *userdata;
@@ -58,6 +62,12 @@ typedef struct {
 static SDL_DisabledEventBlock *SDL_disabled_events[256];
 static Uint32 SDL_userevents = SDL_USEREVENT;
 
+/* Per thread timestamp for pushed events, see SDL_SetEventTimestamp() */
+static SDL_TLSID SDL_event_timestamp_tls = 0;
+
+/* Whether motion events are merged in the queue, see SDL_HINT_EVENT_COALESCING */
+static SDL_bool SDL_event_coalescing = SDL_FALSE;
+
 /* Private data -- event queue */
 typedef struct _SDL_EventEntry
 {
@@ -84,7 +94,11 @@ static struct
     SDL_EventEntry *free;
     SDL_SysWMEntry *wmmsg_used;
     SDL_SysWMEntry *wmmsg_free;
-} SDL_EventQ = { NULL, { 1 }, { 0 }, 0, NULL, NULL, NULL, NULL, NULL };
+    SDL_EventEntry *history_head;
+    SDL_EventEntry *history_tail;
+    int history_count;
+    int coalesced_events;
+} SDL_EventQ = { NULL, { 1 }, { 0 }, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0, 0 };
 
 
 #ifdef SDL_DEBUG_EVENTS
@@ -311,6 +325,16 @@ SDL_DebugPrintEvent(const SDL_Event *event)
 
 
 
+static void SDLCALL
+SDL_EventCoalescingChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    if (hint && (*hint == '1' || SDL_strcasecmp(hint, "true") == 0)) {
+        SDL_event_coalescing = SDL_TRUE;
+    } else {
+        SDL_event_coalescing = SDL_FALSE;
+    }
+}
+
 /* Public functions */
 
 void
@@ -330,6 +354,8 @@ SDL_StopEventLoop(void)
     if (report && SDL_atoi(report)) {
         SDL_Log("SDL EVENT QUEUE: Maximum events in-flight: %d\n",
                 SDL_EventQ.max_events_seen);
+        SDL_Log("SDL EVENT QUEUE: Motion events coalesced: %d\n",
+                SDL_EventQ.coalesced_events);
     }
 
     /* Clean out EventQ */
@@ -338,6 +364,11 @@ SDL_StopEventLoop(void)
         SDL_free(entry);
         entry = next;
     }
+    for (entry = SDL_EventQ.history_head; entry; ) {
+        SDL_EventEntry *next = entry->next;
+        SDL_free(entry);
+        entry = next;
+    }
     for (entry = SDL_EventQ.free; entry; ) {
         SDL_EventEntry *next = entry->next;
         SDL_free(entry);
@@ -361,6 +392,12 @@ SDL_StopEventLoop(void)
     SDL_EventQ.free = NULL;
     SDL_EventQ.wmmsg_used = NULL;
     SDL_EventQ.wmmsg_free = NULL;
+    SDL_EventQ.history_head = NULL;
+    SDL_EventQ.history_tail = NULL;
+    SDL_EventQ.history_count = 0;
+    SDL_EventQ.coalesced_events = 0;
+
+    SDL_DelHintCallback(SDL_HINT_EVENT_COALESCING, SDL_EventCoalescingChanged, NULL);
 
     /* Clear disabled event state */
     for (i = 0; i < SDL_arraysize(SDL_disabled_events); ++i) {
@@ -413,6 +450,12 @@ SDL_StartEventLoop(void)
     }
 #endif /* !SDL_THREADS_DISABLED */
 
+    if (!SDL_event_timestamp_tls) {
+        SDL_event_timestamp_tls = SDL_TLSCreate();
+    }
+
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCING, SDL_EventCoalescingChanged, NULL);
+
     /* Process most event types */
     SDL_EventState(SDL_TEXTINPUT, SDL_DISABLE);
     SDL_EventState(SDL_TEXTEDITING, SDL_DISABLE);
@@ -428,6 +471,122 @@ SDL_StartEventLoop(void)
 }
 
 
+/* Returns whether events of this type can be merged by coalescing */
+static SDL_bool
+SDL_IsMotionEvent(Uint32 type)
+{
+    switch (type) {
+    case SDL_MOUSEMOTION:
+    case SDL_JOYAXISMOTION:
+    case SDL_JOYBALLMOTION:
+    case SDL_CONTROLLERAXISMOTION:
+    case SDL_FINGERMOTION:
+    case SDL_SENSORUPDATE:
+        return SDL_TRUE;
+    default:
+        return SDL_FALSE;
+    }
+}
+
+/* Returns whether two motion events are from the same device and axis */
+static SDL_bool
+SDL_IsSameMotion(const SDL_Event *a, const SDL_Event *b)
+{
+    if (a->type != b->type) {
+        return SDL_FALSE;
+    }
+
+    switch (a->type) {
+    case SDL_MOUSEMOTION:
+        return (a->motion.windowID == b->motion.windowID && a->motion.which == b->motion.which);
+    case SDL_JOYAXISMOTION:
+        return (a->jaxis.which == b->jaxis.which && a->jaxis.axis == b->jaxis.axis);
+    case SDL_JOYBALLMOTION:
+        return (a->jball.which == b->jball.which && a->jball.ball == b->jball.ball);
+    case SDL_CONTROLLERAXISMOTION:
+        return (a->caxis.which == b->caxis.which && a->caxis.axis == b->caxis.axis);
+    case SDL_FINGERMOTION:
+        return (a->tfinger.touchId == b->tfinger.touchId && a->tfinger.fingerId == b->tfinger.fingerId);
+    case SDL_SENSORUPDATE:
+        return (a->sensor.which == b->sensor.which);
+    default:
+        return SDL_FALSE;
+    }
+}
+
+/* Merge a newer motion event into a queued one, keeping relative motion */
+static void
+SDL_CoalesceEvent(SDL_Event *queued, const SDL_Event *event)
+{
+    switch (event->type) {
+    case SDL_MOUSEMOTION:
+        {
+            const Sint32 xrel = queued->motion.xrel + event->motion.xrel;
+            const Sint32 yrel = queued->motion.yrel + event->motion.yrel;
+            *queued = *event;
+            queued->motion.xrel = xrel;
+            queued->motion.yrel = yrel;
+        }
+        break;
+    case SDL_JOYBALLMOTION:
+        {
+            const int xrel = queued->jball.xrel + event->jball.xrel;
+            const int yrel = queued->jball.yrel + event->jball.yrel;
+            *queued = *event;
+            queued->jball.xrel = (Sint16) SDL_max(SDL_MIN_SINT16, SDL_min(xrel, SDL_MAX_SINT16));
+            queued->jball.yrel = (Sint16) SDL_max(SDL_MIN_SINT16, SDL_min(yrel, SDL_MAX_SINT16));
+        }
+        break;
+    case SDL_FINGERMOTION:
+        {
+            const float dx = queued->tfinger.dx + event->tfinger.dx;
+            const float dy = queued->tfinger.dy + event->tfinger.dy;
+            *queued = *event;
+            queued->tfinger.dx = dx;
+            queued->tfinger.dy = dy;
+        }
+        break;
+    default:
+        /* Axes and sensors report absolute values, the latest wins */
+        *queued = *event;
+        break;
+    }
+}
+
+/* Record a raw motion event for SDL_GetEventHistory() -- called with the queue locked */
+static void
+SDL_AddEventHistory(const SDL_Event *event)
+{
+    SDL_EventEntry *entry;
+
+    if (SDL_EventQ.history_count >= SDL_MAX_EVENT_HISTORY) {
+        /* Reuse the oldest entry */
+        entry = SDL_EventQ.history_head;
+        SDL_EventQ.history_head = entry->next;
+        SDL_EventQ.history_head->prev = NULL;
+        --SDL_EventQ.history_count;
+    } else if (SDL_EventQ.free == NULL) {
+        entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
+        if (!entry) {
+            return;
+        }
+    } else {
+        entry = SDL_EventQ.free;
+        SDL_EventQ.free = entry->next;
+    }
+
+    entry->event = *event;
+    entry->next = NULL;
+    entry->prev = SDL_EventQ.history_tail;
+    if (SDL_EventQ.history_tail) {
+        SDL_EventQ.history_tail->next = entry;
+    } else {
+        SDL_EventQ.history_head = entry;
+    }
+    SDL_EventQ.history_tail = entry;
+    ++SDL_EventQ.history_count;
+}
+
 /* Add an event to the event queue -- called with the queue locked */
 static int
 SDL_AddEvent(SDL_Event * event)
@@ -436,6 +595,20 @@ SDL_AddEvent(SDL_Event * event)
     const int initial_count = SDL_AtomicGet(&SDL_EventQ.count);
     int final_count;
 
+    if (SDL_event_coalescing && SDL_IsMotionEvent(event->type)) {
+        SDL_AddEventHistory(event);
+
+        /* Look for the same motion in the run of motion events at the end
+           of the queue, so it never moves past a button press or the like */
+        for (entry = SDL_EventQ.tail; entry && SDL_IsMotionEvent(entry->event.type); entry = entry->prev) {
+            if (SDL_IsSameMotion(&entry->event, event)) {
+                SDL_CoalesceEvent(&entry->event, event);
+                ++SDL_EventQ.coalesced_events;
+                return 1;
+            }
+        }
+    }
+
     if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
         SDL_SetError("Event queue is full (%d events)", initial_count);
         return 0;
@@ -587,6 +760,52 @@ SDL_PeepEvents(SDL_Event * events, int numevents, SDL_eventaction action,
     return (used);
 }
 
+int
+SDL_GetEventHistory(SDL_Event * events, int numevents, Uint32 minType, Uint32 maxType)
+{
+    SDL_EventEntry *entry, *next;
+    int used = 0;
+
+    if (!events || numevents < 0) {
+        return SDL_InvalidParamError("events");
+    }
+
+    /* Don't look after we've quit */
+    if (!SDL_AtomicGet(&SDL_EventQ.active)) {
+        return SDL_SetError("The event system has been shut down");
+    }
+
+    if (!SDL_EventQ.lock || SDL_LockMutex(SDL_EventQ.lock) == 0) {
+        for (entry = SDL_EventQ.history_head; entry && used < numevents; entry = next) {
+            next = entry->next;
+            if (minType <= entry->event.type && entry->event.type <= maxType) {
+                events[used++] = entry->event;
+
+                if (entry->prev) {
+                    entry->prev->next = entry->next;
+                } else {
+                    SDL_EventQ.history_head = entry->next;
+                }
+                if (entry->next) {
+                    entry->next->prev = entry->prev;
+                } else {
+                    SDL_EventQ.history_tail = entry->prev;
+                }
+                --SDL_EventQ.history_count;
+
+                entry->next = SDL_EventQ.free;
+                SDL_EventQ.free = entry;
+            }
+        }
+        if (SDL_EventQ.lock) {
+            SDL_UnlockMutex(SDL_EventQ.lock);
+        }
+    } else {
+        return SDL_SetError("Couldn't lock event queue");
+    }
+    return used;
+}
+
 SDL_bool
 SDL_HasEvent(Uint32 type)
 {
@@ -648,6 +867,8 @@ SDL_PumpEvents(void)
 {
     SDL_VideoDevice *_this = SDL_GetVideoDevice();
 
+    SDL_PROFILE_ZONE_BEGIN("SDL_PumpEvents");
+
     /* Get events from the video subsystem */
     if (_this) {
         _this->PumpEvents(_this);
@@ -667,6 +888,12 @@ SDL_PumpEvents(void)
 #endif
 
     SDL_SendPendingQuit();  /* in case we had a signal handler fire, etc. */
+
+    SDL_PROFILE_ZONE_END("SDL_PumpEvents");
+    SDL_PROFILE_COUNTER("SDL_EventQueue", SDL_AtomicGet(&SDL_EventQ.count));
+
+    /* Applications that don't mark frames still get their events flushed */
+    SDL_PROFILE_FLUSH();
 }
 
 /* Public functions */
@@ -714,10 +941,23 @@ SDL_WaitEventTimeout(SDL_Event * event, int timeout)
     }
 }
 
+void
+SDL_SetEventTimestamp(Uint32 timestamp)
+{
+    if (SDL_event_timestamp_tls) {
+        SDL_TLSSet(SDL_event_timestamp_tls, (void *) (uintptr_t) timestamp, NULL);
+    }
+}
+
 int
 SDL_PushEvent(SDL_Event * event)
 {
-    event->common.timestamp = SDL_GetTicks();
+    Uint32 timestamp = 0;
+
+    if (SDL_event_timestamp_tls) {
+        timestamp = (Uint32) (uintptr_t) SDL_TLSGet(SDL_event_timestamp_tls);
+    }
+    event->common.timestamp = timestamp ? timestamp : SDL_GetTicks();
 
     if (SDL_EventOK.callback || SDL_event_watchers_count > 0) {
         if (!SDL_event_watchers_lock || SDL_LockMutex(SDL_event_watchers_lock) == 0) {
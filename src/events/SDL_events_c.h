@@ -53,6 +53,11 @@ extern void SDL_QuitQuit(void);
 
 extern void SDL_SendPendingQuit(void);
 
+/* Events pushed by the calling thread get this timestamp instead of the
+   current time, until it is set back to 0. Input backends use this to
+   stamp events with the time the hardware reported them. */
+extern void SDL_SetEventTimestamp(Uint32 timestamp);
+
 #endif /* SDL_events_c_h_ */
 
 /* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,505 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* Asynchronous file loading, serviced by a small pool of I/O threads */
+
+#include "SDL_atomic.h"
+#include "SDL_hints.h"
+#include "SDL_rwops.h"
+#include "SDL_thread.h"
+#include "SDL_asyncio_c.h"
+#include "../thread/SDL_systhread.h"
+
+#define SDL_ASYNCIO_DEFAULT_THREADS 4
+#define SDL_ASYNCIO_MAX_THREADS     64
+
+typedef enum
+{
+    SDL_ASYNCIO_LOADFILE,
+    SDL_ASYNCIO_READ
+} SDL_AsyncIOType;
+
+typedef enum
+{
+    SDL_ASYNCIO_STOPPED,
+    SDL_ASYNCIO_RUNNING,
+    SDL_ASYNCIO_SHUTTING_DOWN
+} SDL_AsyncIOPoolState;
+
+struct SDL_AsyncIO
+{
+    SDL_AsyncIOType type;
+    int priority;
+    char *file;
+    SDL_RWops *src;
+    void *ptr;
+    size_t size;
+    size_t maxnum;
+    SDL_AsyncIOCallback callback;
+    void *userdata;
+
+    /* The status can be read at any time, it's only changed with the pool
+       lock held. The rest of these are protected by the pool lock. */
+    SDL_atomic_t status;
+    SDL_bool finished;
+    void *result;
+    size_t result_size;
+    char error[256];
+    struct SDL_AsyncIO *next;
+};
+
+/* The lock and conditions are created with the first request and kept
+   for the life of the library, so requests can always be locked, even
+   while the threads are being shut down or after they're gone. */
+static struct
+{
+    SDL_SpinLock init_lock;
+    SDL_mutex *lock;
+    SDL_cond *work_cond;
+    SDL_cond *done_cond;
+    SDL_Thread *threads[SDL_ASYNCIO_MAX_THREADS];
+    int num_threads;
+    SDL_AsyncIOPoolState state;
+    SDL_AsyncIO *queue;     /* sorted by priority, highest first */
+    SDL_AsyncIO *running;
+} pool;
+
+
+/* Find the first queued request whose stream isn't being read by another thread */
+static SDL_AsyncIO *
+SDL_TakeAsyncIO(void)
+{
+    SDL_AsyncIO **prev;
+    SDL_AsyncIO *request;
+
+    for (prev = &pool.queue; (request = *prev) != NULL; prev = &request->next) {
+        SDL_bool busy = SDL_FALSE;
+        if (request->src) {
+            SDL_AsyncIO *other;
+            for (other = pool.running; other; other = other->next) {
+                if (other->src == request->src) {
+                    busy = SDL_TRUE;
+                    break;
+                }
+            }
+        }
+        if (!busy) {
+            *prev = request->next;
+            request->next = pool.running;
+            pool.running = request;
+            return request;
+        }
+    }
+    return NULL;
+}
+
+static void
+SDL_FinishAsyncIO(SDL_AsyncIO *request)
+{
+    SDL_AsyncIO **prev;
+
+    for (prev = &pool.running; *prev; prev = &(*prev)->next) {
+        if (*prev == request) {
+            *prev = request->next;
+            break;
+        }
+    }
+    request->next = NULL;
+    request->finished = SDL_TRUE;
+    SDL_CondBroadcast(pool.done_cond);
+
+    /* Requests waiting on this stream can go now */
+    if (request->src) {
+        SDL_CondBroadcast(pool.work_cond);
+    }
+}
+
+static void
+SDL_RunAsyncIO(SDL_AsyncIO *request)
+{
+    void *result = NULL;
+    size_t result_size = 0;
+    SDL_bool failed = SDL_FALSE;
+
+    switch (request->type) {
+    case SDL_ASYNCIO_LOADFILE:
+        result = SDL_LoadFile(request->file, &result_size);
+        failed = result ? SDL_FALSE : SDL_TRUE;
+        break;
+    case SDL_ASYNCIO_READ:
+        result = request->ptr;
+        result_size = SDL_RWread(request->src, request->ptr, request->size, request->maxnum);
+        failed = (result_size == 0 && request->maxnum > 0 && *SDL_GetError()) ? SDL_TRUE : SDL_FALSE;
+        break;
+    }
+
+    SDL_LockMutex(pool.lock);
+    request->result = result;
+    request->result_size = result_size;
+    if (failed) {
+        SDL_strlcpy(request->error, SDL_GetError(), sizeof(request->error));
+        SDL_AtomicSet(&request->status, SDL_ASYNCIO_FAILED);
+    } else {
+        SDL_AtomicSet(&request->status, SDL_ASYNCIO_COMPLETE);
+    }
+    SDL_UnlockMutex(pool.lock);
+}
+
+static int SDLCALL
+SDL_AsyncIOThread(void *data)
+{
+    SDL_LockMutex(pool.lock);
+    while (pool.state == SDL_ASYNCIO_RUNNING) {
+        SDL_AsyncIO *request = SDL_TakeAsyncIO();
+        if (!request) {
+            SDL_CondWait(pool.work_cond, pool.lock);
+            continue;
+        }
+        SDL_UnlockMutex(pool.lock);
+
+        SDL_ClearError();
+        SDL_RunAsyncIO(request);
+        if (request->callback) {
+            request->callback(request->userdata, request);
+        }
+
+        SDL_LockMutex(pool.lock);
+        SDL_FinishAsyncIO(request);
+    }
+    SDL_UnlockMutex(pool.lock);
+    return 0;
+}
+
+static int
+SDL_CreateAsyncIOLock(void)
+{
+    int retval = 0;
+
+    SDL_AtomicLock(&pool.init_lock);
+    if (!pool.lock) {
+        SDL_mutex *lock = SDL_CreateMutex();
+        SDL_cond *work_cond = SDL_CreateCond();
+        SDL_cond *done_cond = SDL_CreateCond();
+        if (lock && work_cond && done_cond) {
+            pool.work_cond = work_cond;
+            pool.done_cond = done_cond;
+            pool.lock = lock;
+        } else {
+            if (lock) {
+                SDL_DestroyMutex(lock);
+            }
+            if (work_cond) {
+                SDL_DestroyCond(work_cond);
+            }
+            if (done_cond) {
+                SDL_DestroyCond(done_cond);
+            }
+            retval = SDL_SetError("Couldn't create asynchronous I/O lock");
+        }
+    }
+    SDL_AtomicUnlock(&pool.init_lock);
+
+    return retval;
+}
+
+/* Start the threads if they aren't running, called with the pool lock held */
+static int
+SDL_InitAsyncIO(void)
+{
+    const char *hint;
+    int i, num_threads = SDL_ASYNCIO_DEFAULT_THREADS;
+
+    if (pool.state == SDL_ASYNCIO_RUNNING) {
+        return 0;
+    }
+    if (pool.state == SDL_ASYNCIO_SHUTTING_DOWN) {
+        return SDL_SetError("Asynchronous I/O is shutting down");
+    }
+
+    hint = SDL_GetHint(SDL_HINT_ASYNCIO_THREADS);
+    if (hint && SDL_atoi(hint) > 0) {
+        num_threads = SDL_min(SDL_atoi(hint), SDL_ASYNCIO_MAX_THREADS);
+    }
+
+    /* The threads wait for the pool lock before they look at the state */
+    pool.state = SDL_ASYNCIO_RUNNING;
+    for (i = 0; i < num_threads; ++i) {
+        char name[32];
+        SDL_snprintf(name, sizeof(name), "SDLAsyncIO%d", i);
+        pool.threads[pool.num_threads] = SDL_CreateThreadInternal(SDL_AsyncIOThread, name, 0, NULL);
+        if (pool.threads[pool.num_threads]) {
+            ++pool.num_threads;
+        }
+    }
+    if (pool.num_threads == 0) {
+        pool.state = SDL_ASYNCIO_STOPPED;
+        return SDL_SetError("Couldn't create asynchronous I/O threads");
+    }
+    return 0;
+}
+
+void
+SDL_QuitAsyncIO(void)
+{
+    SDL_Thread *threads[SDL_ASYNCIO_MAX_THREADS];
+    SDL_AsyncIO *canceled, *request;
+    int i, num_threads;
+
+    SDL_AtomicLock(&pool.init_lock);
+    if (!pool.lock) {
+        SDL_AtomicUnlock(&pool.init_lock);
+        return;
+    }
+    SDL_AtomicUnlock(&pool.init_lock);
+
+    /* New requests fail while the threads finish what they're doing,
+       including any that callbacks on those threads make */
+    SDL_LockMutex(pool.lock);
+    if (pool.state != SDL_ASYNCIO_RUNNING) {
+        SDL_UnlockMutex(pool.lock);
+        return;
+    }
+    pool.state = SDL_ASYNCIO_SHUTTING_DOWN;
+    num_threads = pool.num_threads;
+    SDL_memcpy(threads, pool.threads, num_threads * sizeof(*threads));
+    pool.num_threads = 0;
+    SDL_CondBroadcast(pool.work_cond);
+    SDL_UnlockMutex(pool.lock);
+
+    for (i = 0; i < num_threads; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+
+    /* Anything that didn't get a chance to run is canceled */
+    SDL_LockMutex(pool.lock);
+    canceled = pool.queue;
+    pool.queue = NULL;
+    for (request = canceled; request; request = request->next) {
+        SDL_AtomicSet(&request->status, SDL_ASYNCIO_CANCELED);
+    }
+    pool.state = SDL_ASYNCIO_STOPPED;
+    SDL_UnlockMutex(pool.lock);
+
+    /* The callbacks run without any locks held, so they can queue new
+       requests, which start the threads again */
+    while ((request = canceled) != NULL) {
+        canceled = request->next;
+        request->next = NULL;
+        if (request->callback) {
+            request->callback(request->userdata, request);
+        }
+        SDL_LockMutex(pool.lock);
+        request->finished = SDL_TRUE;
+        SDL_CondBroadcast(pool.done_cond);
+        SDL_UnlockMutex(pool.lock);
+    }
+}
+
+static SDL_AsyncIO *
+SDL_QueueAsyncIO(SDL_AsyncIO *request)
+{
+    SDL_AsyncIO **prev;
+
+    if (SDL_CreateAsyncIOLock() < 0) {
+        SDL_free(request->file);
+        SDL_free(request);
+        return NULL;
+    }
+
+    SDL_LockMutex(pool.lock);
+    if (SDL_InitAsyncIO() < 0) {
+        SDL_UnlockMutex(pool.lock);
+        SDL_free(request->file);
+        SDL_free(request);
+        return NULL;
+    }
+
+    SDL_AtomicSet(&request->status, SDL_ASYNCIO_PENDING);
+    for (prev = &pool.queue; *prev; prev = &(*prev)->next) {
+        if ((*prev)->priority < request->priority) {
+            break;
+        }
+    }
+    request->next = *prev;
+    *prev = request;
+    SDL_CondSignal(pool.work_cond);
+    SDL_UnlockMutex(pool.lock);
+
+    return request;
+}
+
+SDL_AsyncIO *
+SDL_LoadFileAsync(const char *file, int priority, SDL_AsyncIOCallback callback, void *userdata)
+{
+    SDL_AsyncIO *request;
+
+    if (!file || !*file) {
+        SDL_InvalidParamError("file");
+        return NULL;
+    }
+
+    request = (SDL_AsyncIO *) SDL_calloc(1, sizeof(*request));
+    if (request) {
+        request->file = SDL_strdup(file);
+    }
+    if (!request || !request->file) {
+        SDL_free(request);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    request->type = SDL_ASYNCIO_LOADFILE;
+    request->priority = priority;
+    request->callback = callback;
+    request->userdata = userdata;
+
+    return SDL_QueueAsyncIO(request);
+}
+
+SDL_AsyncIO *
+SDL_RWReadAsync(SDL_RWops *src, void *ptr, size_t size, size_t maxnum, int priority, SDL_AsyncIOCallback callback, void *userdata)
+{
+    SDL_AsyncIO *request;
+
+    if (!src) {
+        SDL_InvalidParamError("src");
+        return NULL;
+    }
+    if (!ptr) {
+        SDL_InvalidParamError("ptr");
+        return NULL;
+    }
+
+    request = (SDL_AsyncIO *) SDL_calloc(1, sizeof(*request));
+    if (!request) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    request->type = SDL_ASYNCIO_READ;
+    request->priority = priority;
+    request->src = src;
+    request->ptr = ptr;
+    request->size = size;
+    request->maxnum = maxnum;
+    request->callback = callback;
+    request->userdata = userdata;
+
+    return SDL_QueueAsyncIO(request);
+}
+
+SDL_AsyncIOStatus
+SDL_GetAsyncIOStatus(SDL_AsyncIO *request)
+{
+    if (!request) {
+        SDL_InvalidParamError("request");
+        return SDL_ASYNCIO_FAILED;
+    }
+
+    /* This doesn't touch the pool, so it's safe while the pool shuts down */
+    return (SDL_AsyncIOStatus) SDL_AtomicGet(&request->status);
+}
+
+SDL_AsyncIOStatus
+SDL_WaitAsyncIO(SDL_AsyncIO *request)
+{
+    SDL_AsyncIOStatus status;
+
+    if (!request) {
+        SDL_InvalidParamError("request");
+        return SDL_ASYNCIO_FAILED;
+    }
+
+    /* Any request means the pool lock exists, and it's never destroyed */
+    SDL_LockMutex(pool.lock);
+    while (!request->finished) {
+        SDL_CondWait(pool.done_cond, pool.lock);
+    }
+    SDL_UnlockMutex(pool.lock);
+
+    status = (SDL_AsyncIOStatus) SDL_AtomicGet(&request->status);
+    if (status == SDL_ASYNCIO_FAILED) {
+        SDL_SetError("%s", request->error);
+    } else if (status == SDL_ASYNCIO_CANCELED) {
+        SDL_SetError("Asynchronous I/O request was canceled");
+    }
+    return status;
+}
+
+void *
+SDL_GetAsyncIOData(SDL_AsyncIO *request, size_t *size)
+{
+    void *result = NULL;
+
+    if (size) {
+        *size = 0;
+    }
+    if (!request) {
+        SDL_InvalidParamError("request");
+        return NULL;
+    }
+
+    SDL_LockMutex(pool.lock);
+    if (SDL_AtomicGet(&request->status) == SDL_ASYNCIO_COMPLETE) {
+        result = request->result;
+        if (size) {
+            *size = request->result_size;
+        }
+        if (request->type == SDL_ASYNCIO_LOADFILE) {
+            /* The loaded data now belongs to the caller */
+            request->result = NULL;
+        }
+    }
+    SDL_UnlockMutex(pool.lock);
+    return result;
+}
+
+void
+SDL_FreeAsyncIO(SDL_AsyncIO *request)
+{
+    if (!request) {
+        return;
+    }
+
+    SDL_LockMutex(pool.lock);
+    if (SDL_AtomicGet(&request->status) == SDL_ASYNCIO_PENDING) {
+        SDL_AsyncIO **prev;
+        for (prev = &pool.queue; *prev; prev = &(*prev)->next) {
+            if (*prev == request) {
+                *prev = request->next;
+                SDL_AtomicSet(&request->status, SDL_ASYNCIO_CANCELED);
+                request->finished = SDL_TRUE;
+                break;
+            }
+        }
+    }
+    while (!request->finished) {
+        SDL_CondWait(pool.done_cond, pool.lock);
+    }
+    SDL_UnlockMutex(pool.lock);
+
+    if (request->type == SDL_ASYNCIO_LOADFILE) {
+        SDL_free(request->result);
+    }
+    SDL_free(request->file);
+    SDL_free(request);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
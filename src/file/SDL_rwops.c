@@ -40,6 +40,14 @@
 #include <limits.h>
 #endif
 
+#ifdef HAVE_MMAP
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 /* This file provides a general interface for SDL to read and write
    data sources.  It can easily be extended to files, memory, etc.
 */
@@ -505,6 +513,198 @@ mem_close(SDL_RWops * context)
 }
 
 
+/* Functions to read from a read-only memory mapped file */
+
+#ifdef HAVE_MMAP
+static int SDLCALL
+mapped_close(SDL_RWops * context)
+{
+    if (context) {
+        if (context->hidden.mem.base) {
+            munmap(context->hidden.mem.base, (size_t)(context->hidden.mem.stop - context->hidden.mem.base));
+        }
+        SDL_FreeRW(context);
+    }
+    return 0;
+}
+#endif /* HAVE_MMAP */
+
+/* Used when the file can't be mapped and was loaded into memory instead */
+static int SDLCALL
+loaded_close(SDL_RWops * context)
+{
+    if (context) {
+        SDL_free(context->hidden.mem.base);
+        SDL_FreeRW(context);
+    }
+    return 0;
+}
+
+
+/* Functions to buffer reads and writes of another SDL_RWops */
+
+#define DEFAULT_RW_BUFFER_SIZE  16384
+
+typedef struct
+{
+    SDL_RWops *src;
+    SDL_bool autoclose;
+    SDL_bool dirty;     /* the buffer holds data that hasn't been written yet */
+    Uint8 *data;
+    size_t size;
+    size_t pos;
+    size_t len;
+} SDL_RWbuffer;
+
+/* Write out pending data or give back read-ahead data to the source */
+static int
+buffered_sync(SDL_RWbuffer *buffer)
+{
+    if (buffer->dirty) {
+        if (SDL_RWwrite(buffer->src, buffer->data, 1, buffer->len) != buffer->len) {
+            return -1;
+        }
+        buffer->dirty = SDL_FALSE;
+    } else if (buffer->pos < buffer->len) {
+        if (SDL_RWseek(buffer->src, -(Sint64)(buffer->len - buffer->pos), RW_SEEK_CUR) < 0) {
+            return -1;
+        }
+    }
+    buffer->pos = buffer->len = 0;
+    return 0;
+}
+
+static Sint64 SDLCALL
+buffered_size(SDL_RWops * context)
+{
+    SDL_RWbuffer *buffer = (SDL_RWbuffer *) context->hidden.unknown.data1;
+
+    if (buffer->dirty && buffered_sync(buffer) < 0) {
+        return -1;
+    }
+    return SDL_RWsize(buffer->src);
+}
+
+static Sint64 SDLCALL
+buffered_seek(SDL_RWops * context, Sint64 offset, int whence)
+{
+    SDL_RWbuffer *buffer = (SDL_RWbuffer *) context->hidden.unknown.data1;
+
+    /* Relative seeks within the read-ahead data don't touch the source */
+    if (whence == RW_SEEK_CUR && !buffer->dirty && buffer->len > 0) {
+        Sint64 newpos = (Sint64)buffer->pos + offset;
+        if (newpos >= 0 && newpos <= (Sint64)buffer->len) {
+            Sint64 pos = SDL_RWtell(buffer->src);
+            if (pos < 0) {
+                return -1;
+            }
+            buffer->pos = (size_t)newpos;
+            return pos - (Sint64)(buffer->len - buffer->pos);
+        }
+    }
+
+    if (buffered_sync(buffer) < 0) {
+        return -1;
+    }
+    return SDL_RWseek(buffer->src, offset, whence);
+}
+
+static size_t SDLCALL
+buffered_read(SDL_RWops * context, void *ptr, size_t size, size_t maxnum)
+{
+    SDL_RWbuffer *buffer = (SDL_RWbuffer *) context->hidden.unknown.data1;
+    Uint8 *dst = (Uint8 *) ptr;
+    size_t total_bytes, amount = 0;
+
+    total_bytes = (maxnum * size);
+    if ((maxnum <= 0) || (size <= 0)
+        || ((total_bytes / maxnum) != (size_t) size)) {
+        return 0;
+    }
+
+    if (buffer->dirty && buffered_sync(buffer) < 0) {
+        return 0;
+    }
+
+    while (amount < total_bytes) {
+        size_t left = total_bytes - amount;
+        size_t available = buffer->len - buffer->pos;
+
+        if (available > 0) {
+            size_t count = SDL_min(available, left);
+            SDL_memcpy(dst + amount, buffer->data + buffer->pos, count);
+            buffer->pos += count;
+            amount += count;
+        } else if (left >= buffer->size) {
+            /* Large reads go straight to the source */
+            size_t count = SDL_RWread(buffer->src, dst + amount, 1, left);
+            if (count == 0) {
+                break;
+            }
+            amount += count;
+        } else {
+            buffer->pos = 0;
+            buffer->len = SDL_RWread(buffer->src, buffer->data, 1, buffer->size);
+            if (buffer->len == 0) {
+                break;
+            }
+        }
+    }
+    return (amount / size);
+}
+
+static size_t SDLCALL
+buffered_write(SDL_RWops * context, const void *ptr, size_t size, size_t num)
+{
+    SDL_RWbuffer *buffer = (SDL_RWbuffer *) context->hidden.unknown.data1;
+    size_t total_bytes;
+
+    total_bytes = (num * size);
+    if ((num <= 0) || (size <= 0)
+        || ((total_bytes / num) != (size_t) size)) {
+        return 0;
+    }
+
+    if (!buffer->dirty || (buffer->len + total_bytes) > buffer->size) {
+        if (buffered_sync(buffer) < 0) {
+            return 0;
+        }
+    }
+
+    if (total_bytes >= buffer->size) {
+        return SDL_RWwrite(buffer->src, ptr, size, num);
+    }
+
+    SDL_memcpy(buffer->data + buffer->len, ptr, total_bytes);
+    buffer->len += total_bytes;
+    buffer->pos = buffer->len;
+    buffer->dirty = SDL_TRUE;
+    return num;
+}
+
+static int SDLCALL
+buffered_close(SDL_RWops * context)
+{
+    int status = 0;
+    if (context) {
+        SDL_RWbuffer *buffer = (SDL_RWbuffer *) context->hidden.unknown.data1;
+
+        if (buffer->dirty) {
+            status = buffered_sync(buffer);
+        }
+        if (buffer->autoclose) {
+            if (SDL_RWclose(buffer->src) < 0) {
+                status = -1;
+            }
+        }
+        SDL_free(buffer->data);
+        SDL_free(buffer);
+        SDL_FreeRW(context);
+    }
+    return status;
+}
+
+
 /* Functions to create SDL_RWops structures from various data sources */
 
 SDL_RWops *
@@ -678,6 +878,151 @@ SDL_RWFromConstMem(const void *mem, int size)
     return rwops;
 }
 
+SDL_RWops *
+SDL_RWFromFileMapped(const char *file)
+{
+    SDL_RWops *rwops = NULL;
+    void *data;
+    size_t datasize = 0;
+
+    if (!file || !*file) {
+        SDL_SetError("SDL_RWFromFileMapped(): No file specified");
+        return NULL;
+    }
+
+#ifdef HAVE_MMAP
+    {
+        int fd = open(file, O_RDONLY);
+        if (fd >= 0) {
+            struct stat st;
+
+            if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+                data = NULL;
+                if (st.st_size > 0) {
+                    data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                }
+                if (data != MAP_FAILED) {
+                    close(fd);
+                    rwops = SDL_AllocRW();
+                    if (!rwops) {
+                        if (data) {
+                            munmap(data, (size_t)st.st_size);
+                        }
+                        return NULL;
+                    }
+#ifdef MADV_SEQUENTIAL
+                    if (data) {
+                        madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+                    }
+#endif
+                    rwops->size = mem_size;
+                    rwops->seek = mem_seek;
+                    rwops->read = mem_read;
+                    rwops->write = mem_writeconst;
+                    rwops->close = mapped_close;
+                    rwops->hidden.mem.base = (Uint8 *) data;
+                    rwops->hidden.mem.here = rwops->hidden.mem.base;
+                    rwops->hidden.mem.stop = rwops->hidden.mem.base + st.st_size;
+                    rwops->type = SDL_RWOPS_MAPPED;
+                    return rwops;
+                }
+            }
+            close(fd);
+        }
+        /* Fall back to loading the file, e.g. for Android assets or pipes */
+    }
+#endif /* HAVE_MMAP */
+
+    data = SDL_LoadFile(file, &datasize);
+    if (!data) {
+        return NULL;
+    }
+
+    rwops = SDL_AllocRW();
+    if (!rwops) {
+        SDL_free(data);
+        return NULL;
+    }
+    rwops->size = mem_size;
+    rwops->seek = mem_seek;
+    rwops->read = mem_read;
+    rwops->write = mem_writeconst;
+    rwops->close = loaded_close;
+    rwops->hidden.mem.base = (Uint8 *) data;
+    rwops->hidden.mem.here = rwops->hidden.mem.base;
+    rwops->hidden.mem.stop = rwops->hidden.mem.base + datasize;
+    rwops->type = SDL_RWOPS_MEMORY_RO;
+    return rwops;
+}
+
+SDL_RWops *
+SDL_RWFromBuffered(SDL_RWops * src, size_t buffer_size, SDL_bool autoclose)
+{
+    SDL_RWops *rwops = NULL;
+    SDL_RWbuffer *buffer;
+
+    if (!src) {
+        SDL_InvalidParamError("src");
+        return NULL;
+    }
+    if (!buffer_size) {
+        buffer_size = DEFAULT_RW_BUFFER_SIZE;
+    }
+
+    buffer = (SDL_RWbuffer *) SDL_calloc(1, sizeof(*buffer));
+    if (buffer) {
+        buffer->data = (Uint8 *) SDL_malloc(buffer_size);
+    }
+    if (!buffer || !buffer->data) {
+        SDL_free(buffer);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    buffer->src = src;
+    buffer->autoclose = autoclose;
+    buffer->size = buffer_size;
+
+    rwops = SDL_AllocRW();
+    if (!rwops) {
+        SDL_free(buffer->data);
+        SDL_free(buffer);
+        return NULL;
+    }
+    rwops->size = buffered_size;
+    rwops->seek = buffered_seek;
+    rwops->read = buffered_read;
+    rwops->write = buffered_write;
+    rwops->close = buffered_close;
+    rwops->hidden.unknown.data1 = buffer;
+    rwops->type = SDL_RWOPS_BUFFERED;
+    return rwops;
+}
+
+const void *
+SDL_RWGetMemory(SDL_RWops * context, size_t *available)
+{
+    if (!context) {
+        SDL_InvalidParamError("context");
+        return NULL;
+    }
+
+    switch (context->type) {
+    case SDL_RWOPS_MEMORY:
+    case SDL_RWOPS_MEMORY_RO:
+    case SDL_RWOPS_MAPPED:
+        if (available) {
+            *available = (size_t)(context->hidden.mem.stop - context->hidden.mem.here);
+        }
+        return context->hidden.mem.here;
+    default:
+        break;
+    }
+    if (available) {
+        *available = 0;
+    }
+    return NULL;
+}
+
 SDL_RWops *
 SDL_AllocRW(void)
 {
@@ -712,6 +1057,23 @@ SDL_LoadFile_RW(SDL_RWops * src, size_t *datasize, int freesrc)
         return NULL;
     }
 
+    /* Memory backed streams can be copied out in one go */
+    {
+        size_t available;
+        const void *mem = SDL_RWGetMemory(src, &available);
+        if (mem) {
+            data = SDL_malloc(available + 1);
+            if (!data) {
+                SDL_OutOfMemory();
+                goto done;
+            }
+            SDL_memcpy(data, mem, available);
+            SDL_RWseek(src, (Sint64)available, RW_SEEK_CUR);
+            size_total = available;
+            goto finish;
+        }
+    }
+
     size = SDL_RWsize(src);
     if (size < 0) {
         size = FILE_CHUNK_SIZE;
@@ -739,6 +1101,7 @@ SDL_LoadFile_RW(SDL_RWops * src, size_t *datasize, int freesrc)
         size_total += size_read;
     }
 
+finish:
     if (datasize) {
         *datasize = size_total;
     }
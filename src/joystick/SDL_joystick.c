@@ -102,6 +102,15 @@ SDL_UnlockJoysticks(void)
     }
 }
 
+int
+SDL_TryLockJoysticks(void)
+{
+    if (SDL_joystick_lock) {
+        return SDL_TryLockMutex(SDL_joystick_lock);
+    }
+    return 0;
+}
+
 
 static void SDLCALL
 SDL_JoystickAllowBackgroundEventsChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
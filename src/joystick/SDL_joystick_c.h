@@ -33,6 +33,9 @@ struct _SDL_JoystickDriver;
 extern int SDL_JoystickInit(void);
 extern void SDL_JoystickQuit(void);
 
+/* Lock the joysticks without waiting, returns SDL_MUTEX_TIMEDOUT if they're busy */
+extern int SDL_TryLockJoysticks(void);
+
 /* Function to get the next available joystick instance ID */
 extern SDL_JoystickID SDL_GetNextJoystickInstanceID(void);
 
@@ -238,7 +238,7 @@ static SDL_bool ReadFeatureReport(hid_device *dev, Uint8 report_id, Uint8 *data,
 
     SDL_memset(report, 0, sizeof(report));
     report[0] = report_id;
-    if (hid_get_feature_report(dev, report, sizeof(report)) < 0) {
+    if (HIDAPI_GetFeatureReport(dev, report, sizeof(report)) < 0) {
         return SDL_FALSE;
     }
     SDL_memcpy(data, report, SDL_min(size, sizeof(report)));
@@ -386,7 +386,7 @@ HIDAPI_DriverPS4_Rumble(SDL_Joystick *joystick, hid_device *dev, void *context,
         SDL_memcpy(&data[report_size - sizeof(unCRC)], &unCRC, sizeof(unCRC));
     }
 
-    if (hid_write(dev, data, report_size) != report_size) {
+    if (HIDAPI_Write(dev, data, report_size) != report_size) {
         return SDL_SetError("Couldn't send rumble packet");
     }
 
@@ -398,8 +398,44 @@ HIDAPI_DriverPS4_Rumble(SDL_Joystick *joystick, hid_device *dev, void *context,
     return 0;
 }
 
+/* The buttons held in a state packet, as a mask of SDL_GameControllerButton */
+static Uint32
+HIDAPI_DriverPS4_GetButtons(const PS4StatePacket_t *packet)
+{
+    static const Uint32 hat_buttons[] = {
+        (1 << SDL_CONTROLLER_BUTTON_DPAD_UP),
+        (1 << SDL_CONTROLLER_BUTTON_DPAD_UP) | (1 << SDL_CONTROLLER_BUTTON_DPAD_RIGHT),
+        (1 << SDL_CONTROLLER_BUTTON_DPAD_RIGHT),
+        (1 << SDL_CONTROLLER_BUTTON_DPAD_RIGHT) | (1 << SDL_CONTROLLER_BUTTON_DPAD_DOWN),
+        (1 << SDL_CONTROLLER_BUTTON_DPAD_DOWN),
+        (1 << SDL_CONTROLLER_BUTTON_DPAD_LEFT) | (1 << SDL_CONTROLLER_BUTTON_DPAD_DOWN),
+        (1 << SDL_CONTROLLER_BUTTON_DPAD_LEFT),
+        (1 << SDL_CONTROLLER_BUTTON_DPAD_UP) | (1 << SDL_CONTROLLER_BUTTON_DPAD_LEFT),
+    };
+    const Uint8 data0 = packet->rgucButtonsHatAndCounter[0];
+    const Uint8 data1 = packet->rgucButtonsHatAndCounter[1];
+    const Uint8 data2 = packet->rgucButtonsHatAndCounter[2];
+    Uint32 buttons = 0;
+
+    buttons |= (data0 & 0x10) ? (1 << SDL_CONTROLLER_BUTTON_X) : 0;
+    buttons |= (data0 & 0x20) ? (1 << SDL_CONTROLLER_BUTTON_A) : 0;
+    buttons |= (data0 & 0x40) ? (1 << SDL_CONTROLLER_BUTTON_B) : 0;
+    buttons |= (data0 & 0x80) ? (1 << SDL_CONTROLLER_BUTTON_Y) : 0;
+    if ((data0 & 0x0F) < SDL_arraysize(hat_buttons)) {
+        buttons |= hat_buttons[data0 & 0x0F];
+    }
+    buttons |= (data1 & 0x01) ? (1 << SDL_CONTROLLER_BUTTON_LEFTSHOULDER) : 0;
+    buttons |= (data1 & 0x02) ? (1 << SDL_CONTROLLER_BUTTON_RIGHTSHOULDER) : 0;
+    buttons |= (data1 & 0x10) ? (1 << SDL_CONTROLLER_BUTTON_BACK) : 0;
+    buttons |= (data1 & 0x20) ? (1 << SDL_CONTROLLER_BUTTON_START) : 0;
+    buttons |= (data1 & 0x40) ? (1 << SDL_CONTROLLER_BUTTON_LEFTSTICK) : 0;
+    buttons |= (data1 & 0x80) ? (1 << SDL_CONTROLLER_BUTTON_RIGHTSTICK) : 0;
+    buttons |= (data2 & 0x01) ? (1 << SDL_CONTROLLER_BUTTON_GUIDE) : 0;
+    return buttons;
+}
+
 static void
-HIDAPI_DriverPS4_HandleStatePacket(SDL_Joystick *joystick, hid_device *dev, SDL_DriverPS4_Context *ctx, PS4StatePacket_t *packet)
+HIDAPI_DriverPS4_HandleStatePacket(SDL_Joystick *joystick, hid_device *dev, SDL_DriverPS4_Context *ctx, const PS4StatePacket_t *packet)
 {
     Sint16 axis;
 
@@ -508,29 +544,45 @@ HIDAPI_DriverPS4_HandleStatePacket(SDL_Joystick *joystick, hid_device *dev, SDL_
 }
 
 static SDL_bool
-HIDAPI_DriverPS4_Update(SDL_Joystick *joystick, hid_device *dev, void *context)
+HIDAPI_DriverPS4_ReadReport(hid_device *dev, void *context, const Uint8 *data, int size, void *state, SDL_HIDAPI_ButtonEdges *edges)
 {
-    SDL_DriverPS4_Context *ctx = (SDL_DriverPS4_Context *)context;
-    Uint8 data[USB_PACKET_LENGTH];
-    int size;
-
-    while ((size = hid_read_timeout(dev, data, sizeof(data), 0)) > 0) {
-        switch (data[0]) {
-        case k_EPS4ReportIdUsbState:
-            HIDAPI_DriverPS4_HandleStatePacket(joystick, dev, ctx, (PS4StatePacket_t *)&data[1]);
-            break;
-        case k_EPS4ReportIdBluetoothState:
-            /* Bluetooth state packets have two additional bytes at the beginning */
-            HIDAPI_DriverPS4_HandleStatePacket(joystick, dev, ctx, (PS4StatePacket_t *)&data[3]);
-            break;
-        default:
+    PS4StatePacket_t *packet = (PS4StatePacket_t *)state;
+    const Uint32 buttons = HIDAPI_DriverPS4_GetButtons(packet);
+
+    switch (data[0]) {
+    case k_EPS4ReportIdUsbState:
+        SDL_memcpy(packet, &data[1], sizeof(*packet));
+        break;
+    case k_EPS4ReportIdBluetoothState:
+        /* Bluetooth state packets have two additional bytes at the beginning */
+        SDL_memcpy(packet, &data[3], sizeof(*packet));
+        break;
+    default:
 #ifdef DEBUG_JOYSTICK
-            SDL_Log("Unknown PS4 packet: 0x%.2x\n", data[0]);
+        SDL_Log("Unknown PS4 packet: 0x%.2x\n", data[0]);
 #endif
-            break;
-        }
+        return SDL_FALSE;
     }
+    HIDAPI_AddButtonEdges(edges, buttons, HIDAPI_DriverPS4_GetButtons(packet));
+    return SDL_TRUE;
+}
+
+static void
+HIDAPI_DriverPS4_UpdateState(SDL_Joystick *joystick, hid_device *dev, void *context, const void *state, const SDL_HIDAPI_ButtonEdges *edges)
+{
+    SDL_DriverPS4_Context *ctx = (SDL_DriverPS4_Context *)context;
+    const PS4StatePacket_t *packet = (const PS4StatePacket_t *)state;
 
+    HIDAPI_SendButtonTaps(joystick, HIDAPI_DriverPS4_GetButtons(&ctx->last_state), HIDAPI_DriverPS4_GetButtons(packet), edges);
+    HIDAPI_DriverPS4_HandleStatePacket(joystick, dev, ctx, packet);
+}
+
+static SDL_bool
+HIDAPI_DriverPS4_Update(SDL_Joystick *joystick, hid_device *dev, void *context)
+{
+    SDL_DriverPS4_Context *ctx = (SDL_DriverPS4_Context *)context;
+
+    /* Reports are read in the background and handed to HIDAPI_DriverPS4_UpdateState() */
     if (ctx->rumble_expiration) {
         Uint32 now = SDL_GetTicks();
         if (SDL_TICKS_PASSED(now, ctx->rumble_expiration)) {
@@ -538,7 +590,7 @@ HIDAPI_DriverPS4_Update(SDL_Joystick *joystick, hid_device *dev, void *context)
         }
     }
 
-    return (size >= 0);
+    return SDL_TRUE;
 }
 
 static void
@@ -556,7 +608,10 @@ SDL_HIDAPI_DeviceDriver SDL_HIDAPI_DriverPS4 =
     HIDAPI_DriverPS4_Init,
     HIDAPI_DriverPS4_Rumble,
     HIDAPI_DriverPS4_Update,
-    HIDAPI_DriverPS4_Quit
+    HIDAPI_DriverPS4_Quit,
+    sizeof(PS4StatePacket_t),
+    HIDAPI_DriverPS4_ReadReport,
+    HIDAPI_DriverPS4_UpdateState
 };
 
 #endif /* SDL_JOYSTICK_HIDAPI_PS4 */
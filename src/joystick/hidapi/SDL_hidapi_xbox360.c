@@ -270,7 +270,7 @@ static SDL_bool SetSlotLED(hid_device *dev, Uint8 slot)
 {
     const Uint8 led_packet[] = { 0x01, 0x03, (2 + slot) };
 
-    if (hid_write(dev, led_packet, sizeof(led_packet)) != sizeof(led_packet)) {
+    if (HIDAPI_Write(dev, led_packet, sizeof(led_packet)) != sizeof(led_packet)) {
         return SDL_FALSE;
     }
     return SDL_TRUE;
@@ -365,7 +365,7 @@ HIDAPI_DriverXbox360_Rumble(SDL_Joystick *joystick, hid_device *dev, void *conte
     rumble_packet[4] = (high_frequency_rumble >> 8);
 #endif
 
-    if (hid_write(dev, rumble_packet, sizeof(rumble_packet)) != sizeof(rumble_packet)) {
+    if (HIDAPI_Write(dev, rumble_packet, sizeof(rumble_packet)) != sizeof(rumble_packet)) {
         return SDL_SetError("Couldn't send rumble packet");
     }
 #endif /* __WIN32__ */
@@ -711,7 +711,7 @@ HIDAPI_DriverXbox360_Update(SDL_Joystick *joystick, hid_device *dev, void *conte
     Uint8 data[USB_PACKET_LENGTH];
     int size;
 
-    while ((size = hid_read_timeout(dev, data, sizeof(data), 0)) > 0) {
+    while ((size = HIDAPI_ReadTimeout(dev, data, sizeof(data), 0)) > 0) {
 #ifdef __WIN32__
         HIDAPI_DriverXbox360_HandleStatePacket(joystick, dev, ctx, data, size);
 #else
@@ -126,9 +126,16 @@ static const SDL_DriverXboxOne_InitPacket xboxone_init_packets[] = {
 typedef struct {
     Uint8 sequence;
     Uint8 last_state[USB_PACKET_LENGTH];
+    Uint8 last_guide;
     Uint32 rumble_expiration;
 } SDL_DriverXboxOne_Context;
 
+/* What the reader hands over, the last state packet and the guide button from mode packets */
+typedef struct {
+    Uint8 packet[USB_PACKET_LENGTH];
+    Uint8 guide;
+} SDL_DriverXboxOne_State;
+
 
 static SDL_bool
 HIDAPI_DriverXboxOne_IsSupportedDevice(Uint16 vendor_id, Uint16 product_id, Uint16 version, int interface_number)
@@ -162,7 +169,7 @@ HIDAPI_DriverXboxOne_Init(SDL_Joystick *joystick, hid_device *dev, Uint16 vendor
         if (!packet->vendor_id || (vendor_id == packet->vendor_id && product_id == packet->product_id)) {
             SDL_memcpy(init_packet, packet->data, packet->size);
             init_packet[2] = ctx->sequence++;
-            if (hid_write(dev, init_packet, packet->size) != packet->size) {
+            if (HIDAPI_Write(dev, init_packet, packet->size) != packet->size) {
                 SDL_SetError("Couldn't write Xbox One initialization packet");
                 SDL_free(ctx);
                 return SDL_FALSE;
@@ -194,7 +201,7 @@ HIDAPI_DriverXboxOne_Rumble(SDL_Joystick *joystick, hid_device *dev, void *conte
     rumble_packet[8] = (low_frequency_rumble >> 9);
     rumble_packet[9] = (high_frequency_rumble >> 9);
 
-    if (hid_write(dev, rumble_packet, sizeof(rumble_packet)) != sizeof(rumble_packet)) {
+    if (HIDAPI_Write(dev, rumble_packet, sizeof(rumble_packet)) != sizeof(rumble_packet)) {
         return SDL_SetError("Couldn't send rumble packet");
     }
 
@@ -206,8 +213,37 @@ HIDAPI_DriverXboxOne_Rumble(SDL_Joystick *joystick, hid_device *dev, void *conte
     return 0;
 }
 
+/* The buttons held in a state packet and the guide button from mode packets,
+   as a mask of SDL_GameControllerButton */
+static Uint32
+HIDAPI_DriverXboxOne_GetButtons(const Uint8 *data, Uint8 guide)
+{
+    Uint32 buttons = 0;
+
+    if (data[0] == 0x20) {
+        buttons |= (data[4] & 0x04) ? (1 << SDL_CONTROLLER_BUTTON_START) : 0;
+        buttons |= (data[4] & 0x08) ? (1 << SDL_CONTROLLER_BUTTON_BACK) : 0;
+        buttons |= (data[4] & 0x10) ? (1 << SDL_CONTROLLER_BUTTON_A) : 0;
+        buttons |= (data[4] & 0x20) ? (1 << SDL_CONTROLLER_BUTTON_B) : 0;
+        buttons |= (data[4] & 0x40) ? (1 << SDL_CONTROLLER_BUTTON_X) : 0;
+        buttons |= (data[4] & 0x80) ? (1 << SDL_CONTROLLER_BUTTON_Y) : 0;
+        buttons |= (data[5] & 0x01) ? (1 << SDL_CONTROLLER_BUTTON_DPAD_UP) : 0;
+        buttons |= (data[5] & 0x02) ? (1 << SDL_CONTROLLER_BUTTON_DPAD_DOWN) : 0;
+        buttons |= (data[5] & 0x04) ? (1 << SDL_CONTROLLER_BUTTON_DPAD_LEFT) : 0;
+        buttons |= (data[5] & 0x08) ? (1 << SDL_CONTROLLER_BUTTON_DPAD_RIGHT) : 0;
+        buttons |= (data[5] & 0x10) ? (1 << SDL_CONTROLLER_BUTTON_LEFTSHOULDER) : 0;
+        buttons |= (data[5] & 0x20) ? (1 << SDL_CONTROLLER_BUTTON_RIGHTSHOULDER) : 0;
+        buttons |= (data[5] & 0x40) ? (1 << SDL_CONTROLLER_BUTTON_LEFTSTICK) : 0;
+        buttons |= (data[5] & 0x80) ? (1 << SDL_CONTROLLER_BUTTON_RIGHTSTICK) : 0;
+    }
+    if (guide) {
+        buttons |= (1 << SDL_CONTROLLER_BUTTON_GUIDE);
+    }
+    return buttons;
+}
+
 static void
-HIDAPI_DriverXboxOne_HandleStatePacket(SDL_Joystick *joystick, hid_device *dev, SDL_DriverXboxOne_Context *ctx, Uint8 *data, int size)
+HIDAPI_DriverXboxOne_HandleStatePacket(SDL_Joystick *joystick, hid_device *dev, SDL_DriverXboxOne_Context *ctx, const Uint8 *data, int size)
 {
     Sint16 axis;
 
@@ -231,64 +267,81 @@ HIDAPI_DriverXboxOne_HandleStatePacket(SDL_Joystick *joystick, hid_device *dev,
         SDL_PrivateJoystickButton(joystick, SDL_CONTROLLER_BUTTON_RIGHTSTICK, (data[5] & 0x80) ? SDL_PRESSED : SDL_RELEASED);
     }
 
-    axis = ((int)*(Sint16*)(&data[6]) * 64) - 32768;
+    axis = ((int)*(const Sint16*)(&data[6]) * 64) - 32768;
     if (axis == 32704) {
         axis = 32767;
     }
     SDL_PrivateJoystickAxis(joystick, SDL_CONTROLLER_AXIS_TRIGGERLEFT, axis);
-    axis = ((int)*(Sint16*)(&data[8]) * 64) - 32768;
+    axis = ((int)*(const Sint16*)(&data[8]) * 64) - 32768;
     if (axis == 32704) {
         axis = 32767;
     }
     SDL_PrivateJoystickAxis(joystick, SDL_CONTROLLER_AXIS_TRIGGERRIGHT, axis);
-    axis = *(Sint16*)(&data[10]);
+    axis = *(const Sint16*)(&data[10]);
     SDL_PrivateJoystickAxis(joystick, SDL_CONTROLLER_AXIS_LEFTX, axis);
-    axis = *(Sint16*)(&data[12]);
+    axis = *(const Sint16*)(&data[12]);
     SDL_PrivateJoystickAxis(joystick, SDL_CONTROLLER_AXIS_LEFTY, ~axis);
-    axis = *(Sint16*)(&data[14]);
+    axis = *(const Sint16*)(&data[14]);
     SDL_PrivateJoystickAxis(joystick, SDL_CONTROLLER_AXIS_RIGHTX, axis);
-    axis = *(Sint16*)(&data[16]);
+    axis = *(const Sint16*)(&data[16]);
     SDL_PrivateJoystickAxis(joystick, SDL_CONTROLLER_AXIS_RIGHTY, ~axis);
 
     SDL_memcpy(ctx->last_state, data, SDL_min(size, sizeof(ctx->last_state)));
 }
 
-static void
-HIDAPI_DriverXboxOne_HandleModePacket(SDL_Joystick *joystick, hid_device *dev, SDL_DriverXboxOne_Context *ctx, Uint8 *data, int size)
+static SDL_bool
+HIDAPI_DriverXboxOne_ReadReport(hid_device *dev, void *context, const Uint8 *data, int size, void *state, SDL_HIDAPI_ButtonEdges *edges)
 {
-    if (data[1] == 0x30) {
-        /* The Xbox One S controller needs acks for mode reports */
-        const Uint8 seqnum = data[2];
-        const Uint8 ack[] = { 0x01, 0x20, seqnum, 0x09, 0x00, 0x07, 0x20, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00 };
-        hid_write(dev, ack, sizeof(ack));
+    SDL_DriverXboxOne_State *xstate = (SDL_DriverXboxOne_State *)state;
+    const Uint32 buttons = HIDAPI_DriverXboxOne_GetButtons(xstate->packet, xstate->guide);
+
+    switch (data[0]) {
+    case 0x20:
+        SDL_memcpy(xstate->packet, data, SDL_min(size, sizeof(xstate->packet)));
+        break;
+    case 0x07:
+        if (data[1] == 0x30) {
+            /* The Xbox One S controller needs acks for mode reports */
+            const Uint8 seqnum = data[2];
+            const Uint8 ack[] = { 0x01, 0x20, seqnum, 0x09, 0x00, 0x07, 0x20, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00 };
+            HIDAPI_Write(dev, ack, sizeof(ack));
+        }
+        xstate->guide = (data[4] & 0x01);
+        break;
+    default:
+#ifdef DEBUG_JOYSTICK
+        SDL_Log("Unknown Xbox One packet: 0x%.2x\n", data[0]);
+#endif
+        return SDL_FALSE;
     }
+    HIDAPI_AddButtonEdges(edges, buttons, HIDAPI_DriverXboxOne_GetButtons(xstate->packet, xstate->guide));
+    return SDL_TRUE;
+}
 
-    SDL_PrivateJoystickButton(joystick, SDL_CONTROLLER_BUTTON_GUIDE, (data[4] & 0x01) ? SDL_PRESSED : SDL_RELEASED);
+static void
+HIDAPI_DriverXboxOne_UpdateState(SDL_Joystick *joystick, hid_device *dev, void *context, const void *state, const SDL_HIDAPI_ButtonEdges *edges)
+{
+    SDL_DriverXboxOne_Context *ctx = (SDL_DriverXboxOne_Context *)context;
+    const SDL_DriverXboxOne_State *xstate = (const SDL_DriverXboxOne_State *)state;
+
+    HIDAPI_SendButtonTaps(joystick, HIDAPI_DriverXboxOne_GetButtons(ctx->last_state, ctx->last_guide),
+                          HIDAPI_DriverXboxOne_GetButtons(xstate->packet, xstate->guide), edges);
+
+    if (xstate->packet[0] == 0x20) {
+        HIDAPI_DriverXboxOne_HandleStatePacket(joystick, dev, ctx, xstate->packet, sizeof(xstate->packet));
+    }
+    if (ctx->last_guide != xstate->guide) {
+        SDL_PrivateJoystickButton(joystick, SDL_CONTROLLER_BUTTON_GUIDE, xstate->guide ? SDL_PRESSED : SDL_RELEASED);
+        ctx->last_guide = xstate->guide;
+    }
 }
 
 static SDL_bool
 HIDAPI_DriverXboxOne_Update(SDL_Joystick *joystick, hid_device *dev, void *context)
 {
     SDL_DriverXboxOne_Context *ctx = (SDL_DriverXboxOne_Context *)context;
-    Uint8 data[USB_PACKET_LENGTH];
-    int size;
-
-    while ((size = hid_read_timeout(dev, data, sizeof(data), 0)) > 0) {
-        switch (data[0]) {
-        case 0x20:
-            HIDAPI_DriverXboxOne_HandleStatePacket(joystick, dev, ctx, data, size);
-            break;
-        case 0x07:
-            HIDAPI_DriverXboxOne_HandleModePacket(joystick, dev, ctx, data, size);
-            break;
-        default:
-#ifdef DEBUG_JOYSTICK
-            SDL_Log("Unknown Xbox One packet: 0x%.2x\n", data[0]);
-#endif
-            break;
-        }
-    }
 
+    /* Reports are read in the background and handed to HIDAPI_DriverXboxOne_UpdateState() */
     if (ctx->rumble_expiration) {
         Uint32 now = SDL_GetTicks();
         if (SDL_TICKS_PASSED(now, ctx->rumble_expiration)) {
@@ -296,7 +349,7 @@ HIDAPI_DriverXboxOne_Update(SDL_Joystick *joystick, hid_device *dev, void *conte
         }
     }
 
-    return (size >= 0);
+    return SDL_TRUE;
 }
 
 static void
@@ -314,7 +367,10 @@ SDL_HIDAPI_DeviceDriver SDL_HIDAPI_DriverXboxOne =
     HIDAPI_DriverXboxOne_Init,
     HIDAPI_DriverXboxOne_Rumble,
     HIDAPI_DriverXboxOne_Update,
-    HIDAPI_DriverXboxOne_Quit
+    HIDAPI_DriverXboxOne_Quit,
+    sizeof(SDL_DriverXboxOne_State),
+    HIDAPI_DriverXboxOne_ReadReport,
+    HIDAPI_DriverXboxOne_UpdateState
 };
 
 #endif /* SDL_JOYSTICK_HIDAPI_XBOXONE */
@@ -22,7 +22,9 @@
 
 #ifdef SDL_JOYSTICK_HIDAPI
 
+#include "SDL_atomic.h"
 #include "SDL_endian.h"
+#include "SDL_events.h"
 #include "SDL_hints.h"
 #include "SDL_log.h"
 #include "SDL_mutex.h"
@@ -30,6 +32,7 @@
 #include "SDL_timer.h"
 #include "SDL_joystick.h"
 #include "../SDL_sysjoystick.h"
+#include "../../thread/SDL_systhread.h"
 #include "SDL_hidapijoystick_c.h"
 
 #if defined(__WIN32__)
@@ -45,11 +48,17 @@
 
 #if defined(__LINUX__)
 #include "../../core/linux/SDL_udev.h"
-#ifdef SDL_USE_LIBUDEV
-#include <poll.h>
-#endif
 #endif
 
+/* The largest input report the reader takes */
+#define SDL_HIDAPI_MAX_REPORT_SIZE      256
+
+/* How long the reader waits for a report before checking whether it should stop */
+#define SDL_HIDAPI_READER_TIMEOUT_MS    100
+
+/* Set in the published state index when the main thread hasn't taken it yet */
+#define SDL_HIDAPI_STATE_NEW            0x4
+
 struct joystick_hwdata
 {
     SDL_HIDAPI_DeviceDriver *driver;
@@ -57,6 +66,20 @@ struct joystick_hwdata
 
     SDL_mutex *mutex;
     hid_device *dev;
+
+    /* For drivers with ReadReport, reports are folded into state and handed to the
+       main thread through a triple buffer: the reader fills one buffer while the main
+       thread looks at another, and the third is the latest one published. */
+    Uint8 *state;
+    Uint8 *buffers[3];
+    SDL_HIDAPI_ButtonEdges edges[3];    /* The button edges that go with each buffer */
+    SDL_HIDAPI_ButtonEdges pending;     /* Edges not in any buffer yet */
+    int back;                   /* Only used by the reader */
+    int front;                  /* Only used by the main thread */
+    SDL_atomic_t published;
+    SDL_atomic_t running;
+    SDL_atomic_t failed;
+    SDL_Thread *reader;
 };
 
 typedef struct _SDL_HIDAPI_Device
@@ -99,9 +122,19 @@ static SDL_HIDAPI_DeviceDriver *SDL_HIDAPI_drivers[] = {
 static SDL_HIDAPI_Device *SDL_HIDAPI_devices;
 static int SDL_HIDAPI_numjoysticks = 0;
 
-#if defined(SDL_USE_LIBUDEV)
-static const SDL_UDEV_Symbols * usyms = NULL;
-#endif
+static const SDL_HIDAPI_Backend SDL_HIDAPI_hidapi_backend = {
+    hid_enumerate,
+    hid_free_enumeration,
+    hid_open_path,
+    hid_write,
+    hid_read_timeout,
+    hid_get_feature_report,
+    hid_close
+};
+static const SDL_HIDAPI_Backend *SDL_HIDAPI_backend = &SDL_HIDAPI_hidapi_backend;
+
+/* How many changed vendor and product pairs are remembered before falling back to a full update */
+#define SDL_HIDAPI_MAX_CHANGED_DEVICES  16
 
 static struct
 {
@@ -109,6 +142,15 @@ static struct
     SDL_bool m_bCanGetNotifications;
     Uint32 m_unLastDetect;
 
+    /* Set when notifications say which devices changed, so only those need enumerating */
+    SDL_bool m_bIncremental;
+    SDL_bool m_bJoysticksChanged;
+    int m_nChangedDevices;
+    struct {
+        Uint16 vendor_id;
+        Uint16 product_id;
+    } m_changedDevices[SDL_HIDAPI_MAX_CHANGED_DEVICES];
+
 #if defined(__WIN32__)
     SDL_threadID m_nThreadID;
     WNDCLASSEXA m_wndClass;
@@ -123,9 +165,7 @@ static struct
 #endif
 
 #if defined(SDL_USE_LIBUDEV)
-    struct udev *m_pUdev;
-    struct udev_monitor *m_pUdevMonitor;
-    int m_nUdevFd;
+    SDL_bool m_bUdevCallback;
 #endif
 } SDL_HIDAPI_discovery;
 
@@ -191,12 +231,138 @@ static void CallbackIOServiceFunc(void *context, io_iterator_t portIterator)
 }
 #endif /* __MACOSX__ */
 
+
+#if defined(SDL_USE_LIBUDEV)
+static void
+HIDAPI_UdevCallback(SDL_UDEV_deviceevent udev_type, int udev_class, const char *devpath)
+{
+    Uint16 vendor_id, product_id;
+
+    if (devpath == NULL || !(udev_class & (SDL_UDEV_DEVICE_HIDRAW | SDL_UDEV_DEVICE_USB))) {
+        return;
+    }
+
+    switch (udev_type) {
+    case SDL_UDEV_DEVICEADDED:
+        if (SDL_UDEV_GetProductInfo(devpath, &vendor_id, &product_id) < 0) {
+            vendor_id = product_id = 0;
+        }
+        HIDAPI_DeviceAdded(vendor_id, product_id);
+        break;
+    case SDL_UDEV_DEVICEREMOVED:
+        /* The device node is already gone, so there's no telling what it was */
+        HIDAPI_DeviceRemoved(0, 0);
+        break;
+    default:
+        break;
+    }
+}
+#endif /* SDL_USE_LIBUDEV */
+
+void
+HIDAPI_SetBackend(const SDL_HIDAPI_Backend *backend)
+{
+    SDL_HIDAPI_backend = backend ? backend : &SDL_HIDAPI_hidapi_backend;
+}
+
+int
+HIDAPI_Write(hid_device *dev, const Uint8 *data, size_t length)
+{
+    return SDL_HIDAPI_backend->Write(dev, data, length);
+}
+
+int
+HIDAPI_ReadTimeout(hid_device *dev, Uint8 *data, size_t length, int milliseconds)
+{
+    return SDL_HIDAPI_backend->ReadTimeout(dev, data, length, milliseconds);
+}
+
+int
+HIDAPI_GetFeatureReport(hid_device *dev, Uint8 *data, size_t length)
+{
+    return SDL_HIDAPI_backend->GetFeatureReport(dev, data, length);
+}
+
+void
+HIDAPI_AddButtonEdges(SDL_HIDAPI_ButtonEdges *edges, Uint32 old_buttons, Uint32 new_buttons)
+{
+    edges->pressed |= (new_buttons & ~old_buttons);
+    edges->released |= (old_buttons & ~new_buttons);
+}
+
+void
+HIDAPI_SendButtonTaps(SDL_Joystick *joystick, Uint32 last_buttons, Uint32 buttons, const SDL_HIDAPI_ButtonEdges *edges)
+{
+    /* Buttons that changed away from how they were sent and back again */
+    Uint32 taps = ((edges->pressed & ~last_buttons) | (edges->released & last_buttons)) & ~(last_buttons ^ buttons);
+    Uint8 button;
+
+    for (button = 0; taps; ++button, taps >>= 1) {
+        if (taps & 0x01) {
+            const Uint8 state = (last_buttons & (1 << button)) ? SDL_PRESSED : SDL_RELEASED;
+            SDL_PrivateJoystickButton(joystick, button, !state);
+            SDL_PrivateJoystickButton(joystick, button, state);
+        }
+    }
+}
+
+static void
+HIDAPI_AddChangedDevice(Uint16 vendor_id, Uint16 product_id)
+{
+    int i;
+
+    for (i = 0; i < SDL_HIDAPI_discovery.m_nChangedDevices; ++i) {
+        if (SDL_HIDAPI_discovery.m_changedDevices[i].vendor_id == vendor_id &&
+            SDL_HIDAPI_discovery.m_changedDevices[i].product_id == product_id) {
+            return;
+        }
+    }
+    if (i == SDL_arraysize(SDL_HIDAPI_discovery.m_changedDevices)) {
+        SDL_HIDAPI_discovery.m_bHaveDevicesChanged = SDL_TRUE;
+        return;
+    }
+    SDL_HIDAPI_discovery.m_changedDevices[i].vendor_id = vendor_id;
+    SDL_HIDAPI_discovery.m_changedDevices[i].product_id = product_id;
+    ++SDL_HIDAPI_discovery.m_nChangedDevices;
+}
+
+void
+HIDAPI_DeviceAdded(Uint16 vendor_id, Uint16 product_id)
+{
+    if (!vendor_id && !product_id) {
+        SDL_HIDAPI_discovery.m_bHaveDevicesChanged = SDL_TRUE;
+    } else {
+        HIDAPI_AddChangedDevice(vendor_id, product_id);
+    }
+}
+
+void
+HIDAPI_DeviceRemoved(Uint16 vendor_id, Uint16 product_id)
+{
+    if (!vendor_id && !product_id) {
+        /* Only joysticks matter, so check which of those are still there */
+        SDL_HIDAPI_discovery.m_bJoysticksChanged = SDL_TRUE;
+    } else {
+        HIDAPI_AddChangedDevice(vendor_id, product_id);
+    }
+}
+
 static void
 HIDAPI_InitializeDiscovery()
 {
     SDL_HIDAPI_discovery.m_bHaveDevicesChanged = SDL_TRUE;
     SDL_HIDAPI_discovery.m_bCanGetNotifications = SDL_FALSE;
     SDL_HIDAPI_discovery.m_unLastDetect = 0;
+    SDL_HIDAPI_discovery.m_bIncremental = SDL_FALSE;
+    SDL_HIDAPI_discovery.m_bJoysticksChanged = SDL_FALSE;
+    SDL_HIDAPI_discovery.m_nChangedDevices = 0;
+
+    if (SDL_HIDAPI_backend != &SDL_HIDAPI_hidapi_backend) {
+        /* Whoever replaced the backend also reports its hotplug */
+        SDL_HIDAPI_discovery.m_bCanGetNotifications = SDL_TRUE;
+        SDL_HIDAPI_discovery.m_bIncremental = SDL_TRUE;
+        return;
+    }
 
 #if defined(__WIN32__)
     SDL_HIDAPI_discovery.m_nThreadID = SDL_ThreadID();
@@ -274,23 +440,17 @@ HIDAPI_InitializeDiscovery()
 #endif // __MACOSX__
 
 #if defined(SDL_USE_LIBUDEV)
-    SDL_HIDAPI_discovery.m_pUdev = NULL;
-    SDL_HIDAPI_discovery.m_pUdevMonitor = NULL;
-    SDL_HIDAPI_discovery.m_nUdevFd = -1;
-
-    usyms = SDL_UDEV_GetUdevSyms();
-    if (usyms) {
-        SDL_HIDAPI_discovery.m_pUdev = usyms->udev_new();
-    }
-    if (SDL_HIDAPI_discovery.m_pUdev) {
-        SDL_HIDAPI_discovery.m_pUdevMonitor = usyms->udev_monitor_new_from_netlink(SDL_HIDAPI_discovery.m_pUdev, "udev");
-        if (SDL_HIDAPI_discovery.m_pUdevMonitor) {
-            usyms->udev_monitor_enable_receiving(SDL_HIDAPI_discovery.m_pUdevMonitor);
-            SDL_HIDAPI_discovery.m_nUdevFd = usyms->udev_monitor_get_fd(SDL_HIDAPI_discovery.m_pUdevMonitor);
+    /* Share the udev monitor, which tells us the vendor and product of raw HID and USB devices as they come and go */
+    SDL_HIDAPI_discovery.m_bUdevCallback = SDL_FALSE;
+    if (SDL_UDEV_Init() == 0) {
+        if (SDL_UDEV_AddCallback(HIDAPI_UdevCallback) < 0) {
+            SDL_UDEV_Quit();
+        } else {
+            SDL_HIDAPI_discovery.m_bUdevCallback = SDL_TRUE;
             SDL_HIDAPI_discovery.m_bCanGetNotifications = SDL_TRUE;
+            SDL_HIDAPI_discovery.m_bIncremental = SDL_TRUE;
         }
     }
-
 #endif /* SDL_USE_LIBUDEV */
 }
 
@@ -332,29 +492,9 @@ HIDAPI_UpdateDiscovery()
 #endif
 
 #if defined(SDL_USE_LIBUDEV)
-    if (SDL_HIDAPI_discovery.m_nUdevFd >= 0) {
-        /* Drain all notification events.
-         * We don't expect a lot of device notifications so just
-         * do a new discovery on any kind or number of notifications.
-         * This could be made more restrictive if necessary.
-         */
-        for (;;) {
-            struct pollfd PollUdev;
-            struct udev_device *pUdevDevice;
-
-            PollUdev.fd = SDL_HIDAPI_discovery.m_nUdevFd;
-            PollUdev.events = POLLIN;
-            if (poll(&PollUdev, 1, 0) != 1) {
-                break;
-            }
-
-            SDL_HIDAPI_discovery.m_bHaveDevicesChanged = SDL_TRUE;
-
-            pUdevDevice = usyms->udev_monitor_receive_device(SDL_HIDAPI_discovery.m_pUdevMonitor);
-            if (pUdevDevice) {
-                usyms->udev_device_unref(pUdevDevice);
-            }
-        }
+    if (SDL_HIDAPI_discovery.m_bUdevCallback) {
+        /* Our callback sees whatever arrived since the last poll, whoever polls first */
+        SDL_UDEV_Poll();
     }
 #endif
 }
@@ -380,17 +520,14 @@ HIDAPI_ShutdownDiscovery()
 #endif
 
 #if defined(SDL_USE_LIBUDEV)
-    if (usyms) {
-        if (SDL_HIDAPI_discovery.m_pUdevMonitor) {
-            usyms->udev_monitor_unref(SDL_HIDAPI_discovery.m_pUdevMonitor);
-        }
-        if (SDL_HIDAPI_discovery.m_pUdev) {
-            usyms->udev_unref(SDL_HIDAPI_discovery.m_pUdev);
-        }
-        SDL_UDEV_ReleaseUdevSyms();
-        usyms = NULL;
+    if (SDL_HIDAPI_discovery.m_bUdevCallback) {
+        SDL_UDEV_DelCallback(HIDAPI_UdevCallback);
+        SDL_UDEV_Quit();
+        SDL_HIDAPI_discovery.m_bUdevCallback = SDL_FALSE;
     }
 #endif
+
+    SDL_HIDAPI_discovery.m_bIncremental = SDL_FALSE;
 }
 
 
@@ -634,6 +771,8 @@ HIDAPI_GetJoystickByInfo(const char *path, Uint16 vendor_id, Uint16 product_id)
     return device;
 }
 
+static void HIDAPI_UpdateDeviceList(void);
+
 static void SDLCALL
 SDL_HIDAPIDriverHintChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
 {
@@ -656,6 +795,12 @@ SDL_HIDAPIDriverHintChanged(void *userdata, const char *name, const char *oldVal
         }
     }
 
+    /* Devices without a driver aren't followed by incremental updates, so make sure they're still there */
+    if (SDL_HIDAPI_discovery.m_bIncremental) {
+        HIDAPI_UpdateDeviceList();
+        device = SDL_HIDAPI_devices;
+    }
+
     /* Update device list if driver availability changes */
     while (device) {
         if (device->driver) {
@@ -856,20 +1001,21 @@ HIDAPI_DelDevice(SDL_HIDAPI_Device *device, SDL_bool send_event)
 }
 
 static void
-HIDAPI_UpdateDeviceList(void)
+HIDAPI_UpdateDevices(Uint16 vendor_id, Uint16 product_id)
 {
+    const SDL_bool all = (!vendor_id && !product_id);
     SDL_HIDAPI_Device *device;
     struct hid_device_info *devs, *info;
 
-    /* Prepare the existing device list */
+    /* Prepare the existing device list, only devices we enumerate can go away */
     device = SDL_HIDAPI_devices;
     while (device) {
-        device->seen = SDL_FALSE;
+        device->seen = !all && (device->vendor_id != vendor_id || device->product_id != product_id);
         device = device->next;
     }
 
     /* Enumerate the devices */
-    devs = hid_enumerate(0, 0);
+    devs = SDL_HIDAPI_backend->Enumerate(vendor_id, product_id);
     if (devs) {
         for (info = devs; info; info = info->next) {
             device = HIDAPI_GetJoystickByInfo(info->path, info->vendor_id, info->product_id);
@@ -879,7 +1025,7 @@ HIDAPI_UpdateDeviceList(void)
                 HIDAPI_AddDevice(info);
             }
         }
-        hid_free_enumeration(devs);
+        SDL_HIDAPI_backend->FreeEnumeration(devs);
     }
 
     /* Remove any devices that weren't seen */
@@ -894,6 +1040,49 @@ HIDAPI_UpdateDeviceList(void)
     }
 }
 
+static void
+HIDAPI_UpdateDeviceList(void)
+{
+    HIDAPI_UpdateDevices(0, 0);
+
+    SDL_HIDAPI_discovery.m_bJoysticksChanged = SDL_FALSE;
+    SDL_HIDAPI_discovery.m_nChangedDevices = 0;
+}
+
+static void
+HIDAPI_UpdateChangedDevices(void)
+{
+    int i;
+
+    if (SDL_HIDAPI_discovery.m_bJoysticksChanged) {
+        SDL_HIDAPI_Device *device;
+
+        /* Something went away, check again for each kind of joystick we have */
+        SDL_HIDAPI_discovery.m_bJoysticksChanged = SDL_FALSE;
+        for (device = SDL_HIDAPI_devices; device; device = device->next) {
+            if (device->driver) {
+                HIDAPI_AddChangedDevice(device->vendor_id, device->product_id);
+            }
+        }
+        if (SDL_HIDAPI_discovery.m_bHaveDevicesChanged) {
+            HIDAPI_UpdateDeviceList();
+            SDL_HIDAPI_discovery.m_bHaveDevicesChanged = SDL_FALSE;
+            return;
+        }
+    }
+
+    for (i = 0; i < SDL_HIDAPI_discovery.m_nChangedDevices; ++i) {
+        const Uint16 vendor_id = SDL_HIDAPI_discovery.m_changedDevices[i].vendor_id;
+        const Uint16 product_id = SDL_HIDAPI_discovery.m_changedDevices[i].product_id;
+
+        /* Keyboards, mice and the like never need enumerating */
+        if (HIDAPI_IsDeviceSupported(vendor_id, product_id, 0)) {
+            HIDAPI_UpdateDevices(vendor_id, product_id);
+        }
+    }
+    SDL_HIDAPI_discovery.m_nChangedDevices = 0;
+}
+
 SDL_bool
 HIDAPI_IsDevicePresent(Uint16 vendor_id, Uint16 product_id, Uint16 version)
 {
@@ -904,8 +1093,12 @@ HIDAPI_IsDevicePresent(Uint16 vendor_id, Uint16 product_id, Uint16 version)
         return SDL_FALSE;
     }
 
-    /* Make sure the device list is completely up to date when we check for device presence */
-    HIDAPI_UpdateDeviceList();
+    /* Make sure the device list is up to date for this device when we check for device presence */
+    if (SDL_HIDAPI_discovery.m_bIncremental) {
+        HIDAPI_UpdateDevices(vendor_id, product_id);
+    } else {
+        HIDAPI_UpdateDeviceList();
+    }
 
     device = SDL_HIDAPI_devices;
     while (device) {
@@ -925,6 +1118,8 @@ HIDAPI_JoystickDetect(void)
         /* FIXME: We probably need to schedule an update in a few seconds as well */
         HIDAPI_UpdateDeviceList();
         SDL_HIDAPI_discovery.m_bHaveDevicesChanged = SDL_FALSE;
+    } else if (SDL_HIDAPI_discovery.m_bJoysticksChanged || SDL_HIDAPI_discovery.m_nChangedDevices > 0) {
+        HIDAPI_UpdateChangedDevices();
     }
 }
 
@@ -952,6 +1147,122 @@ HIDAPI_JoystickGetDeviceInstanceID(int device_index)
     return HIDAPI_GetJoystickByIndex(device_index)->instance_id;
 }
 
+/* Publish a copy of the reader's state, and take back the buffer that was published before */
+static void
+HIDAPI_PublishState(struct joystick_hwdata *hwdata)
+{
+    SDL_HIDAPI_ButtonEdges *edges = &hwdata->edges[hwdata->back];
+    int published;
+
+    SDL_memcpy(hwdata->buffers[hwdata->back], hwdata->state, hwdata->driver->state_size);
+    do {
+        published = SDL_AtomicGet(&hwdata->published);
+
+        /* Edges in a buffer the main thread hasn't taken would be lost with it, so they
+           move on to this one. If the main thread takes it meanwhile, this starts over. */
+        *edges = hwdata->pending;
+        if (published & SDL_HIDAPI_STATE_NEW) {
+            const SDL_HIDAPI_ButtonEdges *untaken = &hwdata->edges[published & ~SDL_HIDAPI_STATE_NEW];
+            edges->pressed |= untaken->pressed;
+            edges->released |= untaken->released;
+        }
+        SDL_MemoryBarrierRelease();
+    } while (!SDL_AtomicCAS(&hwdata->published, published, hwdata->back | SDL_HIDAPI_STATE_NEW));
+
+    hwdata->back = (published & ~SDL_HIDAPI_STATE_NEW);
+    SDL_zero(hwdata->pending);
+}
+
+static int SDLCALL
+HIDAPI_ReaderThread(void *data)
+{
+    struct joystick_hwdata *hwdata = (struct joystick_hwdata *)data;
+    SDL_HIDAPI_DeviceDriver *driver = hwdata->driver;
+    Uint8 report[SDL_HIDAPI_MAX_REPORT_SIZE];
+    int size;
+
+    while (SDL_AtomicGet(&hwdata->running)) {
+        size = HIDAPI_ReadTimeout(hwdata->dev, report, sizeof(report), SDL_HIDAPI_READER_TIMEOUT_MS);
+        if (size < 0) {
+            SDL_AtomicSet(&hwdata->failed, 1);
+            break;
+        }
+        if (size > 0 && driver->ReadReport(hwdata->dev, hwdata->context, report, size, hwdata->state, &hwdata->pending)) {
+            HIDAPI_PublishState(hwdata);
+        }
+    }
+    return 0;
+}
+
+static SDL_bool
+HIDAPI_StartReader(struct joystick_hwdata *hwdata)
+{
+    SDL_HIDAPI_DeviceDriver *driver = hwdata->driver;
+    int i;
+
+    hwdata->state = (Uint8 *)SDL_calloc(4, driver->state_size);
+    if (!hwdata->state) {
+        SDL_OutOfMemory();
+        return SDL_FALSE;
+    }
+    for (i = 0; i < SDL_arraysize(hwdata->buffers); ++i) {
+        hwdata->buffers[i] = hwdata->state + (i + 1) * driver->state_size;
+    }
+    SDL_zero(hwdata->edges);
+    SDL_zero(hwdata->pending);
+    hwdata->back = 0;
+    hwdata->front = 1;
+    SDL_AtomicSet(&hwdata->published, 2);
+    SDL_AtomicSet(&hwdata->failed, 0);
+    SDL_AtomicSet(&hwdata->running, 1);
+
+    /* Without a thread the reports are read in SDL_JoystickUpdate() instead */
+    hwdata->reader = SDL_CreateThreadInternal(HIDAPI_ReaderThread, "SDLHIDAPIReader", 0, hwdata);
+    return SDL_TRUE;
+}
+
+static void
+HIDAPI_StopReader(struct joystick_hwdata *hwdata)
+{
+    if (hwdata->reader) {
+        SDL_AtomicSet(&hwdata->running, 0);
+        SDL_WaitThread(hwdata->reader, NULL);
+        hwdata->reader = NULL;
+    }
+    SDL_free(hwdata->state);
+    hwdata->state = NULL;
+}
+
+static SDL_bool
+HIDAPI_UpdateReader(SDL_Joystick *joystick, struct joystick_hwdata *hwdata)
+{
+    SDL_HIDAPI_DeviceDriver *driver = hwdata->driver;
+
+    if (hwdata->reader) {
+        if (SDL_AtomicGet(&hwdata->published) & SDL_HIDAPI_STATE_NEW) {
+            hwdata->front = SDL_AtomicSet(&hwdata->published, hwdata->front) & ~SDL_HIDAPI_STATE_NEW;
+            SDL_MemoryBarrierAcquire();
+            driver->UpdateState(joystick, hwdata->dev, hwdata->context, hwdata->buffers[hwdata->front], &hwdata->edges[hwdata->front]);
+        }
+        return !SDL_AtomicGet(&hwdata->failed);
+    } else {
+        Uint8 report[SDL_HIDAPI_MAX_REPORT_SIZE];
+        SDL_bool changed = SDL_FALSE;
+        int size;
+
+        while ((size = HIDAPI_ReadTimeout(hwdata->dev, report, sizeof(report), 0)) > 0) {
+            if (driver->ReadReport(hwdata->dev, hwdata->context, report, size, hwdata->state, &hwdata->pending)) {
+                changed = SDL_TRUE;
+            }
+        }
+        if (changed) {
+            driver->UpdateState(joystick, hwdata->dev, hwdata->context, hwdata->state, &hwdata->pending);
+            SDL_zero(hwdata->pending);
+        }
+        return (size >= 0);
+    }
+}
+
 static int
 HIDAPI_JoystickOpen(SDL_Joystick * joystick, int device_index)
 {
@@ -964,7 +1275,7 @@ HIDAPI_JoystickOpen(SDL_Joystick * joystick, int device_index)
     }
 
     hwdata->driver = device->driver;
-    hwdata->dev = hid_open_path(device->path, 0);
+    hwdata->dev = SDL_HIDAPI_backend->OpenPath(device->path, 0);
     if (!hwdata->dev) {
         SDL_free(hwdata);
         return SDL_SetError("Couldn't open HID device %s", device->path);
@@ -972,7 +1283,16 @@ HIDAPI_JoystickOpen(SDL_Joystick * joystick, int device_index)
     hwdata->mutex = SDL_CreateMutex();
 
     if (!device->driver->Init(joystick, hwdata->dev, device->vendor_id, device->product_id, &hwdata->context)) {
-        hid_close(hwdata->dev);
+        SDL_HIDAPI_backend->Close(hwdata->dev);
+        SDL_DestroyMutex(hwdata->mutex);
+        SDL_free(hwdata);
+        return -1;
+    }
+
+    if (device->driver->ReadReport && !HIDAPI_StartReader(hwdata)) {
+        device->driver->Quit(joystick, hwdata->dev, hwdata->context);
+        SDL_HIDAPI_backend->Close(hwdata->dev);
+        SDL_DestroyMutex(hwdata->mutex);
         SDL_free(hwdata);
         return -1;
     }
@@ -999,10 +1319,15 @@ HIDAPI_JoystickUpdate(SDL_Joystick * joystick)
 {
     struct joystick_hwdata *hwdata = joystick->hwdata;
     SDL_HIDAPI_DeviceDriver *driver = hwdata->driver;
-    SDL_bool succeeded;
+    SDL_bool succeeded = SDL_TRUE;
 
     SDL_LockMutex(hwdata->mutex);
-    succeeded = driver->Update(joystick, hwdata->dev, hwdata->context);
+    if (driver->ReadReport) {
+        succeeded = HIDAPI_UpdateReader(joystick, hwdata);
+    }
+    if (!driver->Update(joystick, hwdata->dev, hwdata->context)) {
+        succeeded = SDL_FALSE;
+    }
     SDL_UnlockMutex(hwdata->mutex);
     
     if (!succeeded) {
@@ -1021,9 +1346,14 @@ HIDAPI_JoystickClose(SDL_Joystick * joystick)
 {
     struct joystick_hwdata *hwdata = joystick->hwdata;
     SDL_HIDAPI_DeviceDriver *driver = hwdata->driver;
+
+    /* The reader uses the context, so it has to stop first */
+    if (driver->ReadReport) {
+        HIDAPI_StopReader(hwdata);
+    }
     driver->Quit(joystick, hwdata->dev, hwdata->context);
 
-    hid_close(hwdata->dev);
+    SDL_HIDAPI_backend->Close(hwdata->dev);
     SDL_DestroyMutex(hwdata->mutex);
     SDL_free(hwdata);
     joystick->hwdata = NULL;
@@ -43,6 +43,14 @@
 #undef SDL_JOYSTICK_HIDAPI_XBOXONE
 #endif
 
+/* Buttons pressed and released by the reports folded into a state, as bit masks of
+   SDL_GameControllerButton, so a quick tap between two updates isn't lost */
+typedef struct _SDL_HIDAPI_ButtonEdges
+{
+    Uint32 pressed;
+    Uint32 released;
+} SDL_HIDAPI_ButtonEdges;
+
 typedef struct _SDL_HIDAPI_DeviceDriver
 {
     const char *hint;
@@ -54,6 +62,16 @@ typedef struct _SDL_HIDAPI_DeviceDriver
     SDL_bool (*Update)(SDL_Joystick *joystick, hid_device *dev, void *context);
     void (*Quit)(SDL_Joystick *joystick, hid_device *dev, void *context);
 
+    /* Optional, for drivers whose input reports are read on a thread of their own.
+       ReadReport runs on that thread and folds a report into a state of state_size bytes,
+       adding the buttons it changed to edges, and returns SDL_TRUE if the state changed.
+       It may only use what Init set up in the context.
+       UpdateState runs before Update with the latest state and the button edges since the
+       last call, and sends events for what changed. */
+    size_t state_size;
+    SDL_bool (*ReadReport)(hid_device *dev, void *context, const Uint8 *data, int size, void *state, SDL_HIDAPI_ButtonEdges *edges);
+    void (*UpdateState)(SDL_Joystick *joystick, hid_device *dev, void *context, const void *state, const SDL_HIDAPI_ButtonEdges *edges);
+
 } SDL_HIDAPI_DeviceDriver;
 
 /* HIDAPI device support */
@@ -66,6 +84,42 @@ extern SDL_HIDAPI_DeviceDriver SDL_HIDAPI_DriverXboxOne;
 /* Return true if a HID device is present and supported as a joystick */
 extern SDL_bool HIDAPI_IsDevicePresent(Uint16 vendor_id, Uint16 product_id, Uint16 version);
 
+/* Where HIDAPI joysticks find and talk to their devices, which can be replaced to test without hardware */
+typedef struct _SDL_HIDAPI_Backend
+{
+    /* Return the devices with this vendor and product, or all of them if both are 0 */
+    struct hid_device_info *(*Enumerate)(unsigned short vendor_id, unsigned short product_id);
+    void (*FreeEnumeration)(struct hid_device_info *devs);
+
+    hid_device *(*OpenPath)(const char *path, int bExclusive);
+    int (*Write)(hid_device *dev, const unsigned char *data, size_t length);
+    int (*ReadTimeout)(hid_device *dev, unsigned char *data, size_t length, int milliseconds);
+    int (*GetFeatureReport)(hid_device *dev, unsigned char *data, size_t length);
+    void (*Close)(hid_device *dev);
+
+} SDL_HIDAPI_Backend;
+
+/* Replace the backend before the joystick subsystem is initialized, or NULL for hidapi.
+   Hotplug notifications then only come from HIDAPI_DeviceAdded() and HIDAPI_DeviceRemoved(). */
+extern void HIDAPI_SetBackend(const SDL_HIDAPI_Backend *backend);
+
+/* Device I/O for drivers, which goes through the backend */
+extern int HIDAPI_Write(hid_device *dev, const Uint8 *data, size_t length);
+extern int HIDAPI_ReadTimeout(hid_device *dev, Uint8 *data, size_t length, int milliseconds);
+extern int HIDAPI_GetFeatureReport(hid_device *dev, Uint8 *data, size_t length);
+
+/* Add the buttons that differ between two button masks to edges */
+extern void HIDAPI_AddButtonEdges(SDL_HIDAPI_ButtonEdges *edges, Uint32 old_buttons, Uint32 new_buttons);
+
+/* Send a press and release, or a release and press, for each button in edges that
+   is back where it was. Call this before sending the changes from last_buttons to buttons. */
+extern void HIDAPI_SendButtonTaps(SDL_Joystick *joystick, Uint32 last_buttons, Uint32 buttons, const SDL_HIDAPI_ButtonEdges *edges);
+
+/* Note that a device appeared or went away, with 0 vendor and product if they aren't known.
+   Only devices with that vendor and product are enumerated again at the next detect. */
+extern void HIDAPI_DeviceAdded(Uint16 vendor_id, Uint16 product_id);
+extern void HIDAPI_DeviceRemoved(Uint16 vendor_id, Uint16 product_id);
+
 /* Return the name of an Xbox 360 or Xbox One controller */
 extern const char *HIDAPI_XboxControllerName(Uint16 vendor_id, Uint16 product_id);
 
@@ -39,6 +39,7 @@
 #include "SDL_assert.h"
 #include "SDL_joystick.h"
 #include "SDL_endian.h"
+#include "SDL_timer.h"
 #include "../../events/SDL_events_c.h"
 #include "../SDL_sysjoystick.h"
 #include "../SDL_joystick_c.h"
@@ -58,6 +59,7 @@ static int MaybeAddDevice(const char *path);
 static int MaybeRemoveDevice(const char *path);
 static void joystick_udev_callback(SDL_UDEV_deviceevent udev_type, int udev_class, const char *devpath);
 #endif /* SDL_USE_LIBUDEV */
+static void LINUX_JoystickDispatch(SDL_EPOLL_Source *source);
 
 
 /* A linked list of available joysticks */
@@ -79,6 +81,11 @@ static SDL_joylist_item *SDL_joylist = NULL;
 static SDL_joylist_item *SDL_joylist_tail = NULL;
 static int numjoysticks = 0;
 
+/* Whether the shared epoll set has been checked since the last detect, so
+   each SDL_JoystickUpdate() makes one system call however many joysticks
+   are open */
+static SDL_bool epoll_polled = SDL_FALSE;
+
 
 #define test_bit(nr, addr) \
     (((1UL << ((nr) % (sizeof(long) * 8))) & ((addr)[(nr) / (sizeof(long) * 8)])) != 0)
@@ -515,6 +522,8 @@ static void SteamControllerDisconnectedCallback(int device_instance)
 static int
 LINUX_JoystickInit(void)
 {
+    SDL_EPOLL_Init();
+
     /* First see if the user specified one or more joysticks to use */
     if (SDL_getenv("SDL_JOYSTICK_DEVICE") != NULL) {
         char *envcopy, *envpath, *delim;
@@ -550,6 +559,11 @@ LINUX_JoystickGetCount(void)
 static void
 LINUX_JoystickDetect(void)
 {
+    if (!epoll_polled) {
+        SDL_EPOLL_Poll();
+    }
+    epoll_polled = SDL_FALSE;
+
 #if SDL_USE_LIBUDEV
     SDL_UDEV_Poll();
 #endif
@@ -801,6 +815,8 @@ LINUX_JoystickOpen(SDL_Joystick * joystick, int device_index)
 
         /* Set the joystick to non-blocking read mode */
         fcntl(fd, F_SETFL, O_NONBLOCK);
+        joystick->hwdata->monotonic_time = SDL_EPOLL_SetMonotonicEventTime(fd);
+        SDL_EPOLL_AddSource(&joystick->hwdata->source, fd, LINUX_JoystickDispatch, joystick);
 
         /* Get the number of buttons and axes on the joystick */
         ConfigJoystick(joystick, fd);
@@ -953,21 +969,20 @@ PollAllValues(SDL_Joystick * joystick)
     }
 }
 
-static SDL_INLINE void
+/* Read everything the joystick has queued, called with the joysticks locked */
+static void
 HandleInputEvents(SDL_Joystick * joystick)
 {
     struct input_event events[32];
     int i, len;
     int code;
 
-    if (joystick->hwdata->fresh) {
-        PollAllValues(joystick);
-        joystick->hwdata->fresh = 0;
-    }
-
     while ((len = read(joystick->hwdata->fd, events, (sizeof events))) > 0) {
         len /= sizeof(events[0]);
         for (i = 0; i < len; ++i) {
+            /* Events are stamped with the time the kernel saw them */
+            SDL_SetEventTimestamp(SDL_EPOLL_GetEventTicks(events[i].time.tv_sec, events[i].time.tv_usec, joystick->hwdata->monotonic_time));
+
             code = events[i].code;
             switch (events[i].type) {
             case EV_KEY:
@@ -1024,6 +1039,21 @@ HandleInputEvents(SDL_Joystick * joystick)
             }
         }
     }
+    SDL_SetEventTimestamp(0);
+}
+
+/* Called on the input thread when an open joystick has input */
+static void
+LINUX_JoystickDispatch(SDL_EPOLL_Source *source)
+{
+    while (SDL_TryLockJoysticks() != 0) {
+        if (!SDL_EPOLL_CanDispatch(source)) {
+            return;
+        }
+        SDL_Delay(0);
+    }
+    HandleInputEvents((SDL_Joystick *) source->data);
+    SDL_UnlockJoysticks();
 }
 
 static void
@@ -1036,7 +1066,21 @@ LINUX_JoystickUpdate(SDL_Joystick * joystick)
         return;
     }
 
-    HandleInputEvents(joystick);
+    /* The input thread may be reading this joystick too */
+    SDL_LockJoysticks();
+
+    if (joystick->hwdata->fresh) {
+        PollAllValues(joystick);
+        joystick->hwdata->fresh = 0;
+    }
+
+    if (!epoll_polled) {
+        SDL_EPOLL_Poll();
+        epoll_polled = SDL_TRUE;
+    }
+    if (SDL_EPOLL_TakeReady(&joystick->hwdata->source)) {
+        HandleInputEvents(joystick);
+    }
 
     /* Deliver ball motion updates */
     for (i = 0; i < joystick->nballs; ++i) {
@@ -1050,6 +1094,8 @@ LINUX_JoystickUpdate(SDL_Joystick * joystick)
             SDL_PrivateJoystickBall(joystick, (Uint8) i, xrel, yrel);
         }
     }
+
+    SDL_UnlockJoysticks();
 }
 
 /* Function to close a joystick after use */
@@ -1062,6 +1108,7 @@ LINUX_JoystickClose(SDL_Joystick * joystick)
             joystick->hwdata->effect.id = -1;
         }
         if (joystick->hwdata->fd >= 0) {
+            SDL_EPOLL_RemoveSource(&joystick->hwdata->source);
             close(joystick->hwdata->fd);
         }
         if (joystick->hwdata->item) {
@@ -1098,6 +1145,8 @@ LINUX_JoystickQuit(void)
 #endif
 
     SDL_QuitSteamControllers();
+
+    SDL_EPOLL_Quit();
 }
 
 SDL_JoystickDriver SDL_LINUX_JoystickDriver =
@@ -24,12 +24,16 @@
 
 #include <linux/input.h>
 
+#include "../../core/linux/SDL_epoll.h"
+
 struct SDL_joylist_item;
 
 /* The private structure used to keep track of a joystick */
 struct joystick_hwdata
 {
     int fd;
+    SDL_EPOLL_Source source;
+    SDL_bool monotonic_time;
     struct SDL_joylist_item *item;
     SDL_JoystickGUID guid;
     char *fname;                /* Used in haptic subsystem */
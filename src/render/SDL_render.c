@@ -28,6 +28,7 @@
 #include "SDL_render.h"
 #include "SDL_sysrender.h"
 #include "software/SDL_render_sw_c.h"
+#include "../SDL_profile_c.h"
 
 
 #define SDL_WINDOWRENDERDATA    "_SDL_WindowRenderData"
@@ -379,6 +380,7 @@ SDL_CreateRenderer(SDL_Window * window, int index, Uint32 flags)
         renderer->scale.y = 1.0f;
         renderer->dpi_scale.x = 1.0f;
         renderer->dpi_scale.y = 1.0f;
+        renderer->stats_blendMode = SDL_BLENDMODE_INVALID;
 
         if (window && renderer->GetOutputSize) {
             int window_w, window_h;
@@ -425,6 +427,7 @@ SDL_CreateSoftwareRenderer(SDL_Surface * surface)
         renderer->target_mutex = SDL_CreateMutex();
         renderer->scale.x = 1.0f;
         renderer->scale.y = 1.0f;
+        renderer->stats_blendMode = SDL_BLENDMODE_INVALID;
 
         SDL_RenderSetViewport(renderer, NULL);
     }
@@ -1247,6 +1250,7 @@ SDL_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
         renderer->logical_h_backup = renderer->logical_h;
     }
     renderer->target = texture;
+    ++renderer->stats.state_changes;
 
     if (renderer->SetRenderTarget(renderer, texture) < 0) {
         SDL_UnlockMutex(renderer->target_mutex);
@@ -1469,6 +1473,7 @@ SDL_RenderSetViewport(SDL_Renderer * renderer, const SDL_Rect * rect)
             return -1;
         }
     }
+    ++renderer->stats.state_changes;
     return renderer->UpdateViewport(renderer);
 }
 
@@ -1500,6 +1505,7 @@ SDL_RenderSetClipRect(SDL_Renderer * renderer, const SDL_Rect * rect)
         renderer->clipping_enabled = SDL_FALSE;
         SDL_zero(renderer->clip_rect);
     }
+    ++renderer->stats.state_changes;
     return renderer->UpdateClipRect(renderer);
 }
 
@@ -1601,6 +1607,26 @@ SDL_GetRenderDrawBlendMode(SDL_Renderer * renderer, SDL_BlendMode *blendMode)
     return 0;
 }
 
+static void
+RenderStatsDraw(SDL_Renderer * renderer, SDL_BlendMode blendMode)
+{
+    ++renderer->stats.draw_calls;
+    if (blendMode != renderer->stats_blendMode) {
+        ++renderer->stats.blend_changes;
+        renderer->stats_blendMode = blendMode;
+    }
+}
+
+static void
+RenderStatsCopy(SDL_Renderer * renderer, SDL_Texture * texture)
+{
+    RenderStatsDraw(renderer, texture->blendMode);
+    if (texture != renderer->stats_texture) {
+        ++renderer->stats.texture_binds;
+        renderer->stats_texture = texture;
+    }
+}
+
 int
 SDL_RenderClear(SDL_Renderer * renderer)
 {
@@ -1610,6 +1636,7 @@ SDL_RenderClear(SDL_Renderer * renderer)
     if (renderer->hidden) {
         return 0;
     }
+    ++renderer->stats.draw_calls;
     return renderer->RenderClear(renderer);
 }
 
@@ -1642,6 +1669,7 @@ RenderDrawPointsWithRects(SDL_Renderer * renderer,
         frects[i].h = renderer->scale.y;
     }
 
+    RenderStatsDraw(renderer, renderer->blendMode);
     status = renderer->RenderFillRects(renderer, frects, count);
 
     SDL_stack_free(frects);
@@ -1684,6 +1712,7 @@ SDL_RenderDrawPoints(SDL_Renderer * renderer,
         fpoints[i].y = points[i].y * renderer->scale.y;
     }
 
+    RenderStatsDraw(renderer, renderer->blendMode);
     status = renderer->RenderDrawPoints(renderer, fpoints, count);
 
     SDL_stack_free(fpoints);
@@ -1745,10 +1774,12 @@ RenderDrawLinesWithRects(SDL_Renderer * renderer,
             fpoints[0].y = points[i].y * renderer->scale.y;
             fpoints[1].x = points[i+1].x * renderer->scale.x;
             fpoints[1].y = points[i+1].y * renderer->scale.y;
+            RenderStatsDraw(renderer, renderer->blendMode);
             status += renderer->RenderDrawLines(renderer, fpoints, 2);
         }
     }
 
+    RenderStatsDraw(renderer, renderer->blendMode);
     status += renderer->RenderFillRects(renderer, frects, nrects);
 
     SDL_stack_free(frects);
@@ -1794,6 +1825,7 @@ SDL_RenderDrawLines(SDL_Renderer * renderer,
         fpoints[i].y = points[i].y * renderer->scale.y;
     }
 
+    RenderStatsDraw(renderer, renderer->blendMode);
     status = renderer->RenderDrawLines(renderer, fpoints, count);
 
     SDL_stack_free(fpoints);
@@ -1908,6 +1940,7 @@ SDL_RenderFillRects(SDL_Renderer * renderer,
         frects[i].h = rects[i].h * renderer->scale.y;
     }
 
+    RenderStatsDraw(renderer, renderer->blendMode);
     status = renderer->RenderFillRects(renderer, frects, count);
 
     SDL_stack_free(frects);
@@ -1964,6 +1997,7 @@ SDL_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
     frect.w = real_dstrect.w * renderer->scale.x;
     frect.h = real_dstrect.h * renderer->scale.y;
 
+    RenderStatsCopy(renderer, texture);
     return renderer->RenderCopy(renderer, texture, &real_srcrect, &frect);
 }
 
@@ -2036,6 +2070,7 @@ SDL_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
     fcenter.x = real_center.x * renderer->scale.x;
     fcenter.y = real_center.y * renderer->scale.y;
 
+    RenderStatsCopy(renderer, texture);
     return renderer->RenderCopyEx(renderer, texture, &real_srcrect, &frect, angle, &fcenter, flip);
 }
 
@@ -2085,7 +2120,53 @@ SDL_RenderPresent(SDL_Renderer * renderer)
     if (renderer->hidden) {
         return;
     }
+    SDL_PROFILE_ZONE_BEGIN("SDL_RenderPresent");
     renderer->RenderPresent(renderer);
+    SDL_PROFILE_ZONE_END("SDL_RenderPresent");
+
+    /* Start counting the next frame */
+    ++renderer->stats.frame;
+    renderer->stats_history[renderer->stats.frame % SDL_RENDER_STATS_HISTORY] = renderer->stats;
+    renderer->stats.draw_calls = 0;
+    renderer->stats.texture_binds = 0;
+    renderer->stats.blend_changes = 0;
+    renderer->stats.state_changes = 0;
+    renderer->stats.texture_uploads = 0;
+    renderer->stats.bytes_uploaded = 0;
+}
+
+int
+SDL_GetRenderStats(SDL_Renderer * renderer, SDL_RenderStats * stats)
+{
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+    if (renderer->stats.frame == 0) {
+        SDL_zerop(stats);
+        return 0;
+    }
+    *stats = renderer->stats_history[renderer->stats.frame % SDL_RENDER_STATS_HISTORY];
+    return 0;
+}
+
+int
+SDL_GetRenderStatsHistory(SDL_Renderer * renderer, SDL_RenderStats * stats, int count)
+{
+    int i;
+
+    CHECK_RENDERER_MAGIC(renderer, -1);
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+    count = SDL_min(count, SDL_RENDER_STATS_HISTORY);
+    count = SDL_min(count, (int) SDL_min(renderer->stats.frame, SDL_RENDER_STATS_HISTORY));
+    for (i = 0; i < count; ++i) {
+        stats[i] = renderer->stats_history[(renderer->stats.frame - i) % SDL_RENDER_STATS_HISTORY];
+    }
+    return SDL_max(count, 0);
 }
 
 void
@@ -2099,6 +2180,9 @@ SDL_DestroyTexture(SDL_Texture * texture)
     if (texture == renderer->target) {
         SDL_SetRenderTarget(renderer, NULL);
     }
+    if (texture == renderer->stats_texture) {
+        renderer->stats_texture = NULL;
+    }
 
     texture->magic = NULL;
 
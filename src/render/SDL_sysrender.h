@@ -178,9 +178,22 @@ struct SDL_Renderer
     Uint8 r, g, b, a;                   /**< Color for drawing operations values */
     SDL_BlendMode blendMode;            /**< The drawing blend mode */
 
+    /* Statistics of the frame being drawn, and of the frames presented */
+    SDL_RenderStats stats;
+    SDL_RenderStats stats_history[SDL_RENDER_STATS_HISTORY];
+    SDL_Texture *stats_texture;         /**< The texture of the last copy */
+    SDL_BlendMode stats_blendMode;      /**< The blend mode of the last draw */
+
     void *driverdata;
 };
 
+/* Backends call this for every texture upload they carry out */
+#define SDL_RENDER_STATS_UPLOAD(renderer, bytes) \
+    do { \
+        ++(renderer)->stats.texture_uploads; \
+        (renderer)->stats.bytes_uploaded += (Uint64) (bytes); \
+    } while (0)
+
 /* Define the SDL render driver structure */
 struct SDL_RenderDriver
 {
@@ -960,6 +960,12 @@ GL_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
     }
     renderdata->glDisable(data->type);
 
+    if (data->yuv || data->nv12) {
+        SDL_RENDER_STATS_UPLOAD(renderer, rect->w * rect->h * texturebpp + 2 * ((rect->w + 1) / 2) * ((rect->h + 1) / 2));
+    } else {
+        SDL_RENDER_STATS_UPLOAD(renderer, rect->w * rect->h * texturebpp);
+    }
+
     return GL_CheckError("glTexSubImage2D()", renderer);
 }
 
@@ -996,6 +1002,8 @@ GL_UpdateTextureYUV(SDL_Renderer * renderer, SDL_Texture * texture,
                                 data->format, data->formattype, Vplane);
     renderdata->glDisable(data->type);
 
+    SDL_RENDER_STATS_UPLOAD(renderer, rect->w * rect->h + 2 * ((rect->w + 1) / 2) * ((rect->h + 1) / 2));
+
     return GL_CheckError("glTexSubImage2D()", renderer);
 }
 
@@ -822,6 +822,12 @@ GLES2_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_Rect
                 pixels, 2 * ((pitch + 1) / 2), 2);
     }
 
+    if (tdata->yuv || tdata->nv12) {
+        SDL_RENDER_STATS_UPLOAD(renderer, rect->w * rect->h * SDL_BYTESPERPIXEL(texture->format) + 2 * ((rect->w + 1) / 2) * ((rect->h + 1) / 2));
+    } else {
+        SDL_RENDER_STATS_UPLOAD(renderer, rect->w * rect->h * SDL_BYTESPERPIXEL(texture->format));
+    }
+
     return GL_CheckError("glTexSubImage2D()", renderer);
 }
 
@@ -872,6 +878,8 @@ GLES2_UpdateTextureYUV(SDL_Renderer * renderer, SDL_Texture * texture,
                     tdata->pixel_type,
                     Yplane, Ypitch, 1);
 
+    SDL_RENDER_STATS_UPLOAD(renderer, rect->w * rect->h + 2 * ((rect->w + 1) / 2) * ((rect->h + 1) / 2));
+
     return GL_CheckError("glTexSubImage2D()", renderer);
 }
 
@@ -33,6 +33,8 @@
 #include "SDL_drawline.h"
 #include "SDL_drawpoint.h"
 #include "SDL_rotate.h"
+#include "SDL_tilebin.h"
+#include "../../video/SDL_rect_c.h"
 
 /* SDL surface based renderer implementation */
 
@@ -95,13 +97,52 @@ SDL_RenderDriver SW_RenderDriver = {
      0}
 };
 
+/* Present the whole window when the dirty rects cover more than this
+   percentage of it, one contiguous copy is cheaper then */
+#define SW_FULL_UPDATE_COVERAGE 50
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+
+    /* The areas of the window surface drawn since the last present */
+    SDL_Rect dirty[SDL_MAX_DIRTY_RECTS];
+    int numdirty;
+    SDL_bool full_update;
+
+    /* Records draws for worker threads, if SDL_HINT_RENDER_SOFTWARE_THREADS
+       asks for them */
+    SDL_TileBinner *binner;
 } SW_RenderData;
 
 
+/* Finish the draws recorded for the worker threads */
+static void
+SW_FlushDraws(SW_RenderData * data)
+{
+    if (data->binner) {
+        SDL_FlushTileBinner(data->binner);
+    }
+}
+
+
+/* Remember where a draw changed the window surface, so the present only
+   has to update those areas */
+static void
+SW_AddDirtyRect(SW_RenderData * data, const SDL_Rect * rect)
+{
+    SDL_Rect dirty;
+
+    if (data->surface != data->window || data->full_update) {
+        return;
+    }
+    if (SDL_IntersectRect(rect, &data->surface->clip_rect, &dirty)) {
+        SDL_AddDirtyRect(data->dirty, &data->numdirty, SDL_MAX_DIRTY_RECTS, &dirty);
+    }
+}
+
+
 static SDL_Surface *
 SW_ActivateRenderer(SDL_Renderer * renderer)
 {
@@ -114,6 +155,7 @@ SW_ActivateRenderer(SDL_Renderer * renderer)
         SDL_Surface *surface = SDL_GetWindowSurface(renderer->window);
         if (surface) {
             data->surface = data->window = surface;
+            data->full_update = SDL_TRUE;
 
             SW_UpdateViewport(renderer);
             SW_UpdateClipRect(renderer);
@@ -127,6 +169,7 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
 {
     SDL_Renderer *renderer;
     SW_RenderData *data;
+    const char *hint;
 
     if (!surface) {
         SDL_SetError("Can't create renderer for NULL surface");
@@ -147,6 +190,13 @@ SW_CreateRendererForSurface(SDL_Surface * surface)
     }
     data->surface = surface;
     data->window = surface;
+    data->full_update = SDL_TRUE;
+
+    hint = SDL_GetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+    if (hint && SDL_atoi(hint) > 1) {
+        /* Without the threads everything is drawn directly, which is fine */
+        data->binner = SDL_CreateTileBinner(SDL_atoi(hint));
+    }
 
     renderer->WindowEvent = SW_WindowEvent;
     renderer->GetOutputSize = SW_GetOutputSize;
@@ -196,8 +246,12 @@ SW_WindowEvent(SDL_Renderer * renderer, const SDL_WindowEvent *event)
     SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
 
     if (event->event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+        SW_FlushDraws(data);
         data->surface = NULL;
         data->window = NULL;
+    } else if (event->event == SDL_WINDOWEVENT_EXPOSED) {
+        /* The window system lost what was presented before */
+        data->full_update = SDL_TRUE;
     }
 }
 
@@ -301,6 +355,8 @@ SW_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
     int row;
     size_t length;
 
+    SW_FlushDraws((SW_RenderData *) renderer->driverdata);
+
     if(SDL_MUSTLOCK(surface))
         SDL_LockSurface(surface);
     src = (Uint8 *) pixels;
@@ -315,6 +371,7 @@ SW_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
     }
     if(SDL_MUSTLOCK(surface))
         SDL_UnlockSurface(surface);
+    SDL_RENDER_STATS_UPLOAD(renderer, rect->h * length);
     return 0;
 }
 
@@ -324,16 +381,21 @@ SW_LockTexture(SDL_Renderer * renderer, SDL_Texture * texture,
 {
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
 
+    SW_FlushDraws((SW_RenderData *) renderer->driverdata);
+
     *pixels =
         (void *) ((Uint8 *) surface->pixels + rect->y * surface->pitch +
                   rect->x * surface->format->BytesPerPixel);
     *pitch = surface->pitch;
+    texture->locked_rect = *rect;
     return 0;
 }
 
 static void
 SW_UnlockTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
+    /* The pixels were written in place, count them as uploaded */
+    SDL_RENDER_STATS_UPLOAD(renderer, texture->locked_rect.w * texture->locked_rect.h * SDL_BYTESPERPIXEL(texture->format));
 }
 
 static int
@@ -341,6 +403,8 @@ SW_SetRenderTarget(SDL_Renderer * renderer, SDL_Texture * texture)
 {
     SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
 
+    SW_FlushDraws(data);
+
     if (texture ) {
         data->surface = (SDL_Surface *) texture->driverdata;
     } else {
@@ -387,6 +451,7 @@ SW_UpdateClipRect(SDL_Renderer * renderer)
 static int
 SW_RenderClear(SDL_Renderer * renderer)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     Uint32 color;
     SDL_Rect clip_rect;
@@ -398,10 +463,19 @@ SW_RenderClear(SDL_Renderer * renderer)
     color = SDL_MapRGBA(surface->format,
                         renderer->r, renderer->g, renderer->b, renderer->a);
 
+    if (surface == data->window) {
+        data->full_update = SDL_TRUE;
+    }
+
     /* By definition the clear ignores the clip rect */
     clip_rect = surface->clip_rect;
     SDL_SetClipRect(surface, NULL);
-    SDL_FillRect(surface, NULL, color);
+    if (!data->binner ||
+        !SDL_TileBinFillRect(data->binner, surface, NULL, SDL_BLENDMODE_NONE,
+                             renderer->r, renderer->g, renderer->b, renderer->a)) {
+        SW_FlushDraws(data);
+        SDL_FillRect(surface, NULL, color);
+    }
     SDL_SetClipRect(surface, &clip_rect);
     return 0;
 }
@@ -410,13 +484,16 @@ static int
 SW_RenderDrawPoints(SDL_Renderer * renderer, const SDL_FPoint * points,
                     int count)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Point *final_points;
+    SDL_Rect bounds;
     int i, status;
 
     if (!surface) {
         return -1;
     }
+    SW_FlushDraws(data);
 
     final_points = SDL_stack_alloc(SDL_Point, count);
     if (!final_points) {
@@ -437,6 +514,10 @@ SW_RenderDrawPoints(SDL_Renderer * renderer, const SDL_FPoint * points,
         }
     }
 
+    if (SDL_EnclosePoints(final_points, count, NULL, &bounds)) {
+        SW_AddDirtyRect(data, &bounds);
+    }
+
     /* Draw the points! */
     if (renderer->blendMode == SDL_BLENDMODE_NONE) {
         Uint32 color = SDL_MapRGBA(surface->format,
@@ -459,13 +540,16 @@ static int
 SW_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
                    int count)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Point *final_points;
+    SDL_Rect bounds;
     int i, status;
 
     if (!surface) {
         return -1;
     }
+    SW_FlushDraws(data);
 
     final_points = SDL_stack_alloc(SDL_Point, count);
     if (!final_points) {
@@ -486,6 +570,12 @@ SW_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
         }
     }
 
+    for (i = 0; i < count - 1; ++i) {
+        if (SDL_EnclosePoints(&final_points[i], 2, NULL, &bounds)) {
+            SW_AddDirtyRect(data, &bounds);
+        }
+    }
+
     /* Draw the lines! */
     if (renderer->blendMode == SDL_BLENDMODE_NONE) {
         Uint32 color = SDL_MapRGBA(surface->format,
@@ -507,6 +597,7 @@ SW_RenderDrawLines(SDL_Renderer * renderer, const SDL_FPoint * points,
 static int
 SW_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Rect *final_rects;
     int i, status;
@@ -537,8 +628,31 @@ SW_RenderFillRects(SDL_Renderer * renderer, const SDL_FRect * rects, int count)
             final_rects[i].h = SDL_max((int)rects[i].h, 1);
         }
     }
+    for (i = 0; i < count; ++i) {
+        SW_AddDirtyRect(data, &final_rects[i]);
+    }
 
-    if (renderer->blendMode == SDL_BLENDMODE_NONE) {
+    if (data->binner) {
+        status = 0;
+        for (i = 0; i < count; ++i) {
+            if (SDL_TileBinFillRect(data->binner, surface, &final_rects[i], renderer->blendMode,
+                                    renderer->r, renderer->g, renderer->b, renderer->a)) {
+                continue;
+            }
+            SDL_FlushTileBinner(data->binner);
+            if (renderer->blendMode == SDL_BLENDMODE_NONE) {
+                status = SDL_FillRect(surface, &final_rects[i],
+                                      SDL_MapRGBA(surface->format,
+                                                  renderer->r, renderer->g,
+                                                  renderer->b, renderer->a));
+            } else {
+                status = SDL_BlendFillRect(surface, &final_rects[i],
+                                           renderer->blendMode,
+                                           renderer->r, renderer->g,
+                                           renderer->b, renderer->a);
+            }
+        }
+    } else if (renderer->blendMode == SDL_BLENDMODE_NONE) {
         Uint32 color = SDL_MapRGBA(surface->format,
                                    renderer->r, renderer->g, renderer->b,
                                    renderer->a);
@@ -558,6 +672,7 @@ static int
 SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
               const SDL_Rect * srcrect, const SDL_FRect * dstrect)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Surface *src = (SDL_Surface *) texture->driverdata;
     SDL_Rect final_rect;
@@ -575,10 +690,17 @@ SW_RenderCopy(SDL_Renderer * renderer, SDL_Texture * texture,
     }
     final_rect.w = (int)dstrect->w;
     final_rect.h = (int)dstrect->h;
+    SW_AddDirtyRect(data, &final_rect);
 
     if ( srcrect->w == final_rect.w && srcrect->h == final_rect.h ) {
+        if (data->binner && SDL_TileBinBlit(data->binner, src, srcrect, surface, &final_rect)) {
+            return 0;
+        }
+        SW_FlushDraws(data);
         return SDL_BlitSurface(src, srcrect, surface, &final_rect);
     } else {
+        SW_FlushDraws(data);
+
         /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
          * to avoid potentially frequent RLE encoding/decoding.
          */
@@ -592,6 +714,7 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
                 const SDL_Rect * srcrect, const SDL_FRect * dstrect,
                 const double angle, const SDL_FPoint * center, const SDL_RendererFlip flip)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SDL_Surface *src = (SDL_Surface *) texture->driverdata;
     SDL_Rect final_rect, tmp_rect;
@@ -608,6 +731,7 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
     if (!surface) {
         return -1;
     }
+    SW_FlushDraws(data);
 
     if (renderer->viewport.x || renderer->viewport.y) {
         final_rect.x = (int)(renderer->viewport.x + dstrect->x);
@@ -756,6 +880,7 @@ SW_RenderCopyEx(SDL_Renderer * renderer, SDL_Texture * texture,
             tmp_rect.y = (int)MIN(MIN(p1y, p2y), MIN(p3y, p4y));
             tmp_rect.w = dstwidth;
             tmp_rect.h = dstheight;
+            SW_AddDirtyRect(data, &tmp_rect);
 
             /* The NONE blend mode needs some special care with non-opaque surfaces.
              * Other blend modes or opaque surfaces can be blitted directly.
@@ -835,6 +960,7 @@ SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
     if (!surface) {
         return -1;
     }
+    SW_FlushDraws((SW_RenderData *) renderer->driverdata);
 
     /* NOTE: The rect is already adjusted according to the viewport by
      * SDL_RenderReadPixels.
@@ -858,11 +984,32 @@ SW_RenderReadPixels(SDL_Renderer * renderer, const SDL_Rect * rect,
 static void
 SW_RenderPresent(SDL_Renderer * renderer)
 {
+    SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
     SDL_Window *window = renderer->window;
+    Sint64 area = 0;
+    int i;
+
+    SW_FlushDraws(data);
 
     if (window) {
-        SDL_UpdateWindowSurface(window);
+        if (!data->full_update) {
+            data->numdirty = SDL_MergeDirtyRects(data->dirty, data->numdirty);
+            for (i = 0; i < data->numdirty; ++i) {
+                area += (Sint64) data->dirty[i].w * data->dirty[i].h;
+            }
+            if (data->window && area * 100 > (Sint64) data->window->w * data->window->h * SW_FULL_UPDATE_COVERAGE) {
+                data->full_update = SDL_TRUE;
+            }
+        }
+
+        if (data->full_update) {
+            SDL_UpdateWindowSurface(window);
+        } else if (data->numdirty > 0) {
+            SDL_UpdateWindowSurfaceRects(window, data->dirty, data->numdirty);
+        }
     }
+    data->numdirty = 0;
+    data->full_update = SDL_FALSE;
 }
 
 static void
@@ -870,6 +1017,7 @@ SW_DestroyTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
     SDL_Surface *surface = (SDL_Surface *) texture->driverdata;
 
+    SW_FlushDraws((SW_RenderData *) renderer->driverdata);
     SDL_FreeSurface(surface);
 }
 
@@ -878,7 +1026,12 @@ SW_DestroyRenderer(SDL_Renderer * renderer)
 {
     SW_RenderData *data = (SW_RenderData *) renderer->driverdata;
 
-    SDL_free(data);
+    if (data) {
+        if (data->binner) {
+            SDL_DestroyTileBinner(data->binner);
+        }
+        SDL_free(data);
+    }
     SDL_free(renderer);
 }
 
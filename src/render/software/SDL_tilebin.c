@@ -0,0 +1,418 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#if !SDL_RENDER_DISABLED
+
+#include "SDL_atomic.h"
+#include "SDL_jobs.h"
+#include "../../video/SDL_blit.h"
+#include "../../video/SDL_pixels_c.h"
+#include "../../SDL_profile_c.h"
+#include "SDL_blendfillrect.h"
+#include "SDL_tilebin.h"
+
+#define TILE_SIZE   64
+
+typedef enum
+{
+    SDL_TILE_FILL,
+    SDL_TILE_BLENDFILL,
+    SDL_TILE_BLIT
+} SDL_TileCommandType;
+
+typedef struct
+{
+    SDL_TileCommandType type;
+    SDL_Rect area;      /* The pixels drawn, clipped to the destination */
+    union {
+        Uint32 color;
+        struct {
+            SDL_BlendMode blendMode;
+            Uint8 r, g, b, a;
+        } blend;
+        struct {
+            SDL_Surface *src;
+            int srcx, srcy; /* The source pixel drawn at the area origin */
+            SDL_BlitFunc func;
+            SDL_BlitInfo info;
+        } blit;
+    } data;
+} SDL_TileCommand;
+
+typedef struct
+{
+    int *commands;
+    int numcommands;
+    int maxcommands;
+} SDL_Tile;
+
+struct SDL_TileBinner
+{
+    SDL_Surface *dst;
+
+    SDL_TileCommand *commands;
+    int numcommands;
+    int maxcommands;
+
+    SDL_Tile *tiles;
+    int numtiles;
+    int maxtiles;
+    int columns;
+    SDL_atomic_t next_tile;
+
+    int numthreads;
+};
+
+
+static void
+SDL_DrawTile(SDL_TileBinner * binner, int index)
+{
+    const SDL_Tile *tile = &binner->tiles[index];
+    SDL_Surface *dst = binner->dst;
+    SDL_Rect bounds, rect;
+    int i;
+
+    bounds.x = (index % binner->columns) * TILE_SIZE;
+    bounds.y = (index / binner->columns) * TILE_SIZE;
+    bounds.w = TILE_SIZE;
+    bounds.h = TILE_SIZE;
+
+    for (i = 0; i < tile->numcommands; ++i) {
+        const SDL_TileCommand *command = &binner->commands[tile->commands[i]];
+
+        if (!SDL_IntersectRect(&command->area, &bounds, &rect)) {
+            continue;
+        }
+        switch (command->type) {
+        case SDL_TILE_FILL:
+            SDL_FillRect(dst, &rect, command->data.color);
+            break;
+        case SDL_TILE_BLENDFILL:
+            SDL_BlendFillRect(dst, &rect, command->data.blend.blendMode,
+                              command->data.blend.r, command->data.blend.g,
+                              command->data.blend.b, command->data.blend.a);
+            break;
+        case SDL_TILE_BLIT:
+            {
+                /* What SDL_SoftBlit() does, with a copy of the blit info so
+                   blits of the same surface can run at the same time */
+                const SDL_Surface *src = command->data.blit.src;
+                const int srcx = command->data.blit.srcx + rect.x - command->area.x;
+                const int srcy = command->data.blit.srcy + rect.y - command->area.y;
+                SDL_BlitInfo info = command->data.blit.info;
+
+                info.src = (Uint8 *) src->pixels + srcy * src->pitch +
+                           srcx * info.src_fmt->BytesPerPixel;
+                info.src_w = rect.w;
+                info.src_h = rect.h;
+                info.src_pitch = src->pitch;
+                info.src_skip = info.src_pitch - info.src_w * info.src_fmt->BytesPerPixel;
+                info.dst = (Uint8 *) dst->pixels + rect.y * dst->pitch +
+                           rect.x * info.dst_fmt->BytesPerPixel;
+                info.dst_w = rect.w;
+                info.dst_h = rect.h;
+                info.dst_pitch = dst->pitch;
+                info.dst_skip = info.dst_pitch - info.dst_w * info.dst_fmt->BytesPerPixel;
+                command->data.blit.func(&info);
+            }
+            break;
+        }
+    }
+}
+
+/* Each call takes tiles until there are none left, so the job system
+   runs at most numthreads of them at once */
+static void SDLCALL
+SDL_DrawTiles(void *data, int start, int end)
+{
+    SDL_TileBinner *binner = (SDL_TileBinner *) data;
+    int index;
+
+    while ((index = SDL_AtomicAdd(&binner->next_tile, 1)) < binner->numtiles) {
+        if (binner->tiles[index].numcommands > 0) {
+            SDL_DrawTile(binner, index);
+        }
+    }
+}
+
+SDL_TileBinner *
+SDL_CreateTileBinner(int numthreads)
+{
+    SDL_TileBinner *binner;
+    int workers;
+
+    /* The flushing thread draws tiles too */
+    workers = SDL_GetJobWorkerCount();
+    if (workers < 1) {
+        return NULL;
+    }
+
+    binner = (SDL_TileBinner *) SDL_calloc(1, sizeof(*binner));
+    if (!binner) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    binner->numthreads = SDL_min(numthreads, workers + 1);
+    return binner;
+}
+
+/* Start recording for a destination, flushing what was recorded for
+   another one */
+static SDL_bool
+SDL_SetTileTarget(SDL_TileBinner * binner, SDL_Surface * dst)
+{
+    const int columns = (dst->w + TILE_SIZE - 1) / TILE_SIZE;
+    const int rows = (dst->h + TILE_SIZE - 1) / TILE_SIZE;
+
+    if (binner->dst == dst) {
+        return SDL_TRUE;
+    }
+    SDL_FlushTileBinner(binner);
+
+    if (columns * rows > binner->maxtiles) {
+        SDL_Tile *tiles = (SDL_Tile *) SDL_realloc(binner->tiles, columns * rows * sizeof(*tiles));
+        if (!tiles) {
+            return SDL_FALSE;
+        }
+        SDL_memset(&tiles[binner->maxtiles], 0, (columns * rows - binner->maxtiles) * sizeof(*tiles));
+        binner->tiles = tiles;
+        binner->maxtiles = columns * rows;
+    }
+    binner->dst = dst;
+    binner->columns = columns;
+    binner->numtiles = columns * rows;
+    return SDL_TRUE;
+}
+
+/* Add a command drawing the given area to the tiles it touches */
+static SDL_TileCommand *
+SDL_AddTileCommand(SDL_TileBinner * binner, SDL_Surface * dst, const SDL_Rect * area)
+{
+    const int column1 = area->x / TILE_SIZE;
+    const int column2 = (area->x + area->w - 1) / TILE_SIZE;
+    const int row1 = area->y / TILE_SIZE;
+    const int row2 = (area->y + area->h - 1) / TILE_SIZE;
+    SDL_TileCommand *command;
+    int row, column;
+
+    if (!SDL_SetTileTarget(binner, dst)) {
+        return NULL;
+    }
+
+    if (binner->numcommands == binner->maxcommands) {
+        const int maxcommands = binner->maxcommands ? binner->maxcommands * 2 : 256;
+        SDL_TileCommand *commands = (SDL_TileCommand *) SDL_realloc(binner->commands, maxcommands * sizeof(*commands));
+        if (!commands) {
+            return NULL;
+        }
+        binner->commands = commands;
+        binner->maxcommands = maxcommands;
+    }
+
+    /* Make room in every tile first, so a failure leaves them untouched */
+    for (row = row1; row <= row2; ++row) {
+        for (column = column1; column <= column2; ++column) {
+            SDL_Tile *tile = &binner->tiles[row * binner->columns + column];
+
+            if (tile->numcommands == tile->maxcommands) {
+                const int maxcommands = tile->maxcommands ? tile->maxcommands * 2 : 16;
+                int *commands = (int *) SDL_realloc(tile->commands, maxcommands * sizeof(*commands));
+                if (!commands) {
+                    return NULL;
+                }
+                tile->commands = commands;
+                tile->maxcommands = maxcommands;
+            }
+        }
+    }
+    for (row = row1; row <= row2; ++row) {
+        for (column = column1; column <= column2; ++column) {
+            SDL_Tile *tile = &binner->tiles[row * binner->columns + column];
+            tile->commands[tile->numcommands++] = binner->numcommands;
+        }
+    }
+
+    command = &binner->commands[binner->numcommands++];
+    command->area = *area;
+    return command;
+}
+
+SDL_bool
+SDL_TileBinFillRect(SDL_TileBinner * binner, SDL_Surface * dst, const SDL_Rect * rect,
+                    SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    SDL_TileCommand *command;
+    SDL_Rect area;
+
+    if (SDL_MUSTLOCK(dst) || dst->format->BitsPerPixel < 8) {
+        return SDL_FALSE;
+    }
+
+    if (rect) {
+        if (!SDL_IntersectRect(rect, &dst->clip_rect, &area)) {
+            return SDL_TRUE;
+        }
+    } else {
+        area = dst->clip_rect;
+        if (SDL_RectEmpty(&area)) {
+            return SDL_TRUE;
+        }
+    }
+
+    command = SDL_AddTileCommand(binner, dst, &area);
+    if (!command) {
+        return SDL_FALSE;
+    }
+    if (blendMode == SDL_BLENDMODE_NONE) {
+        command->type = SDL_TILE_FILL;
+        command->data.color = SDL_MapRGBA(dst->format, r, g, b, a);
+    } else {
+        command->type = SDL_TILE_BLENDFILL;
+        command->data.blend.blendMode = blendMode;
+        command->data.blend.r = r;
+        command->data.blend.g = g;
+        command->data.blend.b = b;
+        command->data.blend.a = a;
+    }
+    return SDL_TRUE;
+}
+
+SDL_bool
+SDL_TileBinBlit(SDL_TileBinner * binner, SDL_Surface * src, const SDL_Rect * srcrect,
+                SDL_Surface * dst, const SDL_Rect * dstrect)
+{
+    SDL_TileCommand *command;
+    SDL_Rect area, clipped;
+    int srcx, srcy;
+
+    if (src->locked || dst->locked || SDL_MUSTLOCK(dst)) {
+        return SDL_FALSE;
+    }
+
+    /* Clip the same way SDL_UpperBlit() does */
+    if (srcrect) {
+        srcx = srcrect->x;
+        srcy = srcrect->y;
+        area.w = srcrect->w;
+        area.h = srcrect->h;
+    } else {
+        srcx = srcy = 0;
+        area.w = src->w;
+        area.h = src->h;
+    }
+    area.x = dstrect ? dstrect->x : 0;
+    area.y = dstrect ? dstrect->y : 0;
+    if (srcx < 0) {
+        area.w += srcx;
+        area.x -= srcx;
+        srcx = 0;
+    }
+    area.w = SDL_min(area.w, src->w - srcx);
+    if (srcy < 0) {
+        area.h += srcy;
+        area.y -= srcy;
+        srcy = 0;
+    }
+    area.h = SDL_min(area.h, src->h - srcy);
+    if (!SDL_IntersectRect(&area, &dst->clip_rect, &clipped)) {
+        return SDL_TRUE;
+    }
+    srcx += clipped.x - area.x;
+    srcy += clipped.y - area.y;
+
+    /* Set the blit up here, the same way SDL_LowerBlit() does, and only
+       record the ones SDL_SoftBlit() could run from the blit info alone */
+    if ((src->map->dst != dst) ||
+        (dst->format->palette &&
+         src->map->dst_palette_version != dst->format->palette->version) ||
+        (src->format->palette &&
+         src->map->src_palette_version != src->format->palette->version)) {
+        if (SDL_MapSurface(src, dst) < 0) {
+            return SDL_FALSE;
+        }
+    }
+    if (SDL_MUSTLOCK(src) || !src->map->data || src->map->info.table) {
+        return SDL_FALSE;
+    }
+
+    command = SDL_AddTileCommand(binner, dst, &clipped);
+    if (!command) {
+        return SDL_FALSE;
+    }
+    command->type = SDL_TILE_BLIT;
+    command->data.blit.src = src;
+    command->data.blit.srcx = srcx;
+    command->data.blit.srcy = srcy;
+    command->data.blit.func = (SDL_BlitFunc) src->map->data;
+    command->data.blit.info = src->map->info;
+    return SDL_TRUE;
+}
+
+void
+SDL_FlushTileBinner(SDL_TileBinner * binner)
+{
+    SDL_Surface *dst = binner->dst;
+    SDL_Rect clip_rect;
+    int i;
+
+    if (binner->numcommands == 0) {
+        binner->dst = NULL;
+        return;
+    }
+
+    SDL_PROFILE_ZONE_BEGIN("SDL_FlushTileBinner");
+
+    /* The commands are clipped already, to clip rects that may since have
+       changed */
+    clip_rect = dst->clip_rect;
+    SDL_SetClipRect(dst, NULL);
+
+    SDL_AtomicSet(&binner->next_tile, 0);
+    SDL_ParallelFor(0, binner->numthreads, 1, SDL_DrawTiles, binner);
+
+    SDL_SetClipRect(dst, &clip_rect);
+
+    for (i = 0; i < binner->numtiles; ++i) {
+        binner->tiles[i].numcommands = 0;
+    }
+    binner->numcommands = 0;
+    binner->dst = NULL;
+
+    SDL_PROFILE_ZONE_END("SDL_FlushTileBinner");
+}
+
+void
+SDL_DestroyTileBinner(SDL_TileBinner * binner)
+{
+    int i;
+
+    for (i = 0; i < binner->maxtiles; ++i) {
+        SDL_free(binner->tiles[i].commands);
+    }
+    SDL_free(binner->tiles);
+    SDL_free(binner->commands);
+    SDL_free(binner);
+}
+
+#endif /* !SDL_RENDER_DISABLED */
+
+/* vi: set ts=4 sw=4 expandtab: */
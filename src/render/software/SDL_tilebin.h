@@ -0,0 +1,49 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_tilebin_h_
+#define SDL_tilebin_h_
+
+#include "../../SDL_internal.h"
+
+/* A tile binner records the fills and blits of a frame, sorts them into
+   screen tiles and draws the tiles in parallel on the job system. Each tile is drawn
+   in the order its draws were recorded, so the result is the same as
+   drawing everything directly. */
+typedef struct SDL_TileBinner SDL_TileBinner;
+
+/* numthreads limits how many threads draw at once, counting the one that
+   flushes. This returns NULL if the job system can't be used. */
+extern SDL_TileBinner *SDL_CreateTileBinner(int numthreads);
+
+/* These return SDL_FALSE if the draw couldn't be recorded, and the caller
+   has to flush the binner and draw it directly */
+extern SDL_bool SDL_TileBinFillRect(SDL_TileBinner * binner, SDL_Surface * dst, const SDL_Rect * rect, SDL_BlendMode blendMode, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+extern SDL_bool SDL_TileBinBlit(SDL_TileBinner * binner, SDL_Surface * src, const SDL_Rect * srcrect, SDL_Surface * dst, const SDL_Rect * dstrect);
+
+/* Draw everything recorded, this has to happen before anything else reads
+   or writes the destination or a recorded source surface */
+extern void SDL_FlushTileBinner(SDL_TileBinner * binner);
+extern void SDL_DestroyTileBinner(SDL_TileBinner * binner);
+
+#endif /* SDL_tilebin_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
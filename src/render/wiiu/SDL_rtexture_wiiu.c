@@ -149,7 +149,7 @@ int WIIU_SDL_LockTexture(SDL_Renderer * renderer, SDL_Texture * texture,
                         rect->x * BytesPerPixel);
     *pitch = (tdata->texture.surface.pitch * BytesPerPixel);
 
-    /* Not sure we even need to bother keeping track of this */
+    /* Remember the rect so the unlock can count the upload */
     texture->locked_rect = *rect;
 
     return 0;
@@ -159,6 +159,8 @@ void WIIU_SDL_UnlockTexture(SDL_Renderer * renderer, SDL_Texture * texture)
 {
     WIIU_TextureData *tdata = (WIIU_TextureData *) texture->driverdata;
     GX2RUnlockSurfaceEx(&tdata->texture.surface, 0, 0);
+
+    SDL_RENDER_STATS_UPLOAD(renderer, texture->locked_rect.w * texture->locked_rect.h * SDL_BYTESPERPIXEL(texture->format));
 }
 
 int WIIU_SDL_UpdateTexture(SDL_Renderer * renderer, SDL_Texture * texture,
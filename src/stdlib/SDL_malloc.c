@@ -5318,6 +5318,259 @@ int SDL_SetMemoryFunctions(SDL_malloc_func malloc_func,
     return 0;
 }
 
+/* Optional allocation statistics, see SDL_SetAllocationTracking() */
+#if defined(__GNUC__) || defined(__clang__)
+#define SDL_ALLOCATION_CALLER() __builtin_return_address(0)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#pragma intrinsic(_ReturnAddress)
+#define SDL_ALLOCATION_CALLER() _ReturnAddress()
+#else
+#define SDL_ALLOCATION_CALLER() NULL
+#endif
+
+#define SDL_ALLOCATION_SITES        1024    /* must be a power of two */
+#define SDL_ALLOCATION_BUCKETS      4096    /* must be a power of two */
+
+typedef struct SDL_tracked_block
+{
+    void *mem;
+    size_t size;
+    struct SDL_tracked_block *next;
+} SDL_tracked_block;
+
+static struct
+{
+    SDL_SpinLock lock;
+    volatile SDL_bool enabled;  /* checked again under the lock */
+    SDL_AllocationStats stats;
+    SDL_AllocationSite sites[SDL_ALLOCATION_SITES];
+    SDL_AllocationSite overflow;    /* sites that didn't fit in the table */
+    SDL_tracked_block *blocks[SDL_ALLOCATION_BUCKETS];
+} s_stats;
+
+static SDL_INLINE Uint32
+SDL_HashAllocationPointer(const void *ptr)
+{
+    uintptr_t value = (uintptr_t)ptr;
+    value ^= (value >> 4) ^ (value >> 13);
+    return (Uint32)(value * 2654435761u);
+}
+
+static SDL_AllocationSite *
+SDL_GetAllocationSite(const void *caller)
+{
+    Uint32 hash = SDL_HashAllocationPointer(caller);
+    int i;
+
+    /* Linear probing; when the table fills up, spill into the overflow site */
+    for (i = 0; i < SDL_ALLOCATION_SITES; ++i) {
+        SDL_AllocationSite *site = &s_stats.sites[(hash + i) & (SDL_ALLOCATION_SITES - 1)];
+        if (site->caller == caller) {
+            return site;
+        }
+        if (!site->caller && !site->num_allocations) {
+            site->caller = caller;
+            return site;
+        }
+    }
+    return &s_stats.overflow;
+}
+
+/* These must be called with s_stats.lock held */
+static void
+SDL_UntrackBlock(void *mem)
+{
+    SDL_tracked_block **prev = &s_stats.blocks[SDL_HashAllocationPointer(mem) & (SDL_ALLOCATION_BUCKETS - 1)];
+    SDL_tracked_block *block;
+
+    for (block = *prev; block; prev = &block->next, block = block->next) {
+        if (block->mem == mem) {
+            *prev = block->next;
+            s_stats.stats.bytes_in_use -= block->size;
+            ++s_stats.stats.num_frees;
+            real_free(block);
+            return;
+        }
+    }
+    /* Allocated before tracking was enabled, nothing to do. */
+}
+
+static void
+SDL_TrackBlock(void *mem, size_t size, const void *caller)
+{
+    SDL_tracked_block *block = (SDL_tracked_block *)real_malloc(sizeof(*block));
+    SDL_AllocationSite *site = SDL_GetAllocationSite(caller);
+
+    if (block) {
+        Uint32 bucket = SDL_HashAllocationPointer(mem) & (SDL_ALLOCATION_BUCKETS - 1);
+        block->mem = mem;
+        block->size = size;
+        block->next = s_stats.blocks[bucket];
+        s_stats.blocks[bucket] = block;
+        s_stats.stats.bytes_in_use += size;
+        if (s_stats.stats.bytes_in_use > s_stats.stats.peak_bytes_in_use) {
+            s_stats.stats.peak_bytes_in_use = s_stats.stats.bytes_in_use;
+        }
+    }
+
+    ++s_stats.stats.num_allocations;
+    s_stats.stats.bytes_allocated += size;
+    ++s_stats.stats.frame_allocations;
+
+    ++site->num_allocations;
+    site->bytes_allocated += size;
+    ++site->frame_allocations;
+    if (site->frame_allocations > site->peak_frame_allocations) {
+        site->peak_frame_allocations = site->frame_allocations;
+    }
+}
+
+static void
+SDL_ClearTrackedBlocks(void)
+{
+    int i;
+
+    for (i = 0; i < SDL_ALLOCATION_BUCKETS; ++i) {
+        SDL_tracked_block *block = s_stats.blocks[i];
+        while (block) {
+            SDL_tracked_block *next = block->next;
+            real_free(block);
+            block = next;
+        }
+        s_stats.blocks[i] = NULL;
+    }
+}
+
+int SDL_SetAllocationTracking(SDL_bool enabled)
+{
+    SDL_AtomicLock(&s_stats.lock);
+    if (enabled && !s_stats.enabled) {
+        SDL_zero(s_stats.stats);
+        SDL_zero(s_stats.sites);
+        SDL_zero(s_stats.overflow);
+    } else if (!enabled) {
+        SDL_ClearTrackedBlocks();
+    }
+    s_stats.enabled = enabled ? SDL_TRUE : SDL_FALSE;
+    SDL_AtomicUnlock(&s_stats.lock);
+    return 0;
+}
+
+SDL_bool SDL_GetAllocationTracking(void)
+{
+    return s_stats.enabled;
+}
+
+void SDL_ResetAllocationStats(void)
+{
+    SDL_AtomicLock(&s_stats.lock);
+    /* Outstanding blocks stay tracked so later frees are still accounted */
+    s_stats.stats.num_allocations = 0;
+    s_stats.stats.num_frees = 0;
+    s_stats.stats.bytes_allocated = 0;
+    s_stats.stats.peak_bytes_in_use = s_stats.stats.bytes_in_use;
+    s_stats.stats.frame_allocations = 0;
+    s_stats.stats.last_frame_allocations = 0;
+    s_stats.stats.peak_frame_allocations = 0;
+    s_stats.stats.num_frames = 0;
+    SDL_zero(s_stats.sites);
+    SDL_zero(s_stats.overflow);
+    SDL_AtomicUnlock(&s_stats.lock);
+}
+
+void SDL_GetAllocationStats(SDL_AllocationStats *stats)
+{
+    if (!stats) {
+        return;
+    }
+    SDL_AtomicLock(&s_stats.lock);
+    SDL_memcpy(stats, &s_stats.stats, sizeof(*stats));
+    SDL_AtomicUnlock(&s_stats.lock);
+}
+
+int SDL_GetAllocationSites(SDL_AllocationSite *sites, int maxsites)
+{
+    int i, count = 0, total = 0;
+
+    if (!sites) {
+        maxsites = 0;
+    }
+
+    SDL_AtomicLock(&s_stats.lock);
+    for (i = 0; i <= SDL_ALLOCATION_SITES; ++i) {
+        const SDL_AllocationSite *site = (i < SDL_ALLOCATION_SITES) ? &s_stats.sites[i] : &s_stats.overflow;
+        int pos;
+
+        if (!site->num_allocations) {
+            continue;
+        }
+        ++total;
+
+        /* Keep the output sorted by allocation count, busiest first */
+        pos = count;
+        while (pos > 0 && sites[pos - 1].num_allocations < site->num_allocations) {
+            --pos;
+        }
+        if (pos >= maxsites) {
+            continue;
+        }
+        if (count < maxsites) {
+            ++count;
+        }
+        SDL_memmove(&sites[pos + 1], &sites[pos], (count - pos - 1) * sizeof(*sites));
+        SDL_memcpy(&sites[pos], site, sizeof(*site));
+    }
+    SDL_AtomicUnlock(&s_stats.lock);
+
+    return total;
+}
+
+void SDL_MarkAllocationFrame(void)
+{
+    int i;
+
+    if (!s_stats.enabled) {
+        return;
+    }
+
+    SDL_AtomicLock(&s_stats.lock);
+    s_stats.stats.last_frame_allocations = s_stats.stats.frame_allocations;
+    if (s_stats.stats.frame_allocations > s_stats.stats.peak_frame_allocations) {
+        s_stats.stats.peak_frame_allocations = s_stats.stats.frame_allocations;
+    }
+    s_stats.stats.frame_allocations = 0;
+    ++s_stats.stats.num_frames;
+    for (i = 0; i < SDL_ALLOCATION_SITES; ++i) {
+        s_stats.sites[i].frame_allocations = 0;
+    }
+    s_stats.overflow.frame_allocations = 0;
+    SDL_AtomicUnlock(&s_stats.lock);
+}
+
+static void
+SDL_RecordAllocation(void *oldmem, void *mem, size_t size, const void *caller)
+{
+    SDL_AtomicLock(&s_stats.lock);
+    if (s_stats.enabled) {
+        if (oldmem) {
+            SDL_UntrackBlock(oldmem);
+        }
+        SDL_TrackBlock(mem, size, caller);
+    }
+    SDL_AtomicUnlock(&s_stats.lock);
+}
+
+static void
+SDL_RecordFree(void *mem)
+{
+    SDL_AtomicLock(&s_stats.lock);
+    if (s_stats.enabled) {
+        SDL_UntrackBlock(mem);
+    }
+    SDL_AtomicUnlock(&s_stats.lock);
+}
+
 int SDL_GetNumAllocations(void)
 {
     return SDL_AtomicGet(&s_mem.num_allocations);
@@ -5334,6 +5587,9 @@ void *SDL_malloc(size_t size)
     mem = s_mem.malloc_func(size);
     if (mem) {
         SDL_AtomicIncRef(&s_mem.num_allocations);
+        if (s_stats.enabled) {
+            SDL_RecordAllocation(NULL, mem, size, SDL_ALLOCATION_CALLER());
+        }
     }
     return mem;
 }
@@ -5350,6 +5606,9 @@ void *SDL_calloc(size_t nmemb, size_t size)
     mem = s_mem.calloc_func(nmemb, size);
     if (mem) {
         SDL_AtomicIncRef(&s_mem.num_allocations);
+        if (s_stats.enabled) {
+            SDL_RecordAllocation(NULL, mem, nmemb * size, SDL_ALLOCATION_CALLER());
+        }
     }
     return mem;
 }
@@ -5366,6 +5625,15 @@ void *SDL_realloc(void *ptr, size_t size)
     if (mem && !ptr) {
         SDL_AtomicIncRef(&s_mem.num_allocations);
     }
+    if (mem && s_stats.enabled) {
+        SDL_RecordAllocation(ptr, mem, size, SDL_ALLOCATION_CALLER());
+    } else if (!mem && !size) {
+        /* realloc(ptr, 0) freed the block */
+        if (s_stats.enabled) {
+            SDL_RecordFree(ptr);
+        }
+        (void)SDL_AtomicDecRef(&s_mem.num_allocations);
+    }
     return mem;
 }
 
@@ -5375,6 +5643,9 @@ void SDL_free(void *ptr)
         return;
     }
 
+    if (s_stats.enabled) {
+        SDL_RecordFree(ptr);
+    }
     s_mem.free_func(ptr);
     (void)SDL_AtomicDecRef(&s_mem.num_allocations);
 }
@@ -0,0 +1,392 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/*
+
+ Benchmark mode for the test harness.
+
+*/
+
+#include "SDL_config.h"
+
+#include "SDL_test.h"
+
+/* Benchmark result message format */
+#define SDLTEST_BENCHMARK_RESULT_FORMAT "Benchmark '%s': median %.3f us, p95 %.3f us, min %.3f us, mean %.3f us, max %.3f us (%d iterations)"
+
+/* ! \brief Measurements of one benchmark, in microseconds per iteration */
+typedef struct SDLTest_BenchmarkResult {
+    char name[64];
+    int iterations;
+    double min;
+    double median;
+    double p95;
+    double mean;
+    double max;
+    /* !< Median of the baseline, or <0 if there is none */
+    double baseline;
+} SDLTest_BenchmarkResult;
+
+/* ! \brief Settings used outside of SDLTest_RunBenchmarks() */
+static const SDLTest_BenchmarkOptions SDLTest_BenchmarkDefaults = {
+    SDLTEST_BENCHMARK_WARMUP_ITERATIONS, SDLTEST_BENCHMARK_ITERATIONS, NULL, NULL, SDLTEST_BENCHMARK_TOLERANCE
+};
+
+/* ! \brief Settings of the current run */
+static SDLTest_BenchmarkOptions SDLTest_BenchmarkSettings = {
+    SDLTEST_BENCHMARK_WARMUP_ITERATIONS, SDLTEST_BENCHMARK_ITERATIONS, NULL, NULL, SDLTEST_BENCHMARK_TOLERANCE
+};
+
+/* ! \brief Contents of the baseline file, or NULL */
+static char *SDLTest_BenchmarkBaseline = NULL;
+
+/* ! \brief Results recorded by SDLTest_RunBenchmarks() */
+static SDL_bool SDLTest_BenchmarkRecording = SDL_FALSE;
+static SDLTest_BenchmarkResult *SDLTest_BenchmarkResults = NULL;
+static int SDLTest_BenchmarkResultCount = 0;
+static int SDLTest_BenchmarkResultSize = 0;
+
+static int
+SDLTest_CompareSamples(const void *a, const void *b)
+{
+    const double x = *(const double *)a;
+    const double y = *(const double *)b;
+    return (x < y) ? -1 : (x > y) ? 1 : 0;
+}
+
+/**
+* Reads a whole file into a zero terminated buffer, which the caller frees.
+*/
+static char *
+SDLTest_ReadFile(const char *file)
+{
+    SDL_RWops *rw;
+    Sint64 size;
+    char *data;
+
+    rw = SDL_RWFromFile(file, "rb");
+    if (rw == NULL) {
+        return NULL;
+    }
+    size = SDL_RWsize(rw);
+    if (size < 0) {
+        SDL_RWclose(rw);
+        return NULL;
+    }
+    data = (char *)SDL_malloc((size_t)size + 1);
+    if (data == NULL) {
+        SDL_RWclose(rw);
+        SDL_Error(SDL_ENOMEM);
+        return NULL;
+    }
+    if (SDL_RWread(rw, data, 1, (size_t)size) != (size_t)size) {
+        SDL_free(data);
+        SDL_RWclose(rw);
+        return NULL;
+    }
+    data[size] = '\0';
+    SDL_RWclose(rw);
+    return data;
+}
+
+/**
+* Looks up the median of a benchmark in the baseline.
+*
+* This only understands the files written by SDLTest_WriteResults(), or
+* reformatted copies of them: each benchmark is an object with a "name"
+* string and a "median_us" number.
+*
+* \returns The median in microseconds, or -1 if the benchmark isn't there.
+*/
+static double
+SDLTest_FindBaseline(const char *name)
+{
+    const size_t length = SDL_strlen(name);
+    const char *data = SDLTest_BenchmarkBaseline;
+    const char *end;
+
+    if (data == NULL) {
+        return -1.0;
+    }
+
+    while ((data = SDL_strstr(data, "\"name\"")) != NULL) {
+        data += 6;
+        while (*data == ' ' || *data == '\t' || *data == '\r' || *data == '\n' || *data == ':') {
+            ++data;
+        }
+        if (*data != '"' || SDL_strncmp(data + 1, name, length) != 0 || data[length + 1] != '"') {
+            continue;
+        }
+
+        /* Found it, the median has to be in the same object */
+        end = SDL_strchr(data, '}');
+        data = SDL_strstr(data, "\"median_us\"");
+        if (data == NULL || (end != NULL && data > end)) {
+            return -1.0;
+        }
+        data += 11;
+        while (*data == ' ' || *data == '\t' || *data == '\r' || *data == '\n' || *data == ':') {
+            ++data;
+        }
+        return SDL_strtod(data, NULL);
+    }
+    return -1.0;
+}
+
+static SDL_bool
+SDLTest_RecordResult(const SDLTest_BenchmarkResult *result)
+{
+    int i;
+
+    for (i = 0; i < SDLTest_BenchmarkResultCount; ++i) {
+        if (SDL_strcmp(SDLTest_BenchmarkResults[i].name, result->name) == 0) {
+            SDLTest_LogError("Benchmark name '%s' was used more than once.", result->name);
+            return SDL_FALSE;
+        }
+    }
+
+    if (SDLTest_BenchmarkResultCount == SDLTest_BenchmarkResultSize) {
+        const int size = SDLTest_BenchmarkResultSize ? SDLTest_BenchmarkResultSize * 2 : 32;
+        SDLTest_BenchmarkResult *results = (SDLTest_BenchmarkResult *)SDL_realloc(SDLTest_BenchmarkResults, size * sizeof(*results));
+        if (results == NULL) {
+            SDLTest_LogError("Unable to allocate benchmark results");
+            SDL_Error(SDL_ENOMEM);
+            return SDL_FALSE;
+        }
+        SDLTest_BenchmarkResults = results;
+        SDLTest_BenchmarkResultSize = size;
+    }
+    SDLTest_BenchmarkResults[SDLTest_BenchmarkResultCount++] = *result;
+    return SDL_TRUE;
+}
+
+/**
+* Writes the recorded results as JSON.
+*/
+static SDL_bool
+SDLTest_WriteResults(const char *file)
+{
+    SDL_RWops *rw;
+    char line[512];
+    SDL_bool success = SDL_TRUE;
+    int i;
+
+    rw = SDL_RWFromFile(file, "wb");
+    if (rw == NULL) {
+        SDLTest_LogError("Couldn't open '%s' for writing: %s", file, SDL_GetError());
+        return SDL_FALSE;
+    }
+
+    SDL_snprintf(line, sizeof(line),
+                 "{\n"
+                 "  \"platform\": \"%s\",\n"
+                 "  \"revision\": \"%s\",\n"
+                 "  \"cpus\": %d,\n"
+                 "  \"warmup_iterations\": %d,\n"
+                 "  \"iterations\": %d,\n"
+                 "  \"benchmarks\": [",
+                 SDL_GetPlatform(), SDL_GetRevision(), SDL_GetCPUCount(),
+                 SDLTest_BenchmarkSettings.warmupIterations, SDLTest_BenchmarkSettings.iterations);
+    success &= (SDL_RWwrite(rw, line, SDL_strlen(line), 1) == 1);
+
+    for (i = 0; i < SDLTest_BenchmarkResultCount; ++i) {
+        const SDLTest_BenchmarkResult *result = &SDLTest_BenchmarkResults[i];
+        SDL_snprintf(line, sizeof(line),
+                     "%s\n    { \"name\": \"%s\", \"iterations\": %d, \"min_us\": %.3f, \"median_us\": %.3f, \"p95_us\": %.3f, \"mean_us\": %.3f, \"max_us\": %.3f",
+                     i ? "," : "", result->name, result->iterations,
+                     result->min, result->median, result->p95, result->mean, result->max);
+        success &= (SDL_RWwrite(rw, line, SDL_strlen(line), 1) == 1);
+        if (result->baseline >= 0.0) {
+            SDL_snprintf(line, sizeof(line), ", \"baseline_median_us\": %.3f", result->baseline);
+            success &= (SDL_RWwrite(rw, line, SDL_strlen(line), 1) == 1);
+        }
+        success &= (SDL_RWwrite(rw, " }", 2, 1) == 1);
+    }
+    success &= (SDL_RWwrite(rw, "\n  ]\n}\n", 7, 1) == 1);
+
+    if (SDL_RWclose(rw) < 0) {
+        success = SDL_FALSE;
+    }
+    if (!success) {
+        SDLTest_LogError("Couldn't write benchmark results to '%s': %s", file, SDL_GetError());
+    }
+    return success;
+}
+
+/*
+ * Measure a piece of code.
+ */
+int
+SDLTest_Benchmark(const char *name, SDLTest_BenchmarkFp benchmark, void *arg)
+{
+    const double freq = (double)SDL_GetPerformanceFrequency();
+    SDLTest_BenchmarkResult result;
+    double *samples;
+    double total = 0.0;
+    Uint64 start;
+    int i;
+
+    if (name == NULL || name[0] == '\0' || SDL_strlen(name) >= sizeof(result.name) ||
+        SDL_strchr(name, '"') || SDL_strchr(name, '\\')) {
+        SDLTest_LogError("Invalid benchmark name.");
+        return -1;
+    }
+    if (benchmark == NULL) {
+        SDLTest_LogError("Benchmark function can't be NULL.");
+        return -1;
+    }
+
+    SDL_zero(result);
+    SDL_strlcpy(result.name, name, sizeof(result.name));
+    result.iterations = SDLTest_BenchmarkSettings.iterations;
+
+    samples = (double *)SDL_malloc(result.iterations * sizeof(*samples));
+    if (samples == NULL) {
+        SDLTest_LogError("Unable to allocate benchmark samples");
+        SDL_Error(SDL_ENOMEM);
+        return -1;
+    }
+
+    for (i = 0; i < SDLTest_BenchmarkSettings.warmupIterations; ++i) {
+        benchmark(arg);
+    }
+    for (i = 0; i < result.iterations; ++i) {
+        start = SDL_GetPerformanceCounter();
+        benchmark(arg);
+        samples[i] = (double)(SDL_GetPerformanceCounter() - start) * 1000000.0 / freq;
+        total += samples[i];
+    }
+
+    /* The median and nearest rank 95th percentile */
+    SDL_qsort(samples, result.iterations, sizeof(*samples), SDLTest_CompareSamples);
+    result.min = samples[0];
+    result.max = samples[result.iterations - 1];
+    result.mean = total / result.iterations;
+    if (result.iterations & 1) {
+        result.median = samples[result.iterations / 2];
+    } else {
+        result.median = (samples[result.iterations / 2 - 1] + samples[result.iterations / 2]) / 2.0;
+    }
+    result.p95 = samples[(result.iterations * 95 + 99) / 100 - 1];
+    SDL_free(samples);
+
+    SDLTest_Log(SDLTEST_BENCHMARK_RESULT_FORMAT, result.name,
+                result.median, result.p95, result.min, result.mean, result.max, result.iterations);
+
+    result.baseline = SDLTest_FindBaseline(result.name);
+    if (SDLTest_BenchmarkRecording && !SDLTest_RecordResult(&result)) {
+        return -1;
+    }
+
+    if (result.baseline > 0.0) {
+        const double change = (result.median - result.baseline) * 100.0 / result.baseline;
+        if (!SDLTest_AssertCheck(change <= SDLTest_BenchmarkSettings.tolerance,
+                                 "Benchmark '%s' median %.3f us vs baseline %.3f us (%+.1f%%, tolerance %.1f%%)",
+                                 result.name, result.median, result.baseline, change, SDLTest_BenchmarkSettings.tolerance)) {
+            return 1;
+        }
+    } else {
+        SDLTest_AssertPass("Benchmark '%s' ran", result.name);
+    }
+    return 0;
+}
+
+/*
+ * Run benchmark suites.
+ */
+int
+SDLTest_RunBenchmarks(SDLTest_TestSuiteReference *testSuites[], const char *filter, const SDLTest_BenchmarkOptions *options)
+{
+    int runResult;
+    int regressions = 0;
+    int i;
+
+    /* Sanitize the options */
+    if (options != NULL) {
+        SDLTest_BenchmarkSettings = *options;
+    }
+    if (SDLTest_BenchmarkSettings.warmupIterations < 0) {
+        SDLTest_BenchmarkSettings.warmupIterations = SDLTEST_BENCHMARK_WARMUP_ITERATIONS;
+    }
+    if (SDLTest_BenchmarkSettings.iterations < 1) {
+        SDLTest_BenchmarkSettings.iterations = SDLTEST_BENCHMARK_ITERATIONS;
+    }
+    if (SDLTest_BenchmarkSettings.tolerance <= 0.0f) {
+        SDLTest_BenchmarkSettings.tolerance = SDLTEST_BENCHMARK_TOLERANCE;
+    }
+
+    if (SDLTest_BenchmarkSettings.baselineFile != NULL) {
+        SDLTest_BenchmarkBaseline = SDLTest_ReadFile(SDLTest_BenchmarkSettings.baselineFile);
+        if (SDLTest_BenchmarkBaseline == NULL) {
+            SDLTest_LogError("Couldn't read benchmark baseline '%s': %s", SDLTest_BenchmarkSettings.baselineFile, SDL_GetError());
+            return 2;
+        }
+    }
+
+    SDLTest_Log("::::: Benchmark run: %d warm-up iterations, %d timed iterations",
+                SDLTest_BenchmarkSettings.warmupIterations, SDLTest_BenchmarkSettings.iterations);
+
+    SDLTest_BenchmarkRecording = SDL_TRUE;
+    runResult = SDLTest_RunSuites(testSuites, NULL, 0, filter, 1);
+    SDLTest_BenchmarkRecording = SDL_FALSE;
+
+    /* Log the summary, easier to read than the interleaved test output */
+    SDLTest_Log("Benchmark results (median / p95 per iteration):");
+    for (i = 0; i < SDLTest_BenchmarkResultCount; ++i) {
+        const SDLTest_BenchmarkResult *result = &SDLTest_BenchmarkResults[i];
+        if (result->baseline > 0.0) {
+            const double change = (result->median - result->baseline) * 100.0 / result->baseline;
+            const SDL_bool regressed = (change > SDLTest_BenchmarkSettings.tolerance) ? SDL_TRUE : SDL_FALSE;
+            if (regressed) {
+                ++regressions;
+            }
+            SDLTest_Log("  %-40s %12.3f us %12.3f us  baseline %12.3f us %+7.1f%%%s",
+                        result->name, result->median, result->p95, result->baseline, change,
+                        regressed ? "  REGRESSION" : "");
+        } else {
+            SDLTest_Log("  %-40s %12.3f us %12.3f us", result->name, result->median, result->p95);
+        }
+    }
+    if (SDLTest_BenchmarkBaseline != NULL) {
+        SDLTest_Log("%d of %d benchmarks slower than the baseline by more than %.1f%%",
+                    regressions, SDLTest_BenchmarkResultCount, SDLTest_BenchmarkSettings.tolerance);
+    }
+
+    if (SDLTest_BenchmarkSettings.outputFile != NULL) {
+        if (SDLTest_WriteResults(SDLTest_BenchmarkSettings.outputFile)) {
+            SDLTest_Log("Benchmark results written to '%s'", SDLTest_BenchmarkSettings.outputFile);
+        } else if (runResult == 0) {
+            runResult = 1;
+        }
+    }
+
+    SDL_free(SDLTest_BenchmarkResults);
+    SDLTest_BenchmarkResults = NULL;
+    SDLTest_BenchmarkResultCount = 0;
+    SDLTest_BenchmarkResultSize = 0;
+    SDL_free(SDLTest_BenchmarkBaseline);
+    SDLTest_BenchmarkBaseline = NULL;
+    SDLTest_BenchmarkSettings = SDLTest_BenchmarkDefaults;
+
+    return runResult;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
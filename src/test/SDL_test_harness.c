@@ -346,10 +346,13 @@ static void SDLTest_LogTestSuiteSummary(SDLTest_TestSuiteReference *testSuites)
 }
 #endif
 
-/* Gets a timer value in seconds */
+/* Performance counter value when the test run started */
+static Uint64 clockStart = 0;
+
+/* Gets the time since the test run started in seconds */
 static float GetClock()
 {
-    float currentClock = clock() / (float) CLOCKS_PER_SEC;
+    float currentClock = (float) ((double) (SDL_GetPerformanceCounter() - clockStart) / SDL_GetPerformanceFrequency());
     return currentClock;
 }
 
@@ -426,6 +429,7 @@ int SDLTest_RunSuites(SDLTest_TestSuiteReference *testSuites[], const char *user
     totalTestSkippedCount = 0;
 
     /* Take time - run start */
+    clockStart = SDL_GetPerformanceCounter();
     runStartSeconds = GetClock();
 
     /* Log run with fuzzer parameters */
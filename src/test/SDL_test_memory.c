@@ -22,6 +22,7 @@
 #include "SDL_assert.h"
 #include "SDL_stdinc.h"
 #include "SDL_log.h"
+#include "SDL_test_assert.h"
 #include "SDL_test_crc32.h"
 #include "SDL_test_memory.h"
 
@@ -52,6 +53,8 @@ static SDL_realloc_func SDL_realloc_orig = NULL;
 static SDL_free_func SDL_free_orig = NULL;
 static int s_previous_allocations = 0;
 static SDL_tracked_allocation *s_tracked_allocations[256];
+static SDL_AllocationStats s_steady_state_stats;
+static SDL_bool s_steady_state_tracking;
 
 static unsigned int get_allocation_bucket(void *mem)
 {
@@ -271,4 +274,29 @@ void SDLTest_LogAllocations()
     SDL_Log("%s", message);
 }
 
+void SDLTest_BeginSteadyState(void)
+{
+    /* Leave tracking the way we found it when the region ends */
+    s_steady_state_tracking = SDL_GetAllocationTracking();
+    SDL_SetAllocationTracking(SDL_TRUE);
+    SDL_GetAllocationStats(&s_steady_state_stats);
+}
+
+int SDLTest_EndSteadyState(void)
+{
+    SDL_AllocationStats stats;
+    int allocations;
+
+    SDL_GetAllocationStats(&stats);
+
+    allocations = (int)(stats.num_allocations - s_steady_state_stats.num_allocations);
+    SDLTest_AssertCheck(allocations == 0,
+                        "Check steady state allocations, expected: 0, got: %d (%"SDL_PRIu64" bytes)",
+                        allocations, stats.bytes_allocated - s_steady_state_stats.bytes_allocated);
+    if (!s_steady_state_tracking) {
+        SDL_SetAllocationTracking(SDL_FALSE);
+    }
+    return allocations;
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,584 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* A work-stealing job system on a fixed pool of worker threads */
+
+#include "SDL_atomic.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_hints.h"
+#include "SDL_jobs.h"
+#include "SDL_thread.h"
+#include "SDL_jobs_c.h"
+#include "SDL_systhread.h"
+
+#define SDL_JOBS_MAX_THREADS    64
+
+/* How many finished jobs to keep around for reuse */
+#define SDL_JOBS_FREE_CACHE     1024
+#define SDL_JOBS_INITIAL_QUEUE  64
+
+typedef struct SDL_Job
+{
+    SDL_JobFunction fn;
+    SDL_ParallelForFunction range_fn;
+    void *data;
+    int start;
+    int end;
+    SDL_JobCounter *counter;
+    struct SDL_Job *next;   /* in a counter's dependents */
+} SDL_Job;
+
+struct SDL_JobCounter
+{
+    SDL_atomic_t value;
+
+    /* Jobs that are still touching the counter after decrementing it.
+       Waiters don't return until this is zero, so the last access to a
+       counter by a finished job is the decrement of this. */
+    SDL_atomic_t finishing;
+
+    SDL_SpinLock lock;
+    SDL_Job *dependents;    /* queued when value reaches zero */
+};
+
+/* Each worker owns a queue: it pushes and pops at the back, other
+   threads steal from the front, where the oldest (and usually largest)
+   pieces of work are. */
+typedef struct
+{
+    SDL_SpinLock lock;
+    SDL_Job **jobs;
+    int capacity;
+    int front;
+    int count;
+    SDL_Thread *thread;
+} SDL_JobQueue;
+
+static struct
+{
+    SDL_SpinLock init_lock;
+    SDL_atomic_t initialized;
+    SDL_mutex *lock;
+    SDL_cond *work_cond;
+    SDL_cond *done_cond;
+    SDL_bool shutdown;
+    SDL_atomic_t queued;
+    SDL_atomic_t sleepers;
+    SDL_atomic_t waiters;
+    SDL_atomic_t next_queue;
+    SDL_TLSID worker_tls;
+    SDL_JobQueue queues[SDL_JOBS_MAX_THREADS];
+    int num_workers;
+    SDL_AtomicQueue *free_jobs;
+} jobs;
+
+
+static SDL_Job *
+SDL_AllocJob(void)
+{
+    SDL_Job *job = NULL;
+
+    if (!jobs.free_jobs || !SDL_AtomicQueuePop(jobs.free_jobs, (void **) &job)) {
+        job = (SDL_Job *) SDL_malloc(sizeof(*job));
+        if (!job) {
+            SDL_OutOfMemory();
+            return NULL;
+        }
+    }
+    SDL_zerop(job);
+    return job;
+}
+
+static void
+SDL_FreeJob(SDL_Job *job)
+{
+    if (!jobs.free_jobs || !SDL_AtomicQueuePush(jobs.free_jobs, job)) {
+        SDL_free(job);
+    }
+}
+
+/* Returns the index of the worker running on this thread, or -1 */
+static int
+SDL_GetWorkerIndex(void)
+{
+    return (int) (intptr_t) SDL_TLSGet(jobs.worker_tls) - 1;
+}
+
+static int
+SDL_PushJob(SDL_JobQueue *queue, SDL_Job *job)
+{
+    SDL_AtomicLock(&queue->lock);
+    if (queue->count == queue->capacity) {
+        const int capacity = queue->capacity ? queue->capacity * 2 : SDL_JOBS_INITIAL_QUEUE;
+        SDL_Job **queued = (SDL_Job **) SDL_malloc(capacity * sizeof(*queued));
+        int i;
+
+        if (!queued) {
+            SDL_AtomicUnlock(&queue->lock);
+            return SDL_OutOfMemory();
+        }
+        for (i = 0; i < queue->count; ++i) {
+            queued[i] = queue->jobs[(queue->front + i) % queue->capacity];
+        }
+        SDL_free(queue->jobs);
+        queue->jobs = queued;
+        queue->capacity = capacity;
+        queue->front = 0;
+    }
+    queue->jobs[(queue->front + queue->count) % queue->capacity] = job;
+    ++queue->count;
+    SDL_AtomicUnlock(&queue->lock);
+    return 0;
+}
+
+static SDL_Job *
+SDL_PopJob(SDL_JobQueue *queue)
+{
+    SDL_Job *job = NULL;
+
+    SDL_AtomicLock(&queue->lock);
+    if (queue->count > 0) {
+        --queue->count;
+        job = queue->jobs[(queue->front + queue->count) % queue->capacity];
+    }
+    SDL_AtomicUnlock(&queue->lock);
+    return job;
+}
+
+static SDL_Job *
+SDL_StealJob(SDL_JobQueue *queue)
+{
+    SDL_Job *job = NULL;
+
+    SDL_AtomicLock(&queue->lock);
+    if (queue->count > 0) {
+        job = queue->jobs[queue->front];
+        queue->front = (queue->front + 1) % queue->capacity;
+        --queue->count;
+    }
+    SDL_AtomicUnlock(&queue->lock);
+    return job;
+}
+
+static SDL_Job *
+SDL_FindJob(int self)
+{
+    SDL_Job *job = NULL;
+    int i, first;
+
+    if (SDL_AtomicGet(&jobs.queued) <= 0) {
+        return NULL;
+    }
+
+    if (self >= 0) {
+        job = SDL_PopJob(&jobs.queues[self]);
+        first = self + 1;
+    } else {
+        first = (int) ((unsigned int) SDL_AtomicGet(&jobs.next_queue) % jobs.num_workers);
+    }
+    for (i = 0; !job && i < jobs.num_workers; ++i) {
+        const int victim = (first + i) % jobs.num_workers;
+        if (victim != self) {
+            job = SDL_StealJob(&jobs.queues[victim]);
+        }
+    }
+    if (job) {
+        SDL_AtomicAdd(&jobs.queued, -1);
+    }
+    return job;
+}
+
+static void SDL_RunJobInline(SDL_Job *job);
+
+static int
+SDL_QueueJob(SDL_Job *job)
+{
+    const int self = SDL_GetWorkerIndex();
+    int index;
+
+    /* Jobs queued by a worker stay with it until stolen; others are spread out */
+    if (self >= 0) {
+        index = self;
+    } else {
+        index = (int) ((unsigned int) SDL_AtomicAdd(&jobs.next_queue, 1) % jobs.num_workers);
+    }
+
+    /* Count the job before it can be taken, so queued never goes negative */
+    SDL_AtomicIncRef(&jobs.queued);
+    if (SDL_PushJob(&jobs.queues[index], job) < 0) {
+        SDL_AtomicAdd(&jobs.queued, -1);
+        return -1;
+    }
+
+    if (SDL_AtomicGet(&jobs.sleepers) > 0) {
+        SDL_LockMutex(jobs.lock);
+        SDL_CondSignal(jobs.work_cond);
+        SDL_UnlockMutex(jobs.lock);
+    }
+    return 0;
+}
+
+static void
+SDL_FinishJobCounter(SDL_JobCounter *counter)
+{
+    SDL_AtomicIncRef(&counter->finishing);
+    if (SDL_AtomicAdd(&counter->value, -1) == 1) {
+        SDL_Job *job;
+
+        SDL_AtomicLock(&counter->lock);
+        job = counter->dependents;
+        counter->dependents = NULL;
+        SDL_AtomicUnlock(&counter->lock);
+
+        while (job) {
+            SDL_Job *next = job->next;
+            if (SDL_QueueJob(job) < 0) {
+                SDL_RunJobInline(job);
+            }
+            job = next;
+        }
+    }
+
+    /* This is the last time we touch the counter; it may be freed after this */
+    if (SDL_AtomicDecRef(&counter->finishing) && SDL_AtomicGet(&jobs.waiters) > 0) {
+        SDL_LockMutex(jobs.lock);
+        SDL_CondBroadcast(jobs.done_cond);
+        SDL_UnlockMutex(jobs.lock);
+    }
+}
+
+static void
+SDL_RunJobInline(SDL_Job *job)
+{
+    SDL_JobCounter *counter = job->counter;
+
+    if (job->range_fn) {
+        job->range_fn(job->data, job->start, job->end);
+    } else {
+        job->fn(job->data);
+    }
+    SDL_FreeJob(job);
+
+    if (counter) {
+        SDL_FinishJobCounter(counter);
+    }
+}
+
+static int SDLCALL
+SDL_JobWorkerThread(void *data)
+{
+    const int self = (int) (intptr_t) data;
+
+    SDL_TLSSet(jobs.worker_tls, (void *) (intptr_t) (self + 1), NULL);
+
+    for ( ; ; ) {
+        SDL_Job *job = SDL_FindJob(self);
+        SDL_bool done;
+
+        if (job) {
+            SDL_RunJobInline(job);
+            continue;
+        }
+
+        SDL_LockMutex(jobs.lock);
+        SDL_AtomicIncRef(&jobs.sleepers);
+        while (SDL_AtomicGet(&jobs.queued) <= 0 && !jobs.shutdown) {
+            SDL_CondWait(jobs.work_cond, jobs.lock);
+        }
+        (void)SDL_AtomicDecRef(&jobs.sleepers);
+        done = (jobs.shutdown && SDL_AtomicGet(&jobs.queued) <= 0);
+        SDL_UnlockMutex(jobs.lock);
+
+        if (done) {
+            break;
+        }
+    }
+    return 0;
+}
+
+static int
+SDL_InitJobs(void)
+{
+    int retval = 0;
+
+    if (SDL_AtomicGet(&jobs.initialized)) {
+        return 0;
+    }
+
+    SDL_AtomicLock(&jobs.init_lock);
+    if (!SDL_AtomicGet(&jobs.initialized)) {
+        const char *hint = SDL_GetHint(SDL_HINT_JOB_THREADS);
+        int i, num_workers;
+
+        /* Threads waiting on jobs help run them, so leave a CPU for one */
+        if (hint && SDL_atoi(hint) > 0) {
+            num_workers = SDL_atoi(hint);
+        } else {
+            num_workers = SDL_GetCPUCount() - 1;
+        }
+        num_workers = SDL_max(SDL_min(num_workers, SDL_JOBS_MAX_THREADS), 1);
+
+        if (!jobs.worker_tls) {
+            jobs.worker_tls = SDL_TLSCreate();
+        }
+        jobs.shutdown = SDL_FALSE;
+        jobs.lock = SDL_CreateMutex();
+        jobs.work_cond = SDL_CreateCond();
+        jobs.done_cond = SDL_CreateCond();
+        jobs.free_jobs = SDL_CreateAtomicQueue(SDL_JOBS_FREE_CACHE);
+        if (jobs.worker_tls && jobs.lock && jobs.work_cond && jobs.done_cond && jobs.free_jobs) {
+            jobs.num_workers = num_workers;
+            for (i = 0; i < num_workers; ++i) {
+                char name[32];
+                SDL_snprintf(name, sizeof(name), "SDLJobWorker%d", i);
+                jobs.queues[i].thread = SDL_CreateThreadInternal(SDL_JobWorkerThread, name, 0, (void *) (intptr_t) i);
+                if (!jobs.queues[i].thread) {
+                    break;
+                }
+            }
+            jobs.num_workers = i;
+        }
+
+        if (jobs.num_workers > 0) {
+            SDL_AtomicSet(&jobs.initialized, 1);
+        } else {
+            SDL_AtomicUnlock(&jobs.init_lock);
+            SDL_QuitJobs();
+            SDL_AtomicLock(&jobs.init_lock);
+            retval = -1;
+        }
+    }
+    SDL_AtomicUnlock(&jobs.init_lock);
+
+    return retval;
+}
+
+void
+SDL_QuitJobs(void)
+{
+    int i;
+
+    SDL_AtomicLock(&jobs.init_lock);
+
+    /* Workers run everything that's queued before they exit */
+    if (jobs.lock) {
+        SDL_LockMutex(jobs.lock);
+        jobs.shutdown = SDL_TRUE;
+        SDL_CondBroadcast(jobs.work_cond);
+        SDL_UnlockMutex(jobs.lock);
+    }
+    for (i = 0; i < jobs.num_workers; ++i) {
+        SDL_JobQueue *queue = &jobs.queues[i];
+        SDL_WaitThread(queue->thread, NULL);
+        SDL_free(queue->jobs);
+        SDL_zerop(queue);
+    }
+    jobs.num_workers = 0;
+
+    if (jobs.free_jobs) {
+        SDL_Job *job;
+        while (SDL_AtomicQueuePop(jobs.free_jobs, (void **) &job)) {
+            SDL_free(job);
+        }
+        SDL_DestroyAtomicQueue(jobs.free_jobs);
+        jobs.free_jobs = NULL;
+    }
+    if (jobs.done_cond) {
+        SDL_DestroyCond(jobs.done_cond);
+        jobs.done_cond = NULL;
+    }
+    if (jobs.work_cond) {
+        SDL_DestroyCond(jobs.work_cond);
+        jobs.work_cond = NULL;
+    }
+    if (jobs.lock) {
+        SDL_DestroyMutex(jobs.lock);
+        jobs.lock = NULL;
+    }
+    SDL_AtomicSet(&jobs.queued, 0);
+    SDL_AtomicSet(&jobs.initialized, 0);
+
+    SDL_AtomicUnlock(&jobs.init_lock);
+}
+
+int
+SDL_GetJobWorkerCount(void)
+{
+    if (SDL_InitJobs() < 0) {
+        return -1;
+    }
+    return jobs.num_workers;
+}
+
+SDL_JobCounter *
+SDL_CreateJobCounter(void)
+{
+    SDL_JobCounter *counter = (SDL_JobCounter *) SDL_calloc(1, sizeof(*counter));
+    if (!counter) {
+        SDL_OutOfMemory();
+    }
+    return counter;
+}
+
+int
+SDL_GetJobCounterValue(SDL_JobCounter *counter)
+{
+    if (!counter) {
+        return SDL_InvalidParamError("counter");
+    }
+    return SDL_AtomicGet(&counter->value);
+}
+
+void
+SDL_DestroyJobCounter(SDL_JobCounter *counter)
+{
+    SDL_free(counter);
+}
+
+int
+SDL_RunJobAfter(SDL_JobFunction fn, void *data, SDL_JobCounter *counter, SDL_JobCounter *dependency)
+{
+    SDL_Job *job;
+
+    if (!fn) {
+        return SDL_InvalidParamError("fn");
+    }
+    if (SDL_InitJobs() < 0) {
+        return -1;
+    }
+
+    job = SDL_AllocJob();
+    if (!job) {
+        return -1;
+    }
+    job->fn = fn;
+    job->data = data;
+    job->counter = counter;
+    if (counter) {
+        SDL_AtomicIncRef(&counter->value);
+    }
+
+    if (dependency) {
+        SDL_AtomicLock(&dependency->lock);
+        if (SDL_AtomicGet(&dependency->value) > 0) {
+            job->next = dependency->dependents;
+            dependency->dependents = job;
+            job = NULL;
+        }
+        SDL_AtomicUnlock(&dependency->lock);
+        if (!job) {
+            return 0;
+        }
+    }
+
+    if (SDL_QueueJob(job) < 0) {
+        SDL_FreeJob(job);
+        if (counter) {
+            SDL_FinishJobCounter(counter);
+        }
+        return -1;
+    }
+    return 0;
+}
+
+int
+SDL_RunJob(SDL_JobFunction fn, void *data, SDL_JobCounter *counter)
+{
+    return SDL_RunJobAfter(fn, data, counter, NULL);
+}
+
+void
+SDL_WaitJobCounter(SDL_JobCounter *counter)
+{
+    const int self = SDL_GetWorkerIndex();
+
+    if (!counter) {
+        return;
+    }
+
+    SDL_AtomicIncRef(&jobs.waiters);
+    while (SDL_AtomicGet(&counter->value) > 0 || SDL_AtomicGet(&counter->finishing) > 0) {
+        SDL_Job *job = jobs.num_workers ? SDL_FindJob(self) : NULL;
+        if (job) {
+            SDL_RunJobInline(job);
+            continue;
+        }
+
+        /* Nothing to help with, sleep until a job finishes */
+        SDL_LockMutex(jobs.lock);
+        if ((SDL_AtomicGet(&counter->value) > 0 || SDL_AtomicGet(&counter->finishing) > 0) &&
+            SDL_AtomicGet(&jobs.queued) <= 0) {
+            SDL_CondWait(jobs.done_cond, jobs.lock);
+        }
+        SDL_UnlockMutex(jobs.lock);
+    }
+    (void)SDL_AtomicDecRef(&jobs.waiters);
+}
+
+int
+SDL_ParallelFor(int start, int end, int grain, SDL_ParallelForFunction fn, void *data)
+{
+    SDL_JobCounter counter;
+    int i;
+
+    if (!fn) {
+        return SDL_InvalidParamError("fn");
+    }
+    if (end <= start) {
+        return 0;
+    }
+    if (SDL_InitJobs() < 0) {
+        fn(data, start, end);
+        return 0;
+    }
+
+    if (grain <= 0) {
+        /* A few ranges per thread, so threads that finish early can steal */
+        grain = SDL_max((end - start) / ((jobs.num_workers + 1) * 4), 1);
+    }
+
+    SDL_zero(counter);
+    for (i = start; end - i > grain; i += grain) {
+        SDL_Job *job = SDL_AllocJob();
+        if (!job) {
+            break;
+        }
+        job->range_fn = fn;
+        job->data = data;
+        job->start = i;
+        job->end = i + grain;
+        job->counter = &counter;
+        SDL_AtomicIncRef(&counter.value);
+        if (SDL_QueueJob(job) < 0) {
+            SDL_FreeJob(job);
+            SDL_AtomicAdd(&counter.value, -1);
+            break;
+        }
+    }
+
+    /* The calling thread takes the rest, then helps with the others */
+    fn(data, i, end);
+    SDL_WaitJobCounter(&counter);
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
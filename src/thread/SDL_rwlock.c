@@ -0,0 +1,290 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../SDL_internal.h"
+
+/* Reader-writer locks: pthread_rwlock_t where it's available, otherwise
+   built from an SDL_mutex and an SDL_cond.
+ */
+
+#include "SDL_thread.h"
+
+#if SDL_THREAD_PTHREAD
+
+#include <errno.h>
+#include <pthread.h>
+
+struct SDL_rwlock
+{
+    pthread_rwlock_t id;
+};
+
+SDL_rwlock *
+SDL_CreateRWLock(void)
+{
+    SDL_rwlock *rwlock = (SDL_rwlock *) SDL_calloc(1, sizeof(*rwlock));
+    if (!rwlock) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    if (pthread_rwlock_init(&rwlock->id, NULL) != 0) {
+        SDL_SetError("pthread_rwlock_init() failed");
+        SDL_free(rwlock);
+        return NULL;
+    }
+    return rwlock;
+}
+
+void
+SDL_DestroyRWLock(SDL_rwlock * rwlock)
+{
+    if (rwlock) {
+        pthread_rwlock_destroy(&rwlock->id);
+        SDL_free(rwlock);
+    }
+}
+
+int
+SDL_LockRWLockForReading(SDL_rwlock * rwlock)
+{
+    if (rwlock == NULL) {
+        return SDL_SetError("Passed a NULL rwlock");
+    }
+    if (pthread_rwlock_rdlock(&rwlock->id) != 0) {
+        return SDL_SetError("pthread_rwlock_rdlock() failed");
+    }
+    return 0;
+}
+
+int
+SDL_LockRWLockForWriting(SDL_rwlock * rwlock)
+{
+    if (rwlock == NULL) {
+        return SDL_SetError("Passed a NULL rwlock");
+    }
+    if (pthread_rwlock_wrlock(&rwlock->id) != 0) {
+        return SDL_SetError("pthread_rwlock_wrlock() failed");
+    }
+    return 0;
+}
+
+int
+SDL_TryLockRWLockForReading(SDL_rwlock * rwlock)
+{
+    int result;
+
+    if (rwlock == NULL) {
+        return SDL_SetError("Passed a NULL rwlock");
+    }
+    result = pthread_rwlock_tryrdlock(&rwlock->id);
+    if (result != 0) {
+        if (result == EBUSY || result == EAGAIN) {
+            return SDL_MUTEX_TIMEDOUT;
+        }
+        return SDL_SetError("pthread_rwlock_tryrdlock() failed");
+    }
+    return 0;
+}
+
+int
+SDL_TryLockRWLockForWriting(SDL_rwlock * rwlock)
+{
+    int result;
+
+    if (rwlock == NULL) {
+        return SDL_SetError("Passed a NULL rwlock");
+    }
+    result = pthread_rwlock_trywrlock(&rwlock->id);
+    if (result != 0) {
+        if (result == EBUSY) {
+            return SDL_MUTEX_TIMEDOUT;
+        }
+        return SDL_SetError("pthread_rwlock_trywrlock() failed");
+    }
+    return 0;
+}
+
+int
+SDL_UnlockRWLock(SDL_rwlock * rwlock)
+{
+    if (rwlock == NULL) {
+        return SDL_SetError("Passed a NULL rwlock");
+    }
+    if (pthread_rwlock_unlock(&rwlock->id) != 0) {
+        return SDL_SetError("pthread_rwlock_unlock() failed");
+    }
+    return 0;
+}
+
+#else
+
+/* Readers only wait for an active writer, not for waiting ones, so a
+   thread that already holds a read lock can always take another one.
+   The cost is that a steady stream of readers can starve writers. */
+struct SDL_rwlock
+{
+    SDL_mutex *lock;
+    SDL_cond *cond;
+    int readers;
+    SDL_bool writer;
+};
+
+SDL_rwlock *
+SDL_CreateRWLock(void)
+{
+    SDL_rwlock *rwlock = (SDL_rwlock *) SDL_calloc(1, sizeof(*rwlock));
+    if (!rwlock) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+#if !SDL_THREADS_DISABLED
+    rwlock->lock = SDL_CreateMutex();
+    rwlock->cond = SDL_CreateCond();
+    if (!rwlock->lock || !rwlock->cond) {
+        SDL_DestroyRWLock(rwlock);
+        return NULL;
+    }
+#endif
+    return rwlock;
+}
+
+void
+SDL_DestroyRWLock(SDL_rwlock * rwlock)
+{
+    if (rwlock) {
+        if (rwlock->cond) {
+            SDL_DestroyCond(rwlock->cond);
+        }
+        if (rwlock->lock) {
+            SDL_DestroyMutex(rwlock->lock);
+        }
+        SDL_free(rwlock);
+    }
+}
+
+int
+SDL_LockRWLockForReading(SDL_rwlock * rwlock)
+{
+#if SDL_THREADS_DISABLED
+    return 0;
+#else
+    if (rwlock == NULL) {
+        return SDL_SetError("Passed a NULL rwlock");
+    }
+    SDL_LockMutex(rwlock->lock);
+    while (rwlock->writer) {
+        SDL_CondWait(rwlock->cond, rwlock->lock);
+    }
+    ++rwlock->readers;
+    SDL_UnlockMutex(rwlock->lock);
+    return 0;
+#endif /* SDL_THREADS_DISABLED */
+}
+
+int
+SDL_LockRWLockForWriting(SDL_rwlock * rwlock)
+{
+#if SDL_THREADS_DISABLED
+    return 0;
+#else
+    if (rwlock == NULL) {
+        return SDL_SetError("Passed a NULL rwlock");
+    }
+    SDL_LockMutex(rwlock->lock);
+    while (rwlock->writer || rwlock->readers > 0) {
+        SDL_CondWait(rwlock->cond, rwlock->lock);
+    }
+    rwlock->writer = SDL_TRUE;
+    SDL_UnlockMutex(rwlock->lock);
+    return 0;
+#endif /* SDL_THREADS_DISABLED */
+}
+
+int
+SDL_TryLockRWLockForReading(SDL_rwlock * rwlock)
+{
+#if SDL_THREADS_DISABLED
+    return 0;
+#else
+    int retval = SDL_MUTEX_TIMEDOUT;
+
+    if (rwlock == NULL) {
+        return SDL_SetError("Passed a NULL rwlock");
+    }
+    SDL_LockMutex(rwlock->lock);
+    if (!rwlock->writer) {
+        ++rwlock->readers;
+        retval = 0;
+    }
+    SDL_UnlockMutex(rwlock->lock);
+    return retval;
+#endif /* SDL_THREADS_DISABLED */
+}
+
+int
+SDL_TryLockRWLockForWriting(SDL_rwlock * rwlock)
+{
+#if SDL_THREADS_DISABLED
+    return 0;
+#else
+    int retval = SDL_MUTEX_TIMEDOUT;
+
+    if (rwlock == NULL) {
+        return SDL_SetError("Passed a NULL rwlock");
+    }
+    SDL_LockMutex(rwlock->lock);
+    if (!rwlock->writer && rwlock->readers == 0) {
+        rwlock->writer = SDL_TRUE;
+        retval = 0;
+    }
+    SDL_UnlockMutex(rwlock->lock);
+    return retval;
+#endif /* SDL_THREADS_DISABLED */
+}
+
+int
+SDL_UnlockRWLock(SDL_rwlock * rwlock)
+{
+#if SDL_THREADS_DISABLED
+    return 0;
+#else
+    if (rwlock == NULL) {
+        return SDL_SetError("Passed a NULL rwlock");
+    }
+    SDL_LockMutex(rwlock->lock);
+    if (rwlock->writer) {
+        rwlock->writer = SDL_FALSE;
+        SDL_CondBroadcast(rwlock->cond);
+    } else if (rwlock->readers > 0) {
+        if (--rwlock->readers == 0) {
+            SDL_CondBroadcast(rwlock->cond);
+        }
+    } else {
+        SDL_UnlockMutex(rwlock->lock);
+        return SDL_SetError("rwlock not locked");
+    }
+    SDL_UnlockMutex(rwlock->lock);
+    return 0;
+#endif /* SDL_THREADS_DISABLED */
+}
+
+#endif /* SDL_THREAD_PTHREAD */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,145 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+/* Condition variables on Linux futexes */
+
+#include "SDL_thread.h"
+#include "SDL_sysfutex.h"
+#include "SDL_sysmutex_c.h"
+
+struct SDL_cond
+{
+    /* Bumped by every signal, waiters sleep until it changes */
+    SDL_atomic_t seq;
+    SDL_atomic_t waiters;
+
+    /* The mutex the waiters are using, so a broadcast can move them
+       straight onto it instead of waking them all to fight over it. */
+    void *mutex;
+};
+
+/* Create a condition variable */
+SDL_cond *
+SDL_CreateCond(void)
+{
+    SDL_cond *cond = (SDL_cond *) SDL_calloc(1, sizeof(*cond));
+    if (!cond) {
+        SDL_OutOfMemory();
+    }
+    return cond;
+}
+
+/* Destroy a condition variable */
+void
+SDL_DestroyCond(SDL_cond * cond)
+{
+    SDL_free(cond);
+}
+
+/* Restart one of the threads that are waiting on the condition variable */
+int
+SDL_CondSignal(SDL_cond * cond)
+{
+    if (!cond) {
+        return SDL_SetError("Passed a NULL condition variable");
+    }
+
+    SDL_AtomicIncRef(&cond->seq);
+    if (SDL_AtomicGet(&cond->waiters) > 0) {
+        SDL_FutexWake(&cond->seq, 1);
+    }
+    return 0;
+}
+
+/* Restart all threads that are waiting on the condition variable */
+int
+SDL_CondBroadcast(SDL_cond * cond)
+{
+    int seq;
+
+    if (!cond) {
+        return SDL_SetError("Passed a NULL condition variable");
+    }
+
+    seq = SDL_AtomicAdd(&cond->seq, 1) + 1;
+    if (SDL_AtomicGet(&cond->waiters) > 0) {
+        /* Wake one waiter and requeue the rest on the mutex. Each one
+           takes the mutex marked as contended, so every unlock wakes the
+           next in turn. */
+        SDL_mutex *mutex = (SDL_mutex *) SDL_AtomicGetPtr(&cond->mutex);
+        if (!mutex || SDL_FutexRequeue(&cond->seq, seq, &mutex->state) < 0) {
+            SDL_FutexWake(&cond->seq, INT_MAX);
+        }
+    }
+    return 0;
+}
+
+int
+SDL_CondWaitTimeout(SDL_cond * cond, SDL_mutex * mutex, Uint32 ms)
+{
+    struct timespec deadline;
+    int seq, recursive, retval;
+
+    if (!cond) {
+        return SDL_SetError("Passed a NULL condition variable");
+    }
+    if (!mutex) {
+        return SDL_SetError("Passed a NULL mutex");
+    }
+    if (SDL_AtomicGetPtr(&mutex->owner) != (void *) (uintptr_t) SDL_ThreadID()) {
+        return SDL_SetError("mutex not owned by this thread");
+    }
+
+    if (ms != SDL_MUTEX_MAXWAIT) {
+        SDL_FutexDeadline(&deadline, ms);
+    }
+
+    seq = SDL_AtomicGet(&cond->seq);
+    SDL_AtomicSetPtr(&cond->mutex, mutex);
+    SDL_AtomicIncRef(&cond->waiters);
+
+    /* Release the mutex completely, however many times it was locked */
+    recursive = mutex->recursive;
+    mutex->recursive = 0;
+    SDL_UnlockMutex(mutex);
+
+    retval = SDL_FutexWait(&cond->seq, seq, (ms != SDL_MUTEX_MAXWAIT) ? &deadline : NULL);
+    (void)SDL_AtomicDecRef(&cond->waiters);
+
+    /* We may have been requeued behind other threads on the mutex */
+    SDL_LockMutexContended(mutex);
+    SDL_AtomicSetPtr(&mutex->owner, (void *) (uintptr_t) SDL_ThreadID());
+    mutex->recursive = recursive;
+
+    return retval;
+}
+
+/* Wait on the condition variable, unlocking the provided mutex.
+   The mutex must be locked before entering this function!
+ */
+int
+SDL_CondWait(SDL_cond * cond, SDL_mutex * mutex)
+{
+    return SDL_CondWaitTimeout(cond, mutex, SDL_MUTEX_MAXWAIT);
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
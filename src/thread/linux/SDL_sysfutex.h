@@ -0,0 +1,89 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+#ifndef SDL_sysfutex_h_
+#define SDL_sysfutex_h_
+
+/* Thin wrappers around the Linux futex system call */
+
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+#include "SDL_atomic.h"
+#include "SDL_mutex.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+#define SDL_FUTEX_PAUSE() __asm__ __volatile__("pause\n")
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+#define SDL_FUTEX_PAUSE() __asm__ __volatile__("yield\n")
+#else
+#define SDL_FUTEX_PAUSE()
+#endif
+
+/* Convert a timeout in milliseconds to an absolute CLOCK_MONOTONIC deadline,
+   so waits aren't affected by changes to the wall clock. */
+static SDL_INLINE void
+SDL_FutexDeadline(struct timespec *deadline, Uint32 ms)
+{
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline->tv_sec += ms / 1000;
+    deadline->tv_nsec += (ms % 1000) * 1000000;
+    if (deadline->tv_nsec >= 1000000000) {
+        deadline->tv_sec += 1;
+        deadline->tv_nsec -= 1000000000;
+    }
+}
+
+/* Sleep while *addr == value, until woken or the deadline (NULL for none) passes.
+   Returns 0 if woken or the value changed, or SDL_MUTEX_TIMEDOUT. */
+static SDL_INLINE int
+SDL_FutexWait(SDL_atomic_t *addr, int value, const struct timespec *deadline)
+{
+    if (syscall(SYS_futex, &addr->value, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG,
+                value, deadline, NULL, FUTEX_BITSET_MATCH_ANY) < 0 && errno == ETIMEDOUT) {
+        return SDL_MUTEX_TIMEDOUT;
+    }
+    return 0;
+}
+
+static SDL_INLINE void
+SDL_FutexWake(SDL_atomic_t *addr, int count)
+{
+    syscall(SYS_futex, &addr->value, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, count, NULL, NULL, 0);
+}
+
+/* Wake one thread waiting on addr and move the rest to wait on target,
+   as long as *addr still equals value. Returns -1 if it didn't. */
+static SDL_INLINE int
+SDL_FutexRequeue(SDL_atomic_t *addr, int value, SDL_atomic_t *target)
+{
+    return (int) syscall(SYS_futex, &addr->value, FUTEX_CMP_REQUEUE | FUTEX_PRIVATE_FLAG,
+                         1, (void *) (intptr_t) INT_MAX, &target->value, value);
+}
+
+#endif /* SDL_sysfutex_h_ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,144 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+/* Recursive mutexes on Linux futexes */
+
+#include "SDL_thread.h"
+#include "SDL_cpuinfo.h"
+#include "SDL_sysfutex.h"
+#include "SDL_sysmutex_c.h"
+
+/* The most times to retry the lock before sleeping on it */
+#define SDL_MUTEX_MAX_SPINS 100
+
+SDL_mutex *
+SDL_CreateMutex(void)
+{
+    SDL_mutex *mutex = (SDL_mutex *) SDL_calloc(1, sizeof(*mutex));
+    if (!mutex) {
+        SDL_OutOfMemory();
+    }
+    return mutex;
+}
+
+void
+SDL_DestroyMutex(SDL_mutex * mutex)
+{
+    SDL_free(mutex);
+}
+
+void
+SDL_LockMutexContended(SDL_mutex * mutex)
+{
+    while (SDL_AtomicSet(&mutex->state, 2) != 0) {
+        SDL_FutexWait(&mutex->state, 2, NULL);
+    }
+}
+
+/* Lock the mutex */
+int
+SDL_LockMutex(SDL_mutex * mutex)
+{
+    void *this_thread;
+
+    if (mutex == NULL) {
+        return SDL_SetError("Passed a NULL mutex");
+    }
+
+    this_thread = (void *) (uintptr_t) SDL_ThreadID();
+    if (SDL_AtomicGetPtr(&mutex->owner) == this_thread) {
+        ++mutex->recursive;
+        return 0;
+    }
+
+    if (!SDL_AtomicCAS(&mutex->state, 0, 1)) {
+        /* Locks are usually held briefly, so retry for a while before
+           paying for a system call. How long adapts to how many tries
+           it has recently taken, the same way glibc's adaptive mutexes do.
+           With a single CPU the owner can't run while we spin, so don't. */
+        const int average = SDL_AtomicGet(&mutex->spins);
+        const int max_spins = (SDL_GetCPUCount() > 1) ? SDL_min(average * 2 + 10, SDL_MUTEX_MAX_SPINS) : 0;
+        int spins;
+
+        for (spins = 0; spins < max_spins; ++spins) {
+            SDL_FUTEX_PAUSE();
+            if (SDL_AtomicGet(&mutex->state) == 0 && SDL_AtomicCAS(&mutex->state, 0, 1)) {
+                break;
+            }
+        }
+        if (spins == max_spins) {
+            SDL_LockMutexContended(mutex);
+        }
+        SDL_AtomicSet(&mutex->spins, average + (spins - average) / 8);
+    }
+
+    SDL_AtomicSetPtr(&mutex->owner, this_thread);
+    mutex->recursive = 0;
+    return 0;
+}
+
+int
+SDL_TryLockMutex(SDL_mutex * mutex)
+{
+    void *this_thread;
+
+    if (mutex == NULL) {
+        return SDL_SetError("Passed a NULL mutex");
+    }
+
+    this_thread = (void *) (uintptr_t) SDL_ThreadID();
+    if (SDL_AtomicGetPtr(&mutex->owner) == this_thread) {
+        ++mutex->recursive;
+        return 0;
+    }
+    if (!SDL_AtomicCAS(&mutex->state, 0, 1)) {
+        return SDL_MUTEX_TIMEDOUT;
+    }
+    SDL_AtomicSetPtr(&mutex->owner, this_thread);
+    mutex->recursive = 0;
+    return 0;
+}
+
+int
+SDL_UnlockMutex(SDL_mutex * mutex)
+{
+    if (mutex == NULL) {
+        return SDL_SetError("Passed a NULL mutex");
+    }
+
+    /* We can only unlock the mutex if we own it */
+    if (SDL_AtomicGetPtr(&mutex->owner) != (void *) (uintptr_t) SDL_ThreadID()) {
+        return SDL_SetError("mutex not owned by this thread");
+    }
+
+    if (mutex->recursive) {
+        --mutex->recursive;
+    } else {
+        SDL_AtomicSetPtr(&mutex->owner, NULL);
+        if (SDL_AtomicSet(&mutex->state, 0) == 2) {
+            SDL_FutexWake(&mutex->state, 1);
+        }
+    }
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,130 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "../../SDL_internal.h"
+
+/* Semaphores on Linux futexes */
+
+#include "SDL_thread.h"
+#include "SDL_sysfutex.h"
+
+struct SDL_semaphore
+{
+    SDL_atomic_t count;
+    SDL_atomic_t waiters;
+};
+
+/* Create a semaphore, initialized with value */
+SDL_sem *
+SDL_CreateSemaphore(Uint32 initial_value)
+{
+    SDL_sem *sem = (SDL_sem *) SDL_calloc(1, sizeof(*sem));
+    if (sem) {
+        SDL_AtomicSet(&sem->count, (int) initial_value);
+    } else {
+        SDL_OutOfMemory();
+    }
+    return sem;
+}
+
+void
+SDL_DestroySemaphore(SDL_sem * sem)
+{
+    SDL_free(sem);
+}
+
+int
+SDL_SemTryWait(SDL_sem * sem)
+{
+    int count;
+
+    if (!sem) {
+        return SDL_SetError("Passed a NULL semaphore");
+    }
+
+    do {
+        count = SDL_AtomicGet(&sem->count);
+        if (count <= 0) {
+            return SDL_MUTEX_TIMEDOUT;
+        }
+    } while (!SDL_AtomicCAS(&sem->count, count, count - 1));
+    return 0;
+}
+
+int
+SDL_SemWaitTimeout(SDL_sem * sem, Uint32 timeout)
+{
+    struct timespec deadline;
+    int retval;
+
+    /* Try the easy cases first */
+    retval = SDL_SemTryWait(sem);
+    if (retval != SDL_MUTEX_TIMEDOUT || timeout == 0) {
+        return retval;
+    }
+
+    if (timeout != SDL_MUTEX_MAXWAIT) {
+        SDL_FutexDeadline(&deadline, timeout);
+    }
+
+    /* Posters only make the system call to wake us if they see a waiter */
+    SDL_AtomicIncRef(&sem->waiters);
+    while ((retval = SDL_SemTryWait(sem)) == SDL_MUTEX_TIMEDOUT) {
+        if (SDL_FutexWait(&sem->count, 0, (timeout != SDL_MUTEX_MAXWAIT) ? &deadline : NULL) == SDL_MUTEX_TIMEDOUT) {
+            retval = SDL_SemTryWait(sem);
+            break;
+        }
+    }
+    (void)SDL_AtomicDecRef(&sem->waiters);
+
+    return retval;
+}
+
+int
+SDL_SemWait(SDL_sem * sem)
+{
+    return SDL_SemWaitTimeout(sem, SDL_MUTEX_MAXWAIT);
+}
+
+Uint32
+SDL_SemValue(SDL_sem * sem)
+{
+    int value = 0;
+    if (sem) {
+        value = SDL_AtomicGet(&sem->count);
+    }
+    return (Uint32) SDL_max(value, 0);
+}
+
+int
+SDL_SemPost(SDL_sem * sem)
+{
+    if (!sem) {
+        return SDL_SetError("Passed a NULL semaphore");
+    }
+
+    SDL_AtomicIncRef(&sem->count);
+    if (SDL_AtomicGet(&sem->waiters) > 0) {
+        SDL_FutexWake(&sem->count, 1);
+    }
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -20,6 +20,8 @@
 */
 #include "../SDL_internal.h"
 
+#include "SDL_hints.h"
+#include "SDL_jobs.h"
 #include "SDL_video.h"
 #include "SDL_sysvideo.h"
 #include "SDL_blit.h"
@@ -29,6 +31,50 @@
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
 
+/* Blits of at least this many pixels are split across the job system, in
+   bands of whole multiples of this many rows, which keeps ordered dither
+   patterns lined up between bands */
+#define SDL_PARALLEL_BLIT_PIXELS    (256 * 256)
+#define SDL_PARALLEL_BLIT_ROWS      16
+
+typedef struct
+{
+    const SDL_BlitInfo *info;
+    SDL_BlitFunc blit;
+} SDL_BlitJob;
+
+static void SDLCALL
+SDL_BlitRows(void *data, int start, int end)
+{
+    const SDL_BlitJob *job = (const SDL_BlitJob *) data;
+    SDL_BlitInfo info;
+
+    /* Each band gets its own copy of the blit info, pointing at its rows */
+    SDL_memcpy(&info, job->info, sizeof(info));
+    start *= SDL_PARALLEL_BLIT_ROWS;
+    end = SDL_min(end * SDL_PARALLEL_BLIT_ROWS, info.dst_h);
+    info.src += start * info.src_pitch;
+    info.dst += start * info.dst_pitch;
+    info.src_h = end - start;
+    info.dst_h = end - start;
+    job->blit(&info);
+}
+
+/* Rows are blitted independently of each other unless the blit scales or
+   copies within one surface, so large blits can be done in bands */
+static SDL_bool
+SDL_UseParallelBlit(SDL_Surface * src, SDL_Surface * dst, const SDL_BlitInfo * info)
+{
+    if (src == dst || info->src_w != info->dst_w || info->src_h != info->dst_h) {
+        return SDL_FALSE;
+    }
+    if (info->dst_h < 2 * SDL_PARALLEL_BLIT_ROWS ||
+        info->dst_w * info->dst_h < SDL_PARALLEL_BLIT_PIXELS) {
+        return SDL_FALSE;
+    }
+    return SDL_GetHintBoolean(SDL_HINT_JOB_BULK_OPERATIONS, SDL_FALSE);
+}
+
 /* The general purpose software blit routine */
 static int SDLCALL
 SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
@@ -85,7 +131,18 @@ SDL_SoftBlit(SDL_Surface * src, SDL_Rect * srcrect,
         RunBlit = (SDL_BlitFunc) src->map->data;
 
         /* Run the actual software blit */
-        RunBlit(info);
+        if (SDL_UseParallelBlit(src, dst, info)) {
+            SDL_BlitJob job;
+
+            /* Nothing in a band can fail, everything that can was set up
+               above on this thread */
+            job.info = info;
+            job.blit = RunBlit;
+            SDL_ParallelFor(0, (info->dst_h + SDL_PARALLEL_BLIT_ROWS - 1) / SDL_PARALLEL_BLIT_ROWS,
+                            0, SDL_BlitRows, &job);
+        } else {
+            RunBlit(info);
+        }
     }
 
     /* We need to unlock the surfaces if they're locked */
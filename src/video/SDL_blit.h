@@ -68,6 +68,7 @@ typedef struct
     int flags;
     Uint32 colorkey;
     Uint8 r, g, b, a;
+    Sint16 dither[16];
 } SDL_BlitInfo;
 
 typedef void (*SDL_BlitFunc) (SDL_BlitInfo *info);
@@ -95,6 +96,9 @@ typedef struct SDL_BlitMap
        an invalid mapping */
     Uint32 dst_palette_version;
     Uint32 src_palette_version;
+
+    /* set when info.table is an inverse colormap shared with other maps */
+    struct SDL_InverseColormap *inverse;
 } SDL_BlitMap;
 
 /* Functions found in SDL_blit.c */
@@ -230,6 +234,11 @@ do {                                                                    \
 {                                                                       \
     Pixel = ((r>>3)<<10)|((g>>3)<<5)|(b>>3);                            \
 }
+/* Blits from RGB to 8-bit surfaces look up the nearest palette entry in
+   an RGB 5-5-5 inverse colormap */
+#define INVERSE_COLORMAP_SIZE   32768
+#define INVERSE_COLORMAP_INDEX(r, g, b)                                 \
+    ((((r)>>3)<<10)|(((g)>>3)<<5)|((b)>>3))
 #define RGB888_FROM_RGB(Pixel, r, g, b)                                 \
 {                                                                       \
     Pixel = (r<<16)|(g<<8)|b;                                           \
@@ -60,7 +60,7 @@ BlitNto1SurfaceAlpha(SDL_BlitInfo * info)
         if ( palmap == NULL ) {
             *dst =((dR>>5)<<(3+2))|((dG>>5)<<(2))|((dB>>6)<<(0));
         } else {
-            *dst = palmap[((dR>>5)<<(3+2))|((dG>>5)<<(2))|((dB>>6)<<(0))];
+            *dst = palmap[INVERSE_COLORMAP_INDEX(dR, dG, dB)];
         }
         dst++;
         src += srcbpp;
@@ -106,7 +106,7 @@ BlitNto1PixelAlpha(SDL_BlitInfo * info)
         if ( palmap == NULL ) {
             *dst =((dR>>5)<<(3+2))|((dG>>5)<<(2))|((dB>>6)<<(0));
         } else {
-            *dst = palmap[((dR>>5)<<(3+2))|((dG>>5)<<(2))|((dB>>6)<<(0))];
+            *dst = palmap[INVERSE_COLORMAP_INDEX(dR, dG, dB)];
         }
         dst++;
         src += srcbpp;
@@ -155,7 +155,7 @@ BlitNto1SurfaceAlphaKey(SDL_BlitInfo * info)
             if ( palmap == NULL ) {
                 *dst =((dR>>5)<<(3+2))|((dG>>5)<<(2))|((dB>>6)<<(0));
             } else {
-                *dst = palmap[((dR>>5)<<(3+2))|((dG>>5)<<(2))|((dB>>6)<<(0))];
+                *dst = palmap[INVERSE_COLORMAP_INDEX(dR, dG, dB)];
             }
         }
         dst++;
@@ -20,6 +20,7 @@
 */
 #include "../SDL_internal.h"
 
+#include "SDL_hints.h"
 #include "SDL_video.h"
 #include "SDL_endian.h"
 #include "SDL_cpuinfo.h"
@@ -893,6 +894,12 @@ GetBlitFeatures(void)
                   (((src)&0x0000E000)>>11)| \
                   (((src)&0x000000C0)>>6)); \
 }
+/* ...or to the RGB 5-5-5 index of the inverse colormap */
+#define RGB888_INDEX555(dst, src) { \
+    dst = (int)((((src)&0x00F80000)>>9)| \
+                (((src)&0x0000F800)>>6)| \
+                (((src)&0x000000F8)>>3)); \
+}
 static void
 Blit_RGB888_index8(SDL_BlitInfo * info)
 {
@@ -955,7 +962,7 @@ Blit_RGB888_index8(SDL_BlitInfo * info)
 #ifdef USE_DUFFS_LOOP
             /* *INDENT-OFF* */
             DUFFS_LOOP(
-                RGB888_RGB332(Pixel, *src);
+                RGB888_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             , width);
@@ -963,30 +970,30 @@ Blit_RGB888_index8(SDL_BlitInfo * info)
 #else
             for (c = width / 4; c; --c) {
                 /* Pack RGB into 8bit pixel */
-                RGB888_RGB332(Pixel, *src);
+                RGB888_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
-                RGB888_RGB332(Pixel, *src);
+                RGB888_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
-                RGB888_RGB332(Pixel, *src);
+                RGB888_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
-                RGB888_RGB332(Pixel, *src);
+                RGB888_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             }
             switch (width & 3) {
             case 3:
-                RGB888_RGB332(Pixel, *src);
+                RGB888_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             case 2:
-                RGB888_RGB332(Pixel, *src);
+                RGB888_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             case 1:
-                RGB888_RGB332(Pixel, *src);
+                RGB888_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             }
@@ -1003,6 +1010,12 @@ Blit_RGB888_index8(SDL_BlitInfo * info)
                   (((src)&0x000E0000)>>15)| \
                   (((src)&0x00000300)>>8)); \
 }
+/* ...or to the RGB 5-5-5 index of the inverse colormap */
+#define RGB101010_INDEX555(dst, src) { \
+    dst = (int)((((src)&0x3E000000)>>15)| \
+                (((src)&0x000F8000)>>10)| \
+                (((src)&0x000003E0)>>5)); \
+}
 static void
 Blit_RGB101010_index8(SDL_BlitInfo * info)
 {
@@ -1065,7 +1078,7 @@ Blit_RGB101010_index8(SDL_BlitInfo * info)
 #ifdef USE_DUFFS_LOOP
             /* *INDENT-OFF* */
             DUFFS_LOOP(
-                RGB101010_RGB332(Pixel, *src);
+                RGB101010_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             , width);
@@ -1073,30 +1086,30 @@ Blit_RGB101010_index8(SDL_BlitInfo * info)
 #else
             for (c = width / 4; c; --c) {
                 /* Pack RGB into 8bit pixel */
-                RGB101010_RGB332(Pixel, *src);
+                RGB101010_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
-                RGB101010_RGB332(Pixel, *src);
+                RGB101010_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
-                RGB101010_RGB332(Pixel, *src);
+                RGB101010_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
-                RGB101010_RGB332(Pixel, *src);
+                RGB101010_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             }
             switch (width & 3) {
             case 3:
-                RGB101010_RGB332(Pixel, *src);
+                RGB101010_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             case 2:
-                RGB101010_RGB332(Pixel, *src);
+                RGB101010_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             case 1:
-                RGB101010_RGB332(Pixel, *src);
+                RGB101010_INDEX555(Pixel, *src);
                 *dst++ = map[Pixel];
                 ++src;
             }
@@ -2046,9 +2059,7 @@ BlitNto1(SDL_BlitInfo * info)
                                 sR, sG, sB);
                 if ( 1 ) {
                     /* Pack RGB into 8bit pixel */
-                    *dst = map[((sR>>5)<<(3+2))|
-                           ((sG>>5)<<(2))  |
-                           ((sB>>6)<<(0))  ];
+                    *dst = map[INVERSE_COLORMAP_INDEX(sR, sG, sB)];
                 }
                 dst++;
                 src += srcbpp;
@@ -2059,8 +2070,7 @@ BlitNto1(SDL_BlitInfo * info)
                 DISEMBLE_RGB(src, srcbpp, srcfmt, Pixel, sR, sG, sB);
                 if (1) {
                     /* Pack RGB into 8bit pixel */
-                    *dst = map[((sR >> 5) << (3 + 2)) |
-                               ((sG >> 5) << (2)) | ((sB >> 6) << (0))];
+                    *dst = map[INVERSE_COLORMAP_INDEX(sR, sG, sB)];
                 }
                 dst++;
                 src += srcbpp;
@@ -2072,6 +2082,97 @@ BlitNto1(SDL_BlitInfo * info)
     }
 }
 
+/* Spread a 4x4 ordered dither pattern over about the distance between
+   neighboring colors in the palette */
+static void
+CalculateDither(Sint16 *dither, const SDL_Palette *pal)
+{
+    static const Uint8 bayer[16] = {
+        0, 8, 2, 10,
+        12, 4, 14, 6,
+        3, 11, 1, 9,
+        15, 7, 13, 5
+    };
+    double total = 0.0;
+    int counted = 0;
+    int spread = 0;
+    int i, j;
+
+    /* RGB 3-3-2 has no palette, its red and green steps are 36 apart */
+    if (!pal) {
+        total = 36.0;
+        counted = 1;
+    }
+    for (i = 0; pal && i < pal->ncolors; ++i) {
+        const SDL_Color *color = &pal->colors[i];
+        unsigned int nearest = ~0;
+
+        for (j = 0; j < pal->ncolors; ++j) {
+            const int rd = pal->colors[j].r - color->r;
+            const int gd = pal->colors[j].g - color->g;
+            const int bd = pal->colors[j].b - color->b;
+            const unsigned int distance = (rd * rd) + (gd * gd) + (bd * bd);
+            if (distance != 0 && distance < nearest) {
+                nearest = distance;
+            }
+        }
+        if (nearest != ~0) {
+            total += SDL_sqrt(nearest);
+            ++counted;
+        }
+    }
+    if (counted) {
+        spread = SDL_min((int) (total / counted), 255);
+    }
+    for (i = 0; i < 16; ++i) {
+        dither[i] = (Sint16) (((2 * bayer[i] + 1 - 16) * spread) / 32);
+    }
+}
+
+#define DITHER_CLAMP(v) (((v) < 0) ? 0 : (((v) > 255) ? 255 : (v)))
+
+/* RGB --> 8-bit with ordered dithering, see SDL_HINT_PALETTE_DITHER */
+static void
+BlitNto1Dither(SDL_BlitInfo * info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    SDL_PixelFormat *srcfmt = info->src_fmt;
+    const Uint8 *map = info->table;
+    int srcbpp = srcfmt->BytesPerPixel;
+    Uint32 Pixel;
+    int sR, sG, sB;
+    int x, y;
+
+    for (y = 0; y < height; ++y) {
+        const Sint16 *dither = &info->dither[(y & 3) * 4];
+
+        for (x = 0; x < width; ++x) {
+            const int d = dither[x & 3];
+
+            DISEMBLE_RGB(src, srcbpp, srcfmt, Pixel, sR, sG, sB);
+            sR = DITHER_CLAMP(sR + d);
+            sG = DITHER_CLAMP(sG + d);
+            sB = DITHER_CLAMP(sB + d);
+            if (map) {
+                *dst = map[INVERSE_COLORMAP_INDEX(sR, sG, sB)];
+            } else {
+                /* Pack RGB into 8bit pixel */
+                *dst = ((sR >> 5) << (3 + 2)) |
+                    ((sG >> 5) << (2)) | ((sB >> 6) << (0));
+            }
+            dst++;
+            src += srcbpp;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
 /* blits 32 bit RGB<->RGBA with both surfaces having the same R,G,B fields */
 static void
 Blit4to4MaskAlpha(SDL_BlitInfo * info)
@@ -2264,9 +2365,7 @@ BlitNto1Key(SDL_BlitInfo * info)
                                 sR, sG, sB);
                 if ( (Pixel & rgbmask) != ckey ) {
                     /* Pack RGB into 8bit pixel */
-                    *dst = (Uint8)palmap[((sR>>5)<<(3+2))|
-                                         ((sG>>5)<<(2))  |
-                                         ((sB>>6)<<(0))  ];
+                    *dst = palmap[INVERSE_COLORMAP_INDEX(sR, sG, sB)];
                 }
                 dst++;
                 src += srcbpp;
@@ -2609,15 +2708,18 @@ SDL_CalculateBlitN(SDL_Surface * surface)
         blitfun = NULL;
         if (dstfmt->BitsPerPixel == 8) {
             if ((srcfmt->BytesPerPixel == 4) &&
-                (srcfmt->Rmask == 0x00FF0000) &&
-                (srcfmt->Gmask == 0x0000FF00) &&
-                (srcfmt->Bmask == 0x000000FF)) {
-                blitfun = Blit_RGB888_index8;
-            } else if ((srcfmt->BytesPerPixel == 4) &&
                 (srcfmt->Rmask == 0x3FF00000) &&
                 (srcfmt->Gmask == 0x000FFC00) &&
                 (srcfmt->Bmask == 0x000003FF)) {
                 blitfun = Blit_RGB101010_index8;
+            } else if (SDL_GetHintBoolean(SDL_HINT_PALETTE_DITHER, SDL_FALSE)) {
+                CalculateDither(surface->map->info.dither, dstfmt->palette);
+                blitfun = BlitNto1Dither;
+            } else if ((srcfmt->BytesPerPixel == 4) &&
+                (srcfmt->Rmask == 0x00FF0000) &&
+                (srcfmt->Gmask == 0x0000FF00) &&
+                (srcfmt->Bmask == 0x000000FF)) {
+                blitfun = Blit_RGB888_index8;
             } else {
                 blitfun = BlitNto1;
             }
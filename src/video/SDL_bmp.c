@@ -40,6 +40,9 @@
 
 #define SAVE_32BIT_BMP
 
+/* How many bytes of rows are read or converted at a time */
+#define BMP_CHUNK_SIZE  (64 * 1024)
+
 /* Compression encodings for BMP files */
 #ifndef BI_RGB
 #define BI_RGB      0
@@ -83,6 +86,72 @@ static void CorrectAlphaChannel(SDL_Surface *surface)
     }
 }
 
+/* Memory streams hand out a pointer to their data rather than copying it */
+static const Uint8 *
+MapBMPBits(SDL_RWops *src, size_t size)
+{
+    if (src->type == SDL_RWOPS_MEMORY || src->type == SDL_RWOPS_MEMORY_RO) {
+        Uint8 *here = src->hidden.mem.here;
+        if ((size_t) (src->hidden.mem.stop - here) >= size) {
+            src->hidden.mem.here += size;
+            return here;
+        }
+    }
+    return NULL;
+}
+
+/* The 8 or 2 pixels each byte of a 1 or 4 bit bitmap holds */
+static void
+BuildExpandTable(Uint8 table[256][8], int ExpandBMP)
+{
+    const int perByte = 8 / ExpandBMP;
+    const int mask = (1 << ExpandBMP) - 1;
+    int i, j;
+
+    for (i = 0; i < 256; ++i) {
+        for (j = 0; j < perByte; ++j) {
+            table[i][j] = (Uint8) ((i >> (8 - ExpandBMP * (j + 1))) & mask);
+        }
+    }
+}
+
+static void
+ExpandBMPRow(Uint8 *dst, const Uint8 *src, int width, int ExpandBMP, Uint8 table[256][8])
+{
+    const Uint8 *pixels;
+    int i;
+
+    if (ExpandBMP == 1) {
+        for (i = width >> 3; i--; dst += 8) {
+            pixels = table[*src++];
+            dst[0] = pixels[0];
+            dst[1] = pixels[1];
+            dst[2] = pixels[2];
+            dst[3] = pixels[3];
+            dst[4] = pixels[4];
+            dst[5] = pixels[5];
+            dst[6] = pixels[6];
+            dst[7] = pixels[7];
+        }
+        width &= 7;
+    } else {
+        for (i = width >> 1; i--; dst += 2) {
+            pixels = table[*src++];
+            dst[0] = pixels[0];
+            dst[1] = pixels[1];
+        }
+        width &= 1;
+    }
+
+    /* The last byte may be only partly used */
+    if (width) {
+        pixels = table[*src];
+        for (i = 0; i < width; ++i) {
+            dst[i] = pixels[i];
+        }
+    }
+}
+
 SDL_Surface *
 SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
 {
@@ -97,7 +166,11 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
     Uint32 Amask = 0;
     SDL_Palette *palette;
     Uint8 *bits;
-    Uint8 *top, *end;
+    const Uint8 *data;
+    Uint8 *buffer = NULL;
+    Uint8 expand[256][8];
+    size_t size;
+    int stride, chunkRows = 1;
     SDL_bool topDown;
     int ExpandBMP;
     SDL_bool haveRGBMasks = SDL_FALSE;
@@ -310,6 +383,9 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
     /* Load the palette, if any */
     palette = (surface->format)->palette;
     if (palette) {
+        const int entrySize = (biSize == 12) ? 3 : 4;
+        Uint8 entries[256 * 4];
+
         SDL_assert(biBitCount <= 8);
         if (biClrUsed == 0) {
             biClrUsed = 1 << biBitCount;
@@ -331,25 +407,25 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
         } else if ((int) biClrUsed < palette->ncolors) {
             palette->ncolors = biClrUsed;
         }
-        if (biSize == 12) {
-            for (i = 0; i < (int) biClrUsed; ++i) {
-                SDL_RWread(src, &palette->colors[i].b, 1, 1);
-                SDL_RWread(src, &palette->colors[i].g, 1, 1);
-                SDL_RWread(src, &palette->colors[i].r, 1, 1);
-                palette->colors[i].a = SDL_ALPHA_OPAQUE;
-            }
-        } else {
-            for (i = 0; i < (int) biClrUsed; ++i) {
-                SDL_RWread(src, &palette->colors[i].b, 1, 1);
-                SDL_RWread(src, &palette->colors[i].g, 1, 1);
-                SDL_RWread(src, &palette->colors[i].r, 1, 1);
-                SDL_RWread(src, &palette->colors[i].a, 1, 1);
-
+        /* Read the color table up to 256 entries at a time */
+        for (i = 0; i < (int) biClrUsed; i += 256) {
+            const int count = SDL_min((int) biClrUsed - i, 256);
+            const int got = (int) SDL_RWread(src, entries, entrySize, count);
+            int j;
+
+            for (j = 0; j < got; ++j) {
+                SDL_Color *color = &palette->colors[i + j];
+                color->b = entries[j * entrySize + 0];
+                color->g = entries[j * entrySize + 1];
+                color->r = entries[j * entrySize + 2];
                 /* According to Microsoft documentation, the fourth element
                    is reserved and must be zero, so we shouldn't treat it as
                    alpha.
                 */
-                palette->colors[i].a = SDL_ALPHA_OPAQUE;
+                color->a = SDL_ALPHA_OPAQUE;
+            }
+            if (got < count) {
+                break;
             }
         }
     }
@@ -360,92 +436,115 @@ SDL_LoadBMP_RW(SDL_RWops * src, int freesrc)
         was_error = SDL_TRUE;
         goto done;
     }
-    top = (Uint8 *)surface->pixels;
-    end = (Uint8 *)surface->pixels+(surface->h*surface->pitch);
     switch (ExpandBMP) {
     case 1:
         bmpPitch = (biWidth + 7) >> 3;
-        pad = (((bmpPitch) % 4) ? (4 - ((bmpPitch) % 4)) : 0);
         break;
     case 4:
         bmpPitch = (biWidth + 1) >> 1;
-        pad = (((bmpPitch) % 4) ? (4 - ((bmpPitch) % 4)) : 0);
         break;
     default:
-        pad = ((surface->pitch % 4) ? (4 - (surface->pitch % 4)) : 0);
+        bmpPitch = surface->w * surface->format->BytesPerPixel;
         break;
     }
-    if (topDown) {
-        bits = top;
-    } else {
-        bits = end - surface->pitch;
+    pad = (((bmpPitch) % 4) ? (4 - ((bmpPitch) % 4)) : 0);
+    if (surface->h == 0 || bmpPitch == 0) {
+        goto done;  /* nothing to read */
     }
-    while (bits >= top && bits < end) {
-        switch (ExpandBMP) {
-        case 1:
-        case 4:{
-                Uint8 pixel = 0;
-                int shift = (8 - ExpandBMP);
-                for (i = 0; i < surface->w; ++i) {
-                    if (i % (8 / ExpandBMP) == 0) {
-                        if (!SDL_RWread(src, &pixel, 1, 1)) {
-                            SDL_SetError("Error reading from BMP");
-                            was_error = SDL_TRUE;
-                            goto done;
-                        }
-                    }
-                    *(bits + i) = (pixel >> shift);
-                    pixel <<= ExpandBMP;
-                }
-            }
-            break;
 
-        default:
-            if (SDL_RWread(src, bits, 1, surface->pitch)
-                != surface->pitch) {
-                SDL_Error(SDL_EFREAD);
-                was_error = SDL_TRUE;
-                goto done;
-            }
-#if SDL_BYTEORDER == SDL_BIG_ENDIAN
-            /* Byte-swap the pixels if needed. Note that the 24bpp
-               case has already been taken care of above. */
-            switch (biBitCount) {
-            case 15:
-            case 16:{
-                    Uint16 *pix = (Uint16 *) bits;
-                    for (i = 0; i < surface->w; i++)
-                        pix[i] = SDL_Swap16(pix[i]);
-                    break;
-                }
+    stride = bmpPitch + pad;
+
+    /* The rows can be used in place from memory, or read straight into the
+       surface if they're laid out the same, otherwise they're read a chunk
+       at a time.  The last row's padding is skipped afterwards, since
+       some files leave it out. */
+    size = (size_t) (surface->h - 1) * stride + bmpPitch;
+    data = MapBMPBits(src, size);
+    if (!data && !ExpandBMP && topDown && stride == surface->pitch) {
+        if (SDL_RWread(src, surface->pixels, 1, size) != size) {
+            SDL_Error(SDL_EFREAD);
+            was_error = SDL_TRUE;
+            goto done;
+        }
+        data = (const Uint8 *) surface->pixels;
+    }
+    if (!data) {
+        chunkRows = SDL_max(1, SDL_min(surface->h, BMP_CHUNK_SIZE / stride));
+        buffer = (Uint8 *) SDL_malloc((size_t) chunkRows * stride);
+        if (!buffer) {
+            SDL_OutOfMemory();
+            was_error = SDL_TRUE;
+            goto done;
+        }
+    }
+    if (ExpandBMP) {
+        BuildExpandTable(expand, ExpandBMP);
+    }
 
-            case 32:{
-                    Uint32 *pix = (Uint32 *) bits;
-                    for (i = 0; i < surface->w; i++)
-                        pix[i] = SDL_Swap32(pix[i]);
-                    break;
+    for (i = 0; i < surface->h; ++i) {
+        const Uint8 *row;
+
+        if (data) {
+            row = data + (size_t) i * stride;
+        } else {
+            if ((i % chunkRows) == 0) {
+                if (surface->h - i > chunkRows) {
+                    size = (size_t) chunkRows * stride;
+                } else {
+                    size = (size_t) (surface->h - i - 1) * stride + bmpPitch;
+                }
+                if (SDL_RWread(src, buffer, 1, size) != size) {
+                    SDL_Error(SDL_EFREAD);
+                    was_error = SDL_TRUE;
+                    goto done;
                 }
             }
-#endif
-            break;
-        }
-        /* Skip padding bytes, ugh */
-        if (pad) {
-            Uint8 padbyte;
-            for (i = 0; i < pad; ++i) {
-                SDL_RWread(src, &padbyte, 1, 1);
-            }
+            row = buffer + (i % chunkRows) * stride;
         }
+
         if (topDown) {
-            bits += surface->pitch;
+            bits = (Uint8 *) surface->pixels + i * surface->pitch;
         } else {
-            bits -= surface->pitch;
+            bits = (Uint8 *) surface->pixels + (surface->h - 1 - i) * surface->pitch;
+        }
+        if (ExpandBMP) {
+            ExpandBMPRow(bits, row, surface->w, ExpandBMP, expand);
+        } else if (bits != row) {
+            SDL_memcpy(bits, row, bmpPitch);
         }
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+        /* Byte-swap the pixels if needed. Note that the 24bpp
+           case has already been taken care of above. */
+        switch (biBitCount) {
+        case 15:
+        case 16:{
+                Uint16 *pix = (Uint16 *) bits;
+                int x;
+                for (x = 0; x < surface->w; x++)
+                    pix[x] = SDL_Swap16(pix[x]);
+                break;
+            }
+
+        case 32:{
+                Uint32 *pix = (Uint32 *) bits;
+                int x;
+                for (x = 0; x < surface->w; x++)
+                    pix[x] = SDL_Swap32(pix[x]);
+                break;
+            }
+        }
+#endif
+    }
+    if (pad) {
+        /* Leave the stream after the bitmap, the same as when reading row by row */
+        Uint8 padding[4];
+        SDL_RWread(src, padding, 1, pad);
     }
     if (correctAlpha) {
         CorrectAlphaChannel(surface);
     }
   done:
+    SDL_free(buffer);
     if (was_error) {
         if (src) {
             SDL_RWseek(src, fp_offset, RW_SEEK_SET);
@@ -465,6 +564,8 @@ SDL_SaveBMP_RW(SDL_Surface * saveme, SDL_RWops * dst, int freedst)
     Sint64 fp_offset;
     int i, pad;
     SDL_Surface *surface;
+    SDL_Surface *strip = NULL;
+    SDL_PixelFormat *fmt;
     Uint8 *bits;
     SDL_bool save32bit = SDL_FALSE;
     SDL_bool saveLegacyBMP = SDL_FALSE;
@@ -530,6 +631,23 @@ SDL_SaveBMP_RW(SDL_Surface * saveme, SDL_RWops * dst, int freedst)
 #endif
             ) {
             surface = saveme;
+        } else if (save32bit && saveme->format->format == SDL_PIXELFORMAT_BGRA32 &&
+                   !(saveme->map->info.flags & SDL_COPY_COLORKEY)) {
+            surface = saveme;
+        } else if (!(saveme->map->info.flags & SDL_COPY_COLORKEY)) {
+            /* Convert a strip of rows at a time as they're written, rather
+               than copying the whole image first */
+            const Uint32 stripFormat = save32bit ? SDL_PIXELFORMAT_BGRA32 : SDL_PIXELFORMAT_BGR24;
+            const int rowSize = saveme->w * SDL_BYTESPERPIXEL(stripFormat);
+            const int rows = SDL_max(1, SDL_min(saveme->h, BMP_CHUNK_SIZE / SDL_max(rowSize, 1)));
+
+            strip = SDL_CreateRGBSurfaceWithFormat(0, saveme->w, rows, 0, stripFormat);
+            if (strip) {
+                surface = saveme;
+            } else {
+                SDL_SetError("Couldn't convert image to %d bpp",
+                             (int) SDL_BITSPERPIXEL(stripFormat));
+            }
         } else {
             SDL_PixelFormat format;
 
@@ -556,8 +674,14 @@ SDL_SaveBMP_RW(SDL_Surface * saveme, SDL_RWops * dst, int freedst)
         saveLegacyBMP = SDL_GetHintBoolean(SDL_HINT_BMP_SAVE_LEGACY_FORMAT, SDL_FALSE);
     }
 
-    if (surface && (SDL_LockSurface(surface) == 0)) {
-        const int bw = surface->w * surface->format->BytesPerPixel;
+    /* The strip blits lock the surface themselves */
+    if (surface && (strip || SDL_LockSurface(surface) == 0)) {
+        static const Uint8 padbytes[4] = { 0, 0, 0, 0 };
+        int bw;
+
+        fmt = strip ? strip->format : surface->format;
+        bw = surface->w * fmt->BytesPerPixel;
+        pad = ((bw % 4) ? (4 - (bw % 4)) : 0);
 
         /* Set the BMP file header values */
         bfSize = 0;             /* We'll write this when we're done */
@@ -579,13 +703,13 @@ SDL_SaveBMP_RW(SDL_Surface * saveme, SDL_RWops * dst, int freedst)
         biWidth = surface->w;
         biHeight = surface->h;
         biPlanes = 1;
-        biBitCount = surface->format->BitsPerPixel;
+        biBitCount = fmt->BitsPerPixel;
         biCompression = BI_RGB;
-        biSizeImage = surface->h * surface->pitch;
+        biSizeImage = surface->h * (bw + pad);
         biXPelsPerMeter = 0;
         biYPelsPerMeter = 0;
-        if (surface->format->palette) {
-            biClrUsed = surface->format->palette->ncolors;
+        if (fmt->palette) {
+            biClrUsed = fmt->palette->ncolors;
         } else {
             biClrUsed = 0;
         }
@@ -635,17 +759,23 @@ SDL_SaveBMP_RW(SDL_Surface * saveme, SDL_RWops * dst, int freedst)
         }
 
         /* Write the palette (in BGR color order) */
-        if (surface->format->palette) {
-            SDL_Color *colors;
-            int ncolors;
-
-            colors = surface->format->palette->colors;
-            ncolors = surface->format->palette->ncolors;
-            for (i = 0; i < ncolors; ++i) {
-                SDL_RWwrite(dst, &colors[i].b, 1, 1);
-                SDL_RWwrite(dst, &colors[i].g, 1, 1);
-                SDL_RWwrite(dst, &colors[i].r, 1, 1);
-                SDL_RWwrite(dst, &colors[i].a, 1, 1);
+        if (fmt->palette) {
+            const SDL_Color *colors = fmt->palette->colors;
+            const int ncolors = fmt->palette->ncolors;
+            Uint8 entries[256 * 4];
+
+            /* ...up to 256 entries at a time */
+            for (i = 0; i < ncolors; i += 256) {
+                const int count = SDL_min(ncolors - i, 256);
+                int j;
+
+                for (j = 0; j < count; ++j) {
+                    entries[j * 4 + 0] = colors[i + j].b;
+                    entries[j * 4 + 1] = colors[i + j].g;
+                    entries[j * 4 + 2] = colors[i + j].r;
+                    entries[j * 4 + 3] = colors[i + j].a;
+                }
+                SDL_RWwrite(dst, entries, 4, count);
             }
         }
 
@@ -660,18 +790,60 @@ SDL_SaveBMP_RW(SDL_Surface * saveme, SDL_RWops * dst, int freedst)
         }
 
         /* Write the bitmap image upside down */
-        bits = (Uint8 *) surface->pixels + (surface->h * surface->pitch);
-        pad = ((bw % 4) ? (4 - (bw % 4)) : 0);
-        while (bits > (Uint8 *) surface->pixels) {
-            bits -= surface->pitch;
-            if (SDL_RWwrite(dst, bits, 1, bw) != bw) {
-                SDL_Error(SDL_EFWRITE);
-                break;
+        if (strip) {
+            SDL_BlitMap *map = surface->map;
+            const Uint32 flags = map->info.flags;
+            const Uint8 r = map->info.r, g = map->info.g, b = map->info.b, a = map->info.a;
+            SDL_Rect srcrect, dstrect;
+            int y = surface->h;
+
+            /* Copy the pixels as they are, like SDL_ConvertSurface() */
+            map->info.r = map->info.g = map->info.b = map->info.a = 0xFF;
+            map->info.flags = 0;
+            SDL_InvalidateMap(map);
+
+            /* The strip's rows are padded with zeroes to at least 4 bytes,
+               so each one goes out with its padding in a single write */
+            while (y > 0) {
+                const int rows = SDL_min(y, strip->h);
+
+                y -= rows;
+                srcrect.x = 0;
+                srcrect.y = y;
+                srcrect.w = surface->w;
+                srcrect.h = rows;
+                dstrect = srcrect;
+                dstrect.y = 0;
+                if (SDL_LowerBlit(surface, &srcrect, strip, &dstrect) < 0) {
+                    break;
+                }
+                for (i = rows; i--; ) {
+                    bits = (Uint8 *) strip->pixels + i * strip->pitch;
+                    if (SDL_RWwrite(dst, bits, 1, bw + pad) != (size_t) (bw + pad)) {
+                        SDL_Error(SDL_EFWRITE);
+                        y = 0;
+                        break;
+                    }
+                }
             }
-            if (pad) {
-                const Uint8 padbyte = 0;
-                for (i = 0; i < pad; ++i) {
-                    SDL_RWwrite(dst, &padbyte, 1, 1);
+
+            map->info.r = r;
+            map->info.g = g;
+            map->info.b = b;
+            map->info.a = a;
+            map->info.flags = flags;
+            SDL_InvalidateMap(map);
+        } else {
+            bits = (Uint8 *) surface->pixels + (surface->h * surface->pitch);
+            while (bits > (Uint8 *) surface->pixels) {
+                bits -= surface->pitch;
+                if (SDL_RWwrite(dst, bits, 1, bw) != bw) {
+                    SDL_Error(SDL_EFWRITE);
+                    break;
+                }
+                if (pad && SDL_RWwrite(dst, padbytes, 1, pad) != pad) {
+                    SDL_Error(SDL_EFWRITE);
+                    break;
                 }
             }
         }
@@ -687,11 +859,14 @@ SDL_SaveBMP_RW(SDL_Surface * saveme, SDL_RWops * dst, int freedst)
         }
 
         /* Close it up.. */
-        SDL_UnlockSurface(surface);
+        if (!strip) {
+            SDL_UnlockSurface(surface);
+        }
         if (surface != saveme) {
             SDL_FreeSurface(surface);
         }
     }
+    SDL_FreeSurface(strip);
 
     if (freedst && dst) {
         SDL_RWclose(dst);
@@ -238,6 +238,7 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
 {
     SDL_Rect clipped;
     Uint8 *pixels;
+    int w, h;
 
     if (!dst) {
         return SDL_SetError("Passed NULL destination surface");
@@ -270,6 +271,16 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
 
     pixels = (Uint8 *) dst->pixels + rect->y * dst->pitch +
                                      rect->x * dst->format->BytesPerPixel;
+    w = rect->w;
+    h = rect->h;
+
+    /* Rows with no padding between them can be filled as one long row,
+       without any work at the row ends. The padding belongs to whoever
+       owns the pixels, so it's never written. */
+    if (w == dst->w && dst->pitch == w * dst->format->BytesPerPixel) {
+        w *= h;
+        h = 1;
+    }
 
     switch (dst->format->BytesPerPixel) {
     case 1:
@@ -278,11 +289,11 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
             color |= (color << 16);
 #ifdef __SSE__
             if (SDL_HasSSE()) {
-                SDL_FillRect1SSE(pixels, dst->pitch, color, rect->w, rect->h);
+                SDL_FillRect1SSE(pixels, dst->pitch, color, w, h);
                 break;
             }
 #endif
-            SDL_FillRect1(pixels, dst->pitch, color, rect->w, rect->h);
+            SDL_FillRect1(pixels, dst->pitch, color, w, h);
             break;
         }
 
@@ -291,18 +302,18 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
             color |= (color << 16);
 #ifdef __SSE__
             if (SDL_HasSSE()) {
-                SDL_FillRect2SSE(pixels, dst->pitch, color, rect->w, rect->h);
+                SDL_FillRect2SSE(pixels, dst->pitch, color, w, h);
                 break;
             }
 #endif
-            SDL_FillRect2(pixels, dst->pitch, color, rect->w, rect->h);
+            SDL_FillRect2(pixels, dst->pitch, color, w, h);
             break;
         }
 
     case 3:
         /* 24-bit RGB is a slow path, at least for now. */
         {
-            SDL_FillRect3(pixels, dst->pitch, color, rect->w, rect->h);
+            SDL_FillRect3(pixels, dst->pitch, color, w, h);
             break;
         }
 
@@ -310,11 +321,11 @@ SDL_FillRect(SDL_Surface * dst, const SDL_Rect * rect, Uint32 color)
         {
 #ifdef __SSE__
             if (SDL_HasSSE()) {
-                SDL_FillRect4SSE(pixels, dst->pitch, color, rect->w, rect->h);
+                SDL_FillRect4SSE(pixels, dst->pitch, color, w, h);
                 break;
             }
 #endif
-            SDL_FillRect4(pixels, dst->pitch, color, rect->w, rect->h);
+            SDL_FillRect4(pixels, dst->pitch, color, w, h);
             break;
         }
     }
@@ -635,6 +635,8 @@ SDL_FreeFormat(SDL_PixelFormat *format)
     SDL_free(format);
 }
 
+static void SDL_ForgetInverseColormaps(SDL_Palette * palette);
+
 SDL_Palette *
 SDL_AllocPalette(int ncolors)
 {
@@ -731,6 +733,7 @@ SDL_FreePalette(SDL_Palette * palette)
     if (--palette->refcount > 0) {
         return;
     }
+    SDL_ForgetInverseColormaps(palette);
     SDL_free(palette->colors);
     SDL_free(palette);
 }
@@ -933,19 +936,274 @@ Map1toN(SDL_PixelFormat * src, Uint8 Rmod, Uint8 Gmod, Uint8 Bmod, Uint8 Amod,
     return (map);
 }
 
-/* Map from BitField to Dithered-Palette to Palette */
-static Uint8 *
+/* The RGB color a 5 bit channel value stands for */
+#define EXPAND_5BIT(v)  (((v) << 3) | ((v) >> 2))
+
+/* Distance from a color to the nearest and farthest points in a range */
+#define RANGE_DISTANCE(v, lo, hi, mindist, maxdist)             \
+{                                                               \
+    const int below = (lo) - (v), above = (v) - (hi);           \
+    mindist = (below > 0) ? below : ((above > 0) ? above : 0);  \
+    maxdist = SDL_max(-below, -above);                          \
+}
+
+/* Pick the palette entries, out of those given, that could be nearest to
+   a color in a size x size x size block of RGB 5-5-5 colors.  That rules
+   out any entry farther from the block than the farthest point of the
+   entry that is closest to it. */
+static int
+FindBlockCandidates(const SDL_Palette * pal, const unsigned int *alpha,
+                    const Uint8 * entries, int nentries,
+                    int r, int g, int b, int size, Uint8 * candidates)
+{
+    unsigned int closest[256];
+    unsigned int bound = ~0;
+    int count = 0;
+    int i;
+
+    for (i = 0; i < nentries; ++i) {
+        const SDL_Color *color = &pal->colors[entries[i]];
+        int rn, rf, gn, gf, bn, bf;
+        unsigned int farthest;
+
+        RANGE_DISTANCE(color->r, EXPAND_5BIT(r), EXPAND_5BIT(r + size - 1), rn, rf);
+        RANGE_DISTANCE(color->g, EXPAND_5BIT(g), EXPAND_5BIT(g + size - 1), gn, gf);
+        RANGE_DISTANCE(color->b, EXPAND_5BIT(b), EXPAND_5BIT(b + size - 1), bn, bf);
+        closest[i] = rn * rn + gn * gn + bn * bn + alpha[entries[i]];
+        farthest = rf * rf + gf * gf + bf * bf + alpha[entries[i]];
+        if (farthest < bound) {
+            bound = farthest;
+        }
+    }
+    for (i = 0; i < nentries; ++i) {
+        if (closest[i] <= bound) {
+            candidates[count++] = entries[i];
+        }
+    }
+    return count;
+}
+
+/* Fill in the palette entry nearest to each RGB 5-5-5 color.  Rather than
+   searching the whole palette for each of the 32K colors, they're searched
+   a block at a time, among only the entries that could be nearest to
+   something in the block.  This gives the same result as SDL_FindColor()
+   for a fraction of the work. */
+static void
+BuildInverseColormap(const SDL_Palette * pal, Uint8 * map)
+{
+    const int ncolors = SDL_min(pal->ncolors, 256);
+    unsigned int alpha[256];
+    Uint8 entries[256], outer[256], inner[256];
+    unsigned int smallest[64];
+    int R, G, B, r, g, b, i;
+
+    for (i = 0; i < ncolors; ++i) {
+        const int ad = pal->colors[i].a - SDL_ALPHA_OPAQUE;
+        alpha[i] = ad * ad;
+        entries[i] = (Uint8) i;
+    }
+
+    /* Narrow the entries down for blocks of 8x8x8 colors, then 4x4x4 */
+    for (R = 0; R < 32; R += 8) {
+        for (G = 0; G < 32; G += 8) {
+            for (B = 0; B < 32; B += 8) {
+                const int nouter = FindBlockCandidates(pal, alpha, entries, ncolors, R, G, B, 8, outer);
+                int br, bg, bb;
+
+                for (br = R; br < R + 8; br += 4) {
+                    for (bg = G; bg < G + 8; bg += 4) {
+                        for (bb = B; bb < B + 8; bb += 4) {
+                            const int ninner = FindBlockCandidates(pal, alpha, outer, nouter, br, bg, bb, 4, inner);
+
+                            /* Do colorspace distance matching, like
+                               SDL_FindColor(), which picks the lowest index
+                               of equally near entries */
+                            SDL_memset(smallest, 0xFF, sizeof(smallest));
+                            for (i = 0; i < ninner; ++i) {
+                                const SDL_Color *color = &pal->colors[inner[i]];
+                                int cell = 0;
+
+                                for (r = br; r < br + 4; ++r) {
+                                    const int rd = color->r - EXPAND_5BIT(r);
+                                    for (g = bg; g < bg + 4; ++g) {
+                                        const int gd = color->g - EXPAND_5BIT(g);
+                                        for (b = bb; b < bb + 4; ++b, ++cell) {
+                                            const int bd = color->b - EXPAND_5BIT(b);
+                                            const unsigned int distance = (rd * rd) + (gd * gd) + (bd * bd) + alpha[inner[i]];
+                                            if (distance < smallest[cell]) {
+                                                smallest[cell] = distance;
+                                                map[(r << 10) | (g << 5) | b] = inner[i];
+                                            }
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* Inverse colormaps are shared by all the blit maps to a palette, and the
+   one for the current palette version is kept until the palette is freed */
+typedef struct SDL_InverseColormap
+{
+    SDL_Palette *palette;       /* NULL once the palette is freed */
+    Uint32 version;
+    int refcount;
+    struct SDL_InverseColormap *next;
+    Uint8 map[INVERSE_COLORMAP_SIZE];
+} SDL_InverseColormap;
+
+static SDL_InverseColormap *inverse_colormaps;
+static SDL_SpinLock inverse_colormaps_lock = 0;
+
+/* Unlink an unused inverse colormap, which the caller frees.
+   Call with the lock held. */
+static void
+SDL_UnlinkInverseColormap(SDL_InverseColormap * inverse)
+{
+    SDL_InverseColormap **prev;
+
+    for (prev = &inverse_colormaps; *prev; prev = &(*prev)->next) {
+        if (*prev == inverse) {
+            *prev = inverse->next;
+            break;
+        }
+    }
+}
+
+static SDL_InverseColormap *
+SDL_GetInverseColormap(SDL_Palette * pal)
+{
+    SDL_InverseColormap *inverse, *next, *built, *found;
+    SDL_InverseColormap *stale = NULL;
+
+    SDL_AtomicLock(&inverse_colormaps_lock);
+    for (inverse = inverse_colormaps; inverse; inverse = inverse->next) {
+        if (inverse->palette == pal && inverse->version == pal->version) {
+            ++inverse->refcount;
+            SDL_AtomicUnlock(&inverse_colormaps_lock);
+            return inverse;
+        }
+    }
+    SDL_AtomicUnlock(&inverse_colormaps_lock);
+
+    /* Build it unlocked, it takes a while.  With no colors, everything maps
+       to entry 0, the way SDL_FindColor() does. */
+    built = (SDL_InverseColormap *) SDL_calloc(1, sizeof(*built));
+    if (built == NULL) {
+        SDL_OutOfMemory();
+        return (NULL);
+    }
+    built->palette = pal;
+    built->version = pal->version;
+    built->refcount = 1;
+    BuildInverseColormap(pal, built->map);
+
+    SDL_AtomicLock(&inverse_colormaps_lock);
+    found = NULL;
+    for (inverse = inverse_colormaps; inverse; inverse = next) {
+        next = inverse->next;
+        if (inverse->palette != pal) {
+            continue;
+        }
+        if (inverse->version == built->version) {
+            /* Someone else built it in the meantime */
+            ++inverse->refcount;
+            found = inverse;
+        } else if (inverse->refcount == 0) {
+            /* Nothing will look up an older version again */
+            SDL_UnlinkInverseColormap(inverse);
+            inverse->next = stale;
+            stale = inverse;
+        }
+    }
+    if (found) {
+        built->next = stale;
+        stale = built;
+        built = found;
+    } else {
+        built->next = inverse_colormaps;
+        inverse_colormaps = built;
+    }
+    SDL_AtomicUnlock(&inverse_colormaps_lock);
+
+    while (stale) {
+        next = stale->next;
+        SDL_free(stale);
+        stale = next;
+    }
+    return built;
+}
+
+static void
+SDL_ReleaseInverseColormap(SDL_InverseColormap * inverse)
+{
+    SDL_bool unused;
+
+    SDL_AtomicLock(&inverse_colormaps_lock);
+    unused = (--inverse->refcount == 0 &&
+              (!inverse->palette || inverse->palette->version != inverse->version));
+    if (unused) {
+        SDL_UnlinkInverseColormap(inverse);
+    }
+    SDL_AtomicUnlock(&inverse_colormaps_lock);
+
+    if (unused) {
+        SDL_free(inverse);
+    }
+}
+
+/* Drop the inverse colormaps for a palette that's being freed, so a new
+   palette at the same address can't pick them up */
+static void
+SDL_ForgetInverseColormaps(SDL_Palette * palette)
+{
+    SDL_InverseColormap *inverse, *next;
+    SDL_InverseColormap *unused = NULL;
+
+    SDL_AtomicLock(&inverse_colormaps_lock);
+    for (inverse = inverse_colormaps; inverse; inverse = next) {
+        next = inverse->next;
+        if (inverse->palette != palette) {
+            continue;
+        }
+        inverse->palette = NULL;
+        if (inverse->refcount == 0) {
+            SDL_UnlinkInverseColormap(inverse);
+            inverse->next = unused;
+            unused = inverse;
+        }
+    }
+    SDL_AtomicUnlock(&inverse_colormaps_lock);
+
+    while (unused) {
+        next = unused->next;
+        SDL_free(unused);
+        unused = next;
+    }
+}
+
+/* Map from BitField to Palette, through an inverse colormap */
+static SDL_InverseColormap *
 MapNto1(SDL_PixelFormat * src, SDL_PixelFormat * dst, int *identical)
 {
-    /* Generate a 256 color dither palette */
-    SDL_Palette dithered;
     SDL_Color colors[256];
     SDL_Palette *pal = dst->palette;
 
-    dithered.ncolors = 256;
+    /* If the palette is the 3-3-2 dither palette, no need to map */
     SDL_DitherColors(colors, 8);
-    dithered.colors = colors;
-    return (Map1to1(&dithered, pal, identical));
+    if (pal->ncolors >= 256 &&
+        SDL_memcmp(colors, pal->colors, sizeof(colors)) == 0) {
+        *identical = 1;
+        return (NULL);
+    }
+    *identical = 0;
+
+    return SDL_GetInverseColormap(pal);
 }
 
 SDL_BlitMap *
@@ -983,7 +1241,12 @@ SDL_InvalidateMap(SDL_BlitMap * map)
     map->dst = NULL;
     map->src_palette_version = 0;
     map->dst_palette_version = 0;
-    SDL_free(map->info.table);
+    if (map->inverse) {
+        SDL_ReleaseInverseColormap(map->inverse);
+        map->inverse = NULL;
+    } else {
+        SDL_free(map->info.table);
+    }
     map->info.table = NULL;
 }
 
@@ -1029,11 +1292,12 @@ SDL_MapSurface(SDL_Surface * src, SDL_Surface * dst)
     } else {
         if (SDL_ISPIXELFORMAT_INDEXED(dstfmt->format)) {
             /* BitField --> Palette */
-            map->info.table = MapNto1(srcfmt, dstfmt, &map->identity);
+            map->inverse = MapNto1(srcfmt, dstfmt, &map->identity);
             if (!map->identity) {
-                if (map->info.table == NULL) {
+                if (map->inverse == NULL) {
                     return (-1);
                 }
+                map->info.table = map->inverse->map;
             }
             map->identity = 0;  /* Don't optimize to copy */
         } else {
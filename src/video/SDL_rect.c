@@ -528,4 +528,71 @@ SDL_GetSpanEnclosingRect(int width, int height,
     return SDL_FALSE;
 }
 
+static Sint64
+SDL_RectArea(const SDL_Rect * rect)
+{
+    return (Sint64) rect->w * rect->h;
+}
+
+/* The pixels merging two rects adds, negative when they overlap */
+static Sint64
+SDL_MergeCost(const SDL_Rect * a, const SDL_Rect * b)
+{
+    const int x1 = SDL_min(a->x, b->x);
+    const int y1 = SDL_min(a->y, b->y);
+    const int x2 = SDL_max(a->x + a->w, b->x + b->w);
+    const int y2 = SDL_max(a->y + a->h, b->y + b->h);
+
+    return (Sint64) (x2 - x1) * (y2 - y1) - SDL_RectArea(a) - SDL_RectArea(b);
+}
+
+void
+SDL_AddDirtyRect(SDL_Rect * dirty, int *numdirty, int maxdirty,
+                 const SDL_Rect * rect)
+{
+    Sint64 cost, best_cost = 0;
+    int i, best = -1;
+
+    if (SDL_RectEmpty(rect)) {
+        return;
+    }
+
+    /* Find the dirty rect it's cheapest to grow into this one */
+    for (i = 0; i < *numdirty; ++i) {
+        cost = SDL_MergeCost(&dirty[i], rect);
+        if (best < 0 || cost < best_cost) {
+            best = i;
+            best_cost = cost;
+        }
+    }
+    if (best >= 0 && (best_cost <= SDL_DIRTY_RECT_MERGE_SLACK || *numdirty == maxdirty)) {
+        SDL_UnionRect(&dirty[best], rect, &dirty[best]);
+    } else {
+        dirty[(*numdirty)++] = *rect;
+    }
+}
+
+int
+SDL_MergeDirtyRects(SDL_Rect * dirty, int numdirty)
+{
+    SDL_bool merged;
+    int i, j;
+
+    /* Growing a rect can make it worth merging with the others */
+    do {
+        merged = SDL_FALSE;
+        for (i = 0; i < numdirty; ++i) {
+            for (j = i + 1; j < numdirty; ++j) {
+                if (SDL_MergeCost(&dirty[i], &dirty[j]) <= SDL_DIRTY_RECT_MERGE_SLACK) {
+                    SDL_UnionRect(&dirty[i], &dirty[j], &dirty[i]);
+                    dirty[j--] = dirty[--numdirty];
+                    merged = SDL_TRUE;
+                }
+            }
+        }
+    } while (merged);
+
+    return numdirty;
+}
+
 /* vi: set ts=4 sw=4 expandtab: */
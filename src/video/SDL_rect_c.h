@@ -26,6 +26,21 @@
 
 extern SDL_bool SDL_GetSpanEnclosingRect(int width, int height, int numrects, const SDL_Rect * rects, SDL_Rect *span);
 
+/* The most rects worth sending to the window system for one update */
+#define SDL_MAX_DIRTY_RECTS 16
+
+/* How many pixels merging two dirty rects may add before sending them
+   separately is cheaper, roughly what one more rect costs to present */
+#define SDL_DIRTY_RECT_MERGE_SLACK  (32 * 32)
+
+/* Add a rect to a set of at most maxdirty dirty rects. It's merged into the
+   one where that adds the fewest pixels if they overlap or are close to each
+   other, or if the set is full. */
+extern void SDL_AddDirtyRect(SDL_Rect * dirty, int *numdirty, int maxdirty, const SDL_Rect * rect);
+
+/* Merge the dirty rects that grew close to each other, returns how many are left */
+extern int SDL_MergeDirtyRects(SDL_Rect * dirty, int numdirty);
+
 #endif /* SDL_rect_c_h_ */
 
 /* vi: set ts=4 sw=4 expandtab: */
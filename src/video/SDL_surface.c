@@ -26,6 +26,8 @@
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
 #include "SDL_yuv_c.h"
+#include "../cpuinfo/SDL_simd.h"
+#include "../SDL_profile_c.h"
 
 
 /* Check to make sure we can safely check multiplication of surface w and pitch and it won't overflow size_t */
@@ -55,6 +57,15 @@ SDL_CalculatePitch(Uint32 format, int width)
         break;
     }
     pitch = (pitch + 3) & ~3;   /* 4-byte aligning */
+
+    /* Rows as wide as a SIMD vector start on a vector boundary, so vector
+       code can work on every row without lining up first */
+    {
+        const int alignment = (int) SDL_SIMDGetAlignment();
+        if (pitch >= alignment) {
+            pitch = (pitch + (alignment - 1)) & ~(alignment - 1);
+        }
+    }
     return pitch;
 }
 
@@ -119,12 +130,13 @@ SDL_CreateRGBSurfaceWithFormat(Uint32 flags, int width, int height, int depth,
             return NULL;
         }
 
-        surface->pixels = SDL_malloc((size_t)size);
+        surface->pixels = SDL_SIMDAlloc((size_t)size);
         if (!surface->pixels) {
             SDL_FreeSurface(surface);
             SDL_OutOfMemory();
             return NULL;
         }
+        surface->flags |= SDL_SIMD_ALIGNED;
         /* This is important for bitmaps */
         SDL_memset(surface->pixels, 0, surface->h * surface->pitch);
     }
@@ -588,6 +600,8 @@ int
 SDL_LowerBlit(SDL_Surface * src, SDL_Rect * srcrect,
               SDL_Surface * dst, SDL_Rect * dstrect)
 {
+    int retval;
+
     /* Check to make sure the blit mapping is valid */
     if ((src->map->dst != dst) ||
         (dst->format->palette &&
@@ -603,7 +617,11 @@ SDL_LowerBlit(SDL_Surface * src, SDL_Rect * srcrect,
 /*              src, dst->flags, src->map->info.flags, dst, dst->flags, */
 /*              dst->map->info.flags, src->map->blit); */
     }
-    return (src->map->blit(src, srcrect, dst, dstrect));
+
+    SDL_PROFILE_ZONE_BEGIN("SDL_LowerBlit");
+    retval = src->map->blit(src, srcrect, dst, dstrect);
+    SDL_PROFILE_ZONE_END("SDL_LowerBlit");
+    return retval;
 }
 
 
@@ -878,7 +896,11 @@ SDL_LowerBlitScaled(SDL_Surface * src, SDL_Rect * srcrect,
     if ( !(src->map->info.flags & complex_copy_flags) &&
          src->format->format == dst->format->format &&
          !SDL_ISPIXELFORMAT_INDEXED(src->format->format) ) {
-        return SDL_SoftStretch( src, srcrect, dst, dstrect );
+        int retval;
+        SDL_PROFILE_ZONE_BEGIN("SDL_SoftStretch");
+        retval = SDL_SoftStretch( src, srcrect, dst, dstrect );
+        SDL_PROFILE_ZONE_END("SDL_SoftStretch");
+        return retval;
     } else {
         return SDL_LowerBlit( src, srcrect, dst, dstrect );
     }
@@ -1235,7 +1257,11 @@ SDL_FreeSurface(SDL_Surface * surface)
         surface->format = NULL;
     }
     if (!(surface->flags & SDL_PREALLOC)) {
-        SDL_free(surface->pixels);
+        if (surface->flags & SDL_SIMD_ALIGNED) {
+            SDL_SIMDFree(surface->pixels);
+        } else {
+            SDL_free(surface->pixels);
+        }
     }
     if (surface->map) {
         SDL_FreeBlitMap(surface->map);
@@ -28,6 +28,7 @@
 #include "SDL_blit.h"
 #include "SDL_pixels_c.h"
 #include "SDL_rect_c.h"
+#include "../SDL_profile_c.h"
 #include "../events/SDL_events_c.h"
 #include "../timer/SDL_timer_c.h"
 
@@ -117,6 +118,9 @@ static VideoBootStrap *bootstrap[] = {
 #endif
 #if SDL_VIDEO_DRIVER_DUMMY
     &DUMMY_bootstrap,
+#if SDL_INPUT_LINUXEV
+    &DUMMY_evdev_bootstrap,
+#endif
 #endif
     NULL
 };
@@ -2329,13 +2333,30 @@ int
 SDL_UpdateWindowSurfaceRects(SDL_Window * window, const SDL_Rect * rects,
                              int numrects)
 {
+    int retval;
+
     CHECK_WINDOW_MAGIC(window, -1);
 
     if (!window->surface_valid) {
         return SDL_SetError("Window surface is invalid, please call SDL_GetWindowSurface() to get a new surface");
     }
 
-    return _this->UpdateWindowFramebuffer(_this, window, rects, numrects);
+    SDL_PROFILE_ZONE_BEGIN("SDL_UpdateWindowSurface");
+    retval = _this->UpdateWindowFramebuffer(_this, window, rects, numrects);
+    SDL_PROFILE_ZONE_END("SDL_UpdateWindowSurface");
+    return retval;
+}
+
+int
+SDL_SetFrameSinkCallback(SDL_FrameSinkCallback callback, void *userdata)
+{
+    if (!_this) {
+        return SDL_UninitializedVideo();
+    }
+    if (!_this->SetFrameSinkCallback) {
+        return SDL_Unsupported();
+    }
+    return _this->SetFrameSinkCallback(_this, callback, userdata);
 }
 
 int
@@ -3595,7 +3616,9 @@ SDL_GL_SwapWindow(SDL_Window * window)
         return;
     }
 
+    SDL_PROFILE_ZONE_BEGIN("SDL_GL_SwapWindow");
     _this->GL_SwapWindow(_this, window);
+    SDL_PROFILE_ZONE_END("SDL_GL_SwapWindow");
 }
 
 void
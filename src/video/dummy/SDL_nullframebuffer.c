@@ -22,12 +22,259 @@
 
 #if SDL_VIDEO_DRIVER_DUMMY
 
+#include "SDL_hints.h"
+#include "SDL_log.h"
+#include "SDL_thread.h"
 #include "../SDL_sysvideo.h"
+#include "../../thread/SDL_systhread.h"
 #include "SDL_nullframebuffer_c.h"
 
 
 #define DUMMY_SURFACE   "_SDL_DummySurface"
 
+/* The number of frames the writer thread can fall behind before
+   SDL_UpdateWindowSurface() waits for it. */
+#define DUMMY_FRAME_SLOTS   3
+
+typedef struct
+{
+    Uint8 *pixels;
+    size_t allocated;
+    int w, h;
+} DUMMY_Frame;
+
+static SDL_FrameSinkCallback frame_sink;
+static void *frame_sink_userdata;
+
+static struct
+{
+    SDL_Thread *thread;
+    SDL_mutex *lock;
+    SDL_cond *cond;
+    SDL_RWops *output;
+    SDL_bool ppm;
+    SDL_bool quit;
+    DUMMY_Frame frames[DUMMY_FRAME_SLOTS];
+    int head;
+    int count;
+} writer;
+
+static int
+SDL_DUMMY_WriteFrame(const DUMMY_Frame *frame, Uint8 **row, size_t *row_size)
+{
+    const size_t packed_pitch = (size_t)frame->w * 4;
+    const Uint8 *src = frame->pixels;
+    int y;
+
+    if (!writer.ppm) {
+        if (SDL_RWwrite(writer.output, src, packed_pitch, frame->h) != (size_t)frame->h) {
+            return -1;
+        }
+        return 0;
+    }
+
+    if (*row_size < (size_t)frame->w * 3) {
+        Uint8 *new_row = (Uint8 *) SDL_realloc(*row, (size_t)frame->w * 3);
+        if (!new_row) {
+            return SDL_OutOfMemory();
+        }
+        *row = new_row;
+        *row_size = (size_t)frame->w * 3;
+    }
+
+    {
+        char header[64];
+        SDL_snprintf(header, sizeof(header), "P6\n%d %d\n255\n", frame->w, frame->h);
+        if (SDL_RWwrite(writer.output, header, SDL_strlen(header), 1) != 1) {
+            return -1;
+        }
+    }
+    for (y = 0; y < frame->h; ++y) {
+        const Uint32 *pixel = (const Uint32 *) src;
+        Uint8 *dst = *row;
+        int x;
+
+        for (x = 0; x < frame->w; ++x) {
+            const Uint32 rgb = *pixel++;
+            *dst++ = (Uint8) (rgb >> 16);
+            *dst++ = (Uint8) (rgb >> 8);
+            *dst++ = (Uint8) rgb;
+        }
+        if (frame->w > 0 && SDL_RWwrite(writer.output, *row, (size_t)frame->w * 3, 1) != 1) {
+            return -1;
+        }
+        src += packed_pitch;
+    }
+    return 0;
+}
+
+static int SDLCALL
+SDL_DUMMY_FrameWriterThread(void *unused)
+{
+    Uint8 *row = NULL;
+    size_t row_size = 0;
+    SDL_bool failed = SDL_FALSE;
+
+    SDL_LockMutex(writer.lock);
+    for ( ; ; ) {
+        DUMMY_Frame *frame;
+
+        while (!writer.count && !writer.quit) {
+            SDL_CondWait(writer.cond, writer.lock);
+        }
+        if (!writer.count) {
+            break;
+        }
+
+        /* The head slot belongs to us until we release it below */
+        frame = &writer.frames[writer.head];
+        SDL_UnlockMutex(writer.lock);
+
+        if (!failed && SDL_DUMMY_WriteFrame(frame, &row, &row_size) < 0) {
+            /* Keep draining the queue so the application never blocks on us */
+            SDL_LogError(SDL_LOG_CATEGORY_VIDEO, "Couldn't write dummy video frame: %s", SDL_GetError());
+            failed = SDL_TRUE;
+        }
+
+        SDL_LockMutex(writer.lock);
+        writer.head = (writer.head + 1) % DUMMY_FRAME_SLOTS;
+        --writer.count;
+        SDL_CondBroadcast(writer.cond);
+    }
+    SDL_UnlockMutex(writer.lock);
+
+    SDL_free(row);
+    return 0;
+}
+
+static void
+SDL_DUMMY_StartFrameWriter(void)
+{
+    const char *path = SDL_GetHint(SDL_HINT_VIDEO_DUMMY_FRAME_OUTPUT);
+    const char *format = SDL_GetHint(SDL_HINT_VIDEO_DUMMY_FRAME_FORMAT);
+
+    if (writer.thread || !path || !*path) {
+        return;
+    }
+
+    if (SDL_strcmp(path, "-") == 0) {
+#ifdef HAVE_STDIO_H
+        writer.output = SDL_RWFromFP(stdout, SDL_FALSE);
+#else
+        SDL_SetError("Writing frames to standard output isn't supported");
+#endif
+    } else {
+        writer.output = SDL_RWFromFile(path, "wb");
+    }
+    if (!writer.output) {
+        SDL_LogError(SDL_LOG_CATEGORY_VIDEO, "Couldn't open %s for dummy video frames: %s", path, SDL_GetError());
+        return;
+    }
+
+    writer.ppm = (!format || SDL_strcasecmp(format, "raw") != 0) ? SDL_TRUE : SDL_FALSE;
+    writer.quit = SDL_FALSE;
+    writer.head = writer.count = 0;
+    writer.lock = SDL_CreateMutex();
+    writer.cond = SDL_CreateCond();
+    if (writer.lock && writer.cond) {
+        writer.thread = SDL_CreateThreadInternal(SDL_DUMMY_FrameWriterThread, "SDLDummyFrames", 0, NULL);
+    }
+    if (!writer.thread) {
+        SDL_LogError(SDL_LOG_CATEGORY_VIDEO, "Couldn't start dummy video frame writer: %s", SDL_GetError());
+        SDL_DUMMY_QuitFrameWriter();
+    }
+}
+
+static void
+SDL_DUMMY_QueueFrame(SDL_Surface *surface)
+{
+    const size_t packed_pitch = (size_t)surface->w * 4;
+    const size_t size = packed_pitch * surface->h;
+    DUMMY_Frame *frame;
+    const Uint8 *src;
+    Uint8 *dst;
+    int y;
+
+    /* Wait for a free slot rather than dropping frames, captures should be complete */
+    SDL_LockMutex(writer.lock);
+    while (writer.count == DUMMY_FRAME_SLOTS) {
+        SDL_CondWait(writer.cond, writer.lock);
+    }
+    frame = &writer.frames[(writer.head + writer.count) % DUMMY_FRAME_SLOTS];
+    SDL_UnlockMutex(writer.lock);
+
+    if (frame->allocated < size) {
+        Uint8 *pixels = (Uint8 *) SDL_realloc(frame->pixels, size);
+        if (!pixels) {
+            SDL_OutOfMemory();
+            return;
+        }
+        frame->pixels = pixels;
+        frame->allocated = size;
+    }
+    frame->w = surface->w;
+    frame->h = surface->h;
+
+    src = (const Uint8 *) surface->pixels;
+    dst = frame->pixels;
+    if ((size_t)surface->pitch == packed_pitch) {
+        SDL_memcpy(dst, src, size);
+    } else {
+        for (y = 0; y < surface->h; ++y) {
+            SDL_memcpy(dst, src, packed_pitch);
+            src += surface->pitch;
+            dst += packed_pitch;
+        }
+    }
+
+    SDL_LockMutex(writer.lock);
+    ++writer.count;
+    SDL_CondBroadcast(writer.cond);
+    SDL_UnlockMutex(writer.lock);
+}
+
+void SDL_DUMMY_QuitFrameWriter(void)
+{
+    int i;
+
+    if (writer.thread) {
+        /* The thread writes out everything still queued before it exits */
+        SDL_LockMutex(writer.lock);
+        writer.quit = SDL_TRUE;
+        SDL_CondBroadcast(writer.cond);
+        SDL_UnlockMutex(writer.lock);
+        SDL_WaitThread(writer.thread, NULL);
+        writer.thread = NULL;
+    }
+    if (writer.output) {
+        SDL_RWclose(writer.output);
+        writer.output = NULL;
+    }
+    if (writer.cond) {
+        SDL_DestroyCond(writer.cond);
+        writer.cond = NULL;
+    }
+    if (writer.lock) {
+        SDL_DestroyMutex(writer.lock);
+        writer.lock = NULL;
+    }
+    for (i = 0; i < DUMMY_FRAME_SLOTS; ++i) {
+        SDL_free(writer.frames[i].pixels);
+        writer.frames[i].pixels = NULL;
+        writer.frames[i].allocated = 0;
+    }
+
+    frame_sink = NULL;
+    frame_sink_userdata = NULL;
+}
+
+int SDL_DUMMY_SetFrameSinkCallback(_THIS, SDL_FrameSinkCallback callback, void *userdata)
+{
+    frame_sink = callback;
+    frame_sink_userdata = userdata;
+    return 0;
+}
+
 int SDL_DUMMY_CreateWindowFramebuffer(_THIS, SDL_Window * window, Uint32 * format, void ** pixels, int *pitch)
 {
     SDL_Surface *surface;
@@ -50,6 +297,7 @@ int SDL_DUMMY_CreateWindowFramebuffer(_THIS, SDL_Window * window, Uint32 * forma
 
     /* Save the info and return! */
     SDL_SetWindowData(window, DUMMY_SURFACE, surface);
+    SDL_DUMMY_StartFrameWriter();
     *format = surface_format;
     *pixels = surface->pixels;
     *pitch = surface->pitch;
@@ -67,6 +315,13 @@ int SDL_DUMMY_UpdateWindowFramebuffer(_THIS, SDL_Window * window, const SDL_Rect
     }
 
     /* Send the data to the display */
+    if (frame_sink) {
+        frame_sink(frame_sink_userdata, window, SDL_PIXELFORMAT_RGB888, surface->pixels, surface->pitch,
+                   surface->w, surface->h, rects, numrects);
+    }
+    if (writer.thread) {
+        SDL_DUMMY_QueueFrame(surface);
+    }
     if (SDL_getenv("SDL_VIDEO_DUMMY_SAVE_FRAMES")) {
         char file[128];
         SDL_snprintf(file, sizeof(file), "SDL_window%d-%8.8d.bmp",
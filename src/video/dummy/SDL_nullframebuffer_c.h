@@ -27,6 +27,8 @@
 extern int SDL_DUMMY_CreateWindowFramebuffer(_THIS, SDL_Window * window, Uint32 * format, void ** pixels, int *pitch);
 extern int SDL_DUMMY_UpdateWindowFramebuffer(_THIS, SDL_Window * window, const SDL_Rect * rects, int numrects);
 extern void SDL_DUMMY_DestroyWindowFramebuffer(_THIS, SDL_Window * window);
+extern int SDL_DUMMY_SetFrameSinkCallback(_THIS, SDL_FrameSinkCallback callback, void *userdata);
+extern void SDL_DUMMY_QuitFrameWriter(void);
 
 #endif /* SDL_nullframebuffer_c_h_ */
 
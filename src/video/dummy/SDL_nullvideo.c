@@ -47,12 +47,21 @@
 #include "SDL_nullevents_c.h"
 #include "SDL_nullframebuffer_c.h"
 
+#if SDL_INPUT_LINUXEV
+#include "../../core/linux/SDL_evdev.h"
+#endif
+
 #define DUMMYVID_DRIVER_NAME "dummy"
+#define DUMMYVID_EVDEV_DRIVER_NAME "evdev"
+
+/* Whether this is the evdev flavour, which reads input devices */
+static SDL_bool evdev = SDL_FALSE;
 
 /* Initialization/Query functions */
 static int DUMMY_VideoInit(_THIS);
 static int DUMMY_SetDisplayMode(_THIS, SDL_VideoDisplay * display, SDL_DisplayMode * mode);
 static void DUMMY_VideoQuit(_THIS);
+static SDL_VideoDevice *DUMMY_CreateDeviceInternal(void);
 
 /* DUMMY driver bootstrap functions */
 
@@ -75,6 +84,13 @@ DUMMY_DeleteDevice(SDL_VideoDevice * device)
 
 static SDL_VideoDevice *
 DUMMY_CreateDevice(int devindex)
+{
+    evdev = SDL_FALSE;
+    return DUMMY_CreateDeviceInternal();
+}
+
+static SDL_VideoDevice *
+DUMMY_CreateDeviceInternal(void)
 {
     SDL_VideoDevice *device;
 
@@ -94,6 +110,7 @@ DUMMY_CreateDevice(int devindex)
     device->CreateWindowFramebuffer = SDL_DUMMY_CreateWindowFramebuffer;
     device->UpdateWindowFramebuffer = SDL_DUMMY_UpdateWindowFramebuffer;
     device->DestroyWindowFramebuffer = SDL_DUMMY_DestroyWindowFramebuffer;
+    device->SetFrameSinkCallback = SDL_DUMMY_SetFrameSinkCallback;
 
     device->free = DUMMY_DeleteDevice;
 
@@ -105,6 +122,45 @@ VideoBootStrap DUMMY_bootstrap = {
     DUMMY_Available, DUMMY_CreateDevice
 };
 
+#if SDL_INPUT_LINUXEV
+/* The dummy driver with keyboard, mouse and touch input from evdev, for
+   measuring input without a window system */
+static int
+DUMMY_EVDEV_Available(void)
+{
+    const char *envr = SDL_getenv("SDL_VIDEODRIVER");
+    if ((envr) && (SDL_strcmp(envr, DUMMYVID_EVDEV_DRIVER_NAME) == 0)) {
+        return (1);
+    }
+
+    return (0);
+}
+
+static void
+DUMMY_EVDEV_PumpEvents(_THIS)
+{
+    SDL_EVDEV_Poll();
+}
+
+static SDL_VideoDevice *
+DUMMY_EVDEV_CreateDevice(int devindex)
+{
+    SDL_VideoDevice *device;
+
+    evdev = SDL_TRUE;
+    device = DUMMY_CreateDeviceInternal();
+    if (device) {
+        device->PumpEvents = DUMMY_EVDEV_PumpEvents;
+    }
+    return device;
+}
+
+VideoBootStrap DUMMY_evdev_bootstrap = {
+    DUMMYVID_EVDEV_DRIVER_NAME, "SDL dummy video driver with evdev input",
+    DUMMY_EVDEV_Available, DUMMY_EVDEV_CreateDevice
+};
+#endif /* SDL_INPUT_LINUXEV */
+
 
 int
 DUMMY_VideoInit(_THIS)
@@ -124,6 +180,12 @@ DUMMY_VideoInit(_THIS)
     SDL_zero(mode);
     SDL_AddDisplayMode(&_this->displays[0], &mode);
 
+#if SDL_INPUT_LINUXEV
+    if (evdev && SDL_EVDEV_Init() < 0) {
+        return -1;
+    }
+#endif
+
     /* We're done! */
     return 0;
 }
@@ -137,6 +199,12 @@ DUMMY_SetDisplayMode(_THIS, SDL_VideoDisplay * display, SDL_DisplayMode * mode)
 void
 DUMMY_VideoQuit(_THIS)
 {
+#if SDL_INPUT_LINUXEV
+    if (evdev) {
+        SDL_EVDEV_Quit();
+    }
+#endif
+    SDL_DUMMY_QuitFrameWriter();
 }
 
 #endif /* SDL_VIDEO_DRIVER_DUMMY */
@@ -29,6 +29,7 @@
 #include <limits.h> /* For INT_MAX */
 
 #include "SDL_x11video.h"
+#include "SDL_x11framebuffer.h"
 #include "SDL_x11touch.h"
 #include "SDL_x11xinput2.h"
 #include "../../core/unix/SDL_poll.h"
@@ -745,6 +746,13 @@ X11_DispatchEvent(_THIS)
         return;
     }
 
+#ifndef NO_SHARED_MEMORY
+    if (xevent.type == videodata->shm_completion_event) {
+        X11_HandleShmCompletion(data, (XShmCompletionEvent *) &xevent);
+        return;
+    }
+#endif
+
     switch (xevent.type) {
 
         /* Gaining mouse coverage? */
@@ -24,6 +24,7 @@
 
 #include "SDL_x11video.h"
 #include "SDL_x11framebuffer.h"
+#include "../SDL_rect_c.h"
 
 
 #ifndef NO_SHARED_MEMORY
@@ -50,8 +51,126 @@ static SDL_bool have_mitshm(void)
     return SDL_FALSE;
 }
 
+static SDL_bool
+CreateShmImage(Display *display, SDL_WindowData *data, XVisualInfo *vinfo,
+               int w, int h, int pitch, X11_ShmImage *image)
+{
+    XShmSegmentInfo *shminfo = &image->shminfo;
+
+    shminfo->shmid = shmget(IPC_PRIVATE, h*pitch, IPC_CREAT | 0777);
+    if ( shminfo->shmid >= 0 ) {
+        shminfo->shmaddr = (char *)shmat(shminfo->shmid, 0, 0);
+        shminfo->readOnly = False;
+        if ( shminfo->shmaddr != (char *)-1 ) {
+            shm_error = False;
+            X_handler = X11_XSetErrorHandler(shm_errhandler);
+            X11_XShmAttach(display, shminfo);
+            X11_XSync(display, False);
+            X11_XSetErrorHandler(X_handler);
+            if ( shm_error )
+                shmdt(shminfo->shmaddr);
+        } else {
+            shm_error = True;
+        }
+        shmctl(shminfo->shmid, IPC_RMID, NULL);
+    } else {
+        shm_error = True;
+    }
+    if (shm_error) {
+        return SDL_FALSE;
+    }
+
+    image->ximage = X11_XShmCreateImage(display, data->visual,
+                     vinfo->depth, ZPixmap,
+                     shminfo->shmaddr, shminfo, w, h);
+    if (!image->ximage) {
+        X11_XShmDetach(display, shminfo);
+        X11_XSync(display, False);
+        shmdt(shminfo->shmaddr);
+        return SDL_FALSE;
+    }
+    image->busy = SDL_FALSE;
+    return SDL_TRUE;
+}
+
+/* The caller has to XSync() before the memory is released with shmdt() */
+static void
+DestroyShmImage(Display *display, X11_ShmImage *image)
+{
+    XDestroyImage(image->ximage);
+    X11_XShmDetach(display, &image->shminfo);
+    image->ximage = NULL;
+}
+
+static Bool
+IsShmCompletion(Display *display, XEvent *event, XPointer arg)
+{
+    SDL_WindowData *data = (SDL_WindowData *) arg;
+
+    return (event->type == data->videodata->shm_completion_event &&
+            ((XShmCompletionEvent *) event)->drawable == data->xwindow);
+}
+
+void
+X11_HandleShmCompletion(SDL_WindowData * data, const XShmCompletionEvent * event)
+{
+    int i;
+
+    for (i = 0; i < SDL_arraysize(data->shmimages); ++i) {
+        if (data->shmimages[i].ximage && data->shmimages[i].shminfo.shmseg == event->shmseg) {
+            data->shmimages[i].busy = SDL_FALSE;
+        }
+    }
+}
+
+/* Wait until the server is done with the image the next update goes to.
+   With two images that's the update before the last one, so this only
+   blocks when the app draws faster than the server presents. */
+static X11_ShmImage *
+GetIdleShmImage(Display *display, SDL_WindowData *data)
+{
+    X11_ShmImage *image = &data->shmimages[data->shmimage];
+    XEvent event;
+
+    while (image->busy && X11_XCheckIfEvent(display, &event, IsShmCompletion, (XPointer) data)) {
+        X11_HandleShmCompletion(data, (XShmCompletionEvent *) &event);
+    }
+    if (image->busy) {
+        /* After the sync every completion we asked for is queued, unless
+           the put failed, in which case nothing reads the image anymore. */
+        X11_XSync(display, False);
+        while (X11_XCheckIfEvent(display, &event, IsShmCompletion, (XPointer) data)) {
+            X11_HandleShmCompletion(data, (XShmCompletionEvent *) &event);
+        }
+        image->busy = SDL_FALSE;
+    }
+    return image;
+}
+
 #endif /* !NO_SHARED_MEMORY */
 
+/* Clip the rects to the window and merge them into at most
+   SDL_MAX_DIRTY_RECTS rects */
+static int
+MergeDirtyRects(SDL_Window * window, const SDL_Rect * rects, int numrects,
+                SDL_Rect * dirty)
+{
+    SDL_Rect bounds, rect;
+    int i, numdirty = 0;
+
+    bounds.x = 0;
+    bounds.y = 0;
+    bounds.w = window->w;
+    bounds.h = window->h;
+
+    for (i = 0; i < numrects; ++i) {
+        if (SDL_IntersectRect(&rects[i], &bounds, &rect)) {
+            SDL_AddDirtyRect(dirty, &numdirty, SDL_MAX_DIRTY_RECTS, &rect);
+        }
+    }
+    return SDL_MergeDirtyRects(dirty, numdirty);
+}
+
 int
 X11_CreateWindowFramebuffer(_THIS, SDL_Window * window, Uint32 * format,
                             void ** pixels, int *pitch)
@@ -84,49 +203,7 @@ X11_CreateWindowFramebuffer(_THIS, SDL_Window * window, Uint32 * format,
     /* Calculate pitch */
     *pitch = (((window->w * SDL_BYTESPERPIXEL(*format)) + 3) & ~3);
 
-    /* Create the actual image */
-#ifndef NO_SHARED_MEMORY
-    if (have_mitshm()) {
-        XShmSegmentInfo *shminfo = &data->shminfo;
-
-        shminfo->shmid = shmget(IPC_PRIVATE, window->h*(*pitch), IPC_CREAT | 0777);
-        if ( shminfo->shmid >= 0 ) {
-            shminfo->shmaddr = (char *)shmat(shminfo->shmid, 0, 0);
-            shminfo->readOnly = False;
-            if ( shminfo->shmaddr != (char *)-1 ) {
-                shm_error = False;
-                X_handler = X11_XSetErrorHandler(shm_errhandler);
-                X11_XShmAttach(display, shminfo);
-                X11_XSync(display, False);
-                X11_XSetErrorHandler(X_handler);
-                if ( shm_error )
-                    shmdt(shminfo->shmaddr);
-            } else {
-                shm_error = True;
-            }
-            shmctl(shminfo->shmid, IPC_RMID, NULL);
-        } else {
-            shm_error = True;
-        }
-        if (!shm_error) {
-            data->ximage = X11_XShmCreateImage(display, data->visual,
-                             vinfo.depth, ZPixmap,
-                             shminfo->shmaddr, shminfo,
-                             window->w, window->h);
-            if (!data->ximage) {
-                X11_XShmDetach(display, shminfo);
-                X11_XSync(display, False);
-                shmdt(shminfo->shmaddr);
-            } else {
-                /* Done! */
-                data->use_mitshm = SDL_TRUE;
-                *pixels = shminfo->shmaddr;
-                return 0;
-            }
-        }
-    }
-#endif /* not NO_SHARED_MEMORY */
-
+    /* Create the image the app draws to */
     *pixels = SDL_malloc(window->h*(*pitch));
     if (*pixels == NULL) {
         return SDL_OutOfMemory();
@@ -139,6 +216,25 @@ X11_CreateWindowFramebuffer(_THIS, SDL_Window * window, Uint32 * format,
         SDL_free(*pixels);
         return SDL_SetError("Couldn't create XImage");
     }
+
+    /* Present it through two shared memory images, so the app can draw the
+       next frame while the server is still reading the last one. */
+#ifndef NO_SHARED_MEMORY
+    if (have_mitshm()) {
+        if (CreateShmImage(display, data, &vinfo, window->w, window->h, *pitch, &data->shmimages[0])) {
+            if (CreateShmImage(display, data, &vinfo, window->w, window->h, *pitch, &data->shmimages[1])) {
+                data->videodata->shm_completion_event = X11_XShmGetEventBase(display) + ShmCompletion;
+                data->use_mitshm = SDL_TRUE;
+                data->shmimage = 0;
+            } else {
+                DestroyShmImage(display, &data->shmimages[0]);
+                X11_XSync(display, False);
+                shmdt(data->shmimages[0].shminfo.shmaddr);
+            }
+        }
+    }
+#endif /* not NO_SHARED_MEMORY */
+
     return 0;
 }
 
@@ -148,73 +244,53 @@ X11_UpdateWindowFramebuffer(_THIS, SDL_Window * window, const SDL_Rect * rects,
 {
     SDL_WindowData *data = (SDL_WindowData *) window->driverdata;
     Display *display = data->videodata->display;
-    int i;
-    int x, y, w ,h;
+    SDL_Rect dirty[SDL_MAX_DIRTY_RECTS];
+    int i, numdirty;
+
+    numdirty = MergeDirtyRects(window, rects, numrects, dirty);
+    if (numdirty == 0) {
+        return 0;
+    }
+
 #ifndef NO_SHARED_MEMORY
     if (data->use_mitshm) {
-        for (i = 0; i < numrects; ++i) {
-            x = rects[i].x;
-            y = rects[i].y;
-            w = rects[i].w;
-            h = rects[i].h;
-
-            if (w <= 0 || h <= 0 || (x + w) <= 0 || (y + h) <= 0) {
-                /* Clipped? */
-                continue;
-            }
-            if (x < 0)
-            {
-                x += w;
-                w += rects[i].x;
-            }
-            if (y < 0)
-            {
-                y += h;
-                h += rects[i].y;
+        X11_ShmImage *image = GetIdleShmImage(display, data);
+        const int bpp = data->ximage->bits_per_pixel / 8;
+        int row;
+
+        for (i = 0; i < numdirty; ++i) {
+            const SDL_Rect *rect = &dirty[i];
+            const Uint8 *src = (Uint8 *) data->ximage->data + rect->y * data->ximage->bytes_per_line + rect->x * bpp;
+            Uint8 *dst = (Uint8 *) image->ximage->data + rect->y * image->ximage->bytes_per_line + rect->x * bpp;
+
+            for (row = 0; row < rect->h; ++row) {
+                SDL_memcpy(dst, src, rect->w * bpp);
+                src += data->ximage->bytes_per_line;
+                dst += image->ximage->bytes_per_line;
             }
-            if (x + w > window->w)
-                w = window->w - x;
-            if (y + h > window->h)
-                h = window->h - y;
 
-            X11_XShmPutImage(display, data->xwindow, data->gc, data->ximage,
-                x, y, x, y, w, h, False);
+            /* The server processes requests in order, so a completion
+               event for the last put covers all of them */
+            X11_XShmPutImage(display, data->xwindow, data->gc, image->ximage,
+                rect->x, rect->y, rect->x, rect->y, rect->w, rect->h,
+                (i == numdirty - 1) ? True : False);
         }
+        image->busy = SDL_TRUE;
+        data->shmimage = (data->shmimage + 1) % SDL_arraysize(data->shmimages);
+
+        /* Don't wait for the server, GetIdleShmImage() does if it has to */
+        X11_XFlush(display);
     }
     else
 #endif /* !NO_SHARED_MEMORY */
     {
-        for (i = 0; i < numrects; ++i) {
-            x = rects[i].x;
-            y = rects[i].y;
-            w = rects[i].w;
-            h = rects[i].h;
-
-            if (w <= 0 || h <= 0 || (x + w) <= 0 || (y + h) <= 0) {
-                /* Clipped? */
-                continue;
-            }
-            if (x < 0)
-            {
-                x += w;
-                w += rects[i].x;
-            }
-            if (y < 0)
-            {
-                y += h;
-                h += rects[i].y;
-            }
-            if (x + w > window->w)
-                w = window->w - x;
-            if (y + h > window->h)
-                h = window->h - y;
-
+        for (i = 0; i < numdirty; ++i) {
             X11_XPutImage(display, data->xwindow, data->gc, data->ximage,
-                x, y, x, y, w, h);
+                dirty[i].x, dirty[i].y, dirty[i].x, dirty[i].y, dirty[i].w, dirty[i].h);
         }
-    }
 
-    X11_XSync(display, False);
+        X11_XSync(display, False);
+    }
 
     return 0;
 }
@@ -232,18 +308,24 @@ X11_DestroyWindowFramebuffer(_THIS, SDL_Window * window)
 
     display = data->videodata->display;
 
-    if (data->ximage) {
-        XDestroyImage(data->ximage);
-
 #ifndef NO_SHARED_MEMORY
-        if (data->use_mitshm) {
-            X11_XShmDetach(display, &data->shminfo);
-            X11_XSync(display, False);
-            shmdt(data->shminfo.shmaddr);
-            data->use_mitshm = SDL_FALSE;
+    if (data->use_mitshm) {
+        int i;
+
+        for (i = 0; i < SDL_arraysize(data->shmimages); ++i) {
+            DestroyShmImage(display, &data->shmimages[i]);
+        }
+        /* Make sure the server is done with them before they go away */
+        X11_XSync(display, False);
+        for (i = 0; i < SDL_arraysize(data->shmimages); ++i) {
+            shmdt(data->shmimages[i].shminfo.shmaddr);
         }
+        data->use_mitshm = SDL_FALSE;
+    }
 #endif /* !NO_SHARED_MEMORY */
 
+    if (data->ximage) {
+        XDestroyImage(data->ximage);
         data->ximage = NULL;
     }
     if (data->gc) {
@@ -141,6 +141,10 @@ typedef struct SDL_VideoData
     KeyCode filter_code;
     Time    filter_time;
 
+#ifndef NO_SHARED_MEMORY
+    int shm_completion_event;   /* The XShmCompletionEvent type, 0 if unused */
+#endif
+
 #if SDL_VIDEO_VULKAN
     /* Vulkan variables only valid if _this->vulkan_config.loader_handle is not NULL */
     void *vulkan_xlib_xcb_library;
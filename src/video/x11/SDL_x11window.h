@@ -40,6 +40,16 @@ typedef enum
     PENDING_FOCUS_OUT
 } PendingFocusEnum;
 
+#ifndef NO_SHARED_MEMORY
+/* A shared memory image the framebuffer is presented from */
+typedef struct
+{
+    XShmSegmentInfo shminfo;
+    XImage *ximage;
+    SDL_bool busy;              /* The server may still be reading from it */
+} X11_ShmImage;
+#endif
+
 typedef struct
 {
     SDL_Window *window;
@@ -50,7 +60,8 @@ typedef struct
 #ifndef NO_SHARED_MEMORY
     /* MIT shared memory extension information */
     SDL_bool use_mitshm;
-    XShmSegmentInfo shminfo;
+    X11_ShmImage shmimages[2];
+    int shmimage;               /* The image the next update is copied to */
 #endif
     XImage *ximage;
     GC gc;
@@ -0,0 +1,301 @@
+/*
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Load many files at once with SDL_LoadFileAsync() and compare the wall
+   clock time against loading them one at a time with SDL_LoadFile().
+
+   Then quit SDL while loads are still queued, with callbacks that queue
+   more loads from the I/O threads, which must not hang the quit.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SDL.h"
+
+static int num_files = 500;
+static int file_size = 64 * 1024;
+static SDL_AsyncIO **chained;
+static SDL_atomic_t in_callback;
+
+static void
+file_name(char *name, size_t len, int index)
+{
+    SDL_snprintf(name, len, "testasyncio_%d.dat", index);
+}
+
+static int
+check_data(const Uint8 *data, size_t size, int index)
+{
+    size_t i;
+
+    if (!data || size != (size_t)file_size) {
+        return -1;
+    }
+    for (i = 0; i < size; ++i) {
+        if (data[i] != (Uint8)(index + i)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int
+create_files(void)
+{
+    Uint8 *data = (Uint8 *)SDL_malloc(file_size);
+    char name[64];
+    int i, j;
+
+    if (!data) {
+        return SDL_OutOfMemory();
+    }
+    for (i = 0; i < num_files; ++i) {
+        SDL_RWops *rw;
+
+        file_name(name, sizeof(name), i);
+        rw = SDL_RWFromFile(name, "wb");
+        if (!rw) {
+            SDL_free(data);
+            return -1;
+        }
+        for (j = 0; j < file_size; ++j) {
+            data[j] = (Uint8)(i + j);
+        }
+        SDL_RWwrite(rw, data, file_size, 1);
+        SDL_RWclose(rw);
+    }
+    SDL_free(data);
+    return 0;
+}
+
+static void
+remove_files(void)
+{
+    char name[64];
+    int i;
+
+    for (i = 0; i < num_files; ++i) {
+        file_name(name, sizeof(name), i);
+        remove(name);
+    }
+}
+
+static double
+elapsed_ms(Uint64 start)
+{
+    return ((double)(SDL_GetPerformanceCounter() - start) * 1000.0) / SDL_GetPerformanceFrequency();
+}
+
+static int
+load_sync(void)
+{
+    char name[64];
+    Uint64 start = SDL_GetPerformanceCounter();
+    int i;
+
+    for (i = 0; i < num_files; ++i) {
+        size_t size;
+        void *data;
+
+        file_name(name, sizeof(name), i);
+        data = SDL_LoadFile(name, &size);
+        if (check_data((const Uint8 *)data, size, i) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bad data in %s\n", name);
+            SDL_free(data);
+            return -1;
+        }
+        SDL_free(data);
+    }
+    SDL_Log("SDL_LoadFile:      %d files in %.2f ms\n", num_files, elapsed_ms(start));
+    return 0;
+}
+
+static int
+load_async(void)
+{
+    SDL_AsyncIO **requests;
+    char name[64];
+    Uint64 start;
+    int i, retval = 0;
+
+    requests = (SDL_AsyncIO **)SDL_calloc(num_files, sizeof(*requests));
+    if (!requests) {
+        return SDL_OutOfMemory();
+    }
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_files; ++i) {
+        file_name(name, sizeof(name), i);
+        requests[i] = SDL_LoadFileAsync(name, 0, NULL, NULL);
+        if (!requests[i]) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't queue %s: %s\n", name, SDL_GetError());
+            retval = -1;
+            break;
+        }
+    }
+    for (i = 0; i < num_files && requests[i]; ++i) {
+        size_t size;
+        void *data;
+
+        if (SDL_WaitAsyncIO(requests[i]) != SDL_ASYNCIO_COMPLETE) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Request %d failed: %s\n", i, SDL_GetError());
+            retval = -1;
+            continue;
+        }
+        data = SDL_GetAsyncIOData(requests[i], &size);
+        if (check_data((const Uint8 *)data, size, i) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bad data in request %d\n", i);
+            retval = -1;
+        }
+        SDL_free(data);
+    }
+    if (retval == 0) {
+        SDL_Log("SDL_LoadFileAsync: %d files in %.2f ms (%s threads)\n", num_files, elapsed_ms(start),
+                SDL_GetHint(SDL_HINT_ASYNCIO_THREADS) ? SDL_GetHint(SDL_HINT_ASYNCIO_THREADS) : "default");
+    }
+
+    for (i = 0; i < num_files; ++i) {
+        SDL_FreeAsyncIO(requests[i]);
+    }
+    SDL_free(requests);
+    return retval;
+}
+
+static void SDLCALL
+chain_load(void *userdata, SDL_AsyncIO *request)
+{
+    const int i = (int)(size_t)userdata;
+    char name[64];
+
+    /* Hold up the first callback, so SDL starts quitting while it runs */
+    if (SDL_AtomicCAS(&in_callback, 0, 1)) {
+        SDL_Delay(100);
+    }
+
+    /* Queue another load for each one that completes, even while SDL quits */
+    if (SDL_GetAsyncIOStatus(request) == SDL_ASYNCIO_COMPLETE) {
+        file_name(name, sizeof(name), i);
+        chained[i] = SDL_LoadFileAsync(name, 0, NULL, NULL);
+    }
+}
+
+static int
+quit_async(void)
+{
+    SDL_AsyncIO **requests;
+    char name[64];
+    int completed = 0, canceled = 0, refused = 0;
+    int i, retval = 0;
+
+    requests = (SDL_AsyncIO **)SDL_calloc(num_files, sizeof(*requests));
+    chained = (SDL_AsyncIO **)SDL_calloc(num_files, sizeof(*chained));
+    if (!requests || !chained) {
+        SDL_free(requests);
+        SDL_free(chained);
+        SDL_Quit();
+        return SDL_OutOfMemory();
+    }
+
+    for (i = 0; i < num_files; ++i) {
+        file_name(name, sizeof(name), i);
+        requests[i] = SDL_LoadFileAsync(name, 0, chain_load, (void *)(size_t)i);
+    }
+    while (!SDL_AtomicGet(&in_callback)) {
+        SDL_Delay(1);
+    }
+    SDL_Quit();
+
+    /* Everything is finished or canceled now, and the requests are still usable */
+    for (i = 0; i < num_files; ++i) {
+        SDL_AsyncIO *request[2];
+        int j;
+
+        request[0] = requests[i];
+        request[1] = chained[i];
+        for (j = 0; j < SDL_arraysize(request); ++j) {
+            if (!request[j]) {
+                if (j == 1 && SDL_GetAsyncIOStatus(requests[i]) == SDL_ASYNCIO_COMPLETE) {
+                    ++refused;
+                }
+                continue;
+            }
+            switch (SDL_WaitAsyncIO(request[j])) {
+            case SDL_ASYNCIO_COMPLETE:
+                SDL_free(SDL_GetAsyncIOData(request[j], NULL));
+                ++completed;
+                break;
+            case SDL_ASYNCIO_CANCELED:
+                ++canceled;
+                break;
+            default:
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Request for file %d failed: %s\n", i, SDL_GetError());
+                retval = -1;
+                break;
+            }
+            SDL_FreeAsyncIO(request[j]);
+        }
+    }
+    SDL_Log("Quit with loads queued: %d completed, %d canceled, %d refused while quitting\n",
+            completed, canceled, refused);
+
+    SDL_free(requests);
+    SDL_free(chained);
+    chained = NULL;
+    return retval;
+}
+
+int
+main(int argc, char *argv[])
+{
+    int retval = 0;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        num_files = SDL_atoi(argv[1]);
+    }
+    if (argc > 2) {
+        file_size = SDL_atoi(argv[2]) * 1024;
+    }
+    if (num_files <= 0 || file_size <= 0) {
+        SDL_Log("USAGE: %s [num_files] [file_size_kb]\n", argv[0]);
+        return 1;
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    if (create_files() < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create test files: %s\n", SDL_GetError());
+        retval = 1;
+    } else {
+        /* The files were just written, so both runs are served from the page cache */
+        if (load_sync() < 0 || load_async() < 0) {
+            retval = 1;
+        }
+    }
+
+    /* This quits SDL */
+    if (retval == 0 && quit_async() < 0) {
+        retval = 1;
+    }
+    remove_files();
+
+    SDL_Quit();
+    return retval;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
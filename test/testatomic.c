@@ -707,6 +707,129 @@ static void RunFIFOTest(SDL_bool lock_free)
 
 /* End FIFO test */
 /**************************************************************************/
+/**************************************************************************/
+/* SDL_AtomicQueue test */
+
+/* Items carry the writer index and a sequence number. A queue is FIFO, so
+   each reader must see every writer's items in increasing order. */
+#define QUEUE_ITEM(writer, i)   ((void *)(uintptr_t)(((writer) << 24) | (i)))
+#define QUEUE_ITEM_WRITER(item) (int)((uintptr_t)(item) >> 24)
+#define QUEUE_ITEM_INDEX(item)  (int)((uintptr_t)(item) & 0xFFFFFF)
+
+static SDL_AtomicQueue *atomicQueue;
+static SDL_atomic_t queueWritersRunning;
+static SDL_atomic_t queueOrderErrors;
+
+typedef struct
+{
+    int index;
+    int counters[NUM_WRITERS];
+    int waits;
+    char padding[SDL_CACHELINE_SIZE];
+} QueueThreadData;
+
+static int SDLCALL AtomicQueue_Writer(void *_data)
+{
+    QueueThreadData *data = (QueueThreadData *)_data;
+    int i;
+
+    for (i = 0; i < EVENTS_PER_WRITER; ++i) {
+        while (!SDL_AtomicQueuePush(atomicQueue, QUEUE_ITEM(data->index, i))) {
+            ++data->waits;
+            SDL_Delay(0);
+        }
+    }
+    SDL_AtomicAdd(&queueWritersRunning, -1);
+    return 0;
+}
+
+static int SDLCALL AtomicQueue_Reader(void *_data)
+{
+    QueueThreadData *data = (QueueThreadData *)_data;
+    int last[NUM_WRITERS];
+    void *item;
+    int i;
+
+    for (i = 0; i < NUM_WRITERS; ++i) {
+        last[i] = -1;
+    }
+    for ( ; ; ) {
+        /* Check before popping: once the writers are done, all their items are visible */
+        const SDL_bool writing = SDL_AtomicGet(&queueWritersRunning) > 0;
+
+        if (SDL_AtomicQueuePop(atomicQueue, &item)) {
+            const int writer = QUEUE_ITEM_WRITER(item);
+            const int index = QUEUE_ITEM_INDEX(item);
+            if (writer >= NUM_WRITERS || index <= last[writer]) {
+                SDL_AtomicIncRef(&queueOrderErrors);
+            } else {
+                last[writer] = index;
+                ++data->counters[writer];
+            }
+        } else if (writing) {
+            ++data->waits;
+            SDL_Delay(0);
+        } else {
+            /* The writers are done and we drained the queue */
+            break;
+        }
+    }
+    return 0;
+}
+
+static void RunAtomicQueueTest(void)
+{
+    QueueThreadData writerData[NUM_WRITERS];
+    QueueThreadData readerData[NUM_READERS];
+    SDL_Thread *writers[NUM_WRITERS];
+    SDL_Thread *readers[NUM_READERS];
+    Uint32 start, end;
+    int i, j, grand_total = 0;
+
+    SDL_Log("\nSDL_AtomicQueue test----------------------------\n\n");
+
+    atomicQueue = SDL_CreateAtomicQueue(MAX_ENTRIES);
+    SDL_AtomicSet(&queueOrderErrors, 0);
+    SDL_AtomicSet(&queueWritersRunning, NUM_WRITERS);
+    SDL_zero(writerData);
+    SDL_zero(readerData);
+
+    start = SDL_GetTicks();
+    for (i = 0; i < NUM_READERS; ++i) {
+        readerData[i].index = i;
+        readers[i] = SDL_CreateThread(AtomicQueue_Reader, "QueueReader", &readerData[i]);
+    }
+    for (i = 0; i < NUM_WRITERS; ++i) {
+        writerData[i].index = i;
+        writers[i] = SDL_CreateThread(AtomicQueue_Writer, "QueueWriter", &writerData[i]);
+    }
+    for (i = 0; i < NUM_WRITERS; ++i) {
+        SDL_WaitThread(writers[i], NULL);
+    }
+    for (i = 0; i < NUM_READERS; ++i) {
+        SDL_WaitThread(readers[i], NULL);
+    }
+    end = SDL_GetTicks();
+
+    SDL_DestroyAtomicQueue(atomicQueue);
+    atomicQueue = NULL;
+
+    SDL_Log("Finished in %f sec\n", (end - start) / 1000.f);
+    for (i = 0; i < NUM_READERS; ++i) {
+        int total = 0;
+        for (j = 0; j < NUM_WRITERS; ++j) {
+            total += readerData[i].counters[j];
+        }
+        grand_total += total;
+        SDL_Log("Reader %d read %d items, had %d waits\n", i, total, readerData[i].waits);
+    }
+    SDL_Log("Readers read %d of %d items, %d out of order: %s\n",
+            grand_total, NUM_WRITERS * EVENTS_PER_WRITER, SDL_AtomicGet(&queueOrderErrors),
+            tf(grand_total == NUM_WRITERS * EVENTS_PER_WRITER && SDL_AtomicGet(&queueOrderErrors) == 0));
+}
+
+/* End SDL_AtomicQueue test */
+/**************************************************************************/
 
 int
 main(int argc, char *argv[])
@@ -716,6 +839,7 @@ main(int argc, char *argv[])
 
     RunBasicTest();
     RunEpicTest();
+    RunAtomicQueueTest();
 /* This test is really slow, so don't run it by default */
 #if 0
     RunFIFOTest(SDL_FALSE);
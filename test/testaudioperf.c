@@ -0,0 +1,154 @@
+/*
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure how long the audio thread takes per buffer when it has to
+   convert the callback's output for the device.
+
+   This uses the disk driver writing a WAV file as fast as it can, which
+   makes the device take little endian data, and asks for big endian
+   data, so every buffer is converted. Each format is run with
+   SDL_HINT_AUDIO_DIRECT_CONVERSION on (convert in place) and off (go
+   through an SDL_AudioStream), and reports:
+     - throughput: sample frames per second through the audio thread
+     - period: average and worst time between callbacks, which is the
+       time the audio thread adds to every buffer
+ */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+static const char *outfile = "/dev/null";
+static int num_buffers = 5000;
+static int samples = 512;
+
+static SDL_atomic_t callbacks;
+static Uint64 last_callback;
+static Uint64 total_period;
+static Uint64 worst_period;
+
+static void SDLCALL
+fill_audio(void *userdata, Uint8 *stream, int len)
+{
+    const Uint64 now = SDL_GetPerformanceCounter();
+
+    /* Touch the buffer like a mixer would, without much work */
+    SDL_memset(stream, SDL_AtomicGet(&callbacks) & 0x7F, len);
+
+    if (last_callback) {
+        const Uint64 period = now - last_callback;
+        total_period += period;
+        if (period > worst_period) {
+            worst_period = period;
+        }
+    }
+    last_callback = now;
+    SDL_AtomicIncRef(&callbacks);
+}
+
+static void
+run_test(const char *name, SDL_AudioFormat format, int channels, const char *direct)
+{
+    const double freq = (double) SDL_GetPerformanceFrequency();
+    SDL_AudioSpec desired, obtained;
+    SDL_AudioDeviceID id;
+    Uint64 start, elapsed;
+    int periods;
+
+    SDL_SetHint(SDL_HINT_AUDIO_DIRECT_CONVERSION, direct);
+
+    SDL_zero(desired);
+    desired.freq = 48000;
+    desired.format = format;
+    desired.channels = channels;
+    desired.samples = samples;
+    desired.callback = fill_audio;
+
+    id = SDL_OpenAudioDevice(outfile, 0, &desired, &obtained, 0);
+    if (!id) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open %s: %s\n", outfile, SDL_GetError());
+        return;
+    }
+
+    SDL_AtomicSet(&callbacks, 0);
+    last_callback = 0;
+    total_period = 0;
+    worst_period = 0;
+
+    start = SDL_GetPerformanceCounter();
+    SDL_PauseAudioDevice(id, 0);
+    while (SDL_AtomicGet(&callbacks) < num_buffers) {
+        SDL_Delay(1);
+    }
+    SDL_LockAudioDevice(id);
+    elapsed = SDL_GetPerformanceCounter() - start;
+    periods = SDL_AtomicGet(&callbacks) - 1;
+    SDL_UnlockAudioDevice(id);
+    SDL_CloseAudioDevice(id);
+
+    SDL_Log("%-14s %-6s: %8.0f kframes/s, period %7.2f us average, %8.2f us worst\n",
+            name, (*direct == '1') ? "direct" : "stream",
+            ((double) (periods + 1) * samples) / (elapsed / freq) / 1000.0,
+            (periods > 0) ? ((double) total_period * 1000000.0) / freq / periods : 0.0,
+            ((double) worst_period * 1000000.0) / freq);
+}
+
+int
+main(int argc, char *argv[])
+{
+    static const struct {
+        const char *name;
+        SDL_AudioFormat format;
+        int channels;
+    } formats[] = {
+        { "S16MSB stereo", AUDIO_S16MSB, 2 },
+        { "S32MSB stereo", AUDIO_S32MSB, 2 },
+        { "F32MSB 5.1", AUDIO_F32MSB, 6 },
+    };
+    int i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        num_buffers = SDL_atoi(argv[1]);
+    }
+    if (argc > 2) {
+        samples = SDL_atoi(argv[2]);
+    }
+    if (argc > 3) {
+        outfile = argv[3];
+    }
+    if (num_buffers <= 0 || samples <= 0) {
+        SDL_Log("USAGE: %s [buffers] [samples] [outfile]\n", argv[0]);
+        return 1;
+    }
+
+    SDL_setenv("SDL_AUDIODRIVER", "disk", 1);
+    SDL_SetHint(SDL_HINT_AUDIO_DISK_REALTIME, "0");
+    SDL_SetHint(SDL_HINT_AUDIO_DISK_WAV_HEADER, "1");
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize the disk audio driver: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Log("%d buffers of %d samples each, written to %s\n", num_buffers, samples, outfile);
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        run_test(formats[i].name, formats[i].format, formats[i].channels, "1");
+        run_test(formats[i].name, formats[i].format, formats[i].channels, "0");
+    }
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
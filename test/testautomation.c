@@ -37,9 +37,14 @@ main(int argc, char *argv[])
     Uint64 userExecKey = 0;
     char *userRunSeed = NULL;
     char *filter = NULL;
+    SDL_bool benchmark = SDL_FALSE;
+    SDLTest_BenchmarkOptions benchmarkOptions;
     int i, done;
     SDL_Event event;
 
+    SDL_zero(benchmarkOptions);
+    benchmarkOptions.warmupIterations = -1;
+
     /* Initialize test framework */
     state = SDLTest_CommonCreateState(argv, SDL_INIT_VIDEO);
     if (!state) {
@@ -57,6 +62,35 @@ main(int argc, char *argv[])
                 if (argv[i + 1]) {
                     testIterations = SDL_atoi(argv[i + 1]);
                     if (testIterations < 1) testIterations = 1;
+                    benchmarkOptions.iterations = testIterations;
+                    consumed = 2;
+                }
+            }
+            else if (SDL_strcasecmp(argv[i], "--benchmark") == 0) {
+                benchmark = SDL_TRUE;
+                consumed = 1;
+            }
+            else if (SDL_strcasecmp(argv[i], "--warmup") == 0) {
+                if (argv[i + 1]) {
+                    benchmarkOptions.warmupIterations = SDL_atoi(argv[i + 1]);
+                    consumed = 2;
+                }
+            }
+            else if (SDL_strcasecmp(argv[i], "--json") == 0) {
+                if (argv[i + 1]) {
+                    benchmarkOptions.outputFile = argv[i + 1];
+                    consumed = 2;
+                }
+            }
+            else if (SDL_strcasecmp(argv[i], "--baseline") == 0) {
+                if (argv[i + 1]) {
+                    benchmarkOptions.baselineFile = argv[i + 1];
+                    consumed = 2;
+                }
+            }
+            else if (SDL_strcasecmp(argv[i], "--tolerance") == 0) {
+                if (argv[i + 1]) {
+                    benchmarkOptions.tolerance = (float) SDL_atof(argv[i + 1]);
                     consumed = 2;
                 }
             }
@@ -80,7 +114,8 @@ main(int argc, char *argv[])
             }
         }
         if (consumed < 0) {
-            SDL_Log("Usage: %s %s [--iterations #] [--execKey #] [--seed string] [--filter suite_name|test_name]\n",
+            SDL_Log("Usage: %s %s [--iterations #] [--execKey #] [--seed string] [--filter suite_name|test_name] "
+                    "[--benchmark [--warmup #] [--json file] [--baseline file] [--tolerance percent]]\n",
                     argv[0], SDLTest_CommonUsage(state));
             quit(1);
         }
@@ -101,7 +136,11 @@ main(int argc, char *argv[])
     }
 
     /* Call Harness */
-    result = SDLTest_RunSuites(testSuites, (const char *)userRunSeed, userExecKey, (const char *)filter, testIterations);
+    if (benchmark) {
+        result = SDLTest_RunBenchmarks(benchmarkSuites, (const char *)filter, &benchmarkOptions);
+    } else {
+        result = SDLTest_RunSuites(testSuites, (const char *)userRunSeed, userExecKey, (const char *)filter, testIterations);
+    }
 
     /* Empty event queue */
     done = 0;
@@ -967,6 +967,460 @@ int audio_openCloseAudioDeviceConnected()
    return TEST_COMPLETED;
 }
 
+/* Ramp written by _audio_diskCallback, continued across callbacks */
+static Sint16 _audio_diskRamp;
+
+static void SDLCALL _audio_diskCallback(void *userdata, Uint8 *stream, int len)
+{
+   Sint16 *samples = (Sint16 *)stream;
+   int i;
+
+   for (i = 0; i < len / 2; i++) {
+      samples[i] = ++_audio_diskRamp;
+   }
+   _audio_testCallbackCounter++;
+   _audio_testCallbackLength += len;
+}
+
+/**
+ * \brief Capture playback to a WAV file with the disk driver, faster than real time
+ *
+ * \sa https://wiki.libsdl.org/SDL_OpenAudioDevice
+ */
+int audio_diskWriterCapture()
+{
+   const char *file = "sdlaudio-capture.wav";
+   const int buffers = 50;
+   SDL_AudioSpec desired, obtained, wavspec;
+   SDL_AudioDeviceID id;
+   Uint8 *wav = NULL;
+   Uint32 wavlen = 0;
+   Uint32 played, i;
+   Sint16 *samples;
+   int totalDelay;
+   int result;
+
+   /* Switch drivers, leaving the subsystem initialized */
+   SDL_AudioQuit();
+   SDLTest_AssertPass("Call to SDL_AudioQuit()");
+   SDL_SetHint(SDL_HINT_AUDIO_DISK_REALTIME, "0");
+   SDL_SetHint(SDL_HINT_AUDIO_DISK_WAV_HEADER, "1");
+   result = SDL_AudioInit("disk");
+   SDLTest_AssertPass("Call to SDL_AudioInit('disk')");
+   if (result != 0) {
+      SDLTest_Log("Disk audio driver not available: %s", SDL_GetError());
+      SDL_SetHint(SDL_HINT_AUDIO_DISK_REALTIME, NULL);
+      SDL_SetHint(SDL_HINT_AUDIO_DISK_WAV_HEADER, NULL);
+      SDL_QuitSubSystem(SDL_INIT_AUDIO);
+      _audioSetUp(NULL);
+      return TEST_SKIPPED;
+   }
+
+   SDL_memset(&desired, 0, sizeof(desired));
+   desired.freq = 44100;
+   desired.format = AUDIO_S16LSB;
+   desired.channels = 2;
+   desired.samples = 1024;
+   desired.callback = _audio_diskCallback;
+   _audio_diskRamp = 0;
+   _audio_testCallbackCounter = 0;
+   _audio_testCallbackLength = 0;
+
+   id = SDL_OpenAudioDevice(file, 0, &desired, &obtained, 0);
+   SDLTest_AssertPass("Call to SDL_OpenAudioDevice('%s',...)", file);
+   SDLTest_AssertCheck(id > 0, "Validate device ID; expected: >0, got: %i", id);
+   if (id > 0) {
+      /* 50 buffers would take over a second to play in real time */
+      SDL_PauseAudioDevice(id, 0);
+      totalDelay = 0;
+      while (_audio_testCallbackCounter < buffers && totalDelay < 10000) {
+         SDL_Delay(1);
+         totalDelay++;
+      }
+      SDL_CloseAudioDevice(id);
+      SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+      SDLTest_AssertCheck(_audio_testCallbackCounter >= buffers, "Verify callback count; expected: >=%d, got: %d", buffers, _audio_testCallbackCounter);
+      SDLTest_AssertCheck(totalDelay < 1000, "Verify faster than real time; expected: <1000 ms, got: %d ms", totalDelay);
+
+      /* The file holds the silence written while paused, followed by every callback's ramp */
+      SDLTest_AssertCheck(SDL_LoadWAV(file, &wavspec, &wav, &wavlen) != NULL, "Verify SDL_LoadWAV('%s') succeeds", file);
+      if (wav != NULL) {
+         played = (Uint32)_audio_testCallbackLength;
+         SDLTest_AssertCheck(wavspec.freq == desired.freq && wavspec.format == desired.format && wavspec.channels == desired.channels,
+            "Verify WAV spec; expected: %d Hz, 0x%x, %d channels, got: %d Hz, 0x%x, %d channels",
+            desired.freq, desired.format, desired.channels, wavspec.freq, wavspec.format, wavspec.channels);
+         SDLTest_AssertCheck(wavlen >= played && (wavlen % obtained.size) == 0,
+            "Verify WAV length; expected: >=%u and multiple of %u, got: %u", played, obtained.size, wavlen);
+         if (wavlen >= played) {
+            samples = (Sint16 *)wav;
+            for (i = 0; i < (wavlen - played) / 2; i++) {
+               if (samples[i] != 0) break;
+            }
+            SDLTest_AssertCheck(i == (wavlen - played) / 2, "Verify leading silence");
+            samples = (Sint16 *)(wav + (wavlen - played));
+            for (i = 0; i < played / 2; i++) {
+               if (samples[i] != (Sint16)(i + 1)) break;
+            }
+            SDLTest_AssertCheck(i == played / 2, "Verify written samples; expected mismatch at: %u, got: %u", played / 2, i);
+         }
+         SDL_FreeWAV(wav);
+      }
+   }
+
+   remove(file);
+   SDL_SetHint(SDL_HINT_AUDIO_DISK_REALTIME, NULL);
+   SDL_SetHint(SDL_HINT_AUDIO_DISK_WAV_HEADER, NULL);
+   SDL_QuitSubSystem(SDL_INIT_AUDIO);
+   _audioSetUp(NULL);
+
+   return TEST_COMPLETED;
+}
+
+
+static void SDLCALL _audio_diskCallbackBE(void *userdata, Uint8 *stream, int len)
+{
+   Sint16 *samples = (Sint16 *)stream;
+   int i;
+
+   for (i = 0; i < len / 2; i++) {
+      samples[i] = (Sint16)SDL_SwapBE16((Uint16)++_audio_diskRamp);
+   }
+   _audio_testCallbackCounter++;
+   _audio_testCallbackLength += len;
+}
+
+/**
+ * \brief Play big endian audio through the disk driver, which converts it for the WAV file
+ *
+ * Runs with and without SDL_HINT_AUDIO_DIRECT_CONVERSION, which should give the same output.
+ *
+ * \sa https://wiki.libsdl.org/SDL_OpenAudioDevice
+ */
+int audio_diskWriterConversion()
+{
+   const char *file = "sdlaudio-conversion.wav";
+   const char *direct[] = { "1", "0" };
+   const int buffers = 20;
+   SDL_AudioSpec desired, obtained, wavspec;
+   SDL_AudioDeviceID id;
+   Uint8 *wav;
+   Uint32 wavlen, played, skip, i;
+   Sint16 *samples;
+   int totalDelay;
+   int result;
+   int j;
+
+   SDL_AudioQuit();
+   SDLTest_AssertPass("Call to SDL_AudioQuit()");
+   SDL_SetHint(SDL_HINT_AUDIO_DISK_REALTIME, "0");
+   SDL_SetHint(SDL_HINT_AUDIO_DISK_WAV_HEADER, "1");
+   result = SDL_AudioInit("disk");
+   SDLTest_AssertPass("Call to SDL_AudioInit('disk')");
+   if (result != 0) {
+      SDLTest_Log("Disk audio driver not available: %s", SDL_GetError());
+      SDL_SetHint(SDL_HINT_AUDIO_DISK_REALTIME, NULL);
+      SDL_SetHint(SDL_HINT_AUDIO_DISK_WAV_HEADER, NULL);
+      SDL_QuitSubSystem(SDL_INIT_AUDIO);
+      _audioSetUp(NULL);
+      return TEST_SKIPPED;
+   }
+
+   for (j = 0; j < SDL_arraysize(direct); j++) {
+      SDL_SetHint(SDL_HINT_AUDIO_DIRECT_CONVERSION, direct[j]);
+
+      SDL_memset(&desired, 0, sizeof(desired));
+      desired.freq = 22050;
+      desired.format = AUDIO_S16MSB;
+      desired.channels = 2;
+      desired.samples = 512;
+      desired.callback = _audio_diskCallbackBE;
+      _audio_diskRamp = 0;
+      _audio_testCallbackCounter = 0;
+      _audio_testCallbackLength = 0;
+
+      id = SDL_OpenAudioDevice(file, 0, &desired, &obtained, 0);
+      SDLTest_AssertPass("Call to SDL_OpenAudioDevice('%s',...) with %s=%s", file, SDL_HINT_AUDIO_DIRECT_CONVERSION, direct[j]);
+      SDLTest_AssertCheck(id > 0, "Validate device ID; expected: >0, got: %i", id);
+      if (id == 0) {
+         continue;
+      }
+      SDLTest_AssertCheck(obtained.format == AUDIO_S16MSB, "Verify obtained format; expected: 0x%x, got: 0x%x", AUDIO_S16MSB, obtained.format);
+
+      SDL_PauseAudioDevice(id, 0);
+      totalDelay = 0;
+      while (_audio_testCallbackCounter < buffers && totalDelay < 10000) {
+         SDL_Delay(1);
+         totalDelay++;
+      }
+      SDL_CloseAudioDevice(id);
+      SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+      SDLTest_AssertCheck(_audio_testCallbackCounter >= buffers, "Verify callback count; expected: >=%d, got: %d", buffers, _audio_testCallbackCounter);
+
+      /* Silence from before we unpaused, then the ramp in little endian */
+      wav = NULL;
+      wavlen = 0;
+      SDLTest_AssertCheck(SDL_LoadWAV(file, &wavspec, &wav, &wavlen) != NULL, "Verify SDL_LoadWAV('%s') succeeds", file);
+      if (wav != NULL) {
+         played = (Uint32)_audio_testCallbackLength;
+         SDLTest_AssertCheck(wavspec.format == AUDIO_S16LSB, "Verify WAV format; expected: 0x%x, got: 0x%x", AUDIO_S16LSB, wavspec.format);
+         SDLTest_AssertCheck(wavlen >= played, "Verify WAV length; expected: >=%u, got: %u", played, wavlen);
+         if (wavlen >= played) {
+            skip = wavlen - played;
+            samples = (Sint16 *)(wav + skip);
+            for (i = 0; i < played / 2; i++) {
+               if (samples[i] != (Sint16)(i + 1)) break;
+            }
+            SDLTest_AssertCheck(i == played / 2, "Verify converted samples; expected mismatch at: %u, got: %u", played / 2, i);
+         }
+         SDL_FreeWAV(wav);
+      }
+   }
+
+   remove(file);
+   SDL_SetHint(SDL_HINT_AUDIO_DIRECT_CONVERSION, NULL);
+   SDL_SetHint(SDL_HINT_AUDIO_DISK_REALTIME, NULL);
+   SDL_SetHint(SDL_HINT_AUDIO_DISK_WAV_HEADER, NULL);
+   SDL_QuitSubSystem(SDL_INIT_AUDIO);
+   _audioSetUp(NULL);
+
+   return TEST_COMPLETED;
+}
+
+/* Timestamps seen by _audio_latencyCallback */
+static SDL_AudioDeviceID _audio_latencyDevice;
+static int _audio_latencyErrors;
+static Uint64 _audio_latencyLastCallback;
+static Uint64 _audio_latencyMaxAhead;
+
+static void SDLCALL _audio_latencyCallback(void *userdata, Uint8 *stream, int len)
+{
+   Uint64 callbackTime, sampleTime;
+
+   SDL_memset(stream, 0, len);
+   if (SDL_GetAudioDeviceTimestamp(_audio_latencyDevice, &callbackTime, &sampleTime) < 0 ||
+       callbackTime <= _audio_latencyLastCallback || sampleTime < callbackTime) {
+      _audio_latencyErrors++;
+   } else if (sampleTime - callbackTime > _audio_latencyMaxAhead) {
+      _audio_latencyMaxAhead = sampleTime - callbackTime;
+   }
+   _audio_latencyLastCallback = callbackTime;
+   _audio_testCallbackCounter++;
+}
+
+/**
+ * \brief Open devices in low latency mode with the dummy and disk drivers, and check the reported latency and timestamps
+ *
+ * \sa https://wiki.libsdl.org/SDL_GetAudioDeviceLatency
+ * \sa https://wiki.libsdl.org/SDL_GetAudioDeviceTimestamp
+ */
+int audio_lowLatency()
+{
+   const char *drivers[] = { "dummy", "disk" };
+   const int buffers = 10;
+   const Uint64 freq = SDL_GetPerformanceFrequency();
+   SDL_AudioSpec desired, obtained;
+   SDL_AudioDeviceID id;
+   Uint64 callbackTime, sampleTime;
+   Uint8 queued[4800 * 4];
+   int latency, totalDelay;
+   int result;
+   int i;
+
+   for (i = 0; i < SDL_arraysize(drivers); i++) {
+      SDL_AudioQuit();
+      result = SDL_AudioInit(drivers[i]);
+      SDLTest_AssertPass("Call to SDL_AudioInit('%s')", drivers[i]);
+      if (result != 0) {
+         SDLTest_Log("Audio driver '%s' not available: %s", drivers[i], SDL_GetError());
+         continue;
+      }
+
+      SDL_memset(&desired, 0, sizeof(desired));
+      desired.freq = 48000;
+      desired.format = AUDIO_S16SYS;
+      desired.channels = 2;
+      desired.samples = 4096;
+      desired.callback = _audio_latencyCallback;
+
+      /* Without the hint we get the samples we asked for */
+      id = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+      SDLTest_AssertCheck(id > 0, "Validate device ID; expected: >0, got: %i", id);
+      SDLTest_AssertCheck(obtained.samples == 4096, "Verify samples without low latency; expected: 4096, got: %d", obtained.samples);
+      SDL_CloseAudioDevice(id);
+
+      SDL_SetHint(SDL_HINT_AUDIO_LOW_LATENCY, "1");
+      id = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+      SDLTest_AssertPass("Call to SDL_OpenAudioDevice() with %s=1", SDL_HINT_AUDIO_LOW_LATENCY);
+      SDLTest_AssertCheck(id > 0, "Validate device ID; expected: >0, got: %i", id);
+      if (id > 0) {
+         SDLTest_AssertCheck(obtained.samples > 0 && obtained.samples < 4096, "Verify low latency samples; expected: <4096, got: %d", obtained.samples);
+
+         result = SDL_GetAudioDeviceTimestamp(id, &callbackTime, &sampleTime);
+         SDLTest_AssertCheck(result == 0 && callbackTime == 0 && sampleTime == 0, "Verify no timestamp before the first callback");
+
+         _audio_latencyDevice = id;
+         _audio_latencyErrors = 0;
+         _audio_latencyLastCallback = 0;
+         _audio_latencyMaxAhead = 0;
+         _audio_testCallbackCounter = 0;
+         SDL_PauseAudioDevice(id, 0);
+         totalDelay = 0;
+         while (_audio_testCallbackCounter < buffers && totalDelay < 2000) {
+            SDL_Delay(10);
+            totalDelay += 10;
+         }
+         latency = SDL_GetAudioDeviceLatency(id);
+         SDL_CloseAudioDevice(id);
+
+         SDLTest_AssertCheck(_audio_testCallbackCounter >= buffers, "Verify callback count; expected: >=%d, got: %d", buffers, _audio_testCallbackCounter);
+         SDLTest_AssertCheck(_audio_latencyErrors == 0, "Verify callback timestamps increase and play after the callback; got %d errors", _audio_latencyErrors);
+         SDLTest_AssertCheck(_audio_latencyMaxAhead <= (freq * 2 * obtained.samples) / obtained.freq,
+            "Verify samples play within two buffers; expected: <=%d frames, got: %d",
+            2 * obtained.samples, (int)((_audio_latencyMaxAhead * obtained.freq) / freq));
+         SDLTest_AssertCheck(latency >= 0 && latency <= 2 * obtained.samples,
+            "Verify SDL_GetAudioDeviceLatency(); expected: 0 to %d, got: %d", 2 * obtained.samples, latency);
+      }
+
+      /* Queued audio counts towards the latency */
+      desired.callback = NULL;
+      id = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+      SDLTest_AssertCheck(id > 0, "Validate queueing device ID; expected: >0, got: %i", id);
+      if (id > 0) {
+         SDL_memset(queued, 0, sizeof(queued));
+         SDL_QueueAudio(id, queued, sizeof(queued));
+         latency = SDL_GetAudioDeviceLatency(id);
+         SDLTest_AssertCheck(latency >= 4800, "Verify latency includes queued audio; expected: >=4800, got: %d", latency);
+         SDL_CloseAudioDevice(id);
+      }
+
+      /* A buffer that's already shorter than the minimum is kept */
+      desired.samples = 64;
+      id = SDL_OpenAudioDevice(NULL, 0, &desired, &obtained, 0);
+      SDLTest_AssertCheck(id > 0, "Validate short buffer device ID; expected: >0, got: %i", id);
+      if (id > 0) {
+         SDLTest_AssertCheck(obtained.samples == 64, "Verify short buffer samples; expected: 64, got: %d", obtained.samples);
+         SDL_CloseAudioDevice(id);
+      }
+      SDL_SetHint(SDL_HINT_AUDIO_LOW_LATENCY, "0");
+   }
+
+   latency = SDL_GetAudioDeviceLatency(0);
+   SDLTest_AssertCheck(latency == -1, "Verify SDL_GetAudioDeviceLatency(0) fails; expected: -1, got: %d", latency);
+   result = SDL_GetAudioDeviceTimestamp(0, NULL, NULL);
+   SDLTest_AssertCheck(result == -1, "Verify SDL_GetAudioDeviceTimestamp(0) fails; expected: -1, got: %d", result);
+
+   remove("sdlaudio.raw");
+   SDL_QuitSubSystem(SDL_INIT_AUDIO);
+   _audioSetUp(NULL);
+
+   return TEST_COMPLETED;
+}
+
+/* Counts every call into the allocator while installed */
+static SDL_malloc_func _audio_realMalloc;
+static SDL_calloc_func _audio_realCalloc;
+static SDL_realloc_func _audio_realRealloc;
+static SDL_free_func _audio_realFree;
+static int _audio_allocationCount;
+
+static void * SDLCALL _audio_countingMalloc(size_t size)
+{
+   _audio_allocationCount++;
+   return _audio_realMalloc(size);
+}
+
+static void * SDLCALL _audio_countingCalloc(size_t nmemb, size_t size)
+{
+   _audio_allocationCount++;
+   return _audio_realCalloc(nmemb, size);
+}
+
+static void * SDLCALL _audio_countingRealloc(void *mem, size_t size)
+{
+   _audio_allocationCount++;
+   return _audio_realRealloc(mem, size);
+}
+
+/**
+ * \brief Checks that a preallocated audio stream, and an SDL_AudioCVT that resamples, run without allocating
+ *
+ * \sa https://wiki.libsdl.org/SDL_AudioStreamPreallocate
+ * \sa https://wiki.libsdl.org/SDL_ConvertAudio
+ */
+int audio_preallocatedStream()
+{
+   const struct { SDL_AudioFormat srcfmt; Uint8 srcchans; int srcrate; SDL_AudioFormat dstfmt; Uint8 dstchans; int dstrate; } convs[] = {
+      { AUDIO_S16SYS, 2, 44100, AUDIO_S16SYS, 2, 44100 },
+      { AUDIO_S16SYS, 2, 44100, AUDIO_F32SYS, 2, 48000 },
+      { AUDIO_F32SYS, 2, 48000, AUDIO_S16SYS, 1, 22050 },
+      { AUDIO_U8, 1, 11025, AUDIO_S32SYS, 6, 96000 },
+      { AUDIO_S16SYS, 6, 96000, AUDIO_U8, 2, 8000 },
+   };
+   const int maxframes = 1024;
+   static Uint8 inbuf[1024 * 6 * 4];
+   static Uint8 outbuf[1024 * 6 * 4 * 16];
+   SDL_AudioStream *stream;
+   SDL_AudioCVT cvt;
+   Uint8 *cvtbuf;
+   int i, j, ret;
+
+   SDL_GetMemoryFunctions(&_audio_realMalloc, &_audio_realCalloc, &_audio_realRealloc, &_audio_realFree);
+   SDL_memset(inbuf, 0x10, sizeof(inbuf));
+
+   for (i = 0; i < SDL_arraysize(convs); i++) {
+      const int srcframesize = (SDL_AUDIO_BITSIZE(convs[i].srcfmt) / 8) * convs[i].srcchans;
+      const int maxput = maxframes * srcframesize;
+
+      stream = SDL_NewAudioStream(convs[i].srcfmt, convs[i].srcchans, convs[i].srcrate, convs[i].dstfmt, convs[i].dstchans, convs[i].dstrate);
+      SDLTest_AssertPass("Call to SDL_NewAudioStream(%d Hz -> %d Hz)", convs[i].srcrate, convs[i].dstrate);
+      SDLTest_AssertCheck(stream != NULL, "Verify stream was created");
+      if (stream == NULL) {
+         continue;
+      }
+
+      ret = SDL_AudioStreamPreallocate(stream, maxput);
+      SDLTest_AssertCheck(ret == 0, "Verify SDL_AudioStreamPreallocate(%d) succeeds, got: %d", maxput, ret);
+
+      /* Puts of any size up to the maximum, draining as we go, and a clear in the middle */
+      SDL_SetMemoryFunctions(_audio_countingMalloc, _audio_countingCalloc, _audio_countingRealloc, _audio_realFree);
+      _audio_allocationCount = 0;
+      for (j = 0; j < 200; j++) {
+         const int frames = (j % 7 == 0) ? maxframes : (1 + (j * 37) % maxframes);
+         SDL_AudioStreamPut(stream, inbuf, frames * srcframesize);
+         SDL_AudioStreamGet(stream, outbuf, SDL_AudioStreamAvailable(stream));
+         if (j == 100) {
+            SDL_AudioStreamClear(stream);
+         }
+      }
+      SDL_SetMemoryFunctions(_audio_realMalloc, _audio_realCalloc, _audio_realRealloc, _audio_realFree);
+      SDLTest_AssertCheck(_audio_allocationCount == 0, "Verify no allocations while streaming; expected: 0, got: %d", _audio_allocationCount);
+
+      SDL_FreeAudioStream(stream);
+      SDLTest_AssertPass("Call to SDL_FreeAudioStream()");
+
+      /* The same conversion through SDL_ConvertAudio, after building the CVT */
+      ret = SDL_BuildAudioCVT(&cvt, convs[i].srcfmt, convs[i].srcchans, convs[i].srcrate, convs[i].dstfmt, convs[i].dstchans, convs[i].dstrate);
+      SDLTest_AssertCheck(ret >= 0, "Verify SDL_BuildAudioCVT succeeds, got: %d", ret);
+      if (ret > 0) {
+         cvt.len = maxput;
+         cvtbuf = (Uint8 *)SDL_malloc(cvt.len * cvt.len_mult);
+         SDLTest_AssertCheck(cvtbuf != NULL, "Verify conversion buffer was allocated");
+         if (cvtbuf != NULL) {
+            SDL_memcpy(cvtbuf, inbuf, maxput);
+            cvt.buf = cvtbuf;
+            SDL_SetMemoryFunctions(_audio_countingMalloc, _audio_countingCalloc, _audio_countingRealloc, _audio_realFree);
+            _audio_allocationCount = 0;
+            ret = SDL_ConvertAudio(&cvt);
+            SDL_SetMemoryFunctions(_audio_realMalloc, _audio_realCalloc, _audio_realRealloc, _audio_realFree);
+            SDLTest_AssertCheck(ret == 0, "Verify SDL_ConvertAudio succeeds, got: %d", ret);
+            SDLTest_AssertCheck(_audio_allocationCount == 0, "Verify no allocations in SDL_ConvertAudio; expected: 0, got: %d", _audio_allocationCount);
+            SDL_free(cvtbuf);
+         }
+      }
+   }
+
+   return TEST_COMPLETED;
+}
 
 
 /* ================= Test Case References ================== */
@@ -1022,11 +1476,23 @@ static const SDLTest_TestCaseReference audioTest14 =
 static const SDLTest_TestCaseReference audioTest15 =
         { (SDLTest_TestCaseFp)audio_pauseUnpauseAudio, "audio_pauseUnpauseAudio", "Pause and Unpause audio for various audio specs while testing callback.", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference audioTest16 =
+        { (SDLTest_TestCaseFp)audio_diskWriterCapture, "audio_diskWriterCapture", "Captures playback to a WAV file with the disk driver.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest17 =
+        { (SDLTest_TestCaseFp)audio_preallocatedStream, "audio_preallocatedStream", "Checks that preallocated audio streams and resampling CVTs don't allocate.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest18 =
+        { (SDLTest_TestCaseFp)audio_diskWriterConversion, "audio_diskWriterConversion", "Converts playback in place and through a stream with the disk driver.", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioTest19 =
+        { (SDLTest_TestCaseFp)audio_lowLatency, "audio_lowLatency", "Opens low latency devices and checks latency and callback timestamps.", TEST_ENABLED };
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] =  {
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
-    &audioTest12, &audioTest13, &audioTest14, &audioTest15, NULL
+    &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16, &audioTest17, &audioTest18, &audioTest19, NULL
 };
 
 /* Audio test suite (global) */
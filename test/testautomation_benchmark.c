@@ -0,0 +1,736 @@
+/**
+ * Benchmark suites, run with testautomation --benchmark
+ *
+ * All of these run headless, with the dummy video and audio drivers or
+ * none at all.
+ */
+
+#include <stdio.h>
+
+#include "SDL.h"
+#include "SDL_test.h"
+
+/* ================= Blit ================== */
+
+#define BENCHMARK_WIDTH     640
+#define BENCHMARK_HEIGHT    480
+
+typedef struct
+{
+    SDL_Surface *src;
+    SDL_Surface *dst;
+    SDL_Rect dstrect;
+} BlitBenchmark;
+
+static SDL_bool
+_createBlitBenchmark(BlitBenchmark *data, Uint32 srcFormat, Uint32 dstFormat, int srcW, int srcH)
+{
+    SDL_zerop(data);
+    data->src = SDL_CreateRGBSurfaceWithFormat(0, srcW, srcH, 0, srcFormat);
+    data->dst = SDL_CreateRGBSurfaceWithFormat(0, BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 0, dstFormat);
+    SDLTest_AssertCheck(data->src != NULL && data->dst != NULL, "Create surfaces %s -> %s",
+                        SDL_GetPixelFormatName(srcFormat), SDL_GetPixelFormatName(dstFormat));
+    if (data->src == NULL || data->dst == NULL) {
+        return SDL_FALSE;
+    }
+
+    /* Gradients, so blending and conversion don't see constant input */
+    if (SDL_LockSurface(data->src) == 0) {
+        Uint8 *pixels = (Uint8 *)data->src->pixels;
+        int x, y;
+        for (y = 0; y < srcH; ++y) {
+            for (x = 0; x < data->src->pitch; ++x) {
+                pixels[y * data->src->pitch + x] = (Uint8)(x + y);
+            }
+        }
+        SDL_UnlockSurface(data->src);
+    }
+    data->dstrect.w = BENCHMARK_WIDTH;
+    data->dstrect.h = BENCHMARK_HEIGHT;
+    return SDL_TRUE;
+}
+
+static void
+_destroyBlitBenchmark(BlitBenchmark *data)
+{
+    SDL_FreeSurface(data->src);
+    SDL_FreeSurface(data->dst);
+}
+
+static void
+_blitBenchmark(void *arg)
+{
+    BlitBenchmark *data = (BlitBenchmark *)arg;
+    SDL_Rect dstrect = data->dstrect;
+    SDL_BlitSurface(data->src, NULL, data->dst, &dstrect);
+}
+
+static void
+_blitScaledBenchmark(void *arg)
+{
+    BlitBenchmark *data = (BlitBenchmark *)arg;
+    SDL_Rect dstrect = data->dstrect;
+    SDL_BlitScaled(data->src, NULL, data->dst, &dstrect);
+}
+
+static int
+_runBlitBenchmark(const char *name, Uint32 srcFormat, Uint32 dstFormat, SDL_BlendMode blendMode, SDL_bool scaled)
+{
+    BlitBenchmark data;
+    int srcW = scaled ? BENCHMARK_WIDTH / 2 : BENCHMARK_WIDTH;
+    int srcH = scaled ? BENCHMARK_HEIGHT / 2 : BENCHMARK_HEIGHT;
+
+    if (!_createBlitBenchmark(&data, srcFormat, dstFormat, srcW, srcH)) {
+        _destroyBlitBenchmark(&data);
+        return TEST_ABORTED;
+    }
+    SDL_SetSurfaceBlendMode(data.src, blendMode);
+    SDLTest_Benchmark(name, scaled ? _blitScaledBenchmark : _blitBenchmark, &data);
+    _destroyBlitBenchmark(&data);
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Copy between surfaces of the same format
+ */
+int
+blitbench_copy(void *arg)
+{
+    return _runBlitBenchmark("blit_copy_xrgb8888", SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, SDL_BLENDMODE_NONE, SDL_FALSE);
+}
+
+/**
+ * @brief Convert between pixel formats
+ */
+int
+blitbench_convert(void *arg)
+{
+    int result = _runBlitBenchmark("blit_convert_argb8888_rgb565", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565, SDL_BLENDMODE_NONE, SDL_FALSE);
+    if (result == TEST_COMPLETED) {
+        result = _runBlitBenchmark("blit_convert_abgr8888_argb8888", SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_NONE, SDL_FALSE);
+    }
+    return result;
+}
+
+/**
+ * @brief Alpha blend onto an opaque surface
+ */
+int
+blitbench_blend(void *arg)
+{
+    return _runBlitBenchmark("blit_blend_argb8888_xrgb8888", SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB888, SDL_BLENDMODE_BLEND, SDL_FALSE);
+}
+
+/**
+ * @brief Scale a surface up by 2
+ */
+int
+blitbench_scaled(void *arg)
+{
+    return _runBlitBenchmark("blit_scaled_2x_xrgb8888", SDL_PIXELFORMAT_RGB888, SDL_PIXELFORMAT_RGB888, SDL_BLENDMODE_NONE, SDL_TRUE);
+}
+
+/* ================= FillRect ================== */
+
+typedef struct
+{
+    SDL_Surface *dst;
+    SDL_Rect rects[256];
+    Uint32 color;
+} FillRectBenchmark;
+
+static void
+_fillRectBenchmark(void *arg)
+{
+    FillRectBenchmark *data = (FillRectBenchmark *)arg;
+    SDL_FillRect(data->dst, NULL, data->color++);
+}
+
+static void
+_fillRectsBenchmark(void *arg)
+{
+    FillRectBenchmark *data = (FillRectBenchmark *)arg;
+    SDL_FillRects(data->dst, data->rects, SDL_arraysize(data->rects), data->color++);
+}
+
+static int
+_runFillRectBenchmark(const char *name, Uint32 format, SDLTest_BenchmarkFp benchmark)
+{
+    FillRectBenchmark data;
+    int i;
+
+    SDL_zero(data);
+    data.dst = SDL_CreateRGBSurfaceWithFormat(0, BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 0, format);
+    SDLTest_AssertCheck(data.dst != NULL, "Create %s surface", SDL_GetPixelFormatName(format));
+    if (data.dst == NULL) {
+        return TEST_ABORTED;
+    }
+
+    /* A grid of small rectangles, like a tile map or a UI */
+    for (i = 0; i < SDL_arraysize(data.rects); ++i) {
+        data.rects[i].x = (i % 16) * (BENCHMARK_WIDTH / 16) + 2;
+        data.rects[i].y = (i / 16) * (BENCHMARK_HEIGHT / 16) + 2;
+        data.rects[i].w = BENCHMARK_WIDTH / 16 - 4;
+        data.rects[i].h = BENCHMARK_HEIGHT / 16 - 4;
+    }
+
+    SDLTest_Benchmark(name, benchmark, &data);
+    SDL_FreeSurface(data.dst);
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Fill whole surfaces
+ */
+int
+fillrectbench_full(void *arg)
+{
+    int result = _runFillRectBenchmark("fillrect_full_xrgb8888", SDL_PIXELFORMAT_RGB888, _fillRectBenchmark);
+    if (result == TEST_COMPLETED) {
+        result = _runFillRectBenchmark("fillrect_full_rgb565", SDL_PIXELFORMAT_RGB565, _fillRectBenchmark);
+    }
+    if (result == TEST_COMPLETED) {
+        result = _runFillRectBenchmark("fillrect_full_index8", SDL_PIXELFORMAT_INDEX8, _fillRectBenchmark);
+    }
+    return result;
+}
+
+/**
+ * @brief Fill many small rectangles
+ */
+int
+fillrectbench_rects(void *arg)
+{
+    return _runFillRectBenchmark("fillrect_rects_xrgb8888", SDL_PIXELFORMAT_RGB888, _fillRectsBenchmark);
+}
+
+/* ================= AudioCVT ================== */
+
+/* A second of audio at the source rate */
+#define BENCHMARK_AUDIO_MS  1000
+
+typedef struct
+{
+    SDL_AudioCVT cvt;
+    Uint8 *src;
+    int srcLength;
+} AudioCVTBenchmark;
+
+static void
+_audioCVTBenchmark(void *arg)
+{
+    AudioCVTBenchmark *data = (AudioCVTBenchmark *)arg;
+
+    /* SDL_ConvertAudio() works in place, so start from the source every time */
+    SDL_memcpy(data->cvt.buf, data->src, data->srcLength);
+    data->cvt.len = data->srcLength;
+    SDL_ConvertAudio(&data->cvt);
+}
+
+static Uint8 *
+_createAudio(SDL_AudioFormat format, Uint8 channels, int freq, int *length)
+{
+    const int frames = freq * BENCHMARK_AUDIO_MS / 1000;
+    const int samples = frames * channels;
+    Uint8 *buffer;
+    int i;
+
+    *length = samples * (SDL_AUDIO_BITSIZE(format) / 8);
+    buffer = (Uint8 *)SDL_malloc(*length);
+    if (buffer == NULL) {
+        return NULL;
+    }
+
+    /* Not silence, so nothing gets skipped */
+    for (i = 0; i < samples; ++i) {
+        const Sint16 value = (Sint16)((i * 97) & 0x3FFF) - 0x2000;
+        if (format == AUDIO_F32SYS) {
+            ((float *)buffer)[i] = value / 32768.0f;
+        } else {
+            ((Sint16 *)buffer)[i] = value;
+        }
+    }
+    return buffer;
+}
+
+static int
+_runAudioCVTBenchmark(const char *name, SDL_AudioFormat srcFormat, Uint8 srcChannels, int srcRate,
+                      SDL_AudioFormat dstFormat, Uint8 dstChannels, int dstRate)
+{
+    AudioCVTBenchmark data;
+    int result;
+
+    SDL_zero(data);
+    result = SDL_BuildAudioCVT(&data.cvt, srcFormat, srcChannels, srcRate, dstFormat, dstChannels, dstRate);
+    SDLTest_AssertCheck(result == 1, "Build audio conversion for %s, expected 1, got %d", name, result);
+    data.src = _createAudio(srcFormat, srcChannels, srcRate, &data.srcLength);
+    if (result == 1 && data.src != NULL) {
+        data.cvt.buf = (Uint8 *)SDL_malloc(data.srcLength * data.cvt.len_mult);
+    }
+    if (data.cvt.buf == NULL) {
+        SDL_free(data.src);
+        return TEST_ABORTED;
+    }
+
+    SDLTest_Benchmark(name, _audioCVTBenchmark, &data);
+    SDL_free(data.cvt.buf);
+    SDL_free(data.src);
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Convert the sample format
+ */
+int
+audiocvtbench_format(void *arg)
+{
+    return _runAudioCVTBenchmark("audiocvt_s16_f32_stereo", AUDIO_S16SYS, 2, 48000, AUDIO_F32SYS, 2, 48000);
+}
+
+/**
+ * @brief Change the channel layout
+ */
+int
+audiocvtbench_channels(void *arg)
+{
+    return _runAudioCVTBenchmark("audiocvt_f32_stereo_to_51", AUDIO_F32SYS, 2, 48000, AUDIO_F32SYS, 6, 48000);
+}
+
+/**
+ * @brief Resample
+ */
+int
+audiocvtbench_resample(void *arg)
+{
+    return _runAudioCVTBenchmark("audiocvt_s16_44100_f32_48000", AUDIO_S16SYS, 2, 44100, AUDIO_F32SYS, 2, 48000);
+}
+
+/* ================= AudioStream ================== */
+
+/* How much the application puts in at a time, like an audio callback */
+#define BENCHMARK_STREAM_CHUNK  4096
+
+typedef struct
+{
+    SDL_AudioStream *stream;
+    Uint8 *src;
+    int srcLength;
+    Uint8 *dst;
+    int dstLength;
+} AudioStreamBenchmark;
+
+static void
+_audioStreamBenchmark(void *arg)
+{
+    AudioStreamBenchmark *data = (AudioStreamBenchmark *)arg;
+    int offset;
+
+    for (offset = 0; offset < data->srcLength; offset += BENCHMARK_STREAM_CHUNK) {
+        SDL_AudioStreamPut(data->stream, data->src + offset, SDL_min(BENCHMARK_STREAM_CHUNK, data->srcLength - offset));
+        while (SDL_AudioStreamGet(data->stream, data->dst, data->dstLength) > 0) {
+            continue;
+        }
+    }
+}
+
+static int
+_runAudioStreamBenchmark(const char *name, SDL_AudioFormat srcFormat, Uint8 srcChannels, int srcRate,
+                         SDL_AudioFormat dstFormat, Uint8 dstChannels, int dstRate)
+{
+    AudioStreamBenchmark data;
+
+    SDL_zero(data);
+    data.stream = SDL_NewAudioStream(srcFormat, srcChannels, srcRate, dstFormat, dstChannels, dstRate);
+    SDLTest_AssertCheck(data.stream != NULL, "Create audio stream for %s", name);
+    data.src = _createAudio(srcFormat, srcChannels, srcRate, &data.srcLength);
+    data.dstLength = BENCHMARK_STREAM_CHUNK * 4;
+    data.dst = (Uint8 *)SDL_malloc(data.dstLength);
+    if (data.stream == NULL || data.src == NULL || data.dst == NULL) {
+        if (data.stream) {
+            SDL_FreeAudioStream(data.stream);
+        }
+        SDL_free(data.src);
+        SDL_free(data.dst);
+        return TEST_ABORTED;
+    }
+
+    SDLTest_Benchmark(name, _audioStreamBenchmark, &data);
+    SDL_FreeAudioStream(data.stream);
+    SDL_free(data.src);
+    SDL_free(data.dst);
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Stream with a sample format change only
+ */
+int
+audiostreambench_format(void *arg)
+{
+    return _runAudioStreamBenchmark("audiostream_s16_f32_stereo", AUDIO_S16SYS, 2, 48000, AUDIO_F32SYS, 2, 48000);
+}
+
+/**
+ * @brief Stream with resampling
+ */
+int
+audiostreambench_resample(void *arg)
+{
+    return _runAudioStreamBenchmark("audiostream_s16_44100_f32_48000", AUDIO_S16SYS, 2, 44100, AUDIO_F32SYS, 2, 48000);
+}
+
+/* ================= Events ================== */
+
+/* About what a frame of high rate input produces */
+#define BENCHMARK_EVENTS    1000
+
+static void
+_pushPollBenchmark(void *arg)
+{
+    SDL_Event event;
+    int i;
+
+    SDL_zero(event);
+    event.type = SDL_USEREVENT;
+    for (i = 0; i < BENCHMARK_EVENTS; ++i) {
+        event.user.code = i;
+        SDL_PushEvent(&event);
+    }
+    while (SDL_PollEvent(&event)) {
+        continue;
+    }
+}
+
+static void
+_peepBenchmark(void *arg)
+{
+    SDL_Event *events = (SDL_Event *)arg;
+    int i;
+
+    for (i = 0; i < BENCHMARK_EVENTS; ++i) {
+        events[i].user.code = i;
+    }
+    SDL_PeepEvents(events, BENCHMARK_EVENTS, SDL_ADDEVENT, 0, 0);
+    SDL_PeepEvents(events, BENCHMARK_EVENTS, SDL_GETEVENT, SDL_USEREVENT, SDL_USEREVENT);
+}
+
+/**
+ * @brief Push events one by one and drain the queue with SDL_PollEvent()
+ */
+int
+eventsbench_pushPoll(void *arg)
+{
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+    SDLTest_Benchmark("events_push_poll_1000", _pushPollBenchmark, NULL);
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Add and get events in batches with SDL_PeepEvents()
+ */
+int
+eventsbench_peep(void *arg)
+{
+    SDL_Event *events = (SDL_Event *)SDL_calloc(BENCHMARK_EVENTS, sizeof(SDL_Event));
+    int i;
+
+    SDLTest_AssertCheck(events != NULL, "Allocate events");
+    if (events == NULL) {
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < BENCHMARK_EVENTS; ++i) {
+        events[i].type = SDL_USEREVENT;
+    }
+
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+    SDLTest_Benchmark("events_peep_1000", _peepBenchmark, events);
+    SDL_free(events);
+    return TEST_COMPLETED;
+}
+
+/* ================= Render ================== */
+
+typedef struct
+{
+    SDL_Surface *target;
+    SDL_Renderer *renderer;
+    SDL_Texture *texture;
+    SDL_Rect rects[256];
+    SDL_Point points[1024];
+} RenderBenchmark;
+
+static void
+_renderClearBenchmark(void *arg)
+{
+    RenderBenchmark *data = (RenderBenchmark *)arg;
+    SDL_SetRenderDrawColor(data->renderer, 0x20, 0x40, 0x60, 0xFF);
+    SDL_RenderClear(data->renderer);
+    SDL_RenderPresent(data->renderer);
+}
+
+static void
+_renderFillRectsBenchmark(void *arg)
+{
+    RenderBenchmark *data = (RenderBenchmark *)arg;
+    SDL_SetRenderDrawBlendMode(data->renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(data->renderer, 0xFF, 0x80, 0x00, 0x80);
+    SDL_RenderFillRects(data->renderer, data->rects, SDL_arraysize(data->rects));
+    SDL_RenderPresent(data->renderer);
+}
+
+static void
+_renderLinesBenchmark(void *arg)
+{
+    RenderBenchmark *data = (RenderBenchmark *)arg;
+    SDL_SetRenderDrawBlendMode(data->renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(data->renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+    SDL_RenderDrawLines(data->renderer, data->points, SDL_arraysize(data->points));
+    SDL_RenderPresent(data->renderer);
+}
+
+static void
+_renderCopyBenchmark(void *arg)
+{
+    RenderBenchmark *data = (RenderBenchmark *)arg;
+    int i;
+
+    for (i = 0; i < SDL_arraysize(data->rects); ++i) {
+        SDL_RenderCopy(data->renderer, data->texture, NULL, &data->rects[i]);
+    }
+    SDL_RenderPresent(data->renderer);
+}
+
+static void
+_renderCopyExBenchmark(void *arg)
+{
+    RenderBenchmark *data = (RenderBenchmark *)arg;
+    int i;
+
+    for (i = 0; i < SDL_arraysize(data->rects); ++i) {
+        SDL_RenderCopyEx(data->renderer, data->texture, NULL, &data->rects[i], (double)(i * 7), NULL, SDL_FLIP_NONE);
+    }
+    SDL_RenderPresent(data->renderer);
+}
+
+static int
+_runRenderBenchmark(const char *name, SDLTest_BenchmarkFp benchmark)
+{
+    RenderBenchmark data;
+    SDL_Surface *image;
+    int i;
+
+    SDL_zero(data);
+    data.target = SDL_CreateRGBSurfaceWithFormat(0, BENCHMARK_WIDTH, BENCHMARK_HEIGHT, 0, SDL_PIXELFORMAT_RGB888);
+    SDLTest_AssertCheck(data.target != NULL, "Create render target surface");
+    if (data.target == NULL) {
+        return TEST_ABORTED;
+    }
+    data.renderer = SDL_CreateSoftwareRenderer(data.target);
+    SDLTest_AssertCheck(data.renderer != NULL, "Create software renderer");
+    image = SDLTest_ImageBlitAlpha();
+    if (data.renderer != NULL && image != NULL) {
+        data.texture = SDL_CreateTextureFromSurface(data.renderer, image);
+        SDL_SetTextureBlendMode(data.texture, SDL_BLENDMODE_BLEND);
+    }
+    SDL_FreeSurface(image);
+    SDLTest_AssertCheck(data.texture != NULL, "Create texture");
+    if (data.texture == NULL) {
+        if (data.renderer) {
+            SDL_DestroyRenderer(data.renderer);
+        }
+        SDL_FreeSurface(data.target);
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(data.rects); ++i) {
+        data.rects[i].x = (i * 37) % (BENCHMARK_WIDTH - 64);
+        data.rects[i].y = (i * 53) % (BENCHMARK_HEIGHT - 64);
+        data.rects[i].w = 32 + (i % 32);
+        data.rects[i].h = 32 + (i % 16) * 2;
+    }
+    for (i = 0; i < SDL_arraysize(data.points); ++i) {
+        data.points[i].x = (i * 97) % BENCHMARK_WIDTH;
+        data.points[i].y = (i * 89) % BENCHMARK_HEIGHT;
+    }
+
+    SDLTest_Benchmark(name, benchmark, &data);
+
+    SDL_DestroyTexture(data.texture);
+    SDL_DestroyRenderer(data.renderer);
+    SDL_FreeSurface(data.target);
+    return TEST_COMPLETED;
+}
+
+/**
+ * @brief Clear the target
+ */
+int
+renderbench_clear(void *arg)
+{
+    return _runRenderBenchmark("render_sw_clear", _renderClearBenchmark);
+}
+
+/**
+ * @brief Blend many rectangles
+ */
+int
+renderbench_fillRects(void *arg)
+{
+    return _runRenderBenchmark("render_sw_fill_rects_blend", _renderFillRectsBenchmark);
+}
+
+/**
+ * @brief Draw a long polyline
+ */
+int
+renderbench_lines(void *arg)
+{
+    return _runRenderBenchmark("render_sw_lines", _renderLinesBenchmark);
+}
+
+/**
+ * @brief Draw many blended, scaled sprites
+ */
+int
+renderbench_copy(void *arg)
+{
+    return _runRenderBenchmark("render_sw_copy_blend", _renderCopyBenchmark);
+}
+
+/**
+ * @brief Draw many rotated sprites
+ */
+int
+renderbench_copyEx(void *arg)
+{
+    return _runRenderBenchmark("render_sw_copy_rotated", _renderCopyExBenchmark);
+}
+
+/* ================= Test References ================== */
+
+/* Blit benchmark cases */
+static const SDLTest_TestCaseReference blitBench1 =
+        { (SDLTest_TestCaseFp)blitbench_copy, "blitbench_copy", "Copy between surfaces of the same format", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference blitBench2 =
+        { (SDLTest_TestCaseFp)blitbench_convert, "blitbench_convert", "Convert between pixel formats", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference blitBench3 =
+        { (SDLTest_TestCaseFp)blitbench_blend, "blitbench_blend", "Alpha blend onto an opaque surface", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference blitBench4 =
+        { (SDLTest_TestCaseFp)blitbench_scaled, "blitbench_scaled", "Scale a surface up by 2", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference *blitBenchmarks[] =  {
+    &blitBench1, &blitBench2, &blitBench3, &blitBench4, NULL
+};
+
+/* FillRect benchmark cases */
+static const SDLTest_TestCaseReference fillRectBench1 =
+        { (SDLTest_TestCaseFp)fillrectbench_full, "fillrectbench_full", "Fill whole surfaces", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference fillRectBench2 =
+        { (SDLTest_TestCaseFp)fillrectbench_rects, "fillrectbench_rects", "Fill many small rectangles", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference *fillRectBenchmarks[] =  {
+    &fillRectBench1, &fillRectBench2, NULL
+};
+
+/* AudioCVT benchmark cases */
+static const SDLTest_TestCaseReference audioCVTBench1 =
+        { (SDLTest_TestCaseFp)audiocvtbench_format, "audiocvtbench_format", "Convert the sample format", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioCVTBench2 =
+        { (SDLTest_TestCaseFp)audiocvtbench_channels, "audiocvtbench_channels", "Change the channel layout", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioCVTBench3 =
+        { (SDLTest_TestCaseFp)audiocvtbench_resample, "audiocvtbench_resample", "Resample", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference *audioCVTBenchmarks[] =  {
+    &audioCVTBench1, &audioCVTBench2, &audioCVTBench3, NULL
+};
+
+/* AudioStream benchmark cases */
+static const SDLTest_TestCaseReference audioStreamBench1 =
+        { (SDLTest_TestCaseFp)audiostreambench_format, "audiostreambench_format", "Stream with a sample format change only", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference audioStreamBench2 =
+        { (SDLTest_TestCaseFp)audiostreambench_resample, "audiostreambench_resample", "Stream with resampling", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference *audioStreamBenchmarks[] =  {
+    &audioStreamBench1, &audioStreamBench2, NULL
+};
+
+/* Events benchmark cases */
+static const SDLTest_TestCaseReference eventsBench1 =
+        { (SDLTest_TestCaseFp)eventsbench_pushPoll, "eventsbench_pushPoll", "Push events one by one and drain the queue with SDL_PollEvent()", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference eventsBench2 =
+        { (SDLTest_TestCaseFp)eventsbench_peep, "eventsbench_peep", "Add and get events in batches with SDL_PeepEvents()", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference *eventsBenchmarks[] =  {
+    &eventsBench1, &eventsBench2, NULL
+};
+
+/* Render benchmark cases */
+static const SDLTest_TestCaseReference renderBench1 =
+        { (SDLTest_TestCaseFp)renderbench_clear, "renderbench_clear", "Clear the target", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderBench2 =
+        { (SDLTest_TestCaseFp)renderbench_fillRects, "renderbench_fillRects", "Blend many rectangles", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderBench3 =
+        { (SDLTest_TestCaseFp)renderbench_lines, "renderbench_lines", "Draw a long polyline", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderBench4 =
+        { (SDLTest_TestCaseFp)renderbench_copy, "renderbench_copy", "Draw many blended, scaled sprites", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference renderBench5 =
+        { (SDLTest_TestCaseFp)renderbench_copyEx, "renderbench_copyEx", "Draw many rotated sprites", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference *renderBenchmarks[] =  {
+    &renderBench1, &renderBench2, &renderBench3, &renderBench4, &renderBench5, NULL
+};
+
+/* Benchmark suites */
+SDLTest_TestSuiteReference blitBenchmarkSuite = {
+    "BlitBenchmark",
+    NULL,
+    blitBenchmarks,
+    NULL
+};
+
+SDLTest_TestSuiteReference fillRectBenchmarkSuite = {
+    "FillRectBenchmark",
+    NULL,
+    fillRectBenchmarks,
+    NULL
+};
+
+SDLTest_TestSuiteReference audioCVTBenchmarkSuite = {
+    "AudioCVTBenchmark",
+    NULL,
+    audioCVTBenchmarks,
+    NULL
+};
+
+SDLTest_TestSuiteReference audioStreamBenchmarkSuite = {
+    "AudioStreamBenchmark",
+    NULL,
+    audioStreamBenchmarks,
+    NULL
+};
+
+SDLTest_TestSuiteReference eventsBenchmarkSuite = {
+    "EventsBenchmark",
+    NULL,
+    eventsBenchmarks,
+    NULL
+};
+
+SDLTest_TestSuiteReference renderBenchmarkSuite = {
+    "RenderBenchmark",
+    NULL,
+    renderBenchmarks,
+    NULL
+};
@@ -175,6 +175,118 @@ events_addDelEventWatchWithUserdata(void *arg)
 }
 
 
+/**
+ * @brief Merges motion events in the queue and reads the raw events back from the history
+ *
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PushEvent
+ * @sa http://wiki.libsdl.org/moin.cgi/SDL_PeepEvents
+ */
+int
+events_coalesceMotionEvents(void *arg)
+{
+   SDL_Event event;
+   SDL_Event events[16];
+   int i, result;
+
+   /* Start with nothing queued */
+   SDL_SetHint(SDL_HINT_EVENT_COALESCING, "1");
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_COALESCING, \"1\")");
+   SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+   while (SDL_GetEventHistory(events, SDL_arraysize(events), SDL_FIRSTEVENT, SDL_LASTEVENT) > 0) {
+      continue;
+   }
+
+   /* Four motions of mouse 1, interleaved with two of mouse 2 */
+   for (i = 0; i < 4; ++i) {
+      SDL_zero(event);
+      event.type = SDL_MOUSEMOTION;
+      event.motion.which = 1;
+      event.motion.x = i;
+      event.motion.xrel = 1;
+      event.motion.yrel = -2;
+      SDL_PushEvent(&event);
+      if (i & 1) {
+         event.motion.which = 2;
+         SDL_PushEvent(&event);
+      }
+   }
+   SDLTest_AssertPass("Call to SDL_PushEvent() with mouse motion");
+
+   /* Motion after a button press must stay after it */
+   SDL_zero(event);
+   event.type = SDL_MOUSEBUTTONDOWN;
+   event.button.which = 1;
+   event.button.button = SDL_BUTTON_LEFT;
+   SDL_PushEvent(&event);
+   SDL_zero(event);
+   event.type = SDL_MOUSEMOTION;
+   event.motion.which = 1;
+   event.motion.xrel = 5;
+   SDL_PushEvent(&event);
+
+   /* Joystick axes are merged per axis, the latest value wins */
+   for (i = 0; i < 3; ++i) {
+      SDL_zero(event);
+      event.type = SDL_JOYAXISMOTION;
+      event.jaxis.which = 0;
+      event.jaxis.axis = (Uint8) (i & 1);
+      event.jaxis.value = (Sint16) (i * 100);
+      SDL_PushEvent(&event);
+   }
+
+   result = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_MOUSEMOTION, SDL_MOUSEBUTTONDOWN);
+   SDLTest_AssertPass("Call to SDL_PeepEvents()");
+   SDLTest_AssertCheck(result == 4, "Check number of mouse events, expected: 4, got: %d", result);
+   if (result == 4) {
+      SDLTest_AssertCheck(events[0].type == SDL_MOUSEMOTION && events[0].motion.which == 1, "Check first event is motion of mouse 1");
+      SDLTest_AssertCheck(events[0].motion.x == 3, "Check merged x, expected: 3, got: %d", events[0].motion.x);
+      SDLTest_AssertCheck(events[0].motion.xrel == 4 && events[0].motion.yrel == -8,
+         "Check merged relative motion, expected: 4,-8, got: %d,%d", events[0].motion.xrel, events[0].motion.yrel);
+      SDLTest_AssertCheck(events[1].type == SDL_MOUSEMOTION && events[1].motion.which == 2 && events[1].motion.xrel == 2,
+         "Check second event is merged motion of mouse 2");
+      SDLTest_AssertCheck(events[2].type == SDL_MOUSEBUTTONDOWN, "Check third event is the button press");
+      SDLTest_AssertCheck(events[3].type == SDL_MOUSEMOTION && events[3].motion.xrel == 5,
+         "Check motion after the button press was not merged into earlier motion");
+   }
+
+   result = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_JOYAXISMOTION, SDL_JOYAXISMOTION);
+   SDLTest_AssertCheck(result == 2, "Check number of joystick axis events, expected: 2, got: %d", result);
+   if (result == 2) {
+      SDLTest_AssertCheck(events[0].jaxis.axis == 0 && events[0].jaxis.value == 200,
+         "Check axis 0 has the latest value, expected: 200, got: %d", events[0].jaxis.value);
+      SDLTest_AssertCheck(events[1].jaxis.axis == 1 && events[1].jaxis.value == 100,
+         "Check axis 1 has the latest value, expected: 100, got: %d", events[1].jaxis.value);
+   }
+
+   /* Every raw motion event is in the history, in order */
+   result = SDL_GetEventHistory(events, SDL_arraysize(events), SDL_MOUSEMOTION, SDL_MOUSEMOTION);
+   SDLTest_AssertPass("Call to SDL_GetEventHistory()");
+   SDLTest_AssertCheck(result == 7, "Check number of raw mouse motion events, expected: 7, got: %d", result);
+   if (result == 7) {
+      SDLTest_AssertCheck(events[0].motion.which == 1 && events[0].motion.x == 0, "Check first raw event");
+      SDLTest_AssertCheck(events[6].motion.xrel == 5, "Check last raw event");
+   }
+   result = SDL_GetEventHistory(events, SDL_arraysize(events), SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == 3, "Check number of raw joystick events left, expected: 3, got: %d", result);
+   result = SDL_GetEventHistory(events, SDL_arraysize(events), SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == 0, "Check history is empty, got: %d", result);
+
+   /* Nothing is merged or recorded with the hint off */
+   SDL_SetHint(SDL_HINT_EVENT_COALESCING, "0");
+   SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_COALESCING, \"0\")");
+   SDL_zero(event);
+   event.type = SDL_MOUSEMOTION;
+   SDL_PushEvent(&event);
+   SDL_PushEvent(&event);
+   result = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_MOUSEMOTION, SDL_MOUSEMOTION);
+   SDLTest_AssertCheck(result == 2, "Check motion is not merged, expected: 2, got: %d", result);
+   result = SDL_GetEventHistory(events, SDL_arraysize(events), SDL_FIRSTEVENT, SDL_LASTEVENT);
+   SDLTest_AssertCheck(result == 0, "Check nothing was recorded, got: %d", result);
+
+   return TEST_COMPLETED;
+}
+
+
 /* ================= Test References ================== */
 
 /* Events test cases */
@@ -187,9 +299,12 @@ static const SDLTest_TestCaseReference eventsTest2 =
 static const SDLTest_TestCaseReference eventsTest3 =
         { (SDLTest_TestCaseFp)events_addDelEventWatchWithUserdata, "events_addDelEventWatchWithUserdata", "Adds and deletes an event watch function with userdata", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference eventsTest4 =
+        { (SDLTest_TestCaseFp)events_coalesceMotionEvents, "events_coalesceMotionEvents", "Merges motion events in the queue and reads them back from the history", TEST_ENABLED };
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] =  {
-    &eventsTest1, &eventsTest2, &eventsTest3, NULL
+    &eventsTest1, &eventsTest2, &eventsTest3, &eventsTest4, NULL
 };
 
 /* Events test suite (global) */
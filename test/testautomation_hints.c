@@ -145,6 +145,61 @@ hints_setHint(void *arg)
   return TEST_COMPLETED;
 }
 
+/**
+ * @brief Call to SDL_SetHint with many different values
+ */
+int
+hints_setHintChangingValues(void *arg)
+{
+  const char *name = "SDL_AUTOMATION_TEST_HINT";
+  SDL_AllocationStats before, after;
+  char value[32];
+  const char *startValue;
+  const char *testValue;
+  SDL_bool tracking;
+  int i, pass;
+
+  tracking = SDL_GetAllocationTracking();
+  SDL_SetAllocationTracking(SDL_TRUE);
+  SDL_SetHint(name, "start");
+  startValue = SDL_GetHint(name);
+
+  /* Values already used are kept, so setting them again doesn't allocate */
+  for (pass = 0; pass < 2; ++pass) {
+    SDL_GetAllocationStats(&before);
+    for (i = 0; i < 1000; ++i) {
+      SDL_snprintf(value, sizeof(value), "value %d", i);
+      SDL_SetHint(name, value);
+    }
+    SDL_GetAllocationStats(&after);
+  }
+  SDLTest_AssertPass("Call to SDL_SetHint(%s) with 1000 different values, twice", name);
+  SDLTest_AssertCheck(
+    after.bytes_in_use == before.bytes_in_use,
+    "Verify setting the same values again doesn't allocate, expected: 0 more bytes in use, got: %d",
+    (int)(after.bytes_in_use - before.bytes_in_use));
+
+  testValue = SDL_GetHint(name);
+  SDLTest_AssertCheck(
+    testValue && SDL_strcmp(testValue, value) == 0,
+    "Verify returned value equals last set value; got: testValue='%s' value='%s'",
+    testValue ? testValue : "null",
+    value);
+
+  /* A value returned earlier is still valid */
+  SDLTest_AssertCheck(
+    startValue && SDL_strcmp(startValue, "start") == 0,
+    "Verify the first value returned is still intact; got: '%s'",
+    startValue ? startValue : "null");
+  SDL_SetHint(name, "start");
+  SDLTest_AssertCheck(
+    SDL_GetHint(name) == startValue,
+    "Verify setting the first value again returns the same pointer");
+
+  SDL_SetAllocationTracking(tracking);
+  return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Hints test cases */
@@ -154,9 +209,12 @@ static const SDLTest_TestCaseReference hintsTest1 =
 static const SDLTest_TestCaseReference hintsTest2 =
         { (SDLTest_TestCaseFp)hints_setHint, "hints_setHint", "Call to SDL_SetHint", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference hintsTest3 =
+        { (SDLTest_TestCaseFp)hints_setHintChangingValues, "hints_setHintChangingValues", "Call to SDL_SetHint with many different values", TEST_ENABLED };
+
 /* Sequence of Hints test cases */
 static const SDLTest_TestCaseReference *hintsTests[] =  {
-    &hintsTest1, &hintsTest2, NULL
+    &hintsTest1, &hintsTest2, &hintsTest3, NULL
 };
 
 /* Hints test suite (global) */
@@ -765,6 +765,98 @@ render_testBlitBlend (void *arg)
    return TEST_COMPLETED;
 }
 
+/**
+ * @brief Tests the per frame render statistics.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_GetRenderStats
+ * http://wiki.libsdl.org/moin.cgi/SDL_GetRenderStatsHistory
+ */
+int
+render_testRenderStats (void *arg)
+{
+   SDL_RenderStats stats;
+   SDL_RenderStats history[SDL_RENDER_STATS_HISTORY + 1];
+   SDL_Texture *textures[2];
+   Uint32 pixels[16 * 16];
+   SDL_Rect rect;
+   int i, ret;
+
+   /* Nothing was presented yet. */
+   ret = SDL_GetRenderStats(renderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(stats.frame == 0 && stats.draw_calls == 0, "Validate no frame was counted yet, got frame %u with %u draw calls", stats.frame, stats.draw_calls);
+   ret = SDL_GetRenderStatsHistory(renderer, history, SDL_arraysize(history));
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStatsHistory, expected: 0, got: %i", ret);
+
+   for (i = 0; i < 2; ++i) {
+      textures[i] = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 16, 16);
+      SDLTest_AssertCheck(textures[i] != NULL, "Verify result from SDL_CreateTexture");
+      if (textures[i] == NULL) {
+         return TEST_ABORTED;
+      }
+   }
+   SDL_memset(pixels, 0xFF, sizeof(pixels));
+   SDL_SetTextureBlendMode(textures[0], SDL_BLENDMODE_BLEND);
+   SDL_SetTextureBlendMode(textures[1], SDL_BLENDMODE_NONE);
+   SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+   /* Draw a frame with a known amount of work, after the one setting up the renderer. */
+   SDL_RenderPresent(renderer);
+   rect.x = 0;
+   rect.y = 0;
+   rect.w = 16;
+   rect.h = 16;
+   SDL_UpdateTexture(textures[0], NULL, pixels, 16 * sizeof(Uint32));
+   SDL_RenderSetClipRect(renderer, &rect);
+   SDL_RenderClear(renderer);
+   SDL_RenderFillRect(renderer, &rect);
+   SDL_RenderCopy(renderer, textures[0], NULL, &rect);
+   SDL_RenderCopy(renderer, textures[0], NULL, &rect);
+   SDL_RenderCopy(renderer, textures[1], NULL, &rect);
+   SDL_RenderCopy(renderer, textures[0], NULL, &rect);
+   SDL_RenderSetClipRect(renderer, NULL);
+   SDL_RenderPresent(renderer);
+
+   ret = SDL_GetRenderStats(renderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(stats.frame == 2, "Validate frame, expected: 2, got: %u", stats.frame);
+   SDLTest_AssertCheck(stats.draw_calls == 6, "Validate draw_calls, expected: 6, got: %u", stats.draw_calls);
+   SDLTest_AssertCheck(stats.texture_binds == 3, "Validate texture_binds, expected: 3, got: %u", stats.texture_binds);
+   SDLTest_AssertCheck(stats.blend_changes == 4, "Validate blend_changes, expected: 4, got: %u", stats.blend_changes);
+   SDLTest_AssertCheck(stats.state_changes == 2, "Validate state_changes, expected: 2, got: %u", stats.state_changes);
+   SDLTest_AssertCheck(stats.texture_uploads == 1, "Validate texture_uploads, expected: 1, got: %u", stats.texture_uploads);
+   SDLTest_AssertCheck(stats.bytes_uploaded == sizeof(pixels), "Validate bytes_uploaded, expected: %i, got: %i", (int) sizeof(pixels), (int) stats.bytes_uploaded);
+
+   /* The counters start over at present. */
+   SDL_RenderPresent(renderer);
+   ret = SDL_GetRenderStats(renderer, &stats);
+   SDLTest_AssertCheck(ret == 0, "Validate result from SDL_GetRenderStats, expected: 0, got: %i", ret);
+   SDLTest_AssertCheck(stats.frame == 3 && stats.draw_calls == 0 && stats.bytes_uploaded == 0, "Validate empty frame 3, got frame %u with %u draw calls", stats.frame, stats.draw_calls);
+
+   /* The history has the newest frame first, and only the frames presented. */
+   ret = SDL_GetRenderStatsHistory(renderer, history, SDL_arraysize(history));
+   SDLTest_AssertCheck(ret == 3, "Validate result from SDL_GetRenderStatsHistory, expected: 3, got: %i", ret);
+   SDLTest_AssertCheck(history[0].frame == 3 && history[1].frame == 2, "Validate history frames, expected: 3 2, got: %u %u", history[0].frame, history[1].frame);
+   SDLTest_AssertCheck(history[1].draw_calls == 6, "Validate history draw_calls, expected: 6, got: %u", history[1].draw_calls);
+
+   /* Only the last frames are remembered. */
+   for (i = 0; i < SDL_RENDER_STATS_HISTORY; ++i) {
+      SDL_RenderPresent(renderer);
+   }
+   ret = SDL_GetRenderStatsHistory(renderer, history, SDL_arraysize(history));
+   SDLTest_AssertCheck(ret == SDL_RENDER_STATS_HISTORY, "Validate result from SDL_GetRenderStatsHistory, expected: %i, got: %i", SDL_RENDER_STATS_HISTORY, ret);
+   SDLTest_AssertCheck(history[ret - 1].frame == 4, "Validate oldest frame, expected: 4, got: %u", history[ret - 1].frame);
+
+   ret = SDL_GetRenderStats(renderer, NULL);
+   SDLTest_AssertCheck(ret == -1, "Validate result from SDL_GetRenderStats with NULL stats, expected: -1, got: %i", ret);
+
+   SDL_DestroyTexture(textures[0]);
+   SDL_DestroyTexture(textures[1]);
+
+   return TEST_COMPLETED;
+}
+
 
 /**
  * @brief Checks to see if functionality is supported. Helper function.
@@ -1085,9 +1177,12 @@ static const SDLTest_TestCaseReference renderTest6 =
 static const SDLTest_TestCaseReference renderTest7 =
         {  (SDLTest_TestCaseFp)render_testBlitBlend, "render_testBlitBlend", "Tests blitting with blending", TEST_DISABLED };
 
+static const SDLTest_TestCaseReference renderTest8 =
+        { (SDLTest_TestCaseFp)render_testRenderStats, "render_testRenderStats", "Tests the per frame render statistics", TEST_ENABLED };
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] =  {
-    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, NULL
+    &renderTest1, &renderTest2, &renderTest3, &renderTest4, &renderTest5, &renderTest6, &renderTest7, &renderTest8, NULL
 };
 
 /* Render test suite (global) */
@@ -699,6 +699,226 @@ rwops_testFileWriteReadEndian(void)
    return TEST_COMPLETED;
 }
 
+/**
+ * @brief Tests reading from a memory mapped file.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RWFromFileMapped
+ * http://wiki.libsdl.org/moin.cgi/SDL_RWGetMemory
+ */
+int
+rwops_testFileMapped(void)
+{
+   SDL_RWops *rw;
+   const void *mem;
+   size_t available;
+   char *data;
+   size_t datasize;
+   int result;
+
+   rw = SDL_RWFromFileMapped(RWopsReadTestFilename);
+   SDLTest_AssertPass("Call to SDL_RWFromFileMapped() succeeded");
+   SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_RWFromFileMapped does not return NULL");
+
+   /* Bail out if NULL */
+   if (rw == NULL) return TEST_ABORTED;
+
+   SDLTest_AssertCheck(
+      rw->type == SDL_RWOPS_MAPPED || rw->type == SDL_RWOPS_MEMORY_RO,
+      "Verify RWops type is SDL_RWOPS_MAPPED or SDL_RWOPS_MEMORY_RO; expected: %d|%d, got: %d", SDL_RWOPS_MAPPED, SDL_RWOPS_MEMORY_RO, rw->type);
+
+   /* Run generic tests */
+   _testGenericRWopsValidations( rw, 0 );
+
+   /* Direct access to the data */
+   SDL_RWseek(rw, 6, RW_SEEK_SET);
+   mem = SDL_RWGetMemory(rw, &available);
+   SDLTest_AssertPass("Call to SDL_RWGetMemory() succeeded");
+   SDLTest_AssertCheck(mem != NULL, "Verify SDL_RWGetMemory does not return NULL");
+   SDLTest_AssertCheck(available == SDL_strlen(RWopsHelloWorldTestString) - 6, "Verify available bytes, expected %i, got %i", (int) SDL_strlen(RWopsHelloWorldTestString) - 6, (int) available);
+   if (mem) {
+      SDLTest_AssertCheck(SDL_memcmp(mem, RWopsHelloWorldTestString + 6, available) == 0, "Verify mapped data matches file contents");
+   }
+
+   /* Load the rest of the file */
+   data = (char *) SDL_LoadFile_RW(rw, &datasize, 0);
+   SDLTest_AssertPass("Call to SDL_LoadFile_RW() succeeded");
+   SDLTest_AssertCheck(data != NULL, "Verify SDL_LoadFile_RW does not return NULL");
+   SDLTest_AssertCheck(datasize == available, "Verify loaded size, expected %i, got %i", (int) available, (int) datasize);
+   if (data) {
+      SDLTest_AssertCheck(SDL_strcmp(data, RWopsHelloWorldTestString + 6) == 0, "Verify loaded data, expected '%s', got '%s'", RWopsHelloWorldTestString + 6, data);
+      SDL_free(data);
+   }
+   SDLTest_AssertCheck(SDL_RWtell(rw) == (Sint64) SDL_strlen(RWopsHelloWorldTestString), "Verify stream is at the end after SDL_LoadFile_RW");
+
+   /* The size argument is optional */
+   SDLTest_AssertCheck(SDL_RWGetMemory(rw, NULL) != NULL, "Verify SDL_RWGetMemory accepts NULL size");
+
+   /* Close handle */
+   result = SDL_RWclose(rw);
+   SDLTest_AssertPass("Call to SDL_RWclose() succeeded");
+   SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+
+   return TEST_COMPLETED;
+}
+
+/**
+ * @brief Tests reading and writing through a buffered stream.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_RWFromBuffered
+ */
+int
+rwops_testBuffered(void)
+{
+   SDL_RWops *rw;
+   char buffer[27];
+   Sint64 position;
+   size_t s;
+   int result;
+   int bufsize;
+
+   /* Small buffers exercise refills, pass-through reads and in-buffer seeks */
+   for (bufsize = 1; bufsize <= 32; bufsize *= 2) {
+      rw = SDL_RWFromBuffered(SDL_RWFromFile(RWopsWriteTestFilename, "w+"), bufsize, SDL_TRUE);
+      SDLTest_AssertPass("Call to SDL_RWFromBuffered(..., %d, SDL_TRUE) succeeded", bufsize);
+      SDLTest_AssertCheck(rw != NULL, "Verify SDL_RWFromBuffered does not return NULL");
+
+      /* Bail out if NULL */
+      if (rw == NULL) return TEST_ABORTED;
+
+      SDLTest_AssertCheck(
+         rw->type == SDL_RWOPS_BUFFERED,
+         "Verify RWops type is SDL_RWOPS_BUFFERED; expected: %d, got: %d", SDL_RWOPS_BUFFERED, rw->type);
+      SDLTest_AssertCheck(SDL_RWGetMemory(rw, NULL) == NULL, "Verify SDL_RWGetMemory returns NULL for a buffered stream");
+
+      /* Run generic tests */
+      _testGenericRWopsValidations( rw, 1 );
+
+      /* Overwrite with the alphabet and read it back in odd sized pieces */
+      SDL_RWseek(rw, 0, RW_SEEK_SET);
+      s = SDL_RWwrite(rw, RWopsAlphabetString, 1, 26);
+      SDLTest_AssertCheck(s == 26, "Verify result of SDL_RWwrite, expected 26, got %i", (int) s);
+      SDLTest_AssertCheck(SDL_RWsize(rw) == 26, "Verify size after write, expected 26, got %i", (int) SDL_RWsize(rw));
+
+      SDL_zero(buffer);
+      SDL_RWseek(rw, 0, RW_SEEK_SET);
+      s = SDL_RWread(rw, buffer, 3, 2);
+      SDLTest_AssertCheck(s == 2, "Verify result of SDL_RWread, expected 2, got %i", (int) s);
+      position = SDL_RWseek(rw, 4, RW_SEEK_CUR);
+      SDLTest_AssertCheck(position == 10, "Verify seek forward with RW_SEEK_CUR, expected 10, got %i", (int) position);
+      position = SDL_RWseek(rw, -3, RW_SEEK_CUR);
+      SDLTest_AssertCheck(position == 7, "Verify seek backward with RW_SEEK_CUR, expected 7, got %i", (int) position);
+      s = SDL_RWread(rw, buffer + 7, 1, 19);
+      SDLTest_AssertCheck(s == 19, "Verify result of SDL_RWread, expected 19, got %i", (int) s);
+      SDLTest_AssertCheck(SDL_memcmp(buffer, RWopsAlphabetString, 6) == 0 && SDL_memcmp(buffer + 7, RWopsAlphabetString + 7, 19) == 0, "Verify read data matches the alphabet");
+      s = SDL_RWread(rw, buffer, 1, 1);
+      SDLTest_AssertCheck(s == 0, "Verify reading at the end returns 0, got %i", (int) s);
+
+      /* Mixed writes after a read */
+      SDL_RWseek(rw, 1, RW_SEEK_SET);
+      SDL_RWread(rw, buffer, 1, 1);
+      SDL_WriteU8(rw, 'x');
+      SDL_RWseek(rw, 0, RW_SEEK_SET);
+      SDL_RWread(rw, buffer, 1, 4);
+      SDLTest_AssertCheck(SDL_memcmp(buffer, "ABxD", 4) == 0, "Verify write after read lands at the right offset");
+
+      result = SDL_RWclose(rw);
+      SDLTest_AssertPass("Call to SDL_RWclose() succeeded");
+      SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+   }
+
+   /* Negative case */
+   rw = SDL_RWFromBuffered(NULL, 0, SDL_FALSE);
+   SDLTest_AssertPass("Call to SDL_RWFromBuffered(NULL, 0, SDL_FALSE) succeeded");
+   SDLTest_AssertCheck(rw == NULL, "Verify SDL_RWFromBuffered with NULL source returns NULL");
+
+   return TEST_COMPLETED;
+}
+
+static void SDLCALL
+_asyncCallback(void *userdata, SDL_AsyncIO *request)
+{
+   SDL_AtomicIncRef((SDL_atomic_t *) userdata);
+}
+
+/**
+ * @brief Tests asynchronous file loading and reading.
+ *
+ * \sa
+ * http://wiki.libsdl.org/moin.cgi/SDL_LoadFileAsync
+ * http://wiki.libsdl.org/moin.cgi/SDL_RWReadAsync
+ */
+int
+rwops_testAsync(void)
+{
+   SDL_AsyncIO *requests[3];
+   SDL_AsyncIOStatus status;
+   SDL_atomic_t callbacks;
+   SDL_RWops *rw;
+   char buffer[27];
+   char *data;
+   size_t size;
+   int i;
+
+   SDL_AtomicSet(&callbacks, 0);
+
+   /* Load a whole file */
+   requests[0] = SDL_LoadFileAsync(RWopsReadTestFilename, 0, _asyncCallback, &callbacks);
+   SDLTest_AssertPass("Call to SDL_LoadFileAsync() succeeded");
+   SDLTest_AssertCheck(requests[0] != NULL, "Verify SDL_LoadFileAsync does not return NULL");
+   if (requests[0] == NULL) return TEST_ABORTED;
+
+   status = SDL_WaitAsyncIO(requests[0]);
+   SDLTest_AssertPass("Call to SDL_WaitAsyncIO() succeeded");
+   SDLTest_AssertCheck(status == SDL_ASYNCIO_COMPLETE, "Verify request status, expected: %d, got: %d", SDL_ASYNCIO_COMPLETE, status);
+   SDLTest_AssertCheck(SDL_GetAsyncIOStatus(requests[0]) == SDL_ASYNCIO_COMPLETE, "Verify SDL_GetAsyncIOStatus matches");
+   data = (char *) SDL_GetAsyncIOData(requests[0], &size);
+   SDLTest_AssertCheck(data != NULL, "Verify SDL_GetAsyncIOData does not return NULL");
+   SDLTest_AssertCheck(size == SDL_strlen(RWopsHelloWorldTestString), "Verify loaded size, expected: %d, got: %d", (int) SDL_strlen(RWopsHelloWorldTestString), (int) size);
+   if (data) {
+      SDLTest_AssertCheck(SDL_strcmp(data, RWopsHelloWorldTestString) == 0, "Verify loaded data, expected: '%s', got: '%s'", RWopsHelloWorldTestString, data);
+      SDL_free(data);
+   }
+   SDLTest_AssertCheck(SDL_GetAsyncIOData(requests[0], NULL) == NULL, "Verify the loaded data is only handed out once");
+   SDL_FreeAsyncIO(requests[0]);
+
+   /* Missing file */
+   requests[0] = SDL_LoadFileAsync("rwops_does_not_exist", 0, NULL, NULL);
+   SDLTest_AssertCheck(requests[0] != NULL, "Verify SDL_LoadFileAsync does not return NULL");
+   if (requests[0] == NULL) return TEST_ABORTED;
+   status = SDL_WaitAsyncIO(requests[0]);
+   SDLTest_AssertCheck(status == SDL_ASYNCIO_FAILED, "Verify loading a missing file fails, expected: %d, got: %d", SDL_ASYNCIO_FAILED, status);
+   SDL_FreeAsyncIO(requests[0]);
+
+   /* Consecutive reads of the same stream run in order */
+   rw = SDL_RWFromFile(RWopsAlphabetFilename, "r");
+   SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_RWFromFile in read mode does not return NULL");
+   if (rw == NULL) return TEST_ABORTED;
+
+   SDL_zero(buffer);
+   requests[0] = SDL_RWReadAsync(rw, buffer, 1, 10, 0, _asyncCallback, &callbacks);
+   requests[1] = SDL_RWReadAsync(rw, buffer + 10, 1, 10, 0, _asyncCallback, &callbacks);
+   requests[2] = SDL_RWReadAsync(rw, buffer + 20, 1, 10, 0, _asyncCallback, &callbacks);
+   SDLTest_AssertPass("Call to SDL_RWReadAsync() succeeded");
+   for (i = 0; i < SDL_arraysize(requests); ++i) {
+      SDLTest_AssertCheck(requests[i] != NULL, "Verify SDL_RWReadAsync does not return NULL");
+      status = SDL_WaitAsyncIO(requests[i]);
+      SDLTest_AssertCheck(status == SDL_ASYNCIO_COMPLETE, "Verify request status, expected: %d, got: %d", SDL_ASYNCIO_COMPLETE, status);
+   }
+   SDL_GetAsyncIOData(requests[2], &size);
+   SDLTest_AssertCheck(size == 6, "Verify size of last read, expected: 6, got: %d", (int) size);
+   SDLTest_AssertCheck(SDL_strcmp(buffer, RWopsAlphabetString) == 0, "Verify read data, expected: '%s', got: '%s'", RWopsAlphabetString, buffer);
+   for (i = 0; i < SDL_arraysize(requests); ++i) {
+      SDL_FreeAsyncIO(requests[i]);
+   }
+   SDL_RWclose(rw);
+
+   SDLTest_AssertCheck(SDL_AtomicGet(&callbacks) == 4, "Verify number of callbacks, expected: 4, got: %d", SDL_AtomicGet(&callbacks));
+
+   return TEST_COMPLETED;
+}
+
 
 /* ================= Test References ================== */
 
@@ -733,10 +953,19 @@ static const SDLTest_TestCaseReference rwopsTest9 =
 static const SDLTest_TestCaseReference rwopsTest10 =
         { (SDLTest_TestCaseFp)rwops_testCompareRWFromMemWithRWFromFile, "rwops_testCompareRWFromMemWithRWFromFile", "Compare RWFromMem and RWFromFile RWops for read and seek", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference rwopsTest11 =
+        { (SDLTest_TestCaseFp)rwops_testFileMapped, "rwops_testFileMapped", "Tests reading from a memory mapped file", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference rwopsTest12 =
+        { (SDLTest_TestCaseFp)rwops_testBuffered, "rwops_testBuffered", "Tests reading and writing through a buffered stream", TEST_ENABLED };
+
+static const SDLTest_TestCaseReference rwopsTest13 =
+        { (SDLTest_TestCaseFp)rwops_testAsync, "rwops_testAsync", "Tests asynchronous file loading and reading", TEST_ENABLED };
+
 /* Sequence of RWops test cases */
 static const SDLTest_TestCaseReference *rwopsTests[] =  {
     &rwopsTest1, &rwopsTest2, &rwopsTest3, &rwopsTest4, &rwopsTest5, &rwopsTest6,
-    &rwopsTest7, &rwopsTest8, &rwopsTest9, &rwopsTest10, NULL
+    &rwopsTest7, &rwopsTest8, &rwopsTest9, &rwopsTest10, &rwopsTest11, &rwopsTest12, &rwopsTest13, NULL
 };
 
 /* RWops test suite (global) */
@@ -290,6 +290,88 @@ stdlib_sscanf(void *arg)
   return TEST_COMPLETED;
 }
 
+/**
+ * @brief Call to SDL_SetAllocationTracking and SDL_GetAllocationStats
+ */
+int
+stdlib_allocationStats(void *arg)
+{
+  SDL_AllocationStats before, after;
+  SDL_AllocationSite sites[4];
+  int result, i;
+  void *mem[3];
+  char buffer[64];
+
+  result = SDL_SetAllocationTracking(SDL_TRUE);
+  SDLTest_AssertPass("Call to SDL_SetAllocationTracking(SDL_TRUE)");
+  SDLTest_AssertCheck(result == 0, "Check return value, expected: 0, got: %d", result);
+
+  /* Logging allocates, so check the counters before asserting anything */
+  SDL_ResetAllocationStats();
+  SDL_GetAllocationStats(&before);
+  SDLTest_AssertPass("Call to SDL_ResetAllocationStats()");
+  SDLTest_AssertCheck(before.num_allocations == 0, "Check num_allocations after reset, expected: 0, got: %d", (int) before.num_allocations);
+
+  for (i = 0; i < SDL_arraysize(mem); ++i) {
+    mem[i] = SDL_malloc(100);
+  }
+  mem[0] = SDL_realloc(mem[0], 200);
+  SDL_GetAllocationStats(&after);
+  SDLTest_AssertPass("Call to SDL_GetAllocationStats()");
+  SDLTest_AssertCheck(after.num_allocations - before.num_allocations >= 4, "Check num_allocations, expected: >= 4, got: %d", (int) (after.num_allocations - before.num_allocations));
+  SDLTest_AssertCheck(after.bytes_in_use >= before.bytes_in_use + 400, "Check bytes_in_use grew by at least 400 bytes");
+  SDLTest_AssertCheck(after.frame_allocations >= 4, "Check frame_allocations, expected: >= 4, got: %d", (int) after.frame_allocations);
+
+  result = SDL_GetAllocationSites(sites, SDL_arraysize(sites));
+  SDLTest_AssertPass("Call to SDL_GetAllocationSites()");
+  SDLTest_AssertCheck(result >= 1, "Check number of call sites, expected: >= 1, got: %d", result);
+  SDLTest_AssertCheck(sites[0].num_allocations >= 3, "Check busiest call site, expected: >= 3 allocations, got: %d", (int) sites[0].num_allocations);
+  for (i = 1; i < SDL_min(result, SDL_arraysize(sites)); ++i) {
+    SDLTest_AssertCheck(sites[i].num_allocations <= sites[i - 1].num_allocations, "Check call sites are sorted by allocation count");
+  }
+
+  for (i = 0; i < SDL_arraysize(mem); ++i) {
+    SDL_free(mem[i]);
+  }
+  SDL_GetAllocationStats(&after);
+  SDLTest_AssertCheck(after.bytes_in_use == before.bytes_in_use, "Check bytes_in_use, expected: %d, got: %d", (int) before.bytes_in_use, (int) after.bytes_in_use);
+  SDLTest_AssertCheck(after.peak_bytes_in_use >= before.bytes_in_use + 400, "Check peak_bytes_in_use grew by at least 400 bytes");
+
+  SDL_MarkAllocationFrame();
+  SDL_GetAllocationStats(&after);
+  SDLTest_AssertPass("Call to SDL_MarkAllocationFrame()");
+  SDLTest_AssertCheck(after.num_frames == 1, "Check num_frames, expected: 1, got: %d", (int) after.num_frames);
+  SDLTest_AssertCheck(after.frame_allocations == 0, "Check frame_allocations, expected: 0, got: %d", (int) after.frame_allocations);
+  SDLTest_AssertCheck(after.last_frame_allocations >= 4, "Check last_frame_allocations, expected: >= 4, got: %d", (int) after.last_frame_allocations);
+
+  SDLTest_BeginSteadyState();
+  SDL_memset(buffer, 0, sizeof(buffer));
+  SDL_strlcpy(buffer, "steady", sizeof(buffer));
+  result = SDLTest_EndSteadyState();
+  SDLTest_AssertPass("Call to SDLTest_EndSteadyState()");
+  SDLTest_AssertCheck(result == 0, "Check steady state allocations, expected: 0, got: %d", result);
+  SDLTest_AssertCheck(SDL_GetAllocationTracking(), "Check tracking is still enabled after a steady state region");
+
+  /* Shrinking to nothing may free the block */
+  SDL_GetAllocationStats(&before);
+  mem[0] = SDL_realloc(SDL_malloc(100), 0);
+  SDL_GetAllocationStats(&after);
+  if (!mem[0]) {
+    SDLTest_AssertCheck(after.bytes_in_use == before.bytes_in_use, "Check bytes_in_use after SDL_realloc(ptr, 0), expected: %d, got: %d", (int) before.bytes_in_use, (int) after.bytes_in_use);
+  }
+  SDL_free(mem[0]);
+
+  result = SDL_SetAllocationTracking(SDL_FALSE);
+  SDLTest_AssertPass("Call to SDL_SetAllocationTracking(SDL_FALSE)");
+  SDLTest_AssertCheck(result == 0, "Check return value, expected: 0, got: %d", result);
+
+  SDLTest_BeginSteadyState();
+  SDLTest_EndSteadyState();
+  SDLTest_AssertCheck(!SDL_GetAllocationTracking(), "Check tracking is disabled again after a steady state region");
+
+  return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Standard C routine test cases */
@@ -305,9 +387,12 @@ static const SDLTest_TestCaseReference stdlibTest3 =
 static const SDLTest_TestCaseReference stdlibTest4 =
         { (SDLTest_TestCaseFp)stdlib_sscanf, "stdlib_sscanf", "Call to SDL_sscanf", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference stdlibTest5 =
+        { (SDLTest_TestCaseFp)stdlib_allocationStats, "stdlib_allocationStats", "Call to SDL_SetAllocationTracking and SDL_GetAllocationStats", TEST_ENABLED };
+
 /* Sequence of Standard C routine test cases */
 static const SDLTest_TestCaseReference *stdlibTests[] =  {
-    &stdlibTest1, &stdlibTest2, &stdlibTest3, &stdlibTest4, NULL
+    &stdlibTest1, &stdlibTest2, &stdlibTest3, &stdlibTest4, &stdlibTest5, NULL
 };
 
 /* Standard C routine test suite (global) */
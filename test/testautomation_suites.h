@@ -28,6 +28,14 @@ extern SDLTest_TestSuiteReference timerTestSuite;
 extern SDLTest_TestSuiteReference videoTestSuite;
 extern SDLTest_TestSuiteReference hintsTestSuite;
 
+/* Benchmark collections */
+extern SDLTest_TestSuiteReference blitBenchmarkSuite;
+extern SDLTest_TestSuiteReference fillRectBenchmarkSuite;
+extern SDLTest_TestSuiteReference audioCVTBenchmarkSuite;
+extern SDLTest_TestSuiteReference audioStreamBenchmarkSuite;
+extern SDLTest_TestSuiteReference eventsBenchmarkSuite;
+extern SDLTest_TestSuiteReference renderBenchmarkSuite;
+
 /* All test suites */
 SDLTest_TestSuiteReference *testSuites[] =  {
     &audioTestSuite,
@@ -51,4 +59,15 @@ SDLTest_TestSuiteReference *testSuites[] =  {
     NULL
 };
 
+/* All benchmark suites, run with --benchmark */
+SDLTest_TestSuiteReference *benchmarkSuites[] =  {
+    &blitBenchmarkSuite,
+    &fillRectBenchmarkSuite,
+    &audioCVTBenchmarkSuite,
+    &audioStreamBenchmarkSuite,
+    &eventsBenchmarkSuite,
+    &renderBenchmarkSuite,
+    NULL
+};
+
 #endif
@@ -1720,6 +1720,115 @@ video_getSetWindowData(void *arg)
   return returnValue;
 }
 
+/* Frame sink state for video_frameSink */
+typedef struct
+{
+    int calls;
+    SDL_Window *window;
+    Uint32 format;
+    const void *pixels;
+    int pitch;
+    int w, h;
+    SDL_Rect rect;
+    int numrects;
+} _frameSinkData;
+
+static void SDLCALL
+_frameSinkCallback(void *userdata, SDL_Window *window, Uint32 format, const void *pixels, int pitch, int w, int h, const SDL_Rect *rects, int numrects)
+{
+    _frameSinkData *data = (_frameSinkData *)userdata;
+
+    data->calls++;
+    data->window = window;
+    data->format = format;
+    data->pixels = pixels;
+    data->pitch = pitch;
+    data->w = w;
+    data->h = h;
+    data->numrects = numrects;
+    if (numrects > 0) {
+        data->rect = rects[0];
+    }
+}
+
+/**
+ * @brief Checks SDL_SetFrameSinkCallback receives window surface updates without copying
+ *
+ * @sa http://wiki.libsdl.org/moin.fcg/SDL_SetFrameSinkCallback
+ */
+int
+video_frameSink(void *arg)
+{
+  _frameSinkData data;
+  SDL_Window *window;
+  SDL_Surface *surface;
+  SDL_Rect rect;
+  const char *title = "video_frameSink Test Window";
+  int result;
+
+  if (SDL_strcmp(SDL_GetCurrentVideoDriver(), "dummy") != 0) {
+     /* Other drivers don't support frame sinks */
+     result = SDL_SetFrameSinkCallback(_frameSinkCallback, &data);
+     SDLTest_AssertPass("Call to SDL_SetFrameSinkCallback()");
+     SDLTest_AssertCheck(result == -1, "Validate result value; expected: -1, got: %d", result);
+     return TEST_SKIPPED;
+  }
+
+  SDL_zero(data);
+  result = SDL_SetFrameSinkCallback(_frameSinkCallback, &data);
+  SDLTest_AssertPass("Call to SDL_SetFrameSinkCallback()");
+  SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0, got: %d", result);
+
+  window = _createVideoSuiteTestWindow(title);
+  if (window == NULL) return TEST_ABORTED;
+
+  surface = SDL_GetWindowSurface(window);
+  SDLTest_AssertPass("Call to SDL_GetWindowSurface()");
+  SDLTest_AssertCheck(surface != NULL, "Validate that surface is not NULL");
+  if (surface == NULL) {
+     _destroyVideoSuiteTestWindow(window);
+     return TEST_ABORTED;
+  }
+
+  /* Full update */
+  result = SDL_UpdateWindowSurface(window);
+  SDLTest_AssertPass("Call to SDL_UpdateWindowSurface()");
+  SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0, got: %d", result);
+  SDLTest_AssertCheck(data.calls == 1, "Validate callback count; expected: 1, got: %d", data.calls);
+  SDLTest_AssertCheck(data.window == window, "Validate callback window");
+  SDLTest_AssertCheck(data.pixels == surface->pixels, "Validate callback received the window surface pixels");
+  SDLTest_AssertCheck(data.format == surface->format->format, "Validate callback format; expected: %s, got: %s",
+     SDL_GetPixelFormatName(surface->format->format), SDL_GetPixelFormatName(data.format));
+  SDLTest_AssertCheck(data.pitch == surface->pitch, "Validate callback pitch; expected: %d, got: %d", surface->pitch, data.pitch);
+  SDLTest_AssertCheck(data.w == surface->w && data.h == surface->h, "Validate callback size; expected: %dx%d, got: %dx%d",
+     surface->w, surface->h, data.w, data.h);
+
+  /* Partial update */
+  rect.x = 1;
+  rect.y = 2;
+  rect.w = 3;
+  rect.h = 4;
+  result = SDL_UpdateWindowSurfaceRects(window, &rect, 1);
+  SDLTest_AssertPass("Call to SDL_UpdateWindowSurfaceRects()");
+  SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0, got: %d", result);
+  SDLTest_AssertCheck(data.calls == 2, "Validate callback count; expected: 2, got: %d", data.calls);
+  SDLTest_AssertCheck(data.numrects == 1, "Validate callback rect count; expected: 1, got: %d", data.numrects);
+  SDLTest_AssertCheck(SDL_RectEquals(&data.rect, &rect), "Validate callback rect; expected: (%d,%d,%d,%d), got: (%d,%d,%d,%d)",
+     rect.x, rect.y, rect.w, rect.h, data.rect.x, data.rect.y, data.rect.w, data.rect.h);
+
+  /* Removing the callback stops updates */
+  result = SDL_SetFrameSinkCallback(NULL, NULL);
+  SDLTest_AssertPass("Call to SDL_SetFrameSinkCallback(NULL)");
+  SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0, got: %d", result);
+  SDL_UpdateWindowSurface(window);
+  SDLTest_AssertCheck(data.calls == 2, "Validate callback count; expected: 2, got: %d", data.calls);
+
+  /* Clean up */
+  _destroyVideoSuiteTestWindow(window);
+
+  return TEST_COMPLETED;
+}
+
 
 /* ================= Test References ================== */
 
@@ -1793,13 +1902,16 @@ static const SDLTest_TestCaseReference videoTest22 =
 static const SDLTest_TestCaseReference videoTest23 =
         { (SDLTest_TestCaseFp)video_getSetWindowData, "video_getSetWindowData",  "Checks SDL_SetWindowData and SDL_GetWindowData positive and negative cases", TEST_ENABLED };
 
+static const SDLTest_TestCaseReference videoTest24 =
+        { (SDLTest_TestCaseFp)video_frameSink, "video_frameSink",  "Checks SDL_SetFrameSinkCallback receives window surface updates", TEST_ENABLED };
+
 /* Sequence of Video test cases */
 static const SDLTest_TestCaseReference *videoTests[] =  {
     &videoTest1, &videoTest2, &videoTest3, &videoTest4, &videoTest5, &videoTest6,
     &videoTest7, &videoTest8, &videoTest9, &videoTest10, &videoTest11, &videoTest12,
     &videoTest13, &videoTest14, &videoTest15, &videoTest16, &videoTest17,
     &videoTest18, &videoTest19, &videoTest20, &videoTest21, &videoTest22,
-    &videoTest23, NULL
+    &videoTest23, &videoTest24, NULL
 };
 
 /* Video test suite (global) */
@@ -0,0 +1,313 @@
+/*
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure how long it takes to load and save BMP files.
+
+   Each case saves a surface with SDL_SaveBMP_RW() to memory, then loads it
+   back with SDL_LoadBMP_RW() from memory and from a file, and checks the
+   loaded pixels match what was saved and that loading read the whole
+   file, padding included:
+     - 24 bpp: an XRGB8888 surface, which is converted as it's saved
+     - 32 bpp: an ARGB8888 surface, saved with its alpha channel
+     - 8 bpp:  a paletted surface
+     - 4 bpp and 1 bpp: files SDL can't save, written by hand here
+ */
+
+#include <stdio.h>
+
+#include "SDL.h"
+
+#define FILENAME "testbmpperf.tmp.bmp"
+
+static int width = 1917;     /* Rows of most depths end in padding */
+static int height = 1080;
+static int iterations = 20;
+
+static Uint8 *buffer;
+static size_t buffer_size;
+
+static SDL_Surface *
+create_surface(Uint32 format)
+{
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 0, format);
+    int x, y;
+
+    if (!surface) {
+        return NULL;
+    }
+    if (surface->format->palette) {
+        SDL_Color colors[256];
+        for (x = 0; x < SDL_arraysize(colors); ++x) {
+            colors[x].r = (Uint8) x;
+            colors[x].g = (Uint8) (x * 3);
+            colors[x].b = (Uint8) (255 - x);
+            colors[x].a = SDL_ALPHA_OPAQUE;
+        }
+        SDL_SetPaletteColors(surface->format->palette, colors, 0, SDL_arraysize(colors));
+    }
+    for (y = 0; y < surface->h; ++y) {
+        Uint8 *row = (Uint8 *) surface->pixels + y * surface->pitch;
+        for (x = 0; x < surface->w * surface->format->BytesPerPixel; ++x) {
+            row[x] = (Uint8) (x * 7 + y * 3);
+        }
+    }
+    return surface;
+}
+
+/* Write a 1 or 4 bpp BMP with a gray palette, which SDL_SaveBMP_RW() can't do */
+static size_t
+write_packed_bmp(int bpp)
+{
+    const int ncolors = 1 << bpp;
+    const int bmp_pitch = ((width * bpp + 31) / 32) * 4;
+    const Uint32 offset = 14 + 40 + ncolors * 4;
+    const Uint32 size = offset + bmp_pitch * height;
+    SDL_RWops *dst = SDL_RWFromMem(buffer, (int) buffer_size);
+    int i, x, y;
+
+    SDL_RWwrite(dst, "BM", 2, 1);
+    SDL_WriteLE32(dst, size);
+    SDL_WriteLE32(dst, 0);
+    SDL_WriteLE32(dst, offset);
+    SDL_WriteLE32(dst, 40);
+    SDL_WriteLE32(dst, width);
+    SDL_WriteLE32(dst, height);
+    SDL_WriteLE16(dst, 1);
+    SDL_WriteLE16(dst, bpp);
+    SDL_WriteLE32(dst, 0);
+    SDL_WriteLE32(dst, bmp_pitch * height);
+    SDL_WriteLE32(dst, 0);
+    SDL_WriteLE32(dst, 0);
+    SDL_WriteLE32(dst, ncolors);
+    SDL_WriteLE32(dst, 0);
+    for (i = 0; i < ncolors; ++i) {
+        const Uint8 gray = (Uint8) (i * 255 / (ncolors - 1));
+        const Uint8 entry[4] = { gray, gray, gray, 0 };
+        SDL_RWwrite(dst, entry, sizeof(entry), 1);
+    }
+    for (y = 0; y < height; ++y) {
+        Uint8 *row = buffer + offset + y * bmp_pitch;
+        SDL_memset(row, 0, bmp_pitch);
+        for (x = 0; x < width; ++x) {
+            const int index = (x + y) % ncolors;
+            row[(x * bpp) / 8] |= index << (8 - bpp - (x * bpp) % 8);
+        }
+    }
+    SDL_RWclose(dst);
+    return size;
+}
+
+static SDL_bool
+check_packed_surface(SDL_Surface *surface, int bpp)
+{
+    const int ncolors = 1 << bpp;
+    int x, y;
+
+    for (y = 0; y < height; ++y) {
+        /* The file is stored bottom up */
+        const Uint8 *row = (const Uint8 *) surface->pixels + (height - 1 - y) * surface->pitch;
+        for (x = 0; x < width; ++x) {
+            if (row[x] != (x + y) % ncolors) {
+                return SDL_FALSE;
+            }
+        }
+    }
+    return SDL_TRUE;
+}
+
+static SDL_bool
+compare_surfaces(SDL_Surface *a, SDL_Surface *b)
+{
+    SDL_Surface *ca = SDL_ConvertSurfaceFormat(a, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_Surface *cb = SDL_ConvertSurfaceFormat(b, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_bool same = (ca && cb && ca->w == cb->w && ca->h == cb->h);
+    int y;
+
+    for (y = 0; same && y < ca->h; ++y) {
+        if (SDL_memcmp((Uint8 *) ca->pixels + y * ca->pitch, (Uint8 *) cb->pixels + y * cb->pitch, ca->w * 4) != 0) {
+            same = SDL_FALSE;
+        }
+    }
+    SDL_FreeSurface(ca);
+    SDL_FreeSurface(cb);
+    return same;
+}
+
+static double
+seconds_since(Uint64 start)
+{
+    return (double) (SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+}
+
+static SDL_bool
+run_test(const char *name, SDL_Surface *surface, int bpp)
+{
+    double save_time = 0.0, load_time, file_time;
+    SDL_Surface *loaded = NULL;
+    SDL_RWops *file;
+    Sint64 load_end = -1, file_end = -1;
+    size_t size = 0;
+    Uint64 start;
+    SDL_bool ok;
+    int i;
+
+    if (surface) {
+        start = SDL_GetPerformanceCounter();
+        for (i = 0; i < iterations; ++i) {
+            SDL_RWops *dst = SDL_RWFromMem(buffer, (int) buffer_size);
+            if (SDL_SaveBMP_RW(surface, dst, 0) < 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't save %s BMP: %s\n", name, SDL_GetError());
+                SDL_RWclose(dst);
+                return SDL_FALSE;
+            }
+            size = (size_t) SDL_RWtell(dst);
+            SDL_RWclose(dst);
+        }
+        save_time = seconds_since(start);
+    } else {
+        size = write_packed_bmp(bpp);
+    }
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; ++i) {
+        SDL_RWops *src = SDL_RWFromConstMem(buffer, (int) size);
+        SDL_FreeSurface(loaded);
+        loaded = SDL_LoadBMP_RW(src, 0);
+        load_end = src ? SDL_RWtell(src) : -1;
+        SDL_RWclose(src);
+        if (!loaded) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load %s BMP: %s\n", name, SDL_GetError());
+            return SDL_FALSE;
+        }
+    }
+    load_time = seconds_since(start);
+
+    file = SDL_RWFromFile(FILENAME, "wb");
+    if (!file || SDL_RWwrite(file, buffer, size, 1) != 1) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't write %s: %s\n", FILENAME, SDL_GetError());
+        if (file) {
+            SDL_RWclose(file);
+        }
+        SDL_FreeSurface(loaded);
+        return SDL_FALSE;
+    }
+    SDL_RWclose(file);
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; ++i) {
+        SDL_RWops *src = SDL_RWFromFile(FILENAME, "rb");
+        SDL_FreeSurface(loaded);
+        loaded = SDL_LoadBMP_RW(src, 0);
+        file_end = src ? SDL_RWtell(src) : -1;
+        if (src) {
+            SDL_RWclose(src);
+        }
+        if (!loaded) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load %s: %s\n", FILENAME, SDL_GetError());
+            return SDL_FALSE;
+        }
+    }
+    file_time = seconds_since(start);
+    remove(FILENAME);
+
+    ok = surface ? compare_surfaces(surface, loaded) : check_packed_surface(loaded, bpp);
+    SDL_FreeSurface(loaded);
+    if (load_end != (Sint64) size || file_end != (Sint64) size) {
+        SDL_Log("%s: loading stopped at %d in memory and %d in a file, of %d bytes\n",
+                name, (int) load_end, (int) file_end, (int) size);
+        ok = SDL_FALSE;
+    }
+
+    if (surface) {
+        SDL_Log("%-7s %8.3f ms save, %8.3f ms load from memory, %8.3f ms load from file%s\n",
+                name, save_time * 1000.0 / iterations, load_time * 1000.0 / iterations,
+                file_time * 1000.0 / iterations, ok ? "" : ", MISMATCH");
+    } else {
+        SDL_Log("%-7s %8s         %8.3f ms load from memory, %8.3f ms load from file%s\n",
+                name, "", load_time * 1000.0 / iterations,
+                file_time * 1000.0 / iterations, ok ? "" : ", MISMATCH");
+    }
+    return ok;
+}
+
+int
+main(int argc, char *argv[])
+{
+    static const struct
+    {
+        const char *name;
+        Uint32 format;
+        int bpp;
+    } tests[] = {
+        { "24 bpp", SDL_PIXELFORMAT_RGB888, 24 },
+        { "32 bpp", SDL_PIXELFORMAT_ARGB8888, 32 },
+        { "8 bpp", SDL_PIXELFORMAT_INDEX8, 8 },
+        { "4 bpp", SDL_PIXELFORMAT_UNKNOWN, 4 },
+        { "1 bpp", SDL_PIXELFORMAT_UNKNOWN, 1 },
+    };
+    int failed = 0;
+    int i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        width = SDL_atoi(argv[1]);
+    }
+    if (argc > 2) {
+        height = SDL_atoi(argv[2]);
+    }
+    if (argc > 3) {
+        iterations = SDL_atoi(argv[3]);
+    }
+    if (width <= 0 || height <= 0 || iterations <= 0) {
+        SDL_Log("USAGE: %s [width] [height] [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    /* Big enough for a 32 bpp image, or an 8 bpp one with its palette */
+    buffer_size = (size_t) width * height * 4 + 2048;
+    buffer = (Uint8 *) SDL_malloc(buffer_size);
+    if (!buffer) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_Log("%dx%d images, %d iterations\n", width, height, iterations);
+    for (i = 0; i < SDL_arraysize(tests); ++i) {
+        SDL_Surface *surface = NULL;
+
+        if (tests[i].format != SDL_PIXELFORMAT_UNKNOWN) {
+            surface = create_surface(tests[i].format);
+            if (!surface) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surface: %s\n", SDL_GetError());
+                ++failed;
+                continue;
+            }
+        }
+        if (!run_test(tests[i].name, surface, tests[i].bpp)) {
+            ++failed;
+        }
+        SDL_FreeSurface(surface);
+    }
+
+    SDL_free(buffer);
+    SDL_Quit();
+    return failed ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,134 @@
+/*
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure what SDL_HINT_EVENT_COALESCING saves with high rate input.
+
+   Each frame gets the input of a 1000 Hz mouse and a controller reporting
+   six gyro and accelerometer axes at 1000 Hz, pushed as synthetic events.
+   The frame then drains the queue with SDL_PollEvent() like a game loop.
+   This is run with coalescing off and on, and reports the events the
+   application handles per frame and the CPU time per frame spent queueing
+   and polling them. The mouse motion the application sees is checked
+   against what was pushed, and with coalescing on, the raw events are read
+   back from SDL_GetEventHistory() and counted.
+ */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define NUM_AXES    6
+
+static int num_frames = 2000;
+static int input_rate = 1000;
+static int frame_rate = 60;
+
+static void
+push_input(int frame)
+{
+    const int samples = input_rate / frame_rate;
+    SDL_Event event;
+    int i, axis;
+
+    for (i = 0; i < samples; ++i) {
+        SDL_zero(event);
+        event.type = SDL_MOUSEMOTION;
+        event.motion.which = 0;
+        event.motion.x = frame * samples + i;
+        event.motion.xrel = 1;
+        event.motion.yrel = (i & 1) ? 1 : -1;
+        SDL_PushEvent(&event);
+
+        for (axis = 0; axis < NUM_AXES; ++axis) {
+            SDL_zero(event);
+            event.type = SDL_JOYAXISMOTION;
+            event.jaxis.which = 0;
+            event.jaxis.axis = (Uint8) axis;
+            event.jaxis.value = (Sint16) ((frame * samples + i) * (axis + 1));
+            SDL_PushEvent(&event);
+        }
+    }
+}
+
+static void
+run_test(const char *coalescing)
+{
+    const double freq = (double) SDL_GetPerformanceFrequency();
+    SDL_Event event;
+    SDL_Event history[256];
+    Uint64 start, elapsed = 0;
+    Sint64 handled = 0, raw = 0;
+    Sint64 total_xrel = 0;
+    int frame, count;
+
+    SDL_SetHint(SDL_HINT_EVENT_COALESCING, coalescing);
+    SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+    for (frame = 0; frame < num_frames; ++frame) {
+        start = SDL_GetPerformanceCounter();
+        push_input(frame);
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_MOUSEMOTION) {
+                total_xrel += event.motion.xrel;
+            }
+            ++handled;
+        }
+        elapsed += SDL_GetPerformanceCounter() - start;
+
+        /* Outside the timing, since most applications won't want this */
+        while ((count = SDL_GetEventHistory(history, SDL_arraysize(history), SDL_FIRSTEVENT, SDL_LASTEVENT)) > 0) {
+            raw += count;
+        }
+    }
+
+    SDL_Log("coalescing %-3s: %7.2f events per frame, %7.2f us per frame, mouse moved %s, %.2f raw events per frame\n",
+            (*coalescing == '1') ? "on" : "off",
+            (double) handled / num_frames,
+            ((double) elapsed * 1000000.0) / freq / num_frames,
+            (total_xrel == (Sint64) num_frames * (input_rate / frame_rate)) ? "correctly" : "INCORRECTLY",
+            (double) raw / num_frames);
+}
+
+int
+main(int argc, char *argv[])
+{
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        num_frames = SDL_atoi(argv[1]);
+    }
+    if (argc > 2) {
+        input_rate = SDL_atoi(argv[2]);
+    }
+    if (argc > 3) {
+        frame_rate = SDL_atoi(argv[3]);
+    }
+    if (num_frames <= 0 || frame_rate <= 0 || input_rate < frame_rate) {
+        SDL_Log("USAGE: %s [frames] [input rate in Hz] [frame rate in Hz]\n", argv[0]);
+        return 1;
+    }
+
+    if (SDL_Init(SDL_INIT_EVENTS) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%d frames at %d Hz, mouse and %d controller axes at %d Hz\n", num_frames, frame_rate, NUM_AXES, input_rate);
+    run_test("0");
+    run_test("1");
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,402 @@
+/*
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Exercise the HIDAPI joystick hotplug handling and input reader without
+   any hardware.
+
+   The joystick subsystem is given a fake backend with a keyboard and two
+   PS4 controllers that are plugged in and out, and the test checks that
+   each notification only enumerates the devices it is about.
+
+   Then one controller replays 1000 reports a second to the reader thread
+   while the main thread updates at about 120 Hz. Both sticks always move
+   together, so a state torn between two reports shows up as sticks that
+   disagree, and every press and release of the A button has to come
+   through even though most reports are never seen. The Y button is also
+   tapped for two reports at a time, so most taps start and end between
+   two updates, and each one still has to send a press and a release.
+
+   This uses SDL internals, so it's only built with HIDAPI against the
+   static library.
+ */
+
+/* The internal header comes first, so this calls into SDL the way SDL does */
+#include "../src/SDL_internal.h"
+
+#include "SDL.h"
+#include "../src/joystick/hidapi/SDL_hidapijoystick_c.h"
+
+typedef struct
+{
+    const char *path;
+    Uint16 vendor_id;
+    Uint16 product_id;
+    SDL_bool present;
+} FakeDevice;
+
+enum
+{
+    FAKE_KEYBOARD,
+    FAKE_PS4,
+    FAKE_PS4_SLIM
+};
+
+static FakeDevice fake_devices[] = {
+    { "fake-keyboard", 0x046d, 0xc31c, SDL_FALSE },
+    { "fake-ps4", 0x054c, 0x05c4, SDL_FALSE },
+    { "fake-ps4-slim", 0x054c, 0x09cc, SDL_FALSE },
+};
+
+#define NUM_REPORTS         2000
+#define REPORTS_PER_SECOND  1000
+#define REPORT_LENGTH       64
+#define BUTTON_PERIOD       100     /* Reports between presses and releases of A */
+#define TAP_OFFSET          50      /* Y is held for two reports this far into each period */
+
+/* Where the PS4 driver finds things in a USB state report */
+#define REPORT_LEFT_X       1
+#define REPORT_LEFT_Y       2
+#define REPORT_RIGHT_X      3
+#define REPORT_RIGHT_Y      4
+#define REPORT_BUTTONS      5
+#define REPORT_BATTERY      30
+
+struct hid_device_
+{
+    const FakeDevice *device;
+    Uint64 start;
+    int next_report;
+};
+
+static int enumerations;
+static Uint16 enumerated_vendor_id;
+static Uint16 enumerated_product_id;
+static int failures;
+
+static struct hid_device_info *
+fake_enumerate(unsigned short vendor_id, unsigned short product_id)
+{
+    struct hid_device_info *devs = NULL;
+    int i;
+
+    ++enumerations;
+    enumerated_vendor_id = vendor_id;
+    enumerated_product_id = product_id;
+
+    for (i = SDL_arraysize(fake_devices) - 1; i >= 0; --i) {
+        const FakeDevice *device = &fake_devices[i];
+        struct hid_device_info *info;
+
+        if (!device->present) {
+            continue;
+        }
+        if ((vendor_id || product_id) &&
+            (device->vendor_id != vendor_id || device->product_id != product_id)) {
+            continue;
+        }
+
+        info = (struct hid_device_info *)SDL_calloc(1, sizeof(*info));
+        if (!info) {
+            break;
+        }
+        info->path = SDL_strdup(device->path);
+        info->vendor_id = device->vendor_id;
+        info->product_id = device->product_id;
+        info->interface_number = -1;
+        info->next = devs;
+        devs = info;
+    }
+    return devs;
+}
+
+static void
+fake_free_enumeration(struct hid_device_info *devs)
+{
+    while (devs) {
+        struct hid_device_info *next = devs->next;
+        SDL_free(devs->path);
+        SDL_free(devs);
+        devs = next;
+    }
+}
+
+static hid_device *
+fake_open_path(const char *path, int bExclusive)
+{
+    hid_device *dev;
+    int i;
+
+    for (i = 0; i < SDL_arraysize(fake_devices); ++i) {
+        if (fake_devices[i].present && SDL_strcmp(fake_devices[i].path, path) == 0) {
+            break;
+        }
+    }
+    if (i == SDL_arraysize(fake_devices)) {
+        return NULL;
+    }
+
+    dev = (hid_device *)SDL_calloc(1, sizeof(*dev));
+    if (!dev) {
+        return NULL;
+    }
+    dev->device = &fake_devices[i];
+    dev->start = SDL_GetPerformanceCounter();
+    return dev;
+}
+
+static int
+fake_write(hid_device *dev, const unsigned char *data, size_t length)
+{
+    return (int)length;
+}
+
+static void
+make_report(int i, unsigned char *report)
+{
+    SDL_memset(report, 0, REPORT_LENGTH);
+    report[0] = 1;  /* USB state */
+    report[REPORT_LEFT_X] = report[REPORT_RIGHT_X] = (unsigned char)(i * 7);
+    report[REPORT_LEFT_Y] = report[REPORT_RIGHT_Y] = (unsigned char)(i * 3);
+    report[REPORT_BUTTONS] = 0x08;  /* D-pad centered */
+    if ((i / BUTTON_PERIOD) & 1) {
+        report[REPORT_BUTTONS] |= 0x20;  /* A */
+    }
+    if (i % BUTTON_PERIOD == TAP_OFFSET || i % BUTTON_PERIOD == TAP_OFFSET + 1) {
+        report[REPORT_BUTTONS] |= 0x80;  /* Y */
+    }
+    report[REPORT_BATTERY] = 0x10;  /* Wired */
+}
+
+/* Hand out the reports at the rate a controller would send them */
+static int
+fake_read_timeout(hid_device *dev, unsigned char *data, size_t length, int milliseconds)
+{
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 due, now;
+
+    if (dev->next_report == NUM_REPORTS || length < REPORT_LENGTH) {
+        SDL_Delay(milliseconds);
+        return 0;
+    }
+
+    due = dev->start + dev->next_report * frequency / REPORTS_PER_SECOND;
+    now = SDL_GetPerformanceCounter();
+    if (now < due) {
+        const int wait = (int)((due - now) * 1000 / frequency);
+        if (wait >= milliseconds) {
+            SDL_Delay(milliseconds);
+            return 0;
+        }
+        SDL_Delay(wait);
+    }
+
+    make_report(dev->next_report++, data);
+    return REPORT_LENGTH;
+}
+
+static int
+fake_get_feature_report(hid_device *dev, unsigned char *data, size_t length)
+{
+    size_t i;
+
+    /* Anything but zeroes for the serial number means the controller is on USB */
+    for (i = 1; i < length; ++i) {
+        data[i] = (unsigned char)i;
+    }
+    return (int)length;
+}
+
+static void
+fake_close(hid_device *dev)
+{
+    SDL_free(dev);
+}
+
+static const SDL_HIDAPI_Backend fake_backend = {
+    fake_enumerate,
+    fake_free_enumeration,
+    fake_open_path,
+    fake_write,
+    fake_read_timeout,
+    fake_get_feature_report,
+    fake_close
+};
+
+static void
+check(SDL_bool condition, const char *what)
+{
+    if (!condition) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "FAILED: %s\n", what);
+        ++failures;
+    }
+}
+
+/* Let the joystick subsystem pick up whatever changed, and return how many enumerations that took */
+static int
+update(void)
+{
+    enumerations = 0;
+    SDL_JoystickUpdate();
+    return enumerations;
+}
+
+static void
+test_hotplug(void)
+{
+    const int base = SDL_NumJoysticks();
+    int i;
+
+    check(update() == 0, "nothing is enumerated while nothing changes");
+
+    fake_devices[FAKE_KEYBOARD].present = SDL_TRUE;
+    HIDAPI_DeviceAdded(fake_devices[FAKE_KEYBOARD].vendor_id, fake_devices[FAKE_KEYBOARD].product_id);
+    check(update() == 0, "a keyboard isn't enumerated");
+
+    fake_devices[FAKE_PS4].present = SDL_TRUE;
+    HIDAPI_DeviceAdded(fake_devices[FAKE_PS4].vendor_id, fake_devices[FAKE_PS4].product_id);
+    check(update() == 1, "an added controller is enumerated once");
+    check(enumerated_vendor_id == fake_devices[FAKE_PS4].vendor_id &&
+          enumerated_product_id == fake_devices[FAKE_PS4].product_id,
+          "only the added controller is enumerated");
+    check(SDL_NumJoysticks() == base + 1, "the added controller is a joystick");
+
+    fake_devices[FAKE_PS4_SLIM].present = SDL_TRUE;
+    HIDAPI_DeviceAdded(fake_devices[FAKE_PS4_SLIM].vendor_id, fake_devices[FAKE_PS4_SLIM].product_id);
+    check(update() == 1, "a second controller is enumerated once");
+    check(SDL_NumJoysticks() == base + 2, "the second controller is a joystick");
+
+    /* Removals don't say what went away, so each kind of joystick is checked */
+    fake_devices[FAKE_PS4_SLIM].present = SDL_FALSE;
+    HIDAPI_DeviceRemoved(0, 0);
+    check(update() == 2, "a removal enumerates each kind of joystick");
+    check(SDL_NumJoysticks() == base + 1, "the removed controller is gone");
+
+    /* More changes than are remembered fall back to enumerating everything */
+    for (i = 1; i <= 17; ++i) {
+        HIDAPI_DeviceAdded(0x1234, (Uint16)i);
+    }
+    check(update() == 1, "too many changes are one enumeration");
+    check(enumerated_vendor_id == 0 && enumerated_product_id == 0, "too many changes enumerate everything");
+    check(SDL_NumJoysticks() == base + 1, "a full enumeration keeps the controller");
+
+    enumerations = 0;
+    SDL_SetHint(SDL_HINT_JOYSTICK_HIDAPI_PS4, "0");
+    check(SDL_NumJoysticks() == base, "disabling the driver removes the controller");
+    SDL_SetHint(SDL_HINT_JOYSTICK_HIDAPI_PS4, "1");
+    check(SDL_NumJoysticks() == base + 1, "enabling the driver adds the controller back");
+    check(enumerations == 2, "each driver change enumerates once");
+}
+
+static void
+test_replay(void)
+{
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    unsigned char last_report[REPORT_LENGTH];
+    SDL_Joystick *joystick = NULL;
+    Uint64 update_time = 0;
+    Uint32 start;
+    Uint8 pressed = SDL_RELEASED;
+    int transitions = 0;
+    int taps_down = 0;
+    int taps_up = 0;
+    int torn = 0;
+    int frames = 0;
+    int i;
+
+    for (i = 0; i < SDL_NumJoysticks(); ++i) {
+        if (SDL_JoystickGetDeviceGUID(i).data[14] == 'h') {
+            joystick = SDL_JoystickOpen(i);
+            break;
+        }
+    }
+    check(joystick != NULL, "the controller opens");
+    if (!joystick) {
+        return;
+    }
+
+    /* Run a little past the end of the reports to see the last one come through */
+    start = SDL_GetTicks();
+    while (!SDL_TICKS_PASSED(SDL_GetTicks(), start + NUM_REPORTS * 1000 / REPORTS_PER_SECOND + 250)) {
+        const Uint64 before = SDL_GetPerformanceCounter();
+        SDL_Event event;
+        Uint8 button;
+
+        SDL_JoystickUpdate();
+        update_time += SDL_GetPerformanceCounter() - before;
+        ++frames;
+
+        if (SDL_JoystickGetAxis(joystick, SDL_CONTROLLER_AXIS_LEFTX) != SDL_JoystickGetAxis(joystick, SDL_CONTROLLER_AXIS_RIGHTX) ||
+            SDL_JoystickGetAxis(joystick, SDL_CONTROLLER_AXIS_LEFTY) != SDL_JoystickGetAxis(joystick, SDL_CONTROLLER_AXIS_RIGHTY)) {
+            ++torn;
+        }
+        button = SDL_JoystickGetButton(joystick, SDL_CONTROLLER_BUTTON_A);
+        if (button != pressed) {
+            pressed = button;
+            ++transitions;
+        }
+        while (SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_JOYBUTTONDOWN, SDL_JOYBUTTONUP) > 0) {
+            if (event.jbutton.button == SDL_CONTROLLER_BUTTON_Y) {
+                if (event.type == SDL_JOYBUTTONDOWN) {
+                    ++taps_down;
+                } else {
+                    ++taps_up;
+                }
+            }
+        }
+        SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+        SDL_Delay(8);
+    }
+
+    make_report(NUM_REPORTS - 1, last_report);
+    SDL_Log("%d frames, %d torn, %d button changes, %d taps, %.1f us per update\n",
+            frames, torn, transitions, taps_down, (double)update_time * 1000000.0 / frequency / frames);
+
+    check(torn == 0, "the sticks never disagree");
+    check(transitions == (NUM_REPORTS - 1) / BUTTON_PERIOD, "every press and release comes through");
+    check(taps_down == NUM_REPORTS / BUTTON_PERIOD && taps_up == NUM_REPORTS / BUTTON_PERIOD,
+          "every tap between two updates comes through");
+    check(SDL_JoystickGetAxis(joystick, SDL_CONTROLLER_AXIS_LEFTX) == (int)last_report[REPORT_LEFT_X] * 257 - 32768,
+          "the last report comes through");
+
+    SDL_JoystickClose(joystick);
+}
+
+int
+main(int argc, char *argv[])
+{
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    HIDAPI_SetBackend(&fake_backend);
+
+    if (SDL_Init(SDL_INIT_JOYSTICK) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+    check(enumerations == 1, "initialization enumerates once");
+    check(enumerated_vendor_id == 0 && enumerated_product_id == 0, "initialization enumerates everything");
+
+    test_hotplug();
+    test_replay();
+
+    SDL_Quit();
+    HIDAPI_SetBackend(NULL);
+
+    if (failures) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d checks failed\n", failures);
+        return 1;
+    }
+    SDL_Log("All checks passed\n");
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,199 @@
+/*
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure how long evdev input takes to become an SDL event.
+
+   A FIFO stands in for a keyboard: it is listed in SDL_HINT_EVDEV_DEVICES
+   and read by the "evdev" flavour of the dummy video driver. The main loop
+   runs like a game at a fixed frame rate, pumping events at the start of
+   each frame, and a key press is written to the FIFO halfway through the
+   frame. An event watch notes when the key event is pushed. This is run
+   with SDL_HINT_INPUT_THREAD off, where input is read at the next pump, and
+   on, where the input thread reads it right away but keyboard events are
+   still pushed at the next pump, and reports:
+     - latency: time from the write to the event being pushed
+     - timestamp error: event timestamp minus the time of the write, which
+       should be 0 when events are stamped with the kernel's time
+ */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#ifdef __LINUX__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <linux/input.h>
+
+static int num_frames = 120;
+static int frame_ms = 16;
+
+static int fifo_fd = -1;
+static Uint64 write_time;
+static Uint32 write_ticks;
+
+static int events_seen;
+static Uint64 total_latency;
+static Uint64 worst_latency;
+static Sint64 total_error;
+
+static int SDLCALL
+event_watch(void *userdata, SDL_Event *event)
+{
+    if (event->type == SDL_KEYDOWN || event->type == SDL_KEYUP) {
+        const Uint64 latency = SDL_GetPerformanceCounter() - write_time;
+
+        total_latency += latency;
+        if (latency > worst_latency) {
+            worst_latency = latency;
+        }
+        total_error += (Sint32) (event->key.timestamp - write_ticks);
+        ++events_seen;
+    }
+    return 1;
+}
+
+static void
+write_key(int pressed)
+{
+    struct input_event events[2];
+    struct timeval now;
+
+    gettimeofday(&now, NULL);
+    SDL_zero(events);
+    events[0].time = now;
+    events[0].type = EV_KEY;
+    events[0].code = KEY_A;
+    events[0].value = pressed;
+    events[1].time = now;
+    events[1].type = EV_SYN;
+    events[1].code = SYN_REPORT;
+
+    write_ticks = SDL_GetTicks();
+    write_time = SDL_GetPerformanceCounter();
+    if (write(fifo_fd, events, sizeof(events)) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "write() failed: %s\n", strerror(errno));
+    }
+}
+
+static void
+run_test(const char *path, const char *threaded)
+{
+    const double freq = (double) SDL_GetPerformanceFrequency();
+    SDL_Event event;
+    int frame;
+
+    /* SDL_Quit() clears hints, so they're set for every run */
+    SDL_SetHint(SDL_HINT_EVDEV_DEVICES, path);
+    SDL_SetHint(SDL_HINT_INPUT_THREAD, threaded);
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize the evdev video driver: %s\n", SDL_GetError());
+        return;
+    }
+
+    /* Throw away anything left over from the last run */
+    while (SDL_PollEvent(&event)) {
+        continue;
+    }
+
+    events_seen = 0;
+    total_latency = 0;
+    worst_latency = 0;
+    total_error = 0;
+    SDL_AddEventWatch(event_watch, NULL);
+
+    for (frame = 0; frame < num_frames; ++frame) {
+        while (SDL_PollEvent(&event)) {
+            continue;
+        }
+        SDL_Delay(frame_ms / 2);
+        write_key(!(frame & 1));
+        SDL_Delay(frame_ms - frame_ms / 2);
+    }
+    while (SDL_PollEvent(&event)) {
+        continue;
+    }
+
+    SDL_DelEventWatch(event_watch, NULL);
+    SDL_Quit();
+
+    if (events_seen == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "No key events were seen\n");
+        return;
+    }
+    SDL_Log("input thread %-3s: %d/%d keys, latency %6.2f ms average, %6.2f ms worst, timestamp error %+.2f ms\n",
+            (*threaded == '1') ? "on" : "off", events_seen, num_frames,
+            ((double) total_latency * 1000.0) / freq / events_seen,
+            ((double) worst_latency * 1000.0) / freq,
+            (double) total_error / events_seen);
+}
+
+int
+main(int argc, char *argv[])
+{
+    char path[64];
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        num_frames = SDL_atoi(argv[1]);
+    }
+    if (argc > 2) {
+        frame_ms = SDL_atoi(argv[2]);
+    }
+    if (num_frames <= 0 || frame_ms <= 0) {
+        SDL_Log("USAGE: %s [frames] [frame time in ms]\n", argv[0]);
+        return 1;
+    }
+
+    SDL_snprintf(path, sizeof(path), "/tmp/testinputlatency-%d", (int) getpid());
+    if (mkfifo(path, 0600) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "mkfifo() failed: %s\n", strerror(errno));
+        return 1;
+    }
+
+    /* Opening it read-write keeps a writer around, so SDL never sees a hangup */
+    fifo_fd = open(path, O_RDWR | O_NONBLOCK);
+    if (fifo_fd < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open %s: %s\n", path, strerror(errno));
+        unlink(path);
+        return 1;
+    }
+
+    SDL_setenv("SDL_VIDEODRIVER", "evdev", 1);
+    SDL_Log("%d frames of %d ms, a key written halfway through each\n", num_frames, frame_ms);
+    run_test(path, "0");
+    run_test(path, "1");
+
+    close(fifo_fd);
+    unlink(path);
+    return 0;
+}
+
+#else
+
+int
+main(int argc, char *argv[])
+{
+    SDL_Log("This test requires evdev, which is only available on Linux\n");
+    return 1;
+}
+
+#endif /* __LINUX__ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,215 @@
+/*
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Compare the two ways the Linux input backends can poll their devices.
+
+   Each "device" is a pipe that gets input_event sized records written to
+   it, a few devices at a time, the way a mouse or gamepad in use would.
+   Every frame is polled either:
+     - read: one non-blocking read() of every device until it's drained,
+       which is what the joystick and evdev backends used to do
+     - epoll: one epoll_wait() on a set holding every device, then reads
+       of only the devices it reports, which is what they do now
+   and the system calls and time per frame are reported for each.
+ */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#ifdef __LINUX__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+/* The size of a struct input_event on 64-bit Linux */
+#define EVENT_SIZE  24
+
+static int num_devices = 32;
+static int num_active = 2;
+static int num_frames = 20000;
+
+static int *read_fds;
+static int *write_fds;
+static int epoll_fd = -1;
+static Uint64 syscalls;
+
+static void
+drain(int fd)
+{
+    char events[EVENT_SIZE * 32];
+
+    for ( ; ; ) {
+        ++syscalls;
+        if (read(fd, events, sizeof(events)) <= 0) {
+            break;
+        }
+    }
+}
+
+static void
+poll_read(void)
+{
+    int i;
+
+    for (i = 0; i < num_devices; ++i) {
+        drain(read_fds[i]);
+    }
+}
+
+static void
+poll_epoll(void)
+{
+    struct epoll_event events[64];
+    int count, i;
+
+    ++syscalls;
+    count = epoll_wait(epoll_fd, events, SDL_arraysize(events), 0);
+    for (i = 0; i < count; ++i) {
+        drain(events[i].data.fd);
+    }
+}
+
+/* Input arrives on a few devices each frame, the rest stay idle */
+static void
+generate_input(int frame)
+{
+    char event[EVENT_SIZE];
+    int i;
+
+    SDL_memset(event, frame & 0xFF, sizeof(event));
+    for (i = 0; i < num_active; ++i) {
+        if (write(write_fds[(frame + i) % num_devices], event, sizeof(event)) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "write() failed: %s\n", strerror(errno));
+        }
+    }
+}
+
+static void
+run_test(const char *name, void (*poll_devices)(void))
+{
+    Uint64 start, elapsed = 0;
+    int frame;
+
+    syscalls = 0;
+    for (frame = 0; frame < num_frames; ++frame) {
+        generate_input(frame);
+        start = SDL_GetPerformanceCounter();
+        poll_devices();
+        elapsed += SDL_GetPerformanceCounter() - start;
+    }
+
+    SDL_Log("%-5s: %6.2f system calls per frame, %8.2f us per frame\n", name,
+            (double) syscalls / num_frames,
+            ((double) elapsed * 1000000.0) / SDL_GetPerformanceFrequency() / num_frames);
+}
+
+static int
+create_devices(void)
+{
+    struct epoll_event event;
+    int i;
+
+    read_fds = (int *) SDL_malloc(num_devices * sizeof(*read_fds));
+    write_fds = (int *) SDL_malloc(num_devices * sizeof(*write_fds));
+    if (!read_fds || !write_fds) {
+        return SDL_OutOfMemory();
+    }
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0) {
+        return SDL_SetError("epoll_create1() failed: %s", strerror(errno));
+    }
+
+    for (i = 0; i < num_devices; ++i) {
+        int fds[2];
+
+        if (pipe(fds) < 0) {
+            return SDL_SetError("pipe() failed: %s", strerror(errno));
+        }
+        fcntl(fds[0], F_SETFL, O_NONBLOCK);
+        read_fds[i] = fds[0];
+        write_fds[i] = fds[1];
+
+        SDL_zero(event);
+        event.events = EPOLLIN;
+        event.data.fd = fds[0];
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fds[0], &event) < 0) {
+            return SDL_SetError("epoll_ctl() failed: %s", strerror(errno));
+        }
+    }
+    return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+    int i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        num_devices = SDL_atoi(argv[1]);
+    }
+    if (argc > 2) {
+        num_active = SDL_atoi(argv[2]);
+    }
+    if (argc > 3) {
+        num_frames = SDL_atoi(argv[3]);
+    }
+    if (num_devices <= 0 || num_active < 0 || num_active > num_devices || num_frames <= 0) {
+        SDL_Log("USAGE: %s [devices] [active devices] [frames]\n", argv[0]);
+        return 1;
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    if (create_devices() < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create devices: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%d devices, %d with input each frame, %d frames\n", num_devices, num_active, num_frames);
+    run_test("read", poll_read);
+    run_test("epoll", poll_epoll);
+
+    for (i = 0; i < num_devices; ++i) {
+        close(read_fds[i]);
+        close(write_fds[i]);
+    }
+    close(epoll_fd);
+    SDL_free(read_fds);
+    SDL_free(write_fds);
+
+    SDL_Quit();
+    return 0;
+}
+
+#else
+
+int
+main(int argc, char *argv[])
+{
+    SDL_Log("This test requires epoll, which is only available on Linux\n");
+    return 1;
+}
+
+#endif /* __LINUX__ */
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,268 @@
+/*
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+*/
+
+/* Stress test the job system under contention, then measure how
+   SDL_ParallelFor() and large SDL_ConvertPixels() calls scale with the
+   number of worker threads.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define NUM_SUBMITTERS  4
+#define NUM_JOBS        20000
+#define NUM_CHILDREN    16
+#define CHAIN_LENGTH    1000
+
+static SDL_atomic_t jobs_run;
+
+static void SDLCALL
+count_job(void *data)
+{
+    SDL_AtomicIncRef(&jobs_run);
+}
+
+/* Submits jobs against its own counter while the other submitters do the same */
+static int SDLCALL
+submitter_thread(void *data)
+{
+    SDL_JobCounter *counter = SDL_CreateJobCounter();
+    int i;
+
+    if (!counter) {
+        return -1;
+    }
+    for (i = 0; i < NUM_JOBS; ++i) {
+        if (SDL_RunJob(count_job, NULL, counter) < 0) {
+            break;
+        }
+    }
+    SDL_WaitJobCounter(counter);
+    SDL_DestroyJobCounter(counter);
+    return (i == NUM_JOBS) ? 0 : -1;
+}
+
+/* Spawns children from inside a job and waits for them there */
+static void SDLCALL
+parent_job(void *data)
+{
+    SDL_JobCounter *counter = SDL_CreateJobCounter();
+    int i;
+
+    for (i = 0; i < NUM_CHILDREN; ++i) {
+        SDL_RunJob(count_job, NULL, counter);
+    }
+    SDL_WaitJobCounter(counter);
+    SDL_DestroyJobCounter(counter);
+    SDL_AtomicIncRef(&jobs_run);
+}
+
+/* Each link checks that the previous one already ran */
+static int chain_position;
+
+static void SDLCALL
+chain_job(void *data)
+{
+    const int position = (int) (intptr_t) data;
+    if (chain_position == position) {
+        ++chain_position;
+    }
+}
+
+static void SDLCALL
+sum_range(void *data, int start, int end)
+{
+    SDL_atomic_t *sum = (SDL_atomic_t *) data;
+    int i, local = 0;
+
+    for (i = start; i < end; ++i) {
+        local += i & 0xFF;
+    }
+    SDL_AtomicAdd(sum, local);
+}
+
+static int
+run_stress(void)
+{
+    SDL_Thread *threads[NUM_SUBMITTERS];
+    SDL_JobCounter *counter, *links[CHAIN_LENGTH];
+    SDL_atomic_t sum;
+    int i, expected, failures = 0;
+
+    /* Several threads submitting at once */
+    SDL_AtomicSet(&jobs_run, 0);
+    for (i = 0; i < NUM_SUBMITTERS; ++i) {
+        threads[i] = SDL_CreateThread(submitter_thread, "Submitter", NULL);
+    }
+    for (i = 0; i < NUM_SUBMITTERS; ++i) {
+        int status = -1;
+        SDL_WaitThread(threads[i], &status);
+        if (status != 0) {
+            ++failures;
+        }
+    }
+    expected = NUM_SUBMITTERS * NUM_JOBS;
+    SDL_Log("Concurrent submit: %d of %d jobs ran\n", SDL_AtomicGet(&jobs_run), expected);
+    failures += (SDL_AtomicGet(&jobs_run) != expected);
+
+    /* Jobs waiting on jobs */
+    SDL_AtomicSet(&jobs_run, 0);
+    counter = SDL_CreateJobCounter();
+    for (i = 0; i < NUM_JOBS / NUM_CHILDREN; ++i) {
+        SDL_RunJob(parent_job, NULL, counter);
+    }
+    SDL_WaitJobCounter(counter);
+    expected = (NUM_JOBS / NUM_CHILDREN) * (NUM_CHILDREN + 1);
+    SDL_Log("Nested waits: %d of %d jobs ran\n", SDL_AtomicGet(&jobs_run), expected);
+    failures += (SDL_AtomicGet(&jobs_run) != expected);
+
+    /* A chain of dependencies, submitted all at once */
+    chain_position = 0;
+    for (i = 0; i < CHAIN_LENGTH; ++i) {
+        links[i] = SDL_CreateJobCounter();
+        SDL_RunJobAfter(chain_job, (void *) (intptr_t) i, links[i], i ? links[i - 1] : NULL);
+    }
+    SDL_WaitJobCounter(links[CHAIN_LENGTH - 1]);
+    SDL_Log("Dependency chain: %d of %d links ran in order\n", chain_position, CHAIN_LENGTH);
+    failures += (chain_position != CHAIN_LENGTH);
+    for (i = 0; i < CHAIN_LENGTH; ++i) {
+        SDL_WaitJobCounter(links[i]);
+        SDL_DestroyJobCounter(links[i]);
+    }
+
+    /* Parallel for covers every index exactly once */
+    SDL_AtomicSet(&sum, 0);
+    SDL_ParallelFor(0, 1000000, 0, sum_range, &sum);
+    expected = 0;
+    for (i = 0; i < 1000000; ++i) {
+        expected += i & 0xFF;
+    }
+    SDL_Log("Parallel for: sum %d, expected %d\n", SDL_AtomicGet(&sum), expected);
+    failures += (SDL_AtomicGet(&sum) != expected);
+
+    SDL_DestroyJobCounter(counter);
+    return failures;
+}
+
+/* Enough arithmetic per row that the work, not the memory bus, dominates */
+static float *rows;
+
+static void SDLCALL
+compute_rows(void *data, int start, int end)
+{
+    const int width = *(const int *) data;
+    int y, x, i;
+
+    for (y = start; y < end; ++y) {
+        float *row = &rows[y * width];
+        for (x = 0; x < width; ++x) {
+            float v = (float) (x + y);
+            for (i = 0; i < 32; ++i) {
+                v = v * 0.999f + 0.5f;
+            }
+            row[x] = v;
+        }
+    }
+}
+
+static double
+elapsed_ms(Uint64 start)
+{
+    return ((double)(SDL_GetPerformanceCounter() - start) * 1000.0) / SDL_GetPerformanceFrequency();
+}
+
+static void
+run_benchmark(int max_threads)
+{
+    const int width = 2048, height = 1024;
+    const int image_w = 3840, image_h = 2160;
+    Uint32 *argb = (Uint32 *) SDL_calloc(image_w * image_h, sizeof(Uint32));
+    Uint16 *rgb565 = (Uint16 *) SDL_calloc(image_w * image_h, sizeof(Uint16));
+    double serial_ms, ms;
+    Uint64 start;
+    int threads;
+
+    rows = (float *) SDL_malloc(width * height * sizeof(float));
+    if (!rows || !argb || !rgb565) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        return;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    compute_rows((void *) &width, 0, height);
+    serial_ms = elapsed_ms(start);
+    SDL_Log("Compute %dx%d, serial:      %8.2f ms\n", width, height, serial_ms);
+
+    for (threads = 1; threads <= max_threads; threads *= 2) {
+        char value[16];
+
+        SDL_snprintf(value, sizeof(value), "%d", threads);
+        SDL_SetHint(SDL_HINT_JOB_THREADS, value);
+        SDL_Init(0);
+
+        SDL_ParallelFor(0, height, 0, compute_rows, (void *) &width);  /* warm up */
+        start = SDL_GetPerformanceCounter();
+        SDL_ParallelFor(0, height, 0, compute_rows, (void *) &width);
+        ms = elapsed_ms(start);
+        SDL_Log("Compute %dx%d, %2d workers: %8.2f ms (%.2fx)\n", width, height, SDL_GetJobWorkerCount(), ms, serial_ms / ms);
+
+        SDL_SetHint(SDL_HINT_JOB_BULK_OPERATIONS, "0");
+        start = SDL_GetPerformanceCounter();
+        SDL_ConvertPixels(image_w, image_h, SDL_PIXELFORMAT_ARGB8888, argb, image_w * 4, SDL_PIXELFORMAT_RGB565, rgb565, image_w * 2);
+        ms = elapsed_ms(start);
+        SDL_SetHint(SDL_HINT_JOB_BULK_OPERATIONS, "1");
+        start = SDL_GetPerformanceCounter();
+        SDL_ConvertPixels(image_w, image_h, SDL_PIXELFORMAT_ARGB8888, argb, image_w * 4, SDL_PIXELFORMAT_RGB565, rgb565, image_w * 2);
+        SDL_Log("ConvertPixels %dx%d, %2d workers: %8.2f ms serial, %8.2f ms parallel\n", image_w, image_h, SDL_GetJobWorkerCount(), ms, elapsed_ms(start));
+
+        /* Shuts down the workers, so the next pass can use a different count */
+        SDL_Quit();
+    }
+
+    SDL_free(rows);
+    SDL_free(argb);
+    SDL_free(rgb565);
+}
+
+int
+main(int argc, char *argv[])
+{
+    int failures, max_threads = SDL_GetCPUCount() * 2;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        max_threads = SDL_atoi(argv[1]);
+        if (max_threads <= 0) {
+            SDL_Log("USAGE: %s [max_threads]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Log("Stress testing with %d workers\n", SDL_GetJobWorkerCount());
+    failures = run_stress();
+    SDL_Quit();
+
+    run_benchmark(max_threads);
+
+    SDL_Log("%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
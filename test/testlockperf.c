@@ -0,0 +1,160 @@
+/*
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure SDL_mutex, SDL_sem and SDL_cond under contention.
+   Build SDL with and without futexes (-DFUTEX=ON or --enable-futex)
+   and compare the results.
+ */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+static int num_threads = 4;
+static int iterations = 200000;
+
+static SDL_mutex *mutex;
+static SDL_cond *cond;
+static SDL_sem *sem;
+static SDL_SpinLock spinlock;
+static int shared_counter;
+static int turn;
+
+static int SDLCALL
+mutex_thread(void *data)
+{
+    int i;
+    for (i = 0; i < iterations; ++i) {
+        SDL_LockMutex(mutex);
+        ++shared_counter;
+        SDL_UnlockMutex(mutex);
+    }
+    return 0;
+}
+
+static int SDLCALL
+spinlock_thread(void *data)
+{
+    int i;
+    for (i = 0; i < iterations; ++i) {
+        SDL_AtomicLock(&spinlock);
+        ++shared_counter;
+        SDL_AtomicUnlock(&spinlock);
+    }
+    return 0;
+}
+
+/* Half the threads post, half wait */
+static int SDLCALL
+sem_thread(void *data)
+{
+    const int poster = (int) (intptr_t) data & 1;
+    int i;
+    for (i = 0; i < iterations; ++i) {
+        if (poster) {
+            SDL_SemPost(sem);
+        } else {
+            SDL_SemWait(sem);
+        }
+    }
+    return 0;
+}
+
+/* The threads take turns, each waiting on a broadcast for its turn */
+static int SDLCALL
+cond_thread(void *data)
+{
+    const int self = (int) (intptr_t) data;
+    int i;
+    SDL_LockMutex(mutex);
+    for (i = 0; i < iterations / 10; ++i) {
+        while (turn != self) {
+            SDL_CondWait(cond, mutex);
+        }
+        turn = (turn + 1) % num_threads;
+        SDL_CondBroadcast(cond);
+    }
+    SDL_UnlockMutex(mutex);
+    return 0;
+}
+
+static void
+run_test(const char *name, SDL_ThreadFunction func, int operations)
+{
+    SDL_Thread **threads = (SDL_Thread **) SDL_calloc(num_threads, sizeof(*threads));
+    Uint64 start, elapsed;
+    int i;
+
+    shared_counter = 0;
+    turn = 0;
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_threads; ++i) {
+        threads[i] = SDL_CreateThread(func, name, (void *) (intptr_t) i);
+    }
+    for (i = 0; i < num_threads; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    elapsed = SDL_GetPerformanceCounter() - start;
+    SDL_free(threads);
+
+    SDL_Log("%-10s %d threads: %8.2f ms, %7.1f ns/operation\n", name, num_threads,
+            ((double)elapsed * 1000.0) / SDL_GetPerformanceFrequency(),
+            ((double)elapsed * 1000000000.0) / SDL_GetPerformanceFrequency() / operations);
+}
+
+int
+main(int argc, char *argv[])
+{
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        num_threads = SDL_atoi(argv[1]);
+    }
+    if (argc > 2) {
+        iterations = SDL_atoi(argv[2]);
+    }
+    if (num_threads < 2 || (num_threads & 1) || iterations <= 0) {
+        SDL_Log("USAGE: %s [even_num_threads] [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    mutex = SDL_CreateMutex();
+    cond = SDL_CreateCond();
+    sem = SDL_CreateSemaphore(0);
+    if (!mutex || !cond || !sem) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create primitives: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    run_test("mutex", mutex_thread, num_threads * iterations);
+    if (shared_counter != num_threads * iterations) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Mutex lost updates: %d of %d\n", shared_counter, num_threads * iterations);
+        return 1;
+    }
+    run_test("spinlock", spinlock_thread, num_threads * iterations);
+    run_test("semaphore", sem_thread, num_threads * iterations);
+    run_test("condition", cond_thread, num_threads * (iterations / 10));
+
+    SDL_DestroySemaphore(sem);
+    SDL_DestroyCond(cond);
+    SDL_DestroyMutex(mutex);
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,217 @@
+/*
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure how long it takes to convert an RGB image to 8 bits per pixel.
+
+   A 1920x1080 XRGB8888 image is converted to a few 256 color palettes,
+   both with SDL_ConvertSurface(), which maps the colors from scratch each
+   time, and by blitting it again onto the same 8-bit surface. The error
+   reported is the RMS difference from the source per channel, of single
+   pixels and of 4x4 blocks averaged, which is where dithering helps.
+
+   Set SDL_PALETTE_DITHER=1 to measure ordered dithering.
+ */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+static int width = 1920;
+static int height = 1080;
+static int iterations = 10;
+
+static SDL_Surface *
+create_image(void)
+{
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 0, SDL_PIXELFORMAT_RGB888);
+    int x, y;
+
+    if (!surface) {
+        return NULL;
+    }
+    srand(1);
+    for (y = 0; y < height; ++y) {
+        Uint32 *row = (Uint32 *) ((Uint8 *) surface->pixels + y * surface->pitch);
+        for (x = 0; x < width; ++x) {
+            /* Smooth gradients with a little noise */
+            const int r = (x * 255) / width;
+            const int g = (y * 255) / height;
+            const int b = ((x + y) * 255) / (width + height) + (rand() % 9) - 4;
+            row[x] = SDL_MapRGB(surface->format, r, g, SDL_max(0, SDL_min(b, 255)));
+        }
+    }
+    return surface;
+}
+
+static void
+create_palette(const char *name, SDL_Color *colors)
+{
+    int i;
+
+    if (SDL_strcmp(name, "cube") == 0) {
+        /* A 6x7x6 color cube with the last 4 entries gray */
+        for (i = 0; i < 252; ++i) {
+            colors[i].r = (Uint8) ((i / 42) * 255 / 5);
+            colors[i].g = (Uint8) (((i / 6) % 7) * 255 / 6);
+            colors[i].b = (Uint8) ((i % 6) * 255 / 5);
+            colors[i].a = SDL_ALPHA_OPAQUE;
+        }
+        for (; i < 256; ++i) {
+            colors[i].r = colors[i].g = colors[i].b = (Uint8) ((i - 251) * 51);
+            colors[i].a = SDL_ALPHA_OPAQUE;
+        }
+    } else {
+        /* Colors scattered all over the place */
+        srand(2);
+        for (i = 0; i < 256; ++i) {
+            colors[i].r = (Uint8) rand();
+            colors[i].g = (Uint8) rand();
+            colors[i].b = (Uint8) rand();
+            colors[i].a = SDL_ALPHA_OPAQUE;
+        }
+    }
+}
+
+static void
+measure_error(SDL_Surface *src, SDL_Surface *dst, double *pixel_error, double *block_error)
+{
+    const SDL_Color *colors = dst->format->palette->colors;
+    double pixel_sum = 0.0, block_sum = 0.0;
+    int x, y, i, j;
+
+    for (y = 0; y + 4 <= height; y += 4) {
+        for (x = 0; x + 4 <= width; x += 4) {
+            int diff[3] = { 0, 0, 0 };
+            for (j = 0; j < 4; ++j) {
+                const Uint32 *srow = (const Uint32 *) ((const Uint8 *) src->pixels + (y + j) * src->pitch);
+                const Uint8 *drow = (const Uint8 *) dst->pixels + (y + j) * dst->pitch;
+                for (i = 0; i < 4; ++i) {
+                    const Uint32 pixel = srow[x + i];
+                    const SDL_Color *color = &colors[drow[x + i]];
+                    const int dr = (int) color->r - (int) ((pixel >> 16) & 0xFF);
+                    const int dg = (int) color->g - (int) ((pixel >> 8) & 0xFF);
+                    const int db = (int) color->b - (int) (pixel & 0xFF);
+                    pixel_sum += dr * dr + dg * dg + db * db;
+                    diff[0] += dr;
+                    diff[1] += dg;
+                    diff[2] += db;
+                }
+            }
+            for (i = 0; i < 3; ++i) {
+                block_sum += (diff[i] / 16.0) * (diff[i] / 16.0);
+            }
+        }
+    }
+    *pixel_error = SDL_sqrt(pixel_sum / ((width / 4) * (height / 4) * 16 * 3));
+    *block_error = SDL_sqrt(block_sum / ((width / 4) * (height / 4) * 3));
+}
+
+static double
+seconds_since(Uint64 start)
+{
+    return (double) (SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+}
+
+static SDL_bool
+run_test(SDL_Surface *image, const char *name)
+{
+    SDL_Surface *dst = SDL_CreateRGBSurfaceWithFormat(0, width, height, 0, SDL_PIXELFORMAT_INDEX8);
+    SDL_Color colors[256];
+    double convert_time, blit_time, pixel_error, block_error;
+    Uint64 start;
+    int i;
+
+    if (!dst) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surface: %s\n", SDL_GetError());
+        return SDL_FALSE;
+    }
+    create_palette(name, colors);
+    SDL_SetPaletteColors(dst->format->palette, colors, 0, SDL_arraysize(colors));
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; ++i) {
+        SDL_Surface *converted = SDL_ConvertSurface(image, dst->format, 0);
+        if (!converted) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't convert surface: %s\n", SDL_GetError());
+            SDL_FreeSurface(dst);
+            return SDL_FALSE;
+        }
+        SDL_FreeSurface(converted);
+    }
+    convert_time = seconds_since(start);
+
+    SDL_BlitSurface(image, NULL, dst, NULL);
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; ++i) {
+        SDL_BlitSurface(image, NULL, dst, NULL);
+    }
+    blit_time = seconds_since(start);
+
+    measure_error(image, dst, &pixel_error, &block_error);
+    SDL_Log("%-7s %7.3f ms convert, %7.3f ms blit, error %5.2f per pixel, %5.2f per 4x4 block\n",
+            name, convert_time * 1000.0 / iterations, blit_time * 1000.0 / iterations,
+            pixel_error, block_error);
+
+    SDL_FreeSurface(dst);
+    return SDL_TRUE;
+}
+
+int
+main(int argc, char *argv[])
+{
+    SDL_Surface *image;
+    int failed = 0;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        width = SDL_atoi(argv[1]);
+    }
+    if (argc > 2) {
+        height = SDL_atoi(argv[2]);
+    }
+    if (argc > 3) {
+        iterations = SDL_atoi(argv[3]);
+    }
+    if (width < 4 || height < 4 || iterations <= 0) {
+        SDL_Log("USAGE: %s [width] [height] [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    image = create_image();
+    if (!image) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surface: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_Log("%dx%d image, %d iterations, %s\n", width, height, iterations,
+            SDL_GetHintBoolean("SDL_PALETTE_DITHER", SDL_FALSE) ? "dithered" : "not dithered");
+    if (!run_test(image, "cube")) {
+        ++failed;
+    }
+    if (!run_test(image, "random")) {
+        ++failed;
+    }
+
+    SDL_FreeSurface(image);
+    SDL_Quit();
+    return failed ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,215 @@
+/*
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Exercise the built-in profiler.
+
+   Worker threads record zones and counters while the main thread marks
+   frames, and a callback counts what comes out of SDL_FlushProfile(). The
+   test checks every zone that was entered was also left, and reports how
+   long a zone costs with recording off and on. SDL's own zones show up
+   too, from SDL_PumpEvents() and the blits the workers do. Finally SDL
+   quits while threads are still recording, which they have to survive.
+
+   Set SDL_PROFILE_TRACE to a file name to also get a Chrome trace, which
+   works the same for every other test program:
+     SDL_PROFILE_TRACE=trace.json ./testprofile
+ */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define NUM_THREADS     4
+#define ZONES_PER_FRAME 200
+
+static int num_frames = 100;
+
+static SDL_atomic_t frame;
+static SDL_atomic_t done;
+
+static int zone_begins;
+static int zone_ends;
+static int counters;
+static int frames;
+
+static void SDLCALL
+count_events(void *userdata, const SDL_ProfileEvent *events, int numevents)
+{
+    int i;
+
+    for (i = 0; i < numevents; ++i) {
+        switch (events[i].type) {
+        case SDL_PROFILE_ZONE_BEGIN:
+            ++zone_begins;
+            break;
+        case SDL_PROFILE_ZONE_END:
+            ++zone_ends;
+            break;
+        case SDL_PROFILE_COUNTER:
+            ++counters;
+            break;
+        case SDL_PROFILE_FRAME:
+            ++frames;
+            break;
+        }
+    }
+}
+
+static int SDLCALL
+worker(void *data)
+{
+    SDL_Surface *src = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 0, SDL_PIXELFORMAT_RGB888);
+    SDL_Surface *dst = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 0, SDL_PIXELFORMAT_RGB565);
+    int last_frame = -1;
+    int i;
+
+    while (!SDL_AtomicGet(&done)) {
+        const int current = SDL_AtomicGet(&frame);
+        if (current == last_frame) {
+            SDL_Delay(1);
+            continue;
+        }
+        last_frame = current;
+
+        SDL_ProfileBeginZone("worker frame");
+        for (i = 0; i < ZONES_PER_FRAME; ++i) {
+            SDL_ProfileBeginZone("work item");
+            if ((i % 50) == 0) {
+                SDL_BlitSurface(src, NULL, dst, NULL);
+            }
+            SDL_ProfileEndZone("work item");
+        }
+        SDL_ProfileCounter("worker items", ZONES_PER_FRAME);
+        SDL_ProfileEndZone("worker frame");
+    }
+
+    SDL_FreeSurface(src);
+    SDL_FreeSurface(dst);
+    return 0;
+}
+
+/* Record as fast as possible, across SDL_Quit() */
+static int SDLCALL
+recorder(void *data)
+{
+    while (!SDL_AtomicGet(&done)) {
+        SDL_ProfileBeginZone("recorder");
+        SDL_ProfileEndZone("recorder");
+    }
+    return 0;
+}
+
+static double
+time_zones(void)
+{
+    const int count = 100000;
+    Uint64 start = SDL_GetPerformanceCounter();
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        SDL_ProfileBeginZone("timing");
+        SDL_ProfileEndZone("timing");
+        if ((i % 1000) == 0) {
+            SDL_FlushProfile();
+        }
+    }
+    return (double) (SDL_GetPerformanceCounter() - start) * 1000000000.0 / SDL_GetPerformanceFrequency() / count;
+}
+
+int
+main(int argc, char *argv[])
+{
+    SDL_Thread *threads[NUM_THREADS];
+    double off, on;
+    int i;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        num_frames = SDL_atoi(argv[1]);
+    }
+    if (num_frames <= 0) {
+        SDL_Log("USAGE: %s [frames]\n", argv[0]);
+        return 1;
+    }
+
+    if (SDL_Init(SDL_INIT_EVENTS) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    if (SDL_SetProfileCallback(NULL, NULL) < 0) {
+        SDL_Log("SDL was built without the profiler: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 0;
+    }
+    off = SDL_GetHint(SDL_HINT_PROFILE_TRACE) ? -1.0 : time_zones();
+
+    SDL_SetProfileCallback(count_events, NULL);
+    on = time_zones();
+    zone_begins = zone_ends = 0;
+
+    for (i = 0; i < NUM_THREADS; ++i) {
+        threads[i] = SDL_CreateThread(worker, "ProfileWorker", NULL);
+    }
+    for (i = 0; i < num_frames; ++i) {
+        SDL_ProfileBeginZone("main frame");
+        SDL_AtomicSet(&frame, i);
+        SDL_PumpEvents();
+        SDL_Delay(5);
+        SDL_ProfileEndZone("main frame");
+        SDL_ProfileFrame();
+    }
+    SDL_AtomicSet(&done, 1);
+    for (i = 0; i < NUM_THREADS; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    SDL_FlushProfile();
+
+    SDL_Log("%d frames: %d zones entered, %d left, %d counters, %d frame markers\n",
+            num_frames, zone_begins, zone_ends, counters, frames);
+    if (off >= 0.0) {
+        SDL_Log("a zone costs %.1f ns with recording off, %.1f ns with it on\n", off, on);
+    } else {
+        SDL_Log("a zone costs %.1f ns with recording on\n", on);
+    }
+
+    SDL_Quit();
+
+    if (zone_begins != zone_ends || frames != num_frames) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Events were lost\n");
+        return 1;
+    }
+
+    /* Quit while other threads record */
+    if (SDL_Init(SDL_INIT_EVENTS) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_SetProfileCallback(count_events, NULL);
+    SDL_AtomicSet(&done, 0);
+    for (i = 0; i < NUM_THREADS; ++i) {
+        threads[i] = SDL_CreateThread(recorder, "ProfileRecorder", NULL);
+    }
+    SDL_Delay(10);
+    SDL_Quit();
+    SDL_Delay(10);
+    SDL_AtomicSet(&done, 1);
+    for (i = 0; i < NUM_THREADS; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    SDL_Log("quit while recording\n");
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
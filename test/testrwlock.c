@@ -0,0 +1,203 @@
+/*
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Stress test SDL_rwlock, and the hint list that is protected by one.
+
+   Readers check that a shared table is never seen half updated while
+   writers rewrite it. Run this under ThreadSanitizer to catch races the
+   checks can't see. SDL's CMake build takes its compiler flags from the
+   environment, so for example:
+     CFLAGS=-fsanitize=thread LDFLAGS=-fsanitize=thread cmake -DSDL_SHARED=OFF ..
+ */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define NUM_READERS     6
+#define NUM_WRITERS     2
+#define TABLE_SIZE      64
+
+static int iterations = 20000;
+
+static SDL_rwlock *rwlock;
+static int table[TABLE_SIZE];
+static SDL_atomic_t errors;
+static SDL_atomic_t readers_running;
+
+static int SDLCALL
+reader_thread(void *data)
+{
+    int i, j;
+
+    for (i = 0; i < iterations; ++i) {
+        SDL_LockRWLockForReading(rwlock);
+        for (j = 1; j < TABLE_SIZE; ++j) {
+            if (table[j] != table[0]) {
+                SDL_AtomicIncRef(&errors);
+                break;
+            }
+        }
+
+        /* Readers can take the lock again, and writers can't get in */
+        if ((i % 64) == 0) {
+            if (SDL_LockRWLockForReading(rwlock) < 0) {
+                SDL_AtomicIncRef(&errors);
+            } else {
+                SDL_UnlockRWLock(rwlock);
+            }
+            if (SDL_TryLockRWLockForWriting(rwlock) != SDL_MUTEX_TIMEDOUT) {
+                SDL_AtomicIncRef(&errors);
+            }
+        }
+        SDL_UnlockRWLock(rwlock);
+    }
+    SDL_AtomicAdd(&readers_running, -1);
+    return 0;
+}
+
+static int SDLCALL
+writer_thread(void *data)
+{
+    int i, j;
+
+    /* Keep writing while there are readers, to make sure they overlap */
+    for (i = 0; SDL_AtomicGet(&readers_running) > 0; ++i) {
+        if ((i & 1) == 0) {
+            SDL_LockRWLockForWriting(rwlock);
+        } else if (SDL_TryLockRWLockForWriting(rwlock) != 0) {
+            continue;
+        }
+        for (j = 0; j < TABLE_SIZE; ++j) {
+            ++table[j];
+        }
+        if (SDL_TryLockRWLockForReading(rwlock) != SDL_MUTEX_TIMEDOUT) {
+            SDL_AtomicIncRef(&errors);
+        }
+        SDL_UnlockRWLock(rwlock);
+        SDL_Delay(0);
+    }
+    return 0;
+}
+
+/* Hint readers and writers at the same time, with a callback registered */
+static SDL_atomic_t hint_callbacks;
+
+static void SDLCALL
+hint_callback(void *userdata, const char *name, const char *oldValue, const char *newValue)
+{
+    SDL_AtomicIncRef(&hint_callbacks);
+
+    /* Callbacks are called without the lock, so they can use hints */
+    SDL_GetHint(name);
+}
+
+static int SDLCALL
+hint_reader_thread(void *data)
+{
+    int i;
+
+    for (i = 0; i < iterations; ++i) {
+        const char *value = SDL_GetHint("TESTRWLOCK_HINT");
+        if (value && *value != 'A' && *value != 'B') {
+            SDL_AtomicIncRef(&errors);
+        }
+        SDL_GetHintBoolean("TESTRWLOCK_OTHER_HINT", SDL_FALSE);
+    }
+    SDL_AtomicAdd(&readers_running, -1);
+    return 0;
+}
+
+static int SDLCALL
+hint_writer_thread(void *data)
+{
+    int i;
+
+    for (i = 0; SDL_AtomicGet(&readers_running) > 0; ++i) {
+        SDL_SetHint("TESTRWLOCK_HINT", (i & 1) ? "A" : "B");
+        if ((i % 100) == 0) {
+            SDL_SetHint("TESTRWLOCK_OTHER_HINT", (i & 2) ? "1" : "0");
+        }
+        SDL_Delay(0);
+    }
+    return 0;
+}
+
+static void
+run_threads(SDL_ThreadFunction reader, SDL_ThreadFunction writer)
+{
+    SDL_Thread *threads[NUM_READERS + NUM_WRITERS];
+    int i;
+
+    SDL_AtomicSet(&readers_running, NUM_READERS);
+    for (i = 0; i < NUM_READERS; ++i) {
+        threads[i] = SDL_CreateThread(reader, "Reader", NULL);
+    }
+    for (i = 0; i < NUM_WRITERS; ++i) {
+        threads[NUM_READERS + i] = SDL_CreateThread(writer, "Writer", NULL);
+    }
+    for (i = 0; i < SDL_arraysize(threads); ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    Uint64 start;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        iterations = SDL_atoi(argv[1]);
+        if (iterations <= 0) {
+            SDL_Log("USAGE: %s [iterations]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    rwlock = SDL_CreateRWLock();
+    if (!rwlock) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create rwlock: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    start = SDL_GetPerformanceCounter();
+    run_threads(reader_thread, writer_thread);
+    SDL_Log("rwlock: %d readers x %d reads in %.2f ms, table written %d times\n",
+            NUM_READERS, iterations,
+            ((double)(SDL_GetPerformanceCounter() - start) * 1000.0) / SDL_GetPerformanceFrequency(),
+            table[0]);
+    SDL_DestroyRWLock(rwlock);
+
+    SDL_AddHintCallback("TESTRWLOCK_HINT", hint_callback, NULL);
+    start = SDL_GetPerformanceCounter();
+    run_threads(hint_reader_thread, hint_writer_thread);
+    SDL_Log("hints: %d readers x %d reads in %.2f ms, %d callbacks\n",
+            NUM_READERS, iterations,
+            ((double)(SDL_GetPerformanceCounter() - start) * 1000.0) / SDL_GetPerformanceFrequency(),
+            SDL_AtomicGet(&hint_callbacks));
+    SDL_DelHintCallback("TESTRWLOCK_HINT", hint_callback, NULL);
+
+    SDL_Quit();
+
+    SDL_Log("%d errors: %s\n", SDL_AtomicGet(&errors), SDL_AtomicGet(&errors) ? "FAILED" : "PASSED");
+    return SDL_AtomicGet(&errors) ? 1 : 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
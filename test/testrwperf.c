@@ -0,0 +1,145 @@
+/*
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Compare loading files through stdio, buffered and memory mapped SDL_RWops */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+typedef enum
+{
+    BACKEND_FILE,
+    BACKEND_BUFFERED,
+    BACKEND_MAPPED
+} Backend;
+
+static const char *backend_names[] = { "file", "buffered", "mapped" };
+
+static SDL_RWops *
+open_file(Backend backend, const char *file)
+{
+    switch (backend) {
+    case BACKEND_FILE:
+        return SDL_RWFromFile(file, "rb");
+    case BACKEND_BUFFERED:
+        return SDL_RWFromBuffered(SDL_RWFromFile(file, "rb"), 0, SDL_TRUE);
+    case BACKEND_MAPPED:
+        return SDL_RWFromFileMapped(file);
+    }
+    return NULL;
+}
+
+static int
+load_bmp(SDL_RWops *src)
+{
+    SDL_Surface *surface = SDL_LoadBMP_RW(src, 1);
+    if (!surface) {
+        return -1;
+    }
+    SDL_FreeSurface(surface);
+    return 0;
+}
+
+static int
+load_wav(SDL_RWops *src)
+{
+    SDL_AudioSpec spec;
+    Uint8 *buf;
+    Uint32 len;
+
+    if (!SDL_LoadWAV_RW(src, 1, &spec, &buf, &len)) {
+        return -1;
+    }
+    SDL_FreeWAV(buf);
+    return 0;
+}
+
+static int
+read_le16(SDL_RWops *src)
+{
+    Sint64 i, count = SDL_RWsize(src) / 2;
+    Uint32 sum = 0;
+
+    for (i = 0; i < count; ++i) {
+        sum += SDL_ReadLE16(src);
+    }
+    SDL_RWclose(src);
+    return (sum == 0xFFFFFFFF) ? -1 : 0;
+}
+
+static int
+load_file(SDL_RWops *src)
+{
+    void *data = SDL_LoadFile_RW(src, NULL, 1);
+    if (!data) {
+        return -1;
+    }
+    SDL_free(data);
+    return 0;
+}
+
+static void
+run_test(const char *name, const char *file, int (*func)(SDL_RWops *), int iterations)
+{
+    int backend;
+
+    for (backend = BACKEND_FILE; backend <= BACKEND_MAPPED; ++backend) {
+        Uint64 start, elapsed;
+        int i;
+
+        start = SDL_GetPerformanceCounter();
+        for (i = 0; i < iterations; ++i) {
+            SDL_RWops *src = open_file((Backend)backend, file);
+            if (!src || func(src) < 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s with %s backend failed: %s\n", name, backend_names[backend], SDL_GetError());
+                return;
+            }
+        }
+        elapsed = SDL_GetPerformanceCounter() - start;
+
+        SDL_Log("%-12s %-9s %8.3f ms/iteration\n", name, backend_names[backend],
+                ((double)elapsed * 1000.0) / SDL_GetPerformanceFrequency() / iterations);
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    int iterations = 200;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        iterations = SDL_atoi(argv[1]);
+        if (iterations <= 0) {
+            SDL_Log("USAGE: %s [iterations]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    run_test("LoadBMP", "sample.bmp", load_bmp, iterations);
+    run_test("LoadWAV", "sample.wav", load_wav, iterations);
+    run_test("ReadLE16", "sample.wav", read_le16, SDL_max(iterations / 20, 1));
+    run_test("LoadFile", "sample.wav", load_file, iterations);
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -37,6 +37,8 @@ static SDL_Rect *positions;
 static SDL_Rect *velocities;
 static int sprite_w, sprite_h;
 static SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+static SDL_bool dirty_only;
+static Uint64 presented_bytes;
 
 /* Number of iterations to move sprites - used for visual tests. */
 /* -1: infinite random moves (default); >=0: enables N deterministic moves */
@@ -149,57 +151,67 @@ MoveSprites(SDL_Renderer * renderer, SDL_Texture * sprite)
         SDL_SetTextureAlphaMod(sprite, (Uint8) current_alpha);
     }
 
-    /* Draw a gray background */
-    SDL_SetRenderDrawColor(renderer, 0xA0, 0xA0, 0xA0, 0xFF);
-    SDL_RenderClear(renderer);
-
-    /* Test points */
-    SDL_SetRenderDrawColor(renderer, 0xFF, 0x00, 0x00, 0xFF);
-    SDL_RenderDrawPoint(renderer, 0, 0);
-    SDL_RenderDrawPoint(renderer, viewport.w-1, 0);
-    SDL_RenderDrawPoint(renderer, 0, viewport.h-1);
-    SDL_RenderDrawPoint(renderer, viewport.w-1, viewport.h-1);
-
-    /* Test horizontal and vertical lines */
-    SDL_SetRenderDrawColor(renderer, 0x00, 0xFF, 0x00, 0xFF);
-    SDL_RenderDrawLine(renderer, 1, 0, viewport.w-2, 0);
-    SDL_RenderDrawLine(renderer, 1, viewport.h-1, viewport.w-2, viewport.h-1);
-    SDL_RenderDrawLine(renderer, 0, 1, 0, viewport.h-2);
-    SDL_RenderDrawLine(renderer, viewport.w-1, 1, viewport.w-1, viewport.h-2);
-
-    /* Test fill and copy */
-    SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
-    temp.x = 1;
-    temp.y = 1;
-    temp.w = sprite_w;
-    temp.h = sprite_h;
-    SDL_RenderFillRect(renderer, &temp);
-    SDL_RenderCopy(renderer, sprite, NULL, &temp);
-    temp.x = viewport.w-sprite_w-1;
-    temp.y = 1;
-    temp.w = sprite_w;
-    temp.h = sprite_h;
-    SDL_RenderFillRect(renderer, &temp);
-    SDL_RenderCopy(renderer, sprite, NULL, &temp);
-    temp.x = 1;
-    temp.y = viewport.h-sprite_h-1;
-    temp.w = sprite_w;
-    temp.h = sprite_h;
-    SDL_RenderFillRect(renderer, &temp);
-    SDL_RenderCopy(renderer, sprite, NULL, &temp);
-    temp.x = viewport.w-sprite_w-1;
-    temp.y = viewport.h-sprite_h-1;
-    temp.w = sprite_w;
-    temp.h = sprite_h;
-    SDL_RenderFillRect(renderer, &temp);
-    SDL_RenderCopy(renderer, sprite, NULL, &temp);
-
-    /* Test diagonal lines */
-    SDL_SetRenderDrawColor(renderer, 0x00, 0xFF, 0x00, 0xFF);
-    SDL_RenderDrawLine(renderer, sprite_w, sprite_h,
-                       viewport.w-sprite_w-2, viewport.h-sprite_h-2);
-    SDL_RenderDrawLine(renderer, viewport.w-sprite_w-2, sprite_h,
-                       sprite_w, viewport.h-sprite_h-2);
+    if (dirty_only) {
+        /* Erase the sprites where they were, and leave the rest alone.
+           This relies on the renderer keeping its contents after a present,
+           which the software renderer does. */
+        SDL_SetRenderDrawColor(renderer, 0xA0, 0xA0, 0xA0, 0xFF);
+        for (i = 0; i < num_sprites; ++i) {
+            SDL_RenderFillRect(renderer, &positions[i]);
+        }
+    } else {
+        /* Draw a gray background */
+        SDL_SetRenderDrawColor(renderer, 0xA0, 0xA0, 0xA0, 0xFF);
+        SDL_RenderClear(renderer);
+
+        /* Test points */
+        SDL_SetRenderDrawColor(renderer, 0xFF, 0x00, 0x00, 0xFF);
+        SDL_RenderDrawPoint(renderer, 0, 0);
+        SDL_RenderDrawPoint(renderer, viewport.w-1, 0);
+        SDL_RenderDrawPoint(renderer, 0, viewport.h-1);
+        SDL_RenderDrawPoint(renderer, viewport.w-1, viewport.h-1);
+
+        /* Test horizontal and vertical lines */
+        SDL_SetRenderDrawColor(renderer, 0x00, 0xFF, 0x00, 0xFF);
+        SDL_RenderDrawLine(renderer, 1, 0, viewport.w-2, 0);
+        SDL_RenderDrawLine(renderer, 1, viewport.h-1, viewport.w-2, viewport.h-1);
+        SDL_RenderDrawLine(renderer, 0, 1, 0, viewport.h-2);
+        SDL_RenderDrawLine(renderer, viewport.w-1, 1, viewport.w-1, viewport.h-2);
+
+        /* Test fill and copy */
+        SDL_SetRenderDrawColor(renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+        temp.x = 1;
+        temp.y = 1;
+        temp.w = sprite_w;
+        temp.h = sprite_h;
+        SDL_RenderFillRect(renderer, &temp);
+        SDL_RenderCopy(renderer, sprite, NULL, &temp);
+        temp.x = viewport.w-sprite_w-1;
+        temp.y = 1;
+        temp.w = sprite_w;
+        temp.h = sprite_h;
+        SDL_RenderFillRect(renderer, &temp);
+        SDL_RenderCopy(renderer, sprite, NULL, &temp);
+        temp.x = 1;
+        temp.y = viewport.h-sprite_h-1;
+        temp.w = sprite_w;
+        temp.h = sprite_h;
+        SDL_RenderFillRect(renderer, &temp);
+        SDL_RenderCopy(renderer, sprite, NULL, &temp);
+        temp.x = viewport.w-sprite_w-1;
+        temp.y = viewport.h-sprite_h-1;
+        temp.w = sprite_w;
+        temp.h = sprite_h;
+        SDL_RenderFillRect(renderer, &temp);
+        SDL_RenderCopy(renderer, sprite, NULL, &temp);
+
+        /* Test diagonal lines */
+        SDL_SetRenderDrawColor(renderer, 0x00, 0xFF, 0x00, 0xFF);
+        SDL_RenderDrawLine(renderer, sprite_w, sprite_h,
+                           viewport.w-sprite_w-2, viewport.h-sprite_h-2);
+        SDL_RenderDrawLine(renderer, viewport.w-sprite_w-2, sprite_h,
+                           sprite_w, viewport.h-sprite_h-2);
+    }
 
     /* Conditionally move the sprites, bounce at the wall */
     if (iterations == -1 || iterations > 0) {
@@ -241,6 +253,18 @@ MoveSprites(SDL_Renderer * renderer, SDL_Texture * sprite)
     SDL_RenderPresent(renderer);
 }
 
+static void SDLCALL
+count_presented_bytes(void *userdata, SDL_Window *window, Uint32 format,
+                      const void *pixels, int pitch, int w, int h,
+                      const SDL_Rect *rects, int numrects)
+{
+    int i;
+
+    for (i = 0; i < numrects; ++i) {
+        presented_bytes += (Uint64) rects[i].w * rects[i].h * SDL_BYTESPERPIXEL(format);
+    }
+}
+
 void
 loop()
 {
@@ -311,6 +335,9 @@ main(int argc, char *argv[])
                     if (iterations < -1) iterations = -1;
                     consumed = 2;
                 }
+            } else if (SDL_strcasecmp(argv[i], "--dirty") == 0) {
+                dirty_only = SDL_TRUE;
+                consumed = 1;
             } else if (SDL_strcasecmp(argv[i], "--cyclecolor") == 0) {
                 cycle_color = SDL_TRUE;
                 consumed = 1;
@@ -326,7 +353,7 @@ main(int argc, char *argv[])
             }
         }
         if (consumed < 0) {
-            SDL_Log("Usage: %s %s [--blend none|blend|add|mod] [--cyclecolor] [--cyclealpha] [--iterations N] [num_sprites] [icon.bmp]\n",
+            SDL_Log("Usage: %s %s [--blend none|blend|add|mod] [--cyclecolor] [--cyclealpha] [--dirty] [--iterations N] [num_sprites] [icon.bmp]\n",
                     argv[0], SDLTest_CommonUsage(state));
             quit(1);
         }
@@ -382,6 +409,9 @@ main(int argc, char *argv[])
         }
     }
 
+    /* Count what gets presented, where the video driver can tell us */
+    SDL_SetFrameSinkCallback(count_presented_bytes, NULL);
+
     /* Main render loop */
     frames = 0;
     then = SDL_GetTicks();
@@ -402,6 +432,9 @@ main(int argc, char *argv[])
         double fps = ((double) frames * 1000) / (now - then);
         SDL_Log("%2.2f frames per second\n", fps);
     }
+    if (presented_bytes && frames) {
+        SDL_Log("%.0f bytes presented per frame\n", (double) presented_bytes / frames);
+    }
     quit(0);
     return 0;
 }
@@ -0,0 +1,242 @@
+/*
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+
+/* Measure how the software renderer scales with SDL_RENDER_SOFTWARE_THREADS.
+
+   This draws the testsprite2 scene into a surface for a number of frames,
+   once for each thread count, and reports the frame time and speedup over
+   one thread. The sprites change alpha as they are drawn, and the frame
+   also has blended fills, lines and points, which are drawn directly. Every
+   thread count has to produce exactly the pixels one thread does.
+ */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define WIDTH       1920
+#define HEIGHT      1080
+
+static int num_sprites = 5000;
+static int num_frames = 100;
+static int max_threads;
+
+static SDL_Rect *positions;
+static SDL_Point *velocities;
+
+static void
+reset_sprites(int sprite_w, int sprite_h)
+{
+    Uint32 seed = 1;
+    int i;
+
+    for (i = 0; i < num_sprites; ++i) {
+        seed = seed * 1103515245 + 12345;
+        positions[i].x = (seed >> 8) % (WIDTH - sprite_w);
+        seed = seed * 1103515245 + 12345;
+        positions[i].y = (seed >> 8) % (HEIGHT - sprite_h);
+        positions[i].w = sprite_w;
+        positions[i].h = sprite_h;
+        velocities[i].x = (i % 5) - 2;
+        velocities[i].y = ((i / 5) % 5) - 2;
+    }
+}
+
+static void
+draw_frame(SDL_Renderer *renderer, SDL_Texture *sprite, int frame)
+{
+    SDL_Rect rect;
+    int i;
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(renderer, 0xA0, 0xA0, 0xA0, 0xFF);
+    SDL_RenderClear(renderer);
+
+    SDL_SetRenderDrawColor(renderer, 0xFF, 0x00, 0x00, 0xFF);
+    SDL_RenderDrawPoint(renderer, 0, 0);
+    SDL_RenderDrawPoint(renderer, WIDTH - 1, HEIGHT - 1);
+    SDL_SetRenderDrawColor(renderer, 0x00, 0xFF, 0x00, 0xFF);
+    SDL_RenderDrawLine(renderer, 0, 0, WIDTH - 1, HEIGHT - 1);
+    SDL_RenderDrawLine(renderer, WIDTH - 1, 0, 0, HEIGHT - 1);
+
+    /* Blended fills crossing tile edges */
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    for (i = 0; i < 16; ++i) {
+        rect.x = (i * 117 + frame * 3) % WIDTH - 50;
+        rect.y = (i * 67) % HEIGHT;
+        rect.w = 150;
+        rect.h = 90;
+        SDL_SetRenderDrawColor(renderer, i * 16, 0x80, 0xFF - i * 16, 0x60);
+        SDL_RenderFillRect(renderer, &rect);
+    }
+
+    for (i = 0; i < num_sprites; ++i) {
+        SDL_Rect *position = &positions[i];
+
+        position->x += velocities[i].x;
+        if (position->x < 0 || position->x >= WIDTH - position->w) {
+            velocities[i].x = -velocities[i].x;
+            position->x += velocities[i].x;
+        }
+        position->y += velocities[i].y;
+        if (position->y < 0 || position->y >= HEIGHT - position->h) {
+            velocities[i].y = -velocities[i].y;
+            position->y += velocities[i].y;
+        }
+
+        if ((i % 100) == 0) {
+            SDL_SetTextureAlphaMod(sprite, (Uint8) (255 - (i / 100) % 128));
+        }
+        SDL_RenderCopy(renderer, sprite, NULL, position);
+    }
+
+    SDL_RenderPresent(renderer);
+}
+
+/* Draw all frames with the given thread count, returns ms per frame */
+static double
+run_test(SDL_Surface *icon, SDL_Surface *target, int threads)
+{
+    SDL_Renderer *renderer;
+    SDL_Texture *sprite;
+    Uint64 start;
+    char value[16];
+    int i;
+
+    SDL_snprintf(value, sizeof(value), "%d", threads);
+    SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, value);
+    renderer = SDL_CreateSoftwareRenderer(target);
+    if (!renderer) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create renderer: %s\n", SDL_GetError());
+        return -1.0;
+    }
+    sprite = SDL_CreateTextureFromSurface(renderer, icon);
+    if (!sprite) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create texture: %s\n", SDL_GetError());
+        SDL_DestroyRenderer(renderer);
+        return -1.0;
+    }
+
+    reset_sprites(icon->w, icon->h);
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_frames; ++i) {
+        draw_frame(renderer, sprite, i);
+    }
+    start = SDL_GetPerformanceCounter() - start;
+
+    SDL_DestroyTexture(sprite);
+    SDL_DestroyRenderer(renderer);
+    return (double) start * 1000.0 / SDL_GetPerformanceFrequency() / num_frames;
+}
+
+static SDL_bool
+same_pixels(SDL_Surface *a, SDL_Surface *b)
+{
+    int y;
+
+    for (y = 0; y < a->h; ++y) {
+        if (SDL_memcmp((Uint8 *) a->pixels + y * a->pitch,
+                       (Uint8 *) b->pixels + y * b->pitch, a->w * 4) != 0) {
+            SDL_Log("First difference in row %d\n", y);
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+
+int
+main(int argc, char *argv[])
+{
+    SDL_Surface *icon, *expected, *target;
+    double serial, ms;
+    int threads, status = 0;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    max_threads = SDL_max(SDL_GetCPUCount(), 4);
+    if (argc > 1) {
+        num_sprites = SDL_atoi(argv[1]);
+    }
+    if (argc > 2) {
+        num_frames = SDL_atoi(argv[2]);
+    }
+    if (argc > 3) {
+        max_threads = SDL_atoi(argv[3]);
+    }
+    if (num_sprites <= 0 || num_frames <= 0 || max_threads <= 0) {
+        SDL_Log("USAGE: %s [sprites] [frames] [max threads]\n", argv[0]);
+        return 1;
+    }
+
+    /* The calling thread draws tiles too */
+    if (max_threads > 1) {
+        char value[16];
+        SDL_snprintf(value, sizeof(value), "%d", max_threads - 1);
+        SDL_SetHint(SDL_HINT_JOB_THREADS, value);
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    icon = SDL_LoadBMP("icon.bmp");
+    if (!icon) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load icon.bmp: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    SDL_SetColorKey(icon, SDL_TRUE, *(Uint8 *) icon->pixels);
+
+    positions = (SDL_Rect *) SDL_malloc(num_sprites * sizeof(*positions));
+    velocities = (SDL_Point *) SDL_malloc(num_sprites * sizeof(*velocities));
+    expected = SDL_CreateRGBSurfaceWithFormat(0, WIDTH, HEIGHT, 32, SDL_PIXELFORMAT_RGB888);
+    target = SDL_CreateRGBSurfaceWithFormat(0, WIDTH, HEIGHT, 32, SDL_PIXELFORMAT_RGB888);
+    if (!positions || !velocities || !expected || !target) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory!\n");
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_Log("%dx%d, %d sprites, %d frames, %d CPUs\n",
+            WIDTH, HEIGHT, num_sprites, num_frames, SDL_GetCPUCount());
+    serial = run_test(icon, expected, 1);
+    if (serial < 0.0) {
+        status = 1;
+    } else {
+        SDL_Log(" 1 thread:  %7.3f ms per frame\n", serial);
+    }
+    for (threads = 2; status == 0 && threads <= max_threads; threads *= 2) {
+        ms = run_test(icon, target, threads);
+        if (ms < 0.0) {
+            status = 1;
+            break;
+        }
+        SDL_Log("%2d threads: %7.3f ms per frame, %.2fx\n", threads, ms, serial / ms);
+        if (!same_pixels(expected, target)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%d threads drew different pixels than 1\n", threads);
+            status = 1;
+        }
+    }
+
+    SDL_FreeSurface(target);
+    SDL_FreeSurface(expected);
+    SDL_free(velocities);
+    SDL_free(positions);
+    SDL_FreeSurface(icon);
+    SDL_Quit();
+    return status;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
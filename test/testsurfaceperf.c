@@ -0,0 +1,133 @@
+/*
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure how much SIMD aligned surface memory speeds up fills and blits.
+
+   SDL_CreateRGBSurfaceWithFormat() allocates pixels aligned to the SIMD
+   vector width, with each row padded out to a multiple of it. This compares
+   those surfaces against the same pixels laid out the old way, with rows
+   padded to 4 bytes, created with SDL_CreateRGBSurfaceWithFormatFrom():
+     - fill: SDL_FillRect() of the whole surface
+     - blit: SDL_BlitSurface() copy between two surfaces of the same format
+   The default size has rows that are not a multiple of 16 bytes, like many
+   window sizes.
+ */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+static int width = 1366;
+static int height = 768;
+static int iterations = 500;
+
+static SDL_Surface *
+create_packed_surface(Uint32 format, void **memory)
+{
+    const int pitch = (width * SDL_BYTESPERPIXEL(format) + 3) & ~3;
+
+    /* Offset the pixels so they're only 4 byte aligned, as SDL_malloc() may be */
+    *memory = SDL_malloc(pitch * height + 16);
+    if (!*memory) {
+        return NULL;
+    }
+    return SDL_CreateRGBSurfaceWithFormatFrom((Uint8 *) *memory + 4, width, height,
+                                              SDL_BITSPERPIXEL(format), pitch, format);
+}
+
+static double
+time_fill(SDL_Surface *surface)
+{
+    Uint64 start = SDL_GetPerformanceCounter();
+    int i;
+
+    for (i = 0; i < iterations; ++i) {
+        SDL_FillRect(surface, NULL, (Uint32) i);
+    }
+    return (double) (SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+}
+
+static double
+time_blit(SDL_Surface *src, SDL_Surface *dst)
+{
+    Uint64 start = SDL_GetPerformanceCounter();
+    int i;
+
+    for (i = 0; i < iterations; ++i) {
+        SDL_BlitSurface(src, NULL, dst, NULL);
+    }
+    return (double) (SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+}
+
+static void
+run_test(const char *name, Uint32 format)
+{
+    const double megabytes = (double) width * height * SDL_BYTESPERPIXEL(format) * iterations / (1024.0 * 1024.0);
+    SDL_Surface *aligned_src, *aligned_dst, *packed_src, *packed_dst;
+    void *src_memory = NULL, *dst_memory = NULL;
+
+    aligned_src = SDL_CreateRGBSurfaceWithFormat(0, width, height, SDL_BITSPERPIXEL(format), format);
+    aligned_dst = SDL_CreateRGBSurfaceWithFormat(0, width, height, SDL_BITSPERPIXEL(format), format);
+    packed_src = create_packed_surface(format, &src_memory);
+    packed_dst = create_packed_surface(format, &dst_memory);
+    if (!aligned_src || !aligned_dst || !packed_src || !packed_dst) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surfaces: %s\n", SDL_GetError());
+    } else {
+        SDL_Log("%-8s pitch %5d aligned, %5d packed: fill %7.0f MB/s aligned, %7.0f MB/s packed; blit %7.0f MB/s aligned, %7.0f MB/s packed\n",
+                name, aligned_src->pitch, packed_src->pitch,
+                megabytes / time_fill(aligned_dst), megabytes / time_fill(packed_dst),
+                megabytes / time_blit(aligned_src, aligned_dst), megabytes / time_blit(packed_src, packed_dst));
+    }
+
+    SDL_FreeSurface(aligned_src);
+    SDL_FreeSurface(aligned_dst);
+    SDL_FreeSurface(packed_src);
+    SDL_FreeSurface(packed_dst);
+    SDL_free(src_memory);
+    SDL_free(dst_memory);
+}
+
+int
+main(int argc, char *argv[])
+{
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        width = SDL_atoi(argv[1]);
+    }
+    if (argc > 2) {
+        height = SDL_atoi(argv[2]);
+    }
+    if (argc > 3) {
+        iterations = SDL_atoi(argv[3]);
+    }
+    if (width <= 0 || height <= 0 || iterations <= 0) {
+        SDL_Log("USAGE: %s [width] [height] [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    if (SDL_Init(0) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("%dx%d surfaces, %d iterations\n", width, height, iterations);
+    run_test("XRGB8888", SDL_PIXELFORMAT_RGB888);
+    run_test("RGB565", SDL_PIXELFORMAT_RGB565);
+    run_test("INDEX8", SDL_PIXELFORMAT_INDEX8);
+
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */
@@ -0,0 +1,194 @@
+/*
+  Copyright (C) 1997-2018 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure frame times of a window surface drawn in software.
+
+   Each frame moves a number of sprites around the window surface and then
+   presents it, either just the rects the sprites covered with
+   SDL_UpdateWindowSurfaceRects(), or the whole surface with
+   SDL_UpdateWindowSurface(). It reports the median, 95th percentile and
+   worst frame time for both, which shows how much of the presentation
+   the driver overlaps with drawing the next frame.
+
+   To run it on a headless machine under X11:
+     xvfb-run -s "-screen 0 1024x768x24" ./testwindowsurface
+ */
+
+#include <stdlib.h>
+
+#include "SDL.h"
+
+#define NUM_SPRITES 32
+#define SPRITE_SIZE 32
+
+static int width = 640;
+static int height = 480;
+static int num_frames = 1000;
+
+static SDL_Rect positions[NUM_SPRITES];
+static SDL_Point velocities[NUM_SPRITES];
+
+static int SDLCALL
+compare_ticks(const void *a, const void *b)
+{
+    const Uint64 x = *(const Uint64 *) a;
+    const Uint64 y = *(const Uint64 *) b;
+
+    return (x < y) ? -1 : (x > y);
+}
+
+static void
+move_sprites(SDL_Surface *surface, Uint32 background, Uint32 color, SDL_Rect *dirty)
+{
+    int i;
+
+    for (i = 0; i < NUM_SPRITES; ++i) {
+        SDL_Rect *position = &positions[i];
+
+        SDL_FillRect(surface, position, background);
+        dirty[i * 2] = *position;
+
+        position->x += velocities[i].x;
+        if (position->x < 0 || position->x + SPRITE_SIZE > surface->w) {
+            velocities[i].x = -velocities[i].x;
+            position->x += velocities[i].x * 2;
+        }
+        position->y += velocities[i].y;
+        if (position->y < 0 || position->y + SPRITE_SIZE > surface->h) {
+            velocities[i].y = -velocities[i].y;
+            position->y += velocities[i].y * 2;
+        }
+
+        SDL_FillRect(surface, position, color);
+        dirty[i * 2 + 1] = *position;
+    }
+}
+
+static int
+run_test(SDL_Window *window, SDL_bool full, Uint64 *ticks)
+{
+    SDL_Surface *surface = SDL_GetWindowSurface(window);
+    SDL_Rect dirty[NUM_SPRITES * 2];
+    Uint32 background, color;
+    Uint64 start, now;
+    SDL_Event event;
+    int i;
+
+    if (!surface) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't get window surface: %s\n", SDL_GetError());
+        return -1;
+    }
+    background = SDL_MapRGB(surface->format, 0x20, 0x20, 0x40);
+    color = SDL_MapRGB(surface->format, 0xFF, 0xC0, 0x00);
+
+    for (i = 0; i < NUM_SPRITES; ++i) {
+        positions[i].x = rand() % (surface->w - SPRITE_SIZE);
+        positions[i].y = rand() % (surface->h - SPRITE_SIZE);
+        positions[i].w = SPRITE_SIZE;
+        positions[i].h = SPRITE_SIZE;
+        velocities[i].x = 1 + rand() % 4;
+        velocities[i].y = 1 + rand() % 4;
+    }
+    SDL_FillRect(surface, NULL, background);
+    SDL_UpdateWindowSurface(window);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_frames; ++i) {
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_QUIT) {
+                return -1;
+            }
+        }
+
+        move_sprites(surface, background, color, dirty);
+        if (full) {
+            SDL_UpdateWindowSurface(window);
+        } else {
+            SDL_UpdateWindowSurfaceRects(window, dirty, SDL_arraysize(dirty));
+        }
+
+        now = SDL_GetPerformanceCounter();
+        ticks[i] = now - start;
+        start = now;
+    }
+    return 0;
+}
+
+static void
+report(const char *name, Uint64 *ticks)
+{
+    const double ms = 1000.0 / SDL_GetPerformanceFrequency();
+    Uint64 total = 0;
+    int i;
+
+    for (i = 0; i < num_frames; ++i) {
+        total += ticks[i];
+    }
+    SDL_qsort(ticks, num_frames, sizeof(*ticks), compare_ticks);
+    SDL_Log("%-6s %6.3f ms median, %6.3f ms 95th percentile, %7.3f ms max, %6.1f frames per second\n",
+            name, ticks[num_frames / 2] * ms, ticks[(num_frames * 95 - 1) / 100] * ms,
+            ticks[num_frames - 1] * ms, num_frames / (total * ms / 1000.0));
+}
+
+int
+main(int argc, char *argv[])
+{
+    SDL_Window *window;
+    Uint64 *ticks;
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    if (argc > 1) {
+        width = SDL_atoi(argv[1]);
+    }
+    if (argc > 2) {
+        height = SDL_atoi(argv[2]);
+    }
+    if (argc > 3) {
+        num_frames = SDL_atoi(argv[3]);
+    }
+    if (width <= SPRITE_SIZE || height <= SPRITE_SIZE || num_frames <= 0) {
+        SDL_Log("USAGE: %s [width] [height] [frames]\n", argv[0]);
+        return 1;
+    }
+
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    window = SDL_CreateWindow("testwindowsurface", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                              width, height, 0);
+    ticks = (Uint64 *) SDL_malloc(num_frames * sizeof(*ticks));
+    if (!window || !ticks) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create window: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_Log("%s video driver, %dx%d window, %d sprites, %d frames\n",
+            SDL_GetCurrentVideoDriver(), width, height, NUM_SPRITES, num_frames);
+    if (run_test(window, SDL_FALSE, ticks) == 0) {
+        report("rects", ticks);
+    }
+    if (run_test(window, SDL_TRUE, ticks) == 0) {
+        report("full", ticks);
+    }
+
+    SDL_free(ticks);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    return 0;
+}
+
+/* vi: set ts=4 sw=4 expandtab: */